@@ -61,6 +61,7 @@
 #include <QtCore>
 
 #include <algorithm>
+#include <exception>
 
 /*******************************************************************************
  *  Namespace
@@ -634,16 +635,10 @@ bool CommandLineInterface::openProject(
       boards = project->getBoards();
     }
 
-    // Build planes, if needed.
-    if (runDrc || exportPcbFabricationData || (!runJobs.isEmpty()) ||
-        runAllJobs) {
-      foreach (Board* board, boards) {
-        qInfo().nospace().noquote() << "Rebuilding all planes of board '"
-                                    << *board->getName() << "'...";
-        BoardPlaneFragmentsBuilder builder;
-        builder.runAndApply(*board);  // can throw
-      }
-    } else {
+    // Planes are rebuilt in the background later, if needed.
+    const bool rebuildPlanes = runDrc || exportPcbFabricationData ||
+        (!runJobs.isEmpty()) || runAllJobs;
+    if (!rebuildPlanes) {
       qInfo() << "No need to rebuild planes, thus skipped.";
     }
 
@@ -673,12 +668,104 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // Load custom fabrication output settings already now since the PCB
+    // fabrication data of each board is exported as soon as its DRC is
+    // finished, see below.
+    std::optional<BoardFabricationOutputSettings> customFabricationSettings;
+    QString fabricationSettingsError;
+    if (exportPcbFabricationData && (!pcbFabricationSettingsPath.isEmpty())) {
+      try {
+        qDebug() << "Load custom fabrication output settings:"
+                 << pcbFabricationSettingsPath;
+        const FilePath fp(
+            QFileInfo(pcbFabricationSettingsPath).absoluteFilePath());
+        const std::unique_ptr<const SExpression> root =
+            SExpression::parse(FileUtils::readFile(fp), fp);
+        customFabricationSettings =
+            BoardFabricationOutputSettings(*root);  // can throw
+      } catch (const Exception& e) {
+        fabricationSettingsError = e.getMsg();  // printed later, see below
+      }
+    }
+
+    // Start DRC of all selected boards. The DRC copies the board data and
+    // then runs in worker threads (including the rebuild of planes), so all
+    // boards are checked concurrently and the ERC below runs in parallel to
+    // them. Planes of boards not being checked are rebuilt in the background
+    // as well.
+    struct BoardJobs {
+      Board* board = nullptr;
+      std::unique_ptr<BoardDesignRuleCheck> drc;
+      std::unique_ptr<BoardPlaneFragmentsBuilder> planesBuilder;
+      bool fabricationExported = false;
+      QVector<FilePath> fabricationFiles;
+      std::exception_ptr fabricationError;
+    };
+    std::vector<BoardJobs> boardJobs;
+    QString drcSettingsError;
+    std::optional<BoardDesignRuleCheckSettings> customDrcSettings;
+    if (runDrc && (!drcSettingsPath.isEmpty())) {
+      try {
+        qDebug() << "Load custom DRC settings:" << drcSettingsPath;
+        const FilePath fp(QFileInfo(drcSettingsPath).absoluteFilePath());
+        const std::unique_ptr<const SExpression> root =
+            SExpression::parse(FileUtils::readFile(fp), fp);
+        customDrcSettings = BoardDesignRuleCheckSettings(*root);  // can throw
+      } catch (const Exception& e) {
+        drcSettingsError = e.getMsg();  // printed later, see below
+      }
+    }
+    foreach (Board* board, boards) {
+      BoardJobs jobs;
+      jobs.board = board;
+      if (rebuildPlanes) {
+        qInfo().nospace().noquote() << "Rebuilding all planes of board '"
+                                    << *board->getName() << "'...";
+      }
+      if (runDrc && drcSettingsError.isEmpty()) {
+        jobs.drc.reset(new BoardDesignRuleCheck());
+        jobs.drc->start(*board,
+                        customDrcSettings ? *customDrcSettings
+                                          : board->getDrcSettings(),
+                        false);
+      } else if (rebuildPlanes) {
+        jobs.planesBuilder.reset(new BoardPlaneFragmentsBuilder());
+        if (!jobs.planesBuilder->start(*board)) {
+          jobs.planesBuilder.reset();  // Nothing to rebuild.
+        }
+      }
+      boardJobs.push_back(std::move(jobs));
+    }
+
+    // Export the PCB fabrication data of a board. Requires up-to-date planes,
+    // thus it is called directly after the DRC of the board has finished,
+    // while the other boards are still being checked. The console output is
+    // printed later to keep the order of the output.
+    auto exportFabricationData = [&](BoardJobs& jobs) {
+      if ((!exportPcbFabricationData) ||
+          (!fabricationSettingsError.isEmpty()) || jobs.fabricationExported) {
+        return;
+      }
+      jobs.fabricationExported = true;
+      try {
+        BoardGerberExport grbExport(*jobs.board);
+        grbExport.exportPcbLayers(
+            customFabricationSettings
+                ? *customFabricationSettings
+                : jobs.board->getFabricationOutputSettings());  // can throw
+        jobs.fabricationFiles = grbExport.getWrittenFiles();
+      } catch (...) {
+        jobs.fabricationError = std::current_exception();
+      }
+    };
+
     // ERC
     if (runErc) {
       print(tr("Run ERC..."));
-      ElectricalRuleCheck erc(*project);
+      ElectricalRuleCheck erc;
       int approvedMsgCount = 0;
-      const RuleCheckMessageList messages = erc.runChecks();
+      const RuleCheckMessageList messages =
+          erc.runChecks(ElectricalRuleCheckData(*project));
       const QStringList nonApproved = prepareRuleCheckMessages(
           messages, project->getErcMessageApprovals(), approvedMsgCount);
       print("  " % tr("Approved messages: %1").arg(approvedMsgCount));
@@ -692,29 +779,18 @@ bool CommandLineInterface::openProject(
     // DRC
     if (runDrc) {
       print(tr("Run DRC..."));
-      std::optional<BoardDesignRuleCheckSettings> customSettings;
-      QList<Board*> boardsToCheck = boards;
-      if (!drcSettingsPath.isEmpty()) {
-        try {
-          qDebug() << "Load custom DRC settings:" << drcSettingsPath;
-          const FilePath fp(QFileInfo(drcSettingsPath).absoluteFilePath());
-          const std::unique_ptr<const SExpression> root =
-              SExpression::parse(FileUtils::readFile(fp), fp);
-          customSettings = BoardDesignRuleCheckSettings(*root);  // can throw
-        } catch (const Exception& e) {
-          printErr(
-              tr("ERROR: Failed to load custom settings: %1").arg(e.getMsg()));
-          success = false;
-          boardsToCheck.clear();  // avoid exporting any boards
-        }
+      if (!drcSettingsError.isEmpty()) {
+        printErr(tr("ERROR: Failed to load custom settings: %1")
+                     .arg(drcSettingsError));
+        success = false;
       }
-      foreach (Board* board, boardsToCheck) {
+      for (BoardJobs& jobs : boardJobs) {
+        if (!jobs.drc) continue;
+        Board* board = jobs.board;
         print("  " % tr("Board '%1':").arg(*board->getName()));
-        BoardDesignRuleCheck drc;
-        drc.start(*board,
-                  customSettings ? *customSettings : board->getDrcSettings(),
-                  false);
-        const BoardDesignRuleCheck::Result result = drc.waitForFinished();
+        const BoardDesignRuleCheck::Result result = jobs.drc->waitForFinished();
+        result.applyPlanesToBoard();
+        jobs.drc.reset();
         for (const QString& msg : result.errors) {
           printErr("FATAL ERROR: " % msg);
           success = false;
@@ -729,6 +805,18 @@ bool CommandLineInterface::openProject(
           printErr("      - " % msg);
           success = false;
         }
+        exportFabricationData(jobs);
+      }
+    }
+
+    // Apply planes of all boards which were not rebuilt by the DRC.
+    for (BoardJobs& jobs : boardJobs) {
+      if (jobs.planesBuilder) {
+        const BoardPlaneFragmentsBuilder::Result result =
+            jobs.planesBuilder->waitForFinished();
+        jobs.planesBuilder.reset();
+        result.throwOnError();  // can throw
+        result.applyToBoard();
       }
     }
 
@@ -892,35 +980,22 @@ bool CommandLineInterface::openProject(
       }
     }
 
-    // Export PCB fabrication data
+    // Export PCB fabrication data (if not already done after the DRC)
     if (exportPcbFabricationData) {
       print(tr("Export PCB fabrication data..."));
-      std::optional<BoardFabricationOutputSettings> customSettings;
-      QList<Board*> boardsToExport = boards;
-      if (!pcbFabricationSettingsPath.isEmpty()) {
-        try {
-          qDebug() << "Load custom fabrication output settings:"
-                   << pcbFabricationSettingsPath;
-          const FilePath fp(
-              QFileInfo(pcbFabricationSettingsPath).absoluteFilePath());
-          const std::unique_ptr<const SExpression> root =
-              SExpression::parse(FileUtils::readFile(fp), fp);
-          customSettings = BoardFabricationOutputSettings(*root);  // can throw
-        } catch (const Exception& e) {
-          printErr(
-              tr("ERROR: Failed to load custom settings: %1").arg(e.getMsg()));
-          success = false;
-          boardsToExport.clear();  // avoid exporting any boards
-        }
+      if (!fabricationSettingsError.isEmpty()) {
+        printErr(tr("ERROR: Failed to load custom settings: %1")
+                     .arg(fabricationSettingsError));
+        success = false;
       }
-      foreach (const Board* board, boardsToExport) {
-        print("  " % tr("Board '%1':").arg(*board->getName()));
-        BoardGerberExport grbExport(*board);
-        grbExport.exportPcbLayers(
-            customSettings
-                ? *customSettings
-                : board->getFabricationOutputSettings());  // can throw
-        foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+      for (BoardJobs& jobs : boardJobs) {
+        if (!fabricationSettingsError.isEmpty()) break;
+        print("  " % tr("Board '%1':").arg(*jobs.board->getName()));
+        exportFabricationData(jobs);
+        if (jobs.fabricationError) {
+          std::rethrow_exception(jobs.fabricationError);
+        }
+        foreach (const FilePath& fp, jobs.fabricationFiles) {
           print(QString("    => '%1'").arg(prettyPath(fp, projectFile)));
           writtenFilesCounter[fp]++;
         }
@@ -24,6 +24,7 @@
 
 #include <librepcb/core/application.h>
 #include <librepcb/core/debug.h>
+#include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
 
 #include <QtCore>
 #include <QtGui>
@@ -64,6 +65,10 @@ int main(int argc, char* argv[]) {
   Application::loadBundledFonts();
   Application::setTranslationLocale(QLocale::system());
 
+  // Persistently cache plane fragments to speed up repeated exports & DRCs.
+  BoardPlaneFragmentsBuilder::setDefaultCacheDirectory(
+      Application::getCacheDir().getPathTo("planes"));
+
   // Run application
   cli::CommandLineInterface cli;
   return cli.execute(app.arguments());
@@ -24,6 +24,7 @@
 #include <librepcb/core/debug.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/network/networkaccessmanager.h>
+#include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 #include <librepcb/editor/dialogs/directorylockhandlerdialog.h>
@@ -312,6 +313,10 @@ static int openWorkspace(FilePath& path) {
     EditorCommandSet::instance().updateTranslations();
   }
 
+  // Persistently cache plane fragments to speed up opening boards & DRCs.
+  BoardPlaneFragmentsBuilder::setDefaultCacheDirectory(
+      Application::getCacheDir().getPathTo("planes"));
+
   // Setup global parts information provider (with cache).
   PartInformationProvider::instance().setCacheDir(Application::getCacheDir());
   auto applyPartInformationProviderSettings = [&ws]() {
@@ -68,6 +68,9 @@
 #include <XCAFDoc_ColorTool.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 #include <XCAFDoc_ShapeTool.hxx>
+
+#include <istream>
+#include <streambuf>
 #endif
 // clang-format on
 
@@ -97,6 +100,36 @@ struct OccModel::Data {
 
 #if USE_OPENCASCADE
 
+/**
+ * @brief Read-only stream buffer operating directly on a QByteArray's memory
+ *
+ * STEP files can be many megabytes, so this avoids copying them into a
+ * std::string just for passing them to OpenCascade as a stream.
+ */
+class ByteArrayStreamBuf final : public std::streambuf {
+public:
+  explicit ByteArrayStreamBuf(const QByteArray& data) noexcept {
+    char* begin = const_cast<char*>(data.constData());
+    setg(begin, begin, begin + data.size());
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+    char* target = (dir == std::ios_base::beg) ? eback()
+        : (dir == std::ios_base::cur)          ? gptr()
+                                               : egptr();
+    target += off;
+    if ((target < eback()) || (target > egptr())) return pos_type(off_type(-1));
+    setg(eback(), target, egptr());
+    return pos_type(target - eback());
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
 static bool tryGetColor(Handle(XCAFDoc_ColorTool) colorTool,
                         const TopoDS_Shape& shape, Quantity_Color& color) {
   return colorTool->GetColor(shape, XCAFDoc_ColorSurf, color) ||
@@ -632,7 +665,7 @@ std::unique_ptr<OccModel> OccModel::createBoard(const librepcb::Path& outline,
   return result;
 }
 
-std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
+std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray& content) {
   std::unique_ptr<OccModel> result;
 #if USE_OPENCASCADE
   try {
@@ -648,7 +681,9 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
 
     STEPControl_Reader& reader = stepReader.ChangeReader();
 #if OCC_VERSION_HEX >= 0x070500
-    std::istringstream is(content.data());
+    // Read directly from the given buffer to avoid copying the whole file.
+    ByteArrayStreamBuf buf(content);
+    std::istream is(&buf);
     const IFSelect_ReturnStatus ret = reader.ReadStream("stream.step", is);
 #else
     FilePath tmp = FilePath::getRandomTempPath();
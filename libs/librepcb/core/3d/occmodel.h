@@ -78,7 +78,7 @@ public:
                                                const QVector<Path>& holes,
                                                const PositiveLength& thickness,
                                                const QColor& color);
-  static std::unique_ptr<OccModel> loadStep(const QByteArray content);
+  static std::unique_ptr<OccModel> loadStep(const QByteArray& content);
   static QByteArray minifyStep(const QByteArray& content);
 
   // Operator Overloadings
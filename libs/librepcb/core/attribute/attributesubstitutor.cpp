@@ -34,7 +34,14 @@ namespace librepcb {
  ******************************************************************************/
 
 QString AttributeSubstitutor::substitute(QString str, LookupFunction lookup,
-                                         FilterFunction filter) noexcept {
+                                         FilterFunction filter,
+                                         Dependencies* dependencies) noexcept {
+  if (dependencies) {
+    dependencies->clear();
+  }
+  if (!containsVariables(str)) {
+    return str;  // Fast path for the most common case of literal texts.
+  }
   int startPos = 0;
   int length = 0;
   int outerVariableStart = -1;
@@ -59,7 +66,7 @@ QString AttributeSubstitutor::substitute(QString str, LookupFunction lookup,
             key.length() - 2;  // do not search for variables in the value
         keyFound = true;
         break;
-      } else if ((getValueOfKey(key, value, lookup)) &&
+      } else if ((getValueOfKey(key, value, lookup, dependencies)) &&
                  (!keyBacktrace.contains(key))) {
         // replace "{{KEY}}" with the value of KEY
         str.replace(startPos, length, value);
@@ -79,6 +86,21 @@ QString AttributeSubstitutor::substitute(QString str, LookupFunction lookup,
   return str;
 }
 
+bool AttributeSubstitutor::containsVariables(const QString& str) noexcept {
+  return str.contains(QLatin1String("{{"));
+}
+
+bool AttributeSubstitutor::dependenciesChanged(const Dependencies& dependencies,
+                                               LookupFunction lookup) noexcept {
+  for (auto it = dependencies.begin(); it != dependencies.end(); ++it) {
+    const QString value = lookup ? lookup(it.key()) : QString();
+    if (value != it.value()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -87,8 +109,10 @@ bool AttributeSubstitutor::searchVariablesInText(const QString& text,
                                                  int startPos, int& pos,
                                                  int& length,
                                                  QStringList& keys) noexcept {
-  QRegularExpression re("\\{\\{(.*?)\\}\\}");
-  QRegularExpressionMatch match = re.match(text, startPos);
+  // Compiled only once since this is called very often. QRegularExpression
+  // is reentrant, so sharing a const instance between threads is safe.
+  static const QRegularExpression re("\\{\\{(.*?)\\}\\}");
+  const QRegularExpressionMatch match = re.match(text, startPos);
   if (match.hasMatch() && match.capturedLength() > 0) {
     pos = match.capturedStart();
     if (QStringView(text).mid(pos).startsWith(QLatin1String("{{ '}}' }}"))) {
@@ -117,9 +141,13 @@ void AttributeSubstitutor::applyFilter(QString& str, int& start, int& end,
 }
 
 bool AttributeSubstitutor::getValueOfKey(const QString& key, QString& value,
-                                         LookupFunction lookup) noexcept {
+                                         LookupFunction lookup,
+                                         Dependencies* dependencies) noexcept {
   if (lookup) {
     value = lookup(key);
+    if (dependencies) {
+      dependencies->insert(key, value);
+    }
     return !value.isEmpty();
   } else {
     return false;
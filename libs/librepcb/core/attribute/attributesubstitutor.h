@@ -44,6 +44,17 @@ namespace librepcb {
  * Please read the documentation about the @ref doc_attributes_system to get an
  * idea how the @ref doc_attributes_system works in detail.
  *
+ * Items which keep a substituted text cached (::librepcb::BI_StrokeText and
+ * ::librepcb::SI_Text) record the dependencies of their substitution and use
+ * #dependenciesChanged() to skip re-substitution on unrelated attribute
+ * changes. One-shot substitutions like BOM cells or output file paths are
+ * evaluated only once per export, so they don't track dependencies.
+ *
+ * @note Texts are not split into precompiled literal and variable chunks
+ * since the endless loop detection spans the whole string and substituted
+ * values are searched for variables again, i.e. the result of a variable
+ * depends on its neighbours. Literal texts are returned without any parsing.
+ *
  * @see ::librepcb::ProjectAttributeLookup
  * @see @ref doc_attributes_system
  *
@@ -58,6 +69,7 @@ class AttributeSubstitutor final {
 public:
   using LookupFunction = std::function<QString(const QString&)>;
   using FilterFunction = std::function<QString(const QString&)>;
+  using Dependencies = QHash<QString, QString>;  ///< Key -> looked up value
 
   // Constructors / Destructor / Operator Overloadings
   AttributeSubstitutor() = delete;
@@ -78,11 +90,43 @@ public:
    *                  be passed to this function first. This allows for example
    *                  to remove invalid characters if the resulting string is
    *                  used for a file path.
+   * @param dependencies  If not `nullptr`, all attribute keys which were
+   *                      looked up during the substitution (including those
+   *                      of nested variables) are stored in this hash, together
+   *                      with their looked up values. See
+   *                      #dependenciesChanged().
    *
    * @return True if str was modified in some way, false if not
    */
   static QString substitute(QString str, LookupFunction lookup = nullptr,
-                            FilterFunction filter = nullptr) noexcept;
+                            FilterFunction filter = nullptr,
+                            Dependencies* dependencies = nullptr) noexcept;
+
+  /**
+   * @brief Check whether a string contains any variables at all
+   *
+   * @param str   The string to check.
+   *
+   * @return False if #substitute() would return the string unmodified for
+   *         any lookup function, true otherwise.
+   */
+  static bool containsVariables(const QString& str) noexcept;
+
+  /**
+   * @brief Check whether any dependency of a previous substitution changed
+   *
+   * The result of #substitute() is fully determined by the input string and
+   * the values of the looked up keys. So if none of the recorded values
+   * changed, the substitution does not need to be repeated. Note that looking
+   * up only the recorded keys is much cheaper than a full substitution.
+   *
+   * @param dependencies  Dependencies recorded by #substitute().
+   * @param lookup        The attribute lookup function (key -> value).
+   *
+   * @return True if at least one key evaluates to a different value now.
+   */
+  static bool dependenciesChanged(const Dependencies& dependencies,
+                                  LookupFunction lookup) noexcept;
 
 private:  // Methods
   /**
@@ -108,7 +152,8 @@ private:  // Methods
                           FilterFunction filter) noexcept;
 
   static bool getValueOfKey(const QString& key, QString& value,
-                            LookupFunction lookup) noexcept;
+                            LookupFunction lookup,
+                            Dependencies* dependencies) noexcept;
 };
 
 /*******************************************************************************
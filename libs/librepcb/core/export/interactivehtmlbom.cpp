@@ -23,6 +23,7 @@
 #include "interactivehtmlbom.h"
 
 #include "../exceptions.h"
+#include "../fileio/filepath.h"
 #include "../utils/toolbox.h"
 #include "../utils/transform.h"
 
@@ -195,49 +196,91 @@ void InteractiveHtmlBom::addDrawing(DrawingKind kind, DrawingLayer layer,
                            width->toMm(), filled);
 }
 
-void InteractiveHtmlBom::addTrack(
-    Layer layer, const Point& start, const Point& end,
-    const PositiveLength& width,
+void InteractiveHtmlBom::addTracks(
+    Layer layer, const QVector<Track>& tracks,
     const std::optional<QString>& netName) noexcept {
   static const QHash<Layer, rs::InteractiveHtmlBomLayer> map = {
       {Layer::Top, rs::InteractiveHtmlBomLayer::Front},
       {Layer::Bottom, rs::InteractiveHtmlBomLayer::Back},
   };
-  rs::ffi_ibom_add_track(*mHandle, map[layer], start.getX().toMm(),
-                         -start.getY().toMm(), end.getX().toMm(),
-                         -end.getY().toMm(), width->toMm(),
-                         netName ? &(*netName) : nullptr);
+
+  if (tracks.isEmpty()) {
+    return;
+  }
+
+  std::vector<rs::InteractiveHtmlBomTrack> tracksVec;
+  tracksVec.reserve(tracks.size());
+  for (const Track& track : tracks) {
+    tracksVec.push_back(rs::InteractiveHtmlBomTrack{
+        static_cast<float>(track.start.getX().toMm()),
+        static_cast<float>(-track.start.getY().toMm()),
+        static_cast<float>(track.end.getX().toMm()),
+        static_cast<float>(-track.end.getY().toMm()),
+        static_cast<float>(track.width->toMm()),
+    });
+  }
+  rs::ffi_ibom_add_tracks(*mHandle, map[layer], tracksVec.data(),
+                          tracksVec.size(), netName ? &(*netName) : nullptr);
 }
 
-void InteractiveHtmlBom::addVia(
-    QSet<Layer> layers, const Point& pos, const PositiveLength& diameter,
-    const PositiveLength& drillDiameter,
-    const std::optional<QString>& netName) noexcept {
-  static const QHash<Layer, rs::InteractiveHtmlBomLayer> map = {
-      {Layer::Top, rs::InteractiveHtmlBomLayer::Front},
-      {Layer::Bottom, rs::InteractiveHtmlBomLayer::Back},
-  };
+void InteractiveHtmlBom::addVias(
+    const QVector<Via>& vias, const std::optional<QString>& netName) noexcept {
+  if (vias.isEmpty()) {
+    return;
+  }
 
-  std::vector<rs::InteractiveHtmlBomLayer> layersVec;
-  for (auto layer : layers) {
-    layersVec.push_back(map[layer]);
+  std::vector<rs::InteractiveHtmlBomVia> viasVec;
+  viasVec.reserve(vias.size());
+  for (const Via& via : vias) {
+    viasVec.push_back(rs::InteractiveHtmlBomVia{
+        via.onTop,
+        via.onBottom,
+        static_cast<float>(via.position.getX().toMm()),
+        static_cast<float>(-via.position.getY().toMm()),
+        static_cast<float>(via.diameter->toMm()),
+        static_cast<float>(via.drillDiameter->toMm()),
+    });
   }
-  const float drill = drillDiameter->toMm();
-  rs::ffi_ibom_add_via(*mHandle, layersVec.data(), layersVec.size(),
-                       pos.getX().toMm(), -pos.getY().toMm(), diameter->toMm(),
-                       drill, netName ? &(*netName) : nullptr);
+  rs::ffi_ibom_add_vias(*mHandle, viasVec.data(), viasVec.size(),
+                        netName ? &(*netName) : nullptr);
 }
 
-void InteractiveHtmlBom::addPlaneFragment(
-    Layer layer, const Path& outline,
+void InteractiveHtmlBom::addPlaneFragments(
+    Layer layer, const QVector<Path>& outlines,
     const std::optional<QString>& netName) noexcept {
   static const QHash<Layer, rs::InteractiveHtmlBomLayer> map = {
       {Layer::Top, rs::InteractiveHtmlBomLayer::Front},
       {Layer::Bottom, rs::InteractiveHtmlBomLayer::Back},
   };
-  const QString svg = outline.toClosedPath().toSvgPathMm();
-  rs::ffi_ibom_add_zone(*mHandle, map[layer], &svg,
-                        netName ? &(*netName) : nullptr);
+
+  // Pass the raw vertices of all fragments at once, the SVG paths are built
+  // on the Rust side. Outlines with arcs are not expected here, but if there
+  // are any, they are passed as SVG path since arcs need special handling.
+  std::vector<rs::InteractiveHtmlBomPoint> points;
+  std::vector<std::size_t> sizes;
+  sizes.reserve(outlines.size());
+  for (const Path& outline : outlines) {
+    const Path closedOutline = outline.toClosedPath();
+    if (closedOutline.isCurved()) {
+      const QString svg = closedOutline.toSvgPathMm();
+      rs::ffi_ibom_add_zone(*mHandle, map[layer], &svg,
+                            netName ? &(*netName) : nullptr);
+      continue;
+    }
+    for (const Vertex& vertex : closedOutline.getVertices()) {
+      points.push_back(rs::InteractiveHtmlBomPoint{
+          vertex.getPos().getX().toNm(),
+          -vertex.getPos().getY().toNm(),
+      });
+    }
+    sizes.push_back(closedOutline.getVertices().count());
+  }
+  if (sizes.empty()) {
+    return;
+  }
+  rs::ffi_ibom_add_zones(*mHandle, map[layer], points.data(), points.size(),
+                         sizes.data(), sizes.size(),
+                         netName ? &(*netName) : nullptr);
 }
 
 std::size_t InteractiveHtmlBom::addFootprint(
@@ -346,6 +389,17 @@ QString InteractiveHtmlBom::generateHtml() const {
   return out;
 }
 
+void InteractiveHtmlBom::writeHtml(const FilePath& fp) const {
+  const QString path = fp.toStr();
+  QString err;
+  if (!rs::ffi_ibom_write_html(*mHandle, &path, &err)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString("Failed to write interactive HTML BOM to "
+                               "\"%1\": %2")
+                           .arg(fp.toNative(), err));
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -77,6 +77,18 @@ public:
     std::optional<QString> netName;
     bool pin1;
   };
+  struct Track {
+    Point start;
+    Point end;
+    PositiveLength width;
+  };
+  struct Via {
+    bool onTop;
+    bool onBottom;
+    Point position;
+    PositiveLength diameter;
+    PositiveLength drillDiameter;
+  };
 
   InteractiveHtmlBom() = delete;
   InteractiveHtmlBom(const InteractiveHtmlBom& other) = delete;
@@ -162,41 +174,33 @@ public:
                   const UnsignedLength& width, bool filled) noexcept;
 
   /**
-   * @brief Add a track
+   * @brief Add tracks
    *
-   * @param layer   Layer
-   * @param start   Start position
-   * @param end     End position
-   * @param width   Width
-   * @param netName Net name (if any)
+   * @param layer   Layer of all tracks
+   * @param tracks  Tracks to add
+   * @param netName Net name of all tracks (if any)
    */
-  void addTrack(Layer layer, const Point& start, const Point& end,
-                const PositiveLength& width,
-                const std::optional<QString>& netName) noexcept;
+  void addTracks(Layer layer, const QVector<Track>& tracks,
+                 const std::optional<QString>& netName) noexcept;
 
   /**
-   * @brief Add via
+   * @brief Add vias
    *
-   * @param layers        Layers this via exists on
-   * @param pos           Position
-   * @param diameter      Outer diameter
-   * @param drillDiameter Drill diameter
-   * @param netName       net name (if any)
+   * @param vias    Vias to add
+   * @param netName Net name of all vias (if any)
    */
-  void addVia(QSet<Layer> layers, const Point& pos,
-              const PositiveLength& diameter,
-              const PositiveLength& drillDiameter,
-              const std::optional<QString>& netName) noexcept;
+  void addVias(const QVector<Via>& vias,
+               const std::optional<QString>& netName) noexcept;
 
   /**
-   * @brief Add plane fragment
+   * @brief Add plane fragments
    *
-   * @param layer         Layer
-   * @param outline       Outline
-   * @param netName       Net name (if any)
+   * @param layer     Layer of all fragments
+   * @param outlines  Outlines of the fragments
+   * @param netName   Net name of all fragments (if any)
    */
-  void addPlaneFragment(Layer layer, const Path& outline,
-                        const std::optional<QString>& netName) noexcept;
+  void addPlaneFragments(Layer layer, const QVector<Path>& outlines,
+                         const std::optional<QString>& netName) noexcept;
 
   /**
    * @brief Add footprint
@@ -234,6 +238,18 @@ public:
    */
   QString generateHtml() const;
 
+  /**
+   * @brief Generate the HTML and write it to a file
+   *
+   * Same as #generateHtml(), but avoids the conversion of the (possibly
+   * huge) HTML content to a QString.
+   *
+   * @param fp  Output file path
+   *
+   * @throws If some of the data is invalid or the file could not be written
+   */
+  void writeHtml(const FilePath& fp) const;
+
 private:
   RustHandle<rs::InteractiveHtmlBom> mHandle;
 };
@@ -45,6 +45,11 @@ struct ZipWriter;
 /**
  * @brief Zip file writer
  *
+ * Files are compressed in parallel in background threads, but written to the
+ * archive in the order they were added, thus the output is the same as if
+ * they were compressed serially. Tiny files and files which can't be
+ * compressed (e.g. images or nested archives) are stored uncompressed.
+ *
  * @note This is just a wrapper around its Rust implementation.
  */
 class ZipWriter final {
@@ -79,6 +84,9 @@ public:
    * @param path  Path within archive
    * @param data  File content
    * @param mode  Unix permissions (e.g. 0644).
+   *
+   * @throws On I/O errors. Since files are compressed asynchronously, errors
+   *         might also be caused by previously written files.
    */
   void writeFile(const QString& path, const QByteArray& data, uint32_t mode);
 
@@ -47,7 +47,9 @@ namespace fb = fontobene;
 
 StrokeFont::StrokeFont(const FilePath& fontFilePath,
                        const QByteArray& content) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
+  : QObject(nullptr),
+    mFilePath(fontFilePath),
+    mGlyphCache(sMaxCachedGlyphs) {
   // load the font in another thread because it takes some time to load it
   qDebug() << "Start loading stroke font " << mFilePath.toNative()
            << "in worker thread...";
@@ -161,22 +163,19 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
   Length offset = 0;
   width = 0;  // same as offset, but without last letter spacing
   for (int i = 0; i < text.length(); ++i) {
-    Length glyphSpacing;
-    QVector<Path> glyphPaths = strokeGlyph(text.at(i), height, glyphSpacing);
-    if (!glyphPaths.isEmpty()) {
-      Point bottomLeft, topRight;
-      computeBoundingRect(glyphPaths, bottomLeft, topRight);
-      Length shift =
-          (i == 0) ? -bottomLeft.getX() : 0;  // left-align first character
-      foreach (const Path& p, glyphPaths) {
+    const Glyph glyph = getGlyph(text.at(i), height);
+    if (!glyph.paths.isEmpty()) {
+      Length shift = (i == 0) ? -glyph.bottomLeft.getX()
+                              : 0;  // left-align first character
+      foreach (const Path& p, glyph.paths) {
         paths.append(p.translated(Point(offset + shift, Length(0))));
       }
-      width = offset + topRight.getX() +
+      width = offset + glyph.topRight.getX() +
           shift;  // do *not* count glyph spacing as width!
-      offset = width + glyphSpacing + letterSpacing;
-    } else if (glyphSpacing != 0) {
+      offset = width + glyph.spacing + letterSpacing;
+    } else if (glyph.spacing != 0) {
       // it's a whitespace-only glyph -> count additional glyph spacing as width
-      width = offset + glyphSpacing;
+      width = offset + glyph.spacing;
       offset = width + letterSpacing;
     }
   }
@@ -186,18 +185,9 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
 QVector<Path> StrokeFont::strokeGlyph(const QChar& glyph,
                                       const PositiveLength& height,
                                       Length& spacing) const noexcept {
-  try {
-    qreal glyphSpacing = 0;
-    QVector<fb::Polyline> polylines =
-        accessor().getAllPolylinesOfGlyph(glyph.unicode(),
-                                          &glyphSpacing);  // can throw
-    spacing = convertLength(height, glyphSpacing);
-    return polylines2paths(polylines, height);
-  } catch (const fb::Exception& e) {
-    qWarning().nospace() << "Failed to load stroke font glyph " << glyph << ".";
-    spacing = 0;
-    return QVector<Path>();
-  }
+  const Glyph g = getGlyph(glyph, height);
+  spacing = g.spacing;
+  return g.paths;
 }
 
 /*******************************************************************************
@@ -208,6 +198,43 @@ void StrokeFont::fontLoaded() noexcept {
   accessor();  // trigger the message about loading succeeded or failed
 }
 
+StrokeFont::Glyph StrokeFont::getGlyph(const QChar& glyph,
+                                       const PositiveLength& height) const
+    noexcept {
+  const GlyphKey key(glyph.unicode(), height->toNm());
+  QMutexLocker lock(&mGlyphCacheMutex);
+  if (const Glyph* cached = mGlyphCache.object(key)) {
+    return *cached;
+  }
+
+  // Not cached yet, so convert it now. Note that the fontobene accessor is
+  // not thread-safe, thus the lock is held during conversion too.
+  const Glyph g = loadGlyph(glyph, height);
+  mGlyphCache.insert(key, new Glyph(g));  // takes ownership
+  return g;
+}
+
+StrokeFont::Glyph StrokeFont::loadGlyph(const QChar& glyph,
+                                        const PositiveLength& height) const
+    noexcept {
+  Glyph g;
+  try {
+    qreal glyphSpacing = 0;
+    QVector<fb::Polyline> polylines =
+        accessor().getAllPolylinesOfGlyph(glyph.unicode(),
+                                          &glyphSpacing);  // can throw
+    g.spacing = convertLength(height, glyphSpacing);
+    g.paths = polylines2paths(polylines, height);
+    if (!g.paths.isEmpty()) {
+      computeBoundingRect(g.paths, g.bottomLeft, g.topRight);
+    }
+  } catch (const fb::Exception& e) {
+    qWarning().nospace() << "Failed to load stroke font glyph " << glyph << ".";
+    g = Glyph();
+  }
+  return g;
+}
+
 const fb::GlyphListAccessor& StrokeFont::accessor() const noexcept {
   if (!mFont) {
     try {
@@ -83,8 +83,21 @@ public:
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
+private:  // Types
+  struct Glyph {
+    QVector<Path> paths;
+    Length spacing;
+    Point bottomLeft;
+    Point topRight;
+  };
+  typedef QPair<ushort, LengthBase_t> GlyphKey;  ///< Unicode & height [nm]
+
 private:
   void fontLoaded() noexcept;
+  Glyph getGlyph(const QChar& glyph, const PositiveLength& height) const
+      noexcept;
+  Glyph loadGlyph(const QChar& glyph, const PositiveLength& height) const
+      noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
   static QVector<Path> polylines2paths(
       const QVector<fontobene::Polyline>& polylines,
@@ -105,6 +118,16 @@ private:  // Data
   mutable std::shared_ptr<fontobene::Font> mFont;
   mutable QScopedPointer<fontobene::GlyphListCache> mGlyphListCache;
   mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+
+  /// Cache of already converted glyphs since converting the fontobene
+  /// polylines is quite expensive and the same glyphs are stroked over and
+  /// over again (mostly with only very few different heights). The number
+  /// of cached glyphs is limited to #sMaxCachedGlyphs, the least recently
+  /// used ones get evicted. Accessed from multiple threads, thus protected by
+  /// #mGlyphCacheMutex.
+  static constexpr int sMaxCachedGlyphs = 10000;
+  mutable QMutex mGlyphCacheMutex;
+  mutable QCache<GlyphKey, Glyph> mGlyphCache;
 };
 
 /*******************************************************************************
@@ -39,7 +39,9 @@ namespace librepcb {
  ******************************************************************************/
 
 Path::Path(const Path& other) noexcept
-  : mVertices(other.mVertices), mPainterPathPx(other.mPainterPathPx) {
+  : mVertices(other.mVertices), mPainterPathPx() {
+  // Note: The painter path cache is intentionally not copied to avoid keeping
+  // it alive in copies which are never rendered.
 }
 
 Path::Path(const SExpression& node) {
@@ -177,30 +179,7 @@ QVector<Path> Path::toOutlineStrokes(
 
 const QPainterPath& Path::toQPainterPathPx() const noexcept {
   if (mPainterPathPx.isEmpty()) {
-    for (int i = 0; i < mVertices.count(); ++i) {
-      const Vertex& v = mVertices.at(i);
-      if (i == 0) {
-        mPainterPathPx.moveTo(v.getPos().toPxQPointF());
-        continue;
-      }
-      const Vertex& v0 = mVertices.at(i - 1);
-      if (auto center =
-              Toolbox::arcCenter(v0.getPos(), v.getPos(), v0.getAngle())) {
-        // Arc segment.
-        const QPointF centerPx = center->toPxQPointF();
-        const QPointF diffPx = v0.getPos().toPxQPointF() - centerPx;
-        const qreal radiusPx =
-            std::sqrt(diffPx.x() * diffPx.x() + diffPx.y() * diffPx.y());
-        const qreal startAngleDeg =
-            -qRadiansToDegrees(std::atan2(diffPx.y(), diffPx.x()));
-        mPainterPathPx.arcTo(centerPx.x() - radiusPx, centerPx.y() - radiusPx,
-                             radiusPx * 2, radiusPx * 2, startAngleDeg,
-                             v0.getAngle().toDeg());
-      } else {
-        // Straight segment.
-        mPainterPathPx.lineTo(v.getPos().toPxQPointF());
-      }
-    }
+    mPainterPathPx = buildPainterPathPx();
   }
   return mPainterPathPx;
 }
@@ -403,7 +382,7 @@ void Path::serialize(SExpression& root) const {
 
 Path& Path::operator=(const Path& rhs) noexcept {
   mVertices = rhs.mVertices;
-  mPainterPathPx = rhs.mPainterPathPx;
+  invalidatePainterPath();  // See copy constructor.
   return *this;
 }
 
@@ -694,10 +673,45 @@ QPainterPath Path::toQPainterPathPx(const QVector<Path>& paths,
   QPainterPath p;
   p.setFillRule(Qt::WindingFill);
   foreach (const Path& path, paths) {
+    const QPainterPath pathPx = path.mPainterPathPx.isEmpty()
+        ? path.buildPainterPathPx()
+        : path.mPainterPathPx;
     if (area) {
-      p |= path.toQPainterPathPx();
+      p |= pathPx;
+    } else {
+      p.addPath(pathPx);
+    }
+  }
+  return p;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QPainterPath Path::buildPainterPathPx() const noexcept {
+  QPainterPath p;
+  for (int i = 0; i < mVertices.count(); ++i) {
+    const Vertex& v = mVertices.at(i);
+    if (i == 0) {
+      p.moveTo(v.getPos().toPxQPointF());
+      continue;
+    }
+    const Vertex& v0 = mVertices.at(i - 1);
+    if (auto center =
+            Toolbox::arcCenter(v0.getPos(), v.getPos(), v0.getAngle())) {
+      // Arc segment.
+      const QPointF centerPx = center->toPxQPointF();
+      const QPointF diffPx = v0.getPos().toPxQPointF() - centerPx;
+      const qreal radiusPx =
+          std::sqrt(diffPx.x() * diffPx.x() + diffPx.y() * diffPx.y());
+      const qreal startAngleDeg =
+          -qRadiansToDegrees(std::atan2(diffPx.y(), diffPx.x()));
+      p.arcTo(centerPx.x() - radiusPx, centerPx.y() - radiusPx, radiusPx * 2,
+              radiusPx * 2, startAngleDeg, v0.getAngle().toDeg());
     } else {
-      p.addPath(path.toQPainterPathPx());
+      // Straight segment.
+      p.lineTo(v.getPos().toPxQPointF());
     }
   }
   return p;
@@ -61,6 +61,7 @@ public:
   // Constructors / Destructor
   Path() noexcept : mVertices(), mPainterPathPx() {}
   Path(const Path& other) noexcept;
+  Path(Path&& other) noexcept = default;
   explicit Path(const QVector<Vertex>& vertices) noexcept
     : mVertices(vertices) {}
   explicit Path(const SExpression& node);
@@ -83,7 +84,19 @@ public:
   Path toClosedPath() const noexcept;
   Path toOpenPath() const noexcept;
   QVector<Path> toOutlineStrokes(const PositiveLength& width) const noexcept;
+
+  /**
+   * @brief Convert the path to a QPainterPath
+   *
+   * The QPainterPath is built on the first call and cached, so subsequent
+   * calls are cheap. The cache is not copied to other ::librepcb::Path
+   * objects and is released when the path is modified, so only paths which
+   * are actually rendered keep a QPainterPath in memory.
+   *
+   * @return The QPainterPath in pixels
+   */
   const QPainterPath& toQPainterPathPx() const noexcept;
+
   QString toSvgPathMm() const noexcept;
 
   // Transformations
@@ -122,6 +135,7 @@ public:
 
   // Operator Overloadings
   Path& operator=(const Path& rhs) noexcept;
+  Path& operator=(Path&& rhs) noexcept = default;
   bool operator==(const Path& rhs) const noexcept {
     return mVertices == rhs.mVertices;
   }
@@ -173,6 +187,9 @@ public:
    * @brief Convert multiple ::librepcb::Path objects to a QPainterPath
    *
    * The paths are united, so you get the union of all the passed paths.
+   * In contrast to #toQPainterPathPx() const, this does not populate the
+   * QPainterPath caches of the passed paths since the resulting painter path
+   * is typically stored by the caller anyway.
    *
    * @param paths   The paths to convert.
    * @param area    Whether the passed paths should be interpreted as areas
@@ -183,6 +200,7 @@ public:
                                        bool area) noexcept;
 
 private:  // Methods
+  QPainterPath buildPainterPathPx() const noexcept;
   void invalidatePainterPath() const noexcept {
     mPainterPathPx = QPainterPath();
   }
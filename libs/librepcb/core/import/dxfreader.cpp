@@ -27,11 +27,89 @@
 #include <dl_creationadapter.h>
 #include <dl_dxf.h>
 
+#include <fstream>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class DxfPathJoiner
+ ******************************************************************************/
+
+/**
+ * @brief Private helper class to join open paths while reading a DXF file
+ *
+ * Only the currently open paths are kept in memory, indexed by their end
+ * points. Every path which gets closed is passed to the output function
+ * immediately.
+ */
+class DxfPathJoiner {
+public:
+  explicit DxfPathJoiner(std::function<void(const Path&)> output)
+    : mOutput(output), mNextId(0) {}
+
+  void add(Path path) {
+    while (!path.isClosed()) {
+      const Point start = path.getVertices().first().getPos();
+      const Point end = path.getVertices().last().getPos();
+      if (std::optional<Path> next = takePathAt(end)) {
+        if (next->getVertices().first().getPos() != end) {
+          next = next->reversed();
+        }
+        QVector<Vertex> vertices = path.getVertices();
+        vertices.removeLast();
+        vertices.append(next->getVertices());
+        path = Path(vertices);
+      } else if (std::optional<Path> prev = takePathAt(start)) {
+        if (prev->getVertices().last().getPos() != start) {
+          prev = prev->reversed();
+        }
+        QVector<Vertex> vertices = prev->getVertices();
+        vertices.removeLast();
+        vertices.append(path.getVertices());
+        path = Path(vertices);
+      } else {
+        // Nothing to join, keep it until the end of the file.
+        const int id = mNextId++;
+        mPaths.insert(id, path);
+        mPathEnds.insert(start, id);
+        mPathEnds.insert(end, id);
+        return;
+      }
+    }
+    mOutput(path);
+  }
+
+  void finish() {
+    // Emit remaining open paths in the order they were created to get a
+    // deterministic result.
+    for (const Path& path : mPaths) {
+      mOutput(path);
+    }
+    mPaths.clear();
+    mPathEnds.clear();
+  }
+
+private:
+  std::optional<Path> takePathAt(const Point& pos) {
+    auto it = mPathEnds.find(pos);
+    if (it == mPathEnds.end()) {
+      return std::nullopt;
+    }
+    const Path path = mPaths.take(it.value());
+    mPathEnds.remove(path.getVertices().first().getPos());
+    mPathEnds.remove(path.getVertices().last().getPos());
+    return path;
+  }
+
+  std::function<void(const Path&)> mOutput;
+  int mNextId;
+  QMap<int, Path> mPaths;  ///< Open paths, ordered by creation
+  QHash<Point, int> mPathEnds;  ///< End points of open paths
+};
+
 /*******************************************************************************
  *  Class DxfReaderImpl
  ******************************************************************************/
@@ -48,25 +126,49 @@ namespace librepcb {
  */
 class DxfReaderImpl : public DL_CreationAdapter {
 public:
-  DxfReaderImpl(DxfReader& reader)
+  DxfReaderImpl(const DxfReader& reader, const DxfReader::Callbacks& callbacks,
+                std::istream& stream, qint64 streamSize)
     : mReader(reader),
+      mCallbacks(callbacks),
+      mStream(stream),
+      mStreamSize(streamSize),
+      mEntityCounter(0),
+      mLastProgress(-1),
       mScaleToMm(1),
+      mPolylineAccepted(false),
       mPolylineClosed(false),
       mPolylineVertices(0),
-      mPolylinePath() {}
+      mPolylinePath(),
+      mJoiner() {
+    if (mReader.mJoinPaths && mCallbacks.polygon) {
+      mJoiner.reset(new DxfPathJoiner(mCallbacks.polygon));
+    }
+  }
 
   virtual ~DxfReaderImpl() {}
 
+  void finish() {
+    if (mJoiner) {
+      mJoiner->finish();
+    }
+    reportProgress(100);
+  }
+
   virtual void addPoint(const DL_PointData& data) override {
-    mReader.mPoints.append(point(data.x, data.y));
+    entityRead();
+    const Point pos = point(data.x, data.y);
+    if (mCallbacks.point && isLayerAccepted() && isAreaAccepted(pos, pos)) {
+      mCallbacks.point(pos);
+    }
   }
 
   virtual void addLine(const DL_LineData& data) override {
-    mReader.mPolygons.append(
-        Path::line(point(data.x1, data.y1), point(data.x2, data.y2)));
+    entityRead();
+    addPolygon(Path::line(point(data.x1, data.y1), point(data.x2, data.y2)));
   }
 
   virtual void addArc(const DL_ArcData& data) override {
+    entityRead();
     Point center = point(data.cx, data.cy);
     Length radius = length(data.radius);
     Angle angle1 = angle(data.angle1);
@@ -78,14 +180,19 @@ public:
     if (angle < 0) {
       angle.invert();
     }
-    mReader.mPolygons.append(Path::line(p1, p2, angle));
+    addPolygon(Path::line(p1, p2, angle));
   }
 
   virtual void addCircle(const DL_CircleData& data) override {
+    entityRead();
     Length diameter = length(data.radius * 2);
     if (diameter > 0) {
-      mReader.mCircles.append(
-          DxfReader::Circle{point(data.cx, data.cy), PositiveLength(diameter)});
+      const Point center = point(data.cx, data.cy);
+      const Point radius(diameter / 2, diameter / 2);
+      if (mCallbacks.circle && isLayerAccepted() &&
+          isAreaAccepted(center - radius, center + radius)) {
+        mCallbacks.circle(DxfReader::Circle{center, PositiveLength(diameter)});
+      }
     } else {
       qWarning() << "Circle in DXF file ignored due to invalid radius:"
                  << data.radius;
@@ -94,10 +201,13 @@ public:
 
   virtual void addEllipse(const DL_EllipseData& data) override {
     Q_UNUSED(data);
+    entityRead();
     qWarning() << "Ellipse in DXF file ignored since it is not supported yet.";
   }
 
   virtual void addPolyline(const DL_PolylineData& data) override {
+    entityRead();
+    mPolylineAccepted = isLayerAccepted();
     mPolylineClosed = (data.flags & DL_CLOSED_PLINE) != 0;
     mPolylineVertices = data.number;
     mPolylinePath = Path();
@@ -111,13 +221,14 @@ public:
   }
 
   virtual void endSequence() override {
-    if (mPolylinePath.getVertices().count() >= 2) {
+    if (mPolylineAccepted && (mPolylinePath.getVertices().count() >= 2)) {
       if (mPolylineClosed && (mPolylinePath.getVertices().count() >= 3)) {
         mPolylinePath.close();
       }
-      mReader.mPolygons.append(mPolylinePath);
+      emitPolygon(mPolylinePath);
     }
     mPolylinePath = Path();
+    mPolylineAccepted = false;
   }
 
   virtual void setVariableInt(const std::string& key, int value,
@@ -144,6 +255,67 @@ public:
   }
 
 private:  // Methods
+  void addPolygon(const Path& path) {
+    if (isLayerAccepted()) {
+      emitPolygon(path);
+    }
+  }
+  void emitPolygon(const Path& path) {
+    if (!mCallbacks.polygon) {
+      return;
+    }
+    if (mReader.mBoundingBoxFilter) {
+      Point min = path.getVertices().first().getPos();
+      Point max = min;
+      for (const Vertex& v : path.getVertices()) {
+        min.setX(std::min(min.getX(), v.getPos().getX()));
+        min.setY(std::min(min.getY(), v.getPos().getY()));
+        max.setX(std::max(max.getX(), v.getPos().getX()));
+        max.setY(std::max(max.getY(), v.getPos().getY()));
+      }
+      if (!isAreaAccepted(min, max)) {
+        return;
+      }
+    }
+    if (mJoiner) {
+      mJoiner->add(path);
+    } else {
+      mCallbacks.polygon(path);
+    }
+  }
+  bool isLayerAccepted() {
+    return mReader.mLayerFilter.isEmpty() ||
+        mReader.mLayerFilter.contains(
+            QString::fromStdString(getAttributes().getLayer()));
+  }
+  bool isAreaAccepted(const Point& min, const Point& max) const {
+    if (const auto& rect = mReader.mBoundingBoxFilter) {
+      const Length left = std::min(rect->first.getX(), rect->second.getX());
+      const Length right = std::max(rect->first.getX(), rect->second.getX());
+      const Length bottom = std::min(rect->first.getY(), rect->second.getY());
+      const Length top = std::max(rect->first.getY(), rect->second.getY());
+      return (max.getX() >= left) && (min.getX() <= right) &&
+          (max.getY() >= bottom) && (min.getY() <= top);
+    }
+    return true;
+  }
+  void entityRead() {
+    // Determining the stream position is not free, thus do it only from time
+    // to time.
+    if (mCallbacks.progress && (mStreamSize > 0) &&
+        ((++mEntityCounter % 1000) == 0)) {
+      const qint64 pos = mStream.tellg();
+      if (pos >= 0) {
+        reportProgress(static_cast<int>((pos * 99) / mStreamSize));
+      }
+    }
+  }
+  void reportProgress(int percent) {
+    if (mCallbacks.progress && (percent != mLastProgress)) {
+      mLastProgress = percent;
+      mCallbacks.progress(percent);
+    }
+  }
   Angle angle(double angle) const { return Angle::fromDeg(angle); }
   Angle bulgeToAngle(double bulge) const {
     // Round to 0.001° to avoid odd numbers like 179.999999°.
@@ -158,20 +330,33 @@ private:  // Methods
   }
 
 private:  // Data
-  DxfReader& mReader;
+  const DxfReader& mReader;
+  const DxfReader::Callbacks& mCallbacks;
+  std::istream& mStream;
+  qint64 mStreamSize;
+  qint64 mEntityCounter;
+  int mLastProgress;
   qreal mScaleToMm;
 
   // Current polygon state
+  bool mPolylineAccepted;
   bool mPolylineClosed;
   int mPolylineVertices;
   Path mPolylinePath;
+
+  // Joiner, only if enabled
+  std::unique_ptr<DxfPathJoiner> mJoiner;
 };
 
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
-DxfReader::DxfReader() noexcept : mScaleFactor(1) {
+DxfReader::DxfReader() noexcept
+  : mScaleFactor(1),
+    mLayerFilter(),
+    mBoundingBoxFilter(),
+    mJoinPaths(false) {
 }
 
 DxfReader::~DxfReader() noexcept {
@@ -182,13 +367,32 @@ DxfReader::~DxfReader() noexcept {
  ******************************************************************************/
 
 void DxfReader::parse(const FilePath& dxfFile) {
+  Callbacks callbacks;
+  callbacks.point = [this](const Point& p) { mPoints.append(p); };
+  callbacks.circle = [this](const Circle& c) { mCircles.append(c); };
+  callbacks.polygon = [this](const Path& p) { mPolygons.append(p); };
+  parse(dxfFile, callbacks);  // can throw
+}
+
+void DxfReader::parse(const FilePath& dxfFile, const Callbacks& callbacks) {
   try {
+    std::ifstream stream(dxfFile.toNative().toStdString(),
+                         std::ios::in | std::ios::binary);
+    if (!stream.is_open()) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("File does not exist or is not readable."));
+    }
+    stream.seekg(0, std::ios::end);
+    const qint64 size = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+
     DL_Dxf dxf;
-    DxfReaderImpl helper(*this);
-    if (!dxf.in(dxfFile.toNative().toStdString(), &helper)) {
+    DxfReaderImpl helper(*this, callbacks, stream, size);
+    if (!dxf.in(stream, &helper)) {
       throw RuntimeError(__FILE__, __LINE__,
                          tr("File does not exist or is not readable."));
     }
+    helper.finish();
   } catch (const std::exception& e) {
     // Since a third party library was used, catch std::exception and convert
     // it to our own exception type.
@@ -27,6 +27,9 @@
 
 #include <QtCore>
 
+#include <functional>
+#include <optional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -56,6 +59,13 @@ class FilePath;
  * Note that this class tries to read and apply the length unit defined in the
  * DXF file. However, a DXF file is not required to specify the unit. If it is
  * missing, the unit millimeters is assumed.
+ *
+ * For very large files, a streaming mode is available (see
+ * #parse(const FilePath&, const Callbacks&)) which passes every entity to
+ * a callback as soon as it has been read, instead of collecting all entities
+ * in memory. Optionally, entities can be filtered by layer and bounding box,
+ * and open lines, arcs and polylines can be joined on the fly at their
+ * (exactly) matching end points.
  */
 class DxfReader {
   Q_DECLARE_TR_FUNCTIONS(DxfReader)
@@ -66,6 +76,18 @@ public:
     PositiveLength diameter;
   };
 
+  /**
+   * @brief Callbacks for the streaming mode
+   *
+   * Any callback may be `nullptr` to ignore the corresponding objects.
+   */
+  struct Callbacks {
+    std::function<void(const Point&)> point;
+    std::function<void(const Circle&)> circle;
+    std::function<void(const Path&)> polygon;
+    std::function<void(int percent)> progress;  ///< Called with 0..100
+  };
+
   // Constructors / Destructor
 
   /**
@@ -93,6 +115,41 @@ public:
     mScaleFactor = scaleFactor;
   }
 
+  /**
+   * @brief Only import objects on specific layers
+   *
+   * @param layers  Names of the DXF layers to import. If empty (the default),
+   *                objects on any layer are imported.
+   */
+  void setLayerFilter(const QSet<QString>& layers) noexcept {
+    mLayerFilter = layers;
+  }
+
+  /**
+   * @brief Only import objects within a specific area
+   *
+   * @param rect  If set, objects whose bounding box (with scale factor
+   *              applied) does not intersect with this rectangle are skipped.
+   *              Note that for arcs, only the end points are considered.
+   */
+  void setBoundingBoxFilter(
+      const std::optional<std::pair<Point, Point>>& rect) noexcept {
+    mBoundingBoxFilter = rect;
+  }
+
+  /**
+   * @brief Join open lines, arcs and polylines on the fly
+   *
+   * If enabled, open paths are joined with other open paths at exactly
+   * matching end points while reading the file. Closed paths are emitted
+   * immediately, all other paths at the end of the file. In contrast to
+   * ::librepcb::TangentPathJoiner, paths are simply joined in the order they
+   * appear in the file, without searching for the optimal solution.
+   *
+   * @param join  Whether to join paths or not (default: false).
+   */
+  void setJoinPaths(bool join) noexcept { mJoinPaths = join; }
+
   // Getters
 
   /**
@@ -127,11 +184,30 @@ public:
    */
   void parse(const FilePath& dxfFile);
 
+  /**
+   * @brief Parse a DXF file in streaming mode
+   *
+   * In contrast to #parse(const FilePath&), the imported objects are not
+   * stored in this object, but passed to the given callbacks while reading
+   * the file. Thus #getPoints(), #getCircles() and #getPolygons() are not
+   * modified. Memory usage is bounded by the number of open paths pending
+   * to be joined (see #setJoinPaths()).
+   *
+   * @param dxfFile     File path to the DXF to import.
+   * @param callbacks   Callbacks to be called for each object.
+   *
+   * @throw Exception if anything went wrong (e.g. file does not exist).
+   */
+  void parse(const FilePath& dxfFile, const Callbacks& callbacks);
+
   // Operator Overloadings
   DxfReader& operator=(const DxfReader& rhs) = delete;
 
 private:
   qreal mScaleFactor;
+  QSet<QString> mLayerFilter;
+  std::optional<std::pair<Point, Point>> mBoundingBoxFilter;
+  bool mJoinPaths;
 
   QList<Point> mPoints;
   QList<Circle> mCircles;
@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "libraryelementwriter.h"
+
+#include "../exceptions.h"
+#include "../fileio/transactionaldirectory.h"
+#include "../fileio/transactionalfilesystem.h"
+#include "librarybaseelement.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LibraryElementWriter::LibraryElementWriter(const FilePath& libDir,
+                                           int maxPending) noexcept
+  : mLibDir(libDir),
+    mPool(),
+    mFreeSlots((maxPending > 0) ? maxPending
+                                : (2 * QThread::idealThreadCount())),
+    mWrittenCount(0) {
+}
+
+LibraryElementWriter::~LibraryElementWriter() noexcept {
+  waitForFinished();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void LibraryElementWriter::waitForFinished() noexcept {
+  mPool.waitForDone();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void LibraryElementWriter::write(std::shared_ptr<LibraryBaseElement> element,
+                                 const FilePath& dir,
+                                 ErrorCallback onError) noexcept {
+  mFreeSlots.acquire();  // Blocks if too many elements are pending.
+  mPool.start([this, element, dir, onError]() {
+    try {
+      TransactionalDirectory transDir(
+          TransactionalFileSystem::openRW(dir));  // can throw
+      element->saveTo(transDir);  // can throw
+      transDir.getFileSystem()->save();  // can throw
+      ++mWrittenCount;
+    } catch (const Exception& e) {
+      if (onError) {
+        onError(e.getMsg());
+      }
+    }
+    mFreeSlots.release();
+  });
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
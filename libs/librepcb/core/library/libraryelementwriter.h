@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CORE_LIBRARYELEMENTWRITER_H
+#define LIBREPCB_CORE_LIBRARYELEMENTWRITER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+
+#include <QtCore>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class LibraryBaseElement;
+
+/*******************************************************************************
+ *  Class LibraryElementWriter
+ ******************************************************************************/
+
+/**
+ * @brief Saves library elements into a library in worker threads
+ *
+ * Intended for importers which create lots of library elements: While the
+ * next element is converted, previously converted elements are serialized
+ * and written to disk in parallel. The number of elements waiting to be
+ * written is limited to keep the memory usage bounded, i.e. #write() blocks
+ * if too many elements are pending.
+ *
+ * @note All methods must be called from the same thread.
+ */
+class LibraryElementWriter final {
+public:
+  /// Called from a worker thread if saving an element failed
+  typedef std::function<void(const QString& errorMsg)> ErrorCallback;
+
+  // Constructors / Destructor
+  LibraryElementWriter() = delete;
+  LibraryElementWriter(const LibraryElementWriter& other) = delete;
+
+  /**
+   * @brief Constructor
+   *
+   * @param libDir      Directory of the library to write the elements into.
+   * @param maxPending  Maximum number of elements waiting to be written.
+   *                    If <1, a value depending on the CPU count is used.
+   */
+  explicit LibraryElementWriter(const FilePath& libDir,
+                                int maxPending = 0) noexcept;
+
+  /**
+   * @brief Destructor
+   *
+   * Waits until all pending elements are written.
+   */
+  ~LibraryElementWriter() noexcept;
+
+  // Getters
+  int getWrittenCount() const noexcept { return mWrittenCount; }
+
+  // General Methods
+
+  /**
+   * @brief Write a library element into the library
+   *
+   * The element is written into the subdirectory of its type, named by its
+   * UUID (same as `saveTo()` into a new directory).
+   *
+   * @param element   The element to write. Must not be accessed anymore by
+   *                  the caller.
+   * @param onError   Called (from a worker thread) if writing failed.
+   */
+  template <typename ElementType>
+  void write(std::unique_ptr<ElementType> element,
+             ErrorCallback onError) noexcept {
+    const FilePath dir = mLibDir.getPathTo(ElementType::getShortElementName())
+                             .getPathTo(element->getUuid().toStr());
+    write(std::shared_ptr<LibraryBaseElement>(std::move(element)), dir,
+          onError);
+  }
+
+  /**
+   * @brief Wait until all pending elements are written
+   */
+  void waitForFinished() noexcept;
+
+  // Operator Overloadings
+  LibraryElementWriter& operator=(const LibraryElementWriter& rhs) = delete;
+
+private:  // Methods
+  void write(std::shared_ptr<LibraryBaseElement> element, const FilePath& dir,
+             ErrorCallback onError) noexcept;
+
+private:  // Data
+  const FilePath mLibDir;
+  QThreadPool mPool;
+  QSemaphore mFreeSlots;
+  std::atomic<int> mWrittenCount;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
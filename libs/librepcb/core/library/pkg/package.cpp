@@ -177,6 +177,27 @@ RuleCheckMessageList Package::runChecks() const {
   return check.runChecks();  // can throw
 }
 
+std::unique_ptr<Package> Package::clone() const {
+  std::unique_ptr<Package> obj(new Package(
+      mUuid, mVersion, mAuthor, mNames.getDefaultValue(),
+      mDescriptions.getDefaultValue(), mKeywords.getDefaultValue(),
+      mAssemblyType));
+  obj->mCreated = mCreated;
+  obj->mIsDeprecated = mIsDeprecated;
+  obj->mNames = mNames;
+  obj->mDescriptions = mDescriptions;
+  obj->mKeywords = mKeywords;
+  obj->mMessageApprovals = mMessageApprovals;
+  obj->mGeneratedBy = mGeneratedBy;
+  obj->mCategories = mCategories;
+  obj->mResources = mResources;
+  obj->mAlternativeNames = mAlternativeNames;
+  obj->mPads = mPads;
+  obj->mModels = mModels;
+  obj->mFootprints = mFootprints;
+  return obj;
+}
+
 std::unique_ptr<Package> Package::open(
     std::unique_ptr<TransactionalDirectory> directory,
     bool abortBeforeMigration) {
@@ -113,6 +113,16 @@ public:
   // General Methods
   virtual RuleCheckMessageList runChecks() const override;
 
+  /**
+   * @brief Create a deep copy of this package
+   *
+   * The copy is not associated with any directory, it is intended to run
+   * the checks in a worker thread while this package keeps being edited.
+   *
+   * @return The copied package
+   */
+  std::unique_ptr<Package> clone() const;
+
   // Operator Overloadings
   Package& operator=(const Package& rhs) = delete;
 
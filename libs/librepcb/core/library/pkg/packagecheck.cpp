@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "packagecheck.h"
 
+#include "../../exceptions.h"
 #include "../../geometry/polygon.h"
 #include "../../utils/toolbox.h"
 #include "../../utils/transform.h"
@@ -35,45 +36,140 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+/**
+ * @brief Find all pairs of overlapping rectangles
+ *
+ * Instead of comparing every rectangle with every other rectangle, they are
+ * bucketed into a grid so only rectangles sharing a grid cell are compared.
+ *
+ * @param rects   The rectangles to compare.
+ * @return For each rectangle, the sorted indices of all rectangles with a
+ *         higher index which overlap with it.
+ */
+static QVector<QVector<int>> findOverlappingRects(
+    const QVector<QRectF>& rects) noexcept {
+  // Determine the grid cell size from the average rectangle size, but limit
+  // the number of cells covered by a single (e.g. very large) rectangle.
+  qreal avgSize = 0;
+  qreal maxSize = 0;
+  for (const QRectF& rect : rects) {
+    const qreal size = std::max(rect.width(), rect.height());
+    avgSize += size / rects.count();
+    maxSize = std::max(maxSize, size);
+  }
+  const qreal cellSize = std::max({avgSize, maxSize / 32, qreal(1e-3)});
+
+  // Add all rectangles to the grid.
+  auto getCells = [cellSize](const QRectF& rect) {
+    return QRect(QPoint(qFloor(rect.left() / cellSize),
+                        qFloor(rect.top() / cellSize)),
+                 QPoint(qFloor(rect.right() / cellSize),
+                        qFloor(rect.bottom() / cellSize)));
+  };
+  QHash<std::pair<int, int>, QVector<int>> grid;
+  for (int i = 0; i < rects.count(); ++i) {
+    const QRect cells = getCells(rects.at(i));
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+      for (int y = cells.top(); y <= cells.bottom(); ++y) {
+        grid[std::make_pair(x, y)].append(i);
+      }
+    }
+  }
+
+  // Compare only rectangles within the same cells.
+  QVector<QVector<int>> result(rects.count());
+  for (int i = 0; i < rects.count(); ++i) {
+    const QRect cells = getCells(rects.at(i));
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+      for (int y = cells.top(); y <= cells.bottom(); ++y) {
+        for (int j : grid.value(std::make_pair(x, y))) {
+          if ((j > i) && rects.at(i).intersects(rects.at(j))) {
+            result[i].append(j);
+          }
+        }
+      }
+    }
+    std::sort(result[i].begin(), result[i].end());
+    result[i].erase(std::unique(result[i].begin(), result[i].end()),
+                    result[i].end());
+  }
+  return result;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 PackageCheck::PackageCheck(const Package& package) noexcept
-  : LibraryElementCheck(package), mPackage(package) {
+  : LibraryElementCheck(package),
+    mPackage(package),
+    mAbort(nullptr),
+    mPadOutlineCache(std::make_shared<PadOutlineCache>()) {
 }
 
 PackageCheck::~PackageCheck() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void PackageCheck::setPadOutlineCache(
+    std::shared_ptr<PadOutlineCache> cache) noexcept {
+  Q_ASSERT(cache);
+  mPadOutlineCache = cache;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 RuleCheckMessageList PackageCheck::runChecks() const {
+  // Forget the pad outlines of footprints which don't exist anymore.
+  const QSet<Uuid> footprints = mPackage.getFootprints().getUuidSet();
+  for (auto it = mPadOutlineCache->begin(); it != mPadOutlineCache->end();) {
+    if (footprints.contains(it.key())) {
+      ++it;
+    } else {
+      it = mPadOutlineCache->erase(it);
+    }
+  }
+
   RuleCheckMessageList msgs = LibraryElementCheck::runChecks();
-  checkAssemblyType(msgs);
-  checkDuplicatePadNames(msgs);
-  checkMissingFootprint(msgs);
-  checkMissingTexts(msgs);
-  checkWrongTextLayers(msgs);
-  checkPackageOutlines(msgs);
-  checkCourtyards(msgs);
-  checkOriginInCenter(msgs);
-  checkPadsPackagePadUuid(msgs);
-  checkPadsClearanceToPads(msgs);
-  checkPadsClearanceToLegend(msgs);
-  checkPadsAnnularRing(msgs);
-  checkPadsConnectionPoint(msgs);
-  checkCustomPadOutline(msgs);
-  checkStopMaskOnPads(msgs);
-  checkSolderPasteOnPads(msgs);
-  checkCopperClearanceOnPads(msgs);
-  checkPadFunctions(msgs);
-  checkHolesStopMask(msgs);
-  checkLineWidths(msgs);
-  checkZones(msgs);
-  checkFootprintModels(msgs);
+  const QVector<void (PackageCheck::*)(MsgList&) const> checks = {
+      &PackageCheck::checkAssemblyType,
+      &PackageCheck::checkDuplicatePadNames,
+      &PackageCheck::checkMissingFootprint,
+      &PackageCheck::checkMissingTexts,
+      &PackageCheck::checkWrongTextLayers,
+      &PackageCheck::checkPackageOutlines,
+      &PackageCheck::checkCourtyards,
+      &PackageCheck::checkOriginInCenter,
+      &PackageCheck::checkPadsPackagePadUuid,
+      &PackageCheck::checkPadsClearanceToPads,
+      &PackageCheck::checkPadsClearanceToLegend,
+      &PackageCheck::checkPadsAnnularRing,
+      &PackageCheck::checkPadsConnectionPoint,
+      &PackageCheck::checkCustomPadOutline,
+      &PackageCheck::checkStopMaskOnPads,
+      &PackageCheck::checkSolderPasteOnPads,
+      &PackageCheck::checkCopperClearanceOnPads,
+      &PackageCheck::checkPadFunctions,
+      &PackageCheck::checkHolesStopMask,
+      &PackageCheck::checkLineWidths,
+      &PackageCheck::checkZones,
+      &PackageCheck::checkFootprintModels,
+  };
+  for (auto check : checks) {
+    if (mAbort && mAbort->load()) {
+      throw UserCanceled(__FILE__, __LINE__);
+    }
+    (this->*check)(msgs);  // can throw
+  }
   return msgs;
 }
 
@@ -319,67 +415,76 @@ void PackageCheck::checkPadsPackagePadUuid(MsgList& msgs) const {
 }
 
 void PackageCheck::checkPadsClearanceToPads(MsgList& msgs) const {
-  Length clearance(200000);  // 200 µm
+  Length clearance(200000);  // 200 µm, see getPadOutlines()
   Length tolerance(10);  // 0.01 µm, to avoid rounding issues
 
+  struct PadArea {
+    std::shared_ptr<const FootprintPad> pad;
+    QString pkgPadName;
+    QPainterPath copperPx;
+    QPainterPath clearancePx;
+  };
+
   // Check all footprints.
   for (auto itFtp = mPackage.getFootprints().begin();
        itFtp != mPackage.getFootprints().end(); ++itFtp) {
     std::shared_ptr<const Footprint> footprint = itFtp.ptr();
 
-    // Check all pads.
-    for (auto itPad1 = (*itFtp).getPads().begin();
-         itPad1 != (*itFtp).getPads().end(); ++itPad1) {
-      std::shared_ptr<const FootprintPad> pad1 = itPad1.ptr();
-      std::shared_ptr<const PackagePad> pkgPad1 = pad1->getPackagePadUuid()
-          ? mPackage.getPads().find(*pad1->getPackagePadUuid())
+    // Get the copper and clearance areas of all pads (see getPadOutlines()).
+    const QVector<PadOutlines>& outlines = getPadOutlines(*footprint);
+    QVector<PadArea> pads;
+    QVector<QRectF> padBounds;
+    for (auto itPad = (*itFtp).getPads().begin();
+         itPad != (*itFtp).getPads().end(); ++itPad) {
+      std::shared_ptr<const FootprintPad> pad = itPad.ptr();
+      std::shared_ptr<const PackagePad> pkgPad = pad->getPackagePadUuid()
+          ? mPackage.getPads().find(*pad->getPackagePadUuid())
           : nullptr;
-      const Transform pad1Transform(pad1->getPosition(), pad1->getRotation());
-      const Length pad1Clearance =
-          std::max(clearance, *pad1->getCopperClearance()) - tolerance;
-      const QPainterPath pad1CopperPx =
-          pad1Transform.mapPx(pad1->getGeometry().toFilledQPainterPathPx());
-      const QPainterPath pad1ClearancePx =
-          pad1Transform.mapPx(pad1->getGeometry()
-                                  .withOffset(pad1Clearance)
-                                  .toFilledQPainterPathPx());
-
-      // Compare with all pads *after* pad1 to avoid duplicate messages!
-      // So, don't initialize the iterator with begin() but with pad1 + 1.
-      auto itPad2 = itPad1;
-      for (++itPad2; itPad2 != (*itFtp).getPads().end(); ++itPad2) {
-        std::shared_ptr<const FootprintPad> pad2 = itPad2.ptr();
-        std::shared_ptr<const PackagePad> pkgPad2 = pad2->getPackagePadUuid()
-            ? mPackage.getPads().find(*pad2->getPackagePadUuid())
-            : nullptr;
-        const Transform pad2Transform(pad2->getPosition(), pad2->getRotation());
-        const Length pad2Clearance =
-            std::max(clearance, *pad2->getCopperClearance()) - tolerance;
-        const QPainterPath pad2CopperPx =
-            pad2Transform.mapPx(pad2->getGeometry().toFilledQPainterPathPx());
-        const QPainterPath pad2ClearancePx =
-            pad2Transform.mapPx(pad2->getGeometry()
-                                    .withOffset(pad2Clearance)
-                                    .toFilledQPainterPathPx());
+      const PadOutlines& outline = outlines.at(pads.count());
+      PadArea area{
+          pad,
+          pkgPad ? *pkgPad->getName() : QString(),
+          outline.copperPx,
+          outline.clearancePx,
+      };
+      // The clearance area contains the copper area, so pads can only
+      // violate the clearance if their clearance areas overlap. Enlarge the
+      // bounds a bit to catch pads which are just touching each other.
+      const qreal margin = tolerance.toPx();
+      padBounds.append(
+          area.clearancePx.boundingRect().adjusted(-margin, -margin, margin,
+                                                   margin));
+      pads.append(area);
+    }
+
+    // Compare each pad only with neighbouring pads *after* it to avoid
+    // duplicate messages.
+    const QVector<QVector<int>> neighbours = findOverlappingRects(padBounds);
+    for (int i = 0; i < pads.count(); ++i) {
+      const PadArea& pad1 = pads.at(i);
+      for (int j : neighbours.at(i)) {
+        const PadArea& pad2 = pads.at(j);
 
         // Only warn if both pads have copper on the same board side.
-        if ((pad1->getComponentSide() == pad2->getComponentSide()) ||
-            (pad1->isTht()) || (pad2->isTht())) {
+        if ((pad1.pad->getComponentSide() == pad2.pad->getComponentSide()) ||
+            (pad1.pad->isTht()) || (pad2.pad->isTht())) {
           // Only warn if both pads have different net signal, or one of them
           // is unconnected (an unconnected pad is considered as a different
           // net signal).
-          if ((pad1->getPackagePadUuid() != pad2->getPackagePadUuid()) ||
-              (!pad1->getPackagePadUuid()) || (!pad2->getPackagePadUuid())) {
+          if ((pad1.pad->getPackagePadUuid() !=
+               pad2.pad->getPackagePadUuid()) ||
+              (!pad1.pad->getPackagePadUuid()) ||
+              (!pad2.pad->getPackagePadUuid())) {
             // Now check if the clearance is really too small.
-            if (pad1CopperPx.intersects(pad2CopperPx)) {
+            if (pad1.copperPx.intersects(pad2.copperPx)) {
               msgs.append(std::make_shared<MsgOverlappingPads>(
-                  footprint, pad1, pkgPad1 ? *pkgPad1->getName() : QString(),
-                  pad2, pkgPad2 ? *pkgPad2->getName() : QString()));
-            } else if (pad1ClearancePx.intersects(pad2CopperPx) ||
-                       pad1CopperPx.intersects(pad2ClearancePx)) {
+                  footprint, pad1.pad, pad1.pkgPadName, pad2.pad,
+                  pad2.pkgPadName));
+            } else if (pad1.clearancePx.intersects(pad2.copperPx) ||
+                       pad1.copperPx.intersects(pad2.clearancePx)) {
               msgs.append(std::make_shared<MsgPadClearanceViolation>(
-                  footprint, pad1, pkgPad1 ? *pkgPad1->getName() : QString(),
-                  pad2, pkgPad2 ? *pkgPad2->getName() : QString(), clearance));
+                  footprint, pad1.pad, pad1.pkgPadName, pad2.pad,
+                  pad2.pkgPadName, clearance));
             }
           }
         }
@@ -393,8 +498,12 @@ void PackageCheck::checkPadsClearanceToLegend(MsgList& msgs) const {
        itFtp != mPackage.getFootprints().end(); ++itFtp) {
     std::shared_ptr<const Footprint> footprint = itFtp.ptr();
 
-    QPainterPath topLegend;
-    QPainterPath botLegend;
+    // Memorize the (slightly enlarged) bounding rect of each legend area to
+    // intersect pads only with the legend areas close to them. Areas not
+    // overlapping a pad can be skipped without changing the result.
+    const qreal margin = Length(10).toPx();
+    QVector<std::pair<QRectF, QPainterPath>> topLegend;
+    QVector<std::pair<QRectF, QPainterPath>> botLegend;
     for (const Polygon& polygon : footprint->getPolygons()) {
       QPen pen(Qt::NoPen);
       if (polygon.getLineWidth() > 0) {
@@ -407,33 +516,45 @@ void PackageCheck::checkPadsClearanceToLegend(MsgList& msgs) const {
       }
       QPainterPath area = Toolbox::shapeFromPath(
           polygon.getPath().toQPainterPathPx(), pen, brush);
+      const QRectF bounds =
+          area.boundingRect().adjusted(-margin, -margin, margin, margin);
       if (polygon.getLayer() == Layer::topLegend()) {
-        topLegend.addPath(area);
+        topLegend.append(std::make_pair(bounds, area));
       } else if (polygon.getLayer() == Layer::botLegend()) {
-        botLegend.addPath(area);
+        botLegend.append(std::make_pair(bounds, area));
       }
     }
+    auto intersectsLegend =
+        [margin](const QPainterPath& path,
+                 const QVector<std::pair<QRectF, QPainterPath>>& legend) {
+          const QRectF bounds =
+              path.boundingRect().adjusted(-margin, -margin, margin, margin);
+          QPainterPath nearLegend;
+          for (const auto& area : legend) {
+            if (area.first.intersects(bounds)) {
+              nearLegend.addPath(area.second);
+            }
+          }
+          return path.intersects(nearLegend);
+        };
 
+    const QVector<PadOutlines>& outlines = getPadOutlines(*footprint);
+    int index = 0;
     for (auto it = (*itFtp).getPads().begin(); it != (*itFtp).getPads().end();
          ++it) {
       std::shared_ptr<const FootprintPad> pad = it.ptr();
       std::shared_ptr<const PackagePad> pkgPad = pad->getPackagePadUuid()
           ? mPackage.getPads().find(*pad->getPackagePadUuid())
           : nullptr;
-      Length clearance(150000);  // 150 µm
-      Length tolerance(10);  // 0.01 µm, to avoid rounding issues
-      const Transform transform(pad->getPosition(), pad->getRotation());
-      const QPainterPath stopMask =
-          transform.mapPx(pad->getGeometry()
-                              .withOffset(clearance - tolerance)
-                              .toFilledQPainterPathPx());
+      Length clearance(150000);  // 150 µm, see getPadOutlines()
+      const QPainterPath& stopMask = outlines.at(index++).legendClearancePx;
       if (pad->isOnLayer(Layer::topCopper()) &&
-          stopMask.intersects(topLegend)) {
+          intersectsLegend(stopMask, topLegend)) {
         msgs.append(std::make_shared<MsgPadOverlapsWithLegend>(
             footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
             clearance));
       } else if (pad->isOnLayer(Layer::botCopper()) &&
-                 stopMask.intersects(botLegend)) {
+                 intersectsLegend(stopMask, botLegend)) {
         msgs.append(std::make_shared<MsgPadOverlapsWithLegend>(
             footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
             clearance));
@@ -758,6 +879,42 @@ void PackageCheck::checkFootprintModels(MsgList& msgs) const {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+const QVector<PackageCheck::PadOutlines>& PackageCheck::getPadOutlines(
+    const Footprint& footprint) const {
+  // Clearances as reported by checkPadsClearanceToPads() and
+  // checkPadsClearanceToLegend().
+  const Length padClearance(200000);  // 200 µm
+  const Length legendClearance(150000);  // 150 µm
+  const Length tolerance(10);  // 0.01 µm, to avoid rounding issues
+
+  // The outlines only depend on the pads, so they need to be recalculated
+  // only if any pad of the footprint was modified.
+  CachedPadOutlines& cache = (*mPadOutlineCache)[footprint.getUuid()];
+  if (cache.pads != footprint.getPads()) {
+    cache.pads = footprint.getPads();
+    cache.outlines.clear();
+    cache.outlines.reserve(footprint.getPads().count());
+    for (const FootprintPad& pad : footprint.getPads()) {
+      const Transform transform(pad.getPosition(), pad.getRotation());
+      const Length clearance =
+          std::max(padClearance, *pad.getCopperClearance()) - tolerance;
+      cache.outlines.append(PadOutlines{
+          transform.mapPx(pad.getGeometry().toFilledQPainterPathPx()),
+          transform.mapPx(
+              pad.getGeometry().withOffset(clearance).toFilledQPainterPathPx()),
+          transform.mapPx(pad.getGeometry()
+                              .withOffset(legendClearance - tolerance)
+                              .toFilledQPainterPathPx()),
+      });
+    }
+  }
+  return cache.outlines;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
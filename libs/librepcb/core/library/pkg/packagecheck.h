@@ -23,15 +23,22 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../types/uuid.h"
 #include "../libraryelementcheck.h"
+#include "footprintpad.h"
 
 #include <QtCore>
+#include <QtGui>
+
+#include <atomic>
+#include <memory>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
+class Footprint;
 class Package;
 
 /*******************************************************************************
@@ -43,12 +50,64 @@ class Package;
  */
 class PackageCheck : public LibraryElementCheck {
 public:
+  // Types
+
+  /**
+   * @brief Outlines of a pad, used by the pad clearance checks
+   */
+  struct PadOutlines {
+    QPainterPath copperPx;  ///< Copper area
+    QPainterPath clearancePx;  ///< Copper area plus clearance to other pads
+    QPainterPath legendClearancePx;  ///< Copper area plus clearance to legend
+  };
+
+  /**
+   * @brief Pad outlines of a footprint together with the pads they belong to
+   *
+   * The outlines are valid only as long as the footprint pads are equal to
+   * the memorized pads.
+   */
+  struct CachedPadOutlines {
+    FootprintPadList pads;
+    QVector<PadOutlines> outlines;  ///< Same order as #pads
+  };
+
+  /// Pad outlines by footprint UUID, see #setPadOutlineCache()
+  using PadOutlineCache = QHash<Uuid, CachedPadOutlines>;
+
   // Constructors / Destructor
   PackageCheck() = delete;
   PackageCheck(const PackageCheck& other) = delete;
   explicit PackageCheck(const Package& package) noexcept;
   virtual ~PackageCheck() noexcept;
 
+  // Setters
+
+  /**
+   * @brief Set a flag to abort running checks
+   *
+   * The flag is evaluated between the individual checks. Once it is set,
+   * #runChecks() throws a ::librepcb::UserCanceled exception. This allows
+   * to abandon outdated checks running in a worker thread.
+   *
+   * @param abort   Flag which may be set from any thread, must outlive the
+   *                checks. `nullptr` to disable aborting.
+   */
+  void setAbortFlag(const std::atomic_bool* abort) noexcept { mAbort = abort; }
+
+  /**
+   * @brief Set a cache for pad outlines to be reused by subsequent checks
+   *
+   * Calculating the pad outlines is expensive for footprints with many pads.
+   * When passing the same cache to the checks of each modification of a
+   * package, the outlines are only recalculated for footprints whose pads
+   * have been modified. The cache must not be used by several checks
+   * concurrently.
+   *
+   * @param cache   The cache to use (must not be `nullptr`).
+   */
+  void setPadOutlineCache(std::shared_ptr<PadOutlineCache> cache) noexcept;
+
   // General Methods
   virtual RuleCheckMessageList runChecks() const override;
 
@@ -79,8 +138,13 @@ protected:  // Methods
   void checkZones(MsgList& msgs) const;
   void checkFootprintModels(MsgList& msgs) const;
 
+private:  // Methods
+  const QVector<PadOutlines>& getPadOutlines(const Footprint& footprint) const;
+
 private:  // Data
   const Package& mPackage;
+  const std::atomic_bool* mAbort;
+  std::shared_ptr<PadOutlineCache> mPadOutlineCache;
 };
 
 /*******************************************************************************
@@ -311,14 +311,25 @@ void Board::setDrcSettings(
  *  DRC Message Approval Methods
  ******************************************************************************/
 
+const QSet<RuleCheckMessage::Fingerprint>&
+    Board::getDrcMessageApprovalFingerprints() const noexcept {
+  if (!mDrcMessageApprovalFingerprints) {
+    mDrcMessageApprovalFingerprints =
+        RuleCheckMessage::calcFingerprints(mDrcMessageApprovals);
+  }
+  return *mDrcMessageApprovalFingerprints;
+}
+
 void Board::loadDrcMessageApprovals(
     const Version& version, const QSet<SExpression>& approvals) noexcept {
   mDrcMessageApprovalsVersion = version;
   mDrcMessageApprovals = approvals;
+  mDrcMessageApprovalFingerprints.reset();
 }
 
-bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
-                                      bool partialRun) noexcept {
+bool Board::updateDrcMessageApprovals(
+    const QSet<RuleCheckMessage::Fingerprint>& approvals,
+    bool partialRun) noexcept {
   mSupportedDrcMessageApprovals |= approvals;
 
   // Don't remove obsolete approvals after a partial DRC run because we would
@@ -327,25 +338,48 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
     return false;
   }
 
+  // Remove all approvals for which the passed predicate returns true. The
+  // approvals are compared by their fingerprints (cached until modified) to
+  // avoid hashing and comparing all S-Expressions on every DRC run.
+  auto removeApprovals = [this](auto predicate) {
+    bool modified = false;
+    for (auto it = mDrcMessageApprovals.begin();
+         it != mDrcMessageApprovals.end();) {
+      if (predicate(RuleCheckMessage::calcFingerprint(*it))) {
+        it = mDrcMessageApprovals.erase(it);
+        modified = true;
+      } else {
+        ++it;
+      }
+    }
+    if (modified) {
+      mDrcMessageApprovalFingerprints.reset();
+    }
+    return modified;
+  };
+
   // When running the DRC the first time after a file format upgrade, remove
   // all approvals not occurring anymore to clean up obsolete approvals from
   // the board file.
   if (mDrcMessageApprovalsVersion < Application::getFileFormatVersion()) {
     mDrcMessageApprovalsVersion = Application::getFileFormatVersion();
-    mDrcMessageApprovals &= approvals;
+    removeApprovals([&approvals](const RuleCheckMessage::Fingerprint& fp) {
+      return !approvals.contains(fp);
+    });
     return true;
   }
 
   // Remove only approvals which disappeared during this session to avoid
   // removing approvals added by newer minor application versions.
-  approvals =
-      mDrcMessageApprovals - (mSupportedDrcMessageApprovals - approvals);
-  if (approvals != mDrcMessageApprovals) {
-    mDrcMessageApprovals = approvals;
-    return true;
-  }
-
-  return false;
+  const QSet<RuleCheckMessage::Fingerprint> disappeared =
+      mSupportedDrcMessageApprovals - approvals;
+  if (!getDrcMessageApprovalFingerprints().intersects(disappeared)) {
+    return false;  // Fast path, nothing to remove.
+  }
+  return removeApprovals(
+      [&disappeared](const RuleCheckMessage::Fingerprint& fp) {
+        return disappeared.contains(fp);
+      });
 }
 
 void Board::setDrcMessageApproved(const SExpression& approval,
@@ -355,6 +389,7 @@ void Board::setDrcMessageApproved(const SExpression& approval,
   } else {
     mDrcMessageApprovals.remove(approval);
   }
+  mDrcMessageApprovalFingerprints.reset();
 }
 
 /*******************************************************************************
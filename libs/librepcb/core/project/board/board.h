@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "../../fileio/filepath.h"
 #include "../../fileio/transactionaldirectory.h"
+#include "../../rulecheck/rulecheckmessage.h"
 #include "../../types/elementname.h"
 #include "../../types/length.h"
 #include "../../types/lengthunit.h"
@@ -170,10 +171,13 @@ public:
   const QSet<SExpression>& getDrcMessageApprovals() const noexcept {
     return mDrcMessageApprovals;
   }
+  const QSet<RuleCheckMessage::Fingerprint>& getDrcMessageApprovalFingerprints()
+      const noexcept;
   void loadDrcMessageApprovals(const Version& version,
                                const QSet<SExpression>& approvals) noexcept;
-  bool updateDrcMessageApprovals(QSet<SExpression> approvals,
-                                 bool partialRun) noexcept;
+  bool updateDrcMessageApprovals(
+      const QSet<RuleCheckMessage::Fingerprint>& approvals,
+      bool partialRun) noexcept;
   void setDrcMessageApproved(const SExpression& approval,
                              bool approved) noexcept;
 
@@ -304,7 +308,9 @@ private:
   // DRC
   Version mDrcMessageApprovalsVersion;
   QSet<SExpression> mDrcMessageApprovals;
-  QSet<SExpression> mSupportedDrcMessageApprovals;
+  mutable std::optional<QSet<RuleCheckMessage::Fingerprint>>
+      mDrcMessageApprovalFingerprints;  ///< Lazily calculated
+  QSet<RuleCheckMessage::Fingerprint> mSupportedDrcMessageApprovals;
 
   // items
   QMap<Uuid, BI_Device*> mDeviceInstances;
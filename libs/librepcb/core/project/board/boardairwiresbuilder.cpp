@@ -62,31 +62,33 @@ BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
 
 QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
     BoardAirWiresBuilder::buildAirWires() const {
-  AirWiresBuilder builder;
-
-  // Map from ID to (position, start layer number, end layer number)
-  QHash<int, std::tuple<Point, int, int>> pointLayerMap;
-
-  // Map from anchor to ID
-  QHash<const BI_NetLineAnchor*, int> anchorMap;
+  QVector<Anchor> anchors;
+  Connections connections;
+  QVector<Plane> planes;
+
+  // Map from anchor to index and vice versa
+  QHash<const BI_NetLineAnchor*, int> anchorIds;
+  QVector<const BI_NetLineAnchor*> anchorItems;
+  auto addAnchor = [&](const BI_NetLineAnchor* item, const Point& pos,
+                       const Layer& startLayer, const Layer& endLayer) {
+    anchorIds[item] = anchors.count();
+    anchors.append(Anchor{pos, startLayer.getCopperNumber(),
+                          endLayer.getCopperNumber()});
+    anchorItems.append(item);
+  };
 
   // pads
   foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
       if (&pad->getBoard() != &mBoard) continue;
-      const Point& pos = pad->getPosition();
-      int id = builder.addPoint(pos);
       if (pad->getLibPad().isTht()) {
-        pointLayerMap[id] =
-            std::make_tuple(pos, Layer::topCopper().getCopperNumber(),
-                            Layer::botCopper().getCopperNumber());
+        addAnchor(pad, pad->getPosition(), Layer::topCopper(),
+                  Layer::botCopper());
       } else {
-        pointLayerMap[id] =
-            std::make_tuple(pos, pad->getSolderLayer().getCopperNumber(),
-                            pad->getSolderLayer().getCopperNumber());
+        addAnchor(pad, pad->getPosition(), pad->getSolderLayer(),
+                  pad->getSolderLayer());
       }
-      anchorMap[pad] = id;
     }
   }
 
@@ -96,67 +98,81 @@ QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
     if (&netsegment->getBoard() != &mBoard) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      const Point& pos = via->getPosition();
-      int id = builder.addPoint(pos);
-      pointLayerMap[id] =
-          std::make_tuple(pos, via->getVia().getStartLayer().getCopperNumber(),
-                          via->getVia().getEndLayer().getCopperNumber());
-      anchorMap[via] = id;
+      addAnchor(via, via->getPosition(), via->getVia().getStartLayer(),
+                via->getVia().getEndLayer());
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const Layer* layer = netpoint->getLayerOfTraces()) {
-        Point pos = netpoint->getPosition();
-        int id = builder.addPoint(pos);
-        pointLayerMap[id] = std::make_tuple(pos, layer->getCopperNumber(),
-                                            layer->getCopperNumber());
-        anchorMap[netpoint] = id;
+        addAnchor(netpoint, netpoint->getPosition(), *layer, *layer);
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
-      Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
-      Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      builder.addEdge(anchorMap[&netline->getStartPoint()],
-                      anchorMap[&netline->getEndPoint()]);
+      const int startId = anchorIds.value(&netline->getStartPoint(), -1);
+      const int endId = anchorIds.value(&netline->getEndPoint(), -1);
+      if ((startId < 0) || (endId < 0)) {
+        throw LogicError(__FILE__, __LINE__, "Unknown trace anchor.");
+      }
+      connections.append(std::make_pair(startId, endId));
     }
   }
 
-  // determine connections made by planes
+  // planes
   foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
     Q_ASSERT(plane);
     if (&plane->getBoard() != &mBoard) continue;
-    const int planeLayer = plane->getLayer().getCopperNumber();
-    foreach (const Path& fragment, plane->getFragments()) {
+    planes.append(
+        Plane{plane->getLayer().getCopperNumber(), plane->getFragments()});
+  }
+
+  // Calculate the airwires and convert them back to the result type.
+  const Connections airWireIds = buildAirWires(anchors, connections, planes);
+  QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>> result;
+  result.reserve(airWireIds.size());
+  for (const auto& airWire : airWireIds) {
+    result.append(std::make_pair(anchorItems.at(airWire.first),
+                                 anchorItems.at(airWire.second)));
+  }
+  return result;
+}
+
+BoardAirWiresBuilder::Connections BoardAirWiresBuilder::buildAirWires(
+    const QVector<Anchor>& anchors, const Connections& connections,
+    const QVector<Plane>& planes) noexcept {
+  AirWiresBuilder builder;
+
+  // The IDs assigned by the builder are equal to the anchor indices.
+  for (const Anchor& anchor : anchors) {
+    builder.addPoint(anchor.position);
+  }
+  for (const auto& connection : connections) {
+    builder.addEdge(connection.first, connection.second);
+  }
+
+  // determine connections made by planes
+  for (const Plane& plane : planes) {
+    for (const Path& fragment : plane.fragments) {
+      const QPainterPath fragmentPx = fragment.toQPainterPathPx();
       int lastId = -1;
-      for (auto it = pointLayerMap.begin(); it != pointLayerMap.end(); it++) {
-        const Point& pos = std::get<0>(it.value());
-        const int startLayer = std::get<1>(it.value());
-        const int endLayer = std::get<2>(it.value());
-        if ((planeLayer >= startLayer) && (planeLayer <= endLayer) &&
-            fragment.toQPainterPathPx().contains(pos.toPxQPointF())) {
+      for (int i = 0; i < anchors.count(); ++i) {
+        const Anchor& anchor = anchors.at(i);
+        if ((plane.layer >= anchor.startLayer) &&
+            (plane.layer <= anchor.endLayer) &&
+            fragmentPx.contains(anchor.position.toPxQPointF())) {
           if (lastId >= 0) {
-            builder.addEdge(lastId, it.key());
+            builder.addEdge(lastId, i);
           }
-          lastId = it.key();
+          lastId = i;
         }
       }
     }
   }
 
-  // Calculate the airwires and convert them back to the result type.
-  const AirWiresBuilder::AirWires airWireIds = builder.buildAirWires();
-  QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>> result;
-  result.reserve(airWireIds.size());
-  foreach (const AirWiresBuilder::AirWire& airWire, airWireIds) {
-    const BI_NetLineAnchor* p1 = anchorMap.key(airWire.first, nullptr);
-    const BI_NetLineAnchor* p2 = anchorMap.key(airWire.second, nullptr);
-    if ((!p1) || (!p2)) {
-      throw LogicError(__FILE__, __LINE__, "Unknown air wire IDs received.");
-    }
-    result.append(std::make_pair(p1, p2));
+  Connections result;
+  for (const AirWiresBuilder::AirWire& airWire : builder.buildAirWires()) {
+    result.append(airWire);
   }
-
   return result;
 }
 
@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../geometry/path.h"
 #include "../../types/point.h"
 
 #include <QtCore>
@@ -45,6 +46,24 @@ class NetSignal;
  */
 class BoardAirWiresBuilder final {
 public:
+  // Types
+
+  /// A connectable item of a net (pad, via or junction)
+  struct Anchor {
+    Point position;
+    int startLayer;  ///< Copper number of the top-most layer.
+    int endLayer;  ///< Copper number of the bottom-most layer.
+  };
+
+  /// A plane, connecting all anchors located within its fragments
+  struct Plane {
+    int layer;  ///< Copper number of the plane layer.
+    QVector<Path> fragments;
+  };
+
+  /// Pairs of anchor indices
+  typedef QVector<std::pair<int, int>> Connections;
+
   // Constructors / Destructor
   BoardAirWiresBuilder() = delete;
   BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
@@ -55,6 +74,22 @@ public:
   QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
       buildAirWires() const;
 
+  /**
+   * @brief Build the air wires of a single net from plain data
+   *
+   * This is the actual algorithm, used by #buildAirWires() but also by the
+   * DRC which must not access the board from its worker threads.
+   *
+   * @param anchors       All connectable items of the net.
+   * @param connections   Anchors which are already connected (by traces).
+   * @param planes        All planes of the net.
+   *
+   * @return Anchors to be connected by air wires.
+   */
+  static Connections buildAirWires(const QVector<Anchor>& anchors,
+                                   const Connections& connections,
+                                   const QVector<Plane>& planes) noexcept;
+
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
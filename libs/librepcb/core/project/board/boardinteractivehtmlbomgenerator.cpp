@@ -126,6 +126,8 @@ std::shared_ptr<InteractiveHtmlBom> BoardInteractiveHtmlBomGenerator::generate(
     drawingLayerMap.insert(layer,
                            InteractiveHtmlBom::DrawingLayer::SilkscreenBack);
   }
+  QMap<InteractiveHtmlBom::Layer, QVector<InteractiveHtmlBom::Track>>
+      drawingTracks;  // Added at the end with a single call per layer.
   auto addDrawing = [&](const Layer& layer, const Path& path,
                         UnsignedLength width, bool filled) {
     auto drawingLayer = drawingLayerMap.find(&layer);
@@ -142,8 +144,8 @@ std::shared_ptr<InteractiveHtmlBom> BoardInteractiveHtmlBomGenerator::generate(
         const Point p0 = path.getVertices().at(i - 1).getPos();
         const Point p1 = path.getVertices().at(i).getPos();
         // Note: Arcs not handled yet as we don't use them yet...
-        ibom->addTrack(*copperLayer, p0, p1, PositiveLength(*width),
-                       std::nullopt);
+        drawingTracks[*copperLayer].append(
+            InteractiveHtmlBom::Track{p0, p1, PositiveLength(*width)});
       }
     }
   };
@@ -170,23 +172,32 @@ std::shared_ptr<InteractiveHtmlBom> BoardInteractiveHtmlBomGenerator::generate(
     const NetSignal* net = seg->getNetSignal();
     const auto netName =
         net ? std::make_optional(*net->getName()) : std::nullopt;
+    QMap<InteractiveHtmlBom::Layer, QVector<InteractiveHtmlBom::Track>> tracks;
     for (const auto nl : seg->getNetLines()) {
-      if (layerMap.contains(&nl->getLayer())) {
-        ibom->addTrack(
-            layerMap[&nl->getLayer()], nl->getStartPoint().getPosition(),
-            nl->getEndPoint().getPosition(), nl->getWidth(), netName);
+      auto layer = layerMap.find(&nl->getLayer());
+      if (layer != layerMap.end()) {
+        tracks[*layer].append(InteractiveHtmlBom::Track{
+            nl->getStartPoint().getPosition(),
+            nl->getEndPoint().getPosition(),
+            nl->getWidth(),
+        });
       }
     }
+    for (auto it = tracks.begin(); it != tracks.end(); ++it) {
+      ibom->addTracks(it.key(), it.value(), netName);
+    }
+    QVector<InteractiveHtmlBom::Via> vias;
     for (const auto via : seg->getVias()) {
-      QSet<InteractiveHtmlBom::Layer> layers;
-      if (via->getVia().isOnLayer(Layer::topCopper())) {
-        layers.insert(InteractiveHtmlBom::Layer::Top);
-      }
-      if (via->getVia().isOnLayer(Layer::botCopper())) {
-        layers.insert(InteractiveHtmlBom::Layer::Bottom);
-      }
-      ibom->addVia(layers, via->getVia().getPosition(), via->getSize(),
-                   via->getDrillDiameter(), netName);
+      vias.append(InteractiveHtmlBom::Via{
+          via->getVia().isOnLayer(Layer::topCopper()),
+          via->getVia().isOnLayer(Layer::botCopper()),
+          via->getVia().getPosition(),
+          via->getSize(),
+          via->getDrillDiameter(),
+      });
+    }
+    if (!vias.isEmpty()) {
+      ibom->addVias(vias, netName);
     }
   }
 
@@ -195,10 +206,10 @@ std::shared_ptr<InteractiveHtmlBom> BoardInteractiveHtmlBomGenerator::generate(
     const NetSignal* net = plane->getNetSignal();
     const auto netName =
         net ? std::make_optional(*net->getName()) : std::nullopt;
-    if (layerMap.contains(&plane->getLayer())) {
-      for (const Path& fragment : plane->getFragments()) {
-        ibom->addPlaneFragment(layerMap[&plane->getLayer()], fragment, netName);
-      }
+    if (layerMap.contains(&plane->getLayer()) &&
+        (!plane->getFragments().isEmpty())) {
+      ibom->addPlaneFragments(layerMap[&plane->getLayer()],
+                              plane->getFragments(), netName);
     }
   }
 
@@ -291,6 +302,11 @@ std::shared_ptr<InteractiveHtmlBom> BoardInteractiveHtmlBomGenerator::generate(
     }
   }
 
+  // Add tracks of drawings on copper layers.
+  for (auto it = drawingTracks.begin(); it != drawingTracks.end(); ++it) {
+    ibom->addTracks(it.key(), it.value(), std::nullopt);
+  }
+
   // Sort BOM items.
   QList<QList<BomItem>> sortedItems;
   for (const auto& items : bomItems) {
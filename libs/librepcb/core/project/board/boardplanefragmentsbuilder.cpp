@@ -22,8 +22,10 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "../../fileio/fileutils.h"
 #include "../../library/pkg/footprint.h"
 #include "../../library/pkg/footprintpad.h"
+#include "../../serialization/sexpression.h"
 #include "../../utils/clipperhelpers.h"
 #include "../../utils/transform.h"
 #include "../circuit/netsignal.h"
@@ -51,6 +53,8 @@
  ******************************************************************************/
 namespace librepcb {
 
+static FilePath sDefaultCacheDir;
+
 /*******************************************************************************
  *  Class BoardPlaneFragmentsBuilder::Result
  ******************************************************************************/
@@ -65,7 +69,7 @@ void BoardPlaneFragmentsBuilder::Result::throwOnError() const {
   }
 }
 
-bool BoardPlaneFragmentsBuilder::Result::applyToBoard() noexcept {
+bool BoardPlaneFragmentsBuilder::Result::applyToBoard() const noexcept {
   bool modified = false;
   if (board) {
     for (auto it = planes.begin(); it != planes.end(); it++) {
@@ -89,13 +93,26 @@ bool BoardPlaneFragmentsBuilder::Result::applyToBoard() noexcept {
  ******************************************************************************/
 
 BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(QObject* parent) noexcept
-  : QObject(parent), mFuture(), mAbort(false) {
+  : QObject(parent),
+    mCacheDir(sDefaultCacheDir),
+    mCacheMaxSize(sDefaultCacheMaxSize),
+    mFuture(),
+    mAbort(false) {
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
   cancel();
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardPlaneFragmentsBuilder::setDefaultCacheDirectory(
+    const FilePath& dir) noexcept {
+  sDefaultCacheDir = dir;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -165,6 +182,9 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
 
   auto data = std::make_shared<JobData>();
   data->layers = Toolbox::toList(layers);
+  data->cacheDir = mCacheDir;
+  data->cacheMaxSize = mCacheMaxSize;
+  data->updateCache = (!filter);
   layers.insert(&Layer::boardOutlines());
   layers.insert(&Layer::boardCutouts());
   foreach (const BI_Device* device, board.getDeviceInstances()) {
@@ -358,29 +378,57 @@ BoardPlaneFragmentsBuilder::Result BoardPlaneFragmentsBuilder::run(
                 }
               });
 
+    // Restore planes from the persistent cache, if enabled.
+    QList<const Layer*> layersToCalculate;
+    QHash<const Layer*, FilePath> cacheFiles;
+    foreach (const Layer* layer, data->layers) {
+      if (data->cacheDir.isValid()) {
+        const FilePath fp = data->cacheDir.getPathTo(
+            calcLayerHash(*data, *layer).toHex() % ".lp");
+        if (auto planes = loadFromCache(fp)) {
+          result.planes.insert(*planes);
+          continue;
+        }
+        cacheFiles.insert(layer, fp);
+      }
+      layersToCalculate.append(layer);
+    }
+    bool cacheUpdated = false;
+    auto addLayerResult = [&](const Layer* layer, const LayerJobResult& res) {
+      result.planes.insert(res.planes);
+      result.errors.append(res.errors);
+      if (data->updateCache && res.errors.isEmpty() && (!mAbort) &&
+          cacheFiles.contains(layer)) {
+        saveToCache(cacheFiles.value(layer), res.planes);
+        cacheUpdated = true;
+      }
+    };
+
     // Calculate planes for each layer in a separate thread, except the last
     // one to keep this thread busy too.
-    QList<QFuture<LayerJobResult>> futures;
-    for (int i = 0; i < data->layers.count(); ++i) {
-      const Layer* layer = data->layers.at(i);
-      if (i < data->layers.count() - 1) {
+    QList<std::pair<const Layer*, QFuture<LayerJobResult>>> futures;
+    for (int i = 0; i < layersToCalculate.count(); ++i) {
+      const Layer* layer = layersToCalculate.at(i);
+      if (i < layersToCalculate.count() - 1) {
         // Run in other thread -> Copy JobData for safe concurrent access.
-        futures.append(
+        futures.append(std::make_pair(
+            layer,
             QtConcurrent::run(&BoardPlaneFragmentsBuilder::runLayer, this,
-                              std::make_shared<const JobData>(*data), layer));
+                              std::make_shared<const JobData>(*data), layer)));
       } else {
         // Run in this thread -> no copy of JobData required.
-        const LayerJobResult res = runLayer(data, layer);
-        result.planes.insert(res.planes);
-        result.errors.append(res.errors);
+        addLayerResult(layer, runLayer(data, layer));
       }
     }
 
     // Fetch result of each thread (blocking until all threads finished).
-    foreach (const auto& future, futures) {
-      const LayerJobResult res = future.result();
-      result.planes.insert(res.planes);
-      result.errors.append(res.errors);
+    for (const auto& pair : futures) {
+      addLayerResult(pair.first, pair.second.result());
+    }
+
+    // Keep the cache size bounded.
+    if (cacheUpdated) {
+      pruneCache(data->cacheDir, data->cacheMaxSize);
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to calculate plane fragments:" << e.getMsg();
@@ -852,6 +900,176 @@ QVector<std::pair<Point, Angle>>
   return {};
 }
 
+QByteArray BoardPlaneFragmentsBuilder::calcLayerHash(
+    const JobData& data, const Layer& layer) noexcept {
+  // Note: This is called after preprocessing the job data, so all paths are
+  // already transformed and traces are converted to polygons.
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  auto addInt = [&hash](qint64 value) {
+    hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  auto addStr = [&hash, &addInt](const QString& str) {
+    const QByteArray utf8 = str.toUtf8();
+    addInt(utf8.size());
+    hash.addData(utf8);
+  };
+  auto addNet = [&addStr](const std::optional<Uuid>& uuid) {
+    addStr(uuid ? uuid->toStr() : QString());
+  };
+  auto addPath = [&addInt](const Path& path) {
+    addInt(path.getVertices().count());
+    for (const Vertex& v : path.getVertices()) {
+      addInt(v.getPos().getX().toNm());
+      addInt(v.getPos().getY().toNm());
+      addInt(v.getAngle().toMicroDeg());
+    }
+  };
+  auto addTransform = [&addInt](const Transform& transform) {
+    addInt(transform.getPosition().getX().toNm());
+    addInt(transform.getPosition().getY().toNm());
+    addInt(transform.getRotation().toMicroDeg());
+    addInt(transform.getMirrored());
+  };
+
+  // Bump this number whenever the plane filling algorithm changes!
+  addInt(1);
+  addInt(maxArcTolerance()->toNm());
+  addStr(layer.getId());
+  for (const PlaneData& plane : data.planes) {
+    if (plane.layer == &layer) {
+      addStr(plane.uuid.toStr());
+      addNet(plane.netSignal);
+      addPath(plane.outline);
+      addInt(plane.minWidth->toNm());
+      addInt(plane.minClearance->toNm());
+      addInt(plane.keepIslands);
+      addInt(plane.priority);
+      addInt(static_cast<int>(plane.connectStyle));
+      addInt(plane.thermalGap->toNm());
+      addInt(plane.thermalSpokeWidth->toNm());
+    }
+  }
+  for (const KeepoutZoneData& zone : data.keepoutZones) {
+    if (zone.boardLayers.contains(&layer)) {
+      addPath(zone.outline);
+    }
+  }
+  for (const PolygonData& polygon : data.polygons) {
+    if ((polygon.layer == &layer) ||
+        (polygon.layer == &Layer::boardOutlines()) ||
+        (polygon.layer == &Layer::boardCutouts())) {
+      addStr(polygon.layer->getId());
+      addNet(polygon.netSignal);
+      addPath(polygon.path);
+      addInt(polygon.width->toNm());
+      addInt(polygon.filled);
+    }
+  }
+  for (const ViaData& via : data.vias) {
+    addNet(via.netSignal);
+    addInt(via.position.getX().toNm());
+    addInt(via.position.getY().toNm());
+    addInt(via.diameter->toNm());
+    addStr(via.startLayer->getId());
+    addStr(via.endLayer->getId());
+  }
+  for (const PadData& pad : data.pads) {
+    addTransform(pad.transform);
+    addNet(pad.netSignal);
+    addInt(pad.clearance->toNm());
+    for (const PadGeometry& geometry : pad.geometries.value(&layer)) {
+      addInt(static_cast<int>(geometry.getShape()));
+      addInt(geometry.getWidth().toNm());
+      addInt(geometry.getHeight().toNm());
+      addInt(geometry.getCornerRadius()->toNm());
+      addPath(geometry.getPath());
+      for (const PadHole& hole : geometry.getHoles()) {
+        addInt(hole.getDiameter()->toNm());
+        addPath(*hole.getPath());
+      }
+    }
+  }
+  for (const auto& hole : data.holes) {
+    addInt(std::get<1>(hole)->toNm());
+    addPath(*std::get<2>(hole));
+  }
+  return hash.result();
+}
+
+std::optional<QHash<Uuid, QVector<Path>>>
+    BoardPlaneFragmentsBuilder::loadFromCache(const FilePath& fp) noexcept {
+  try {
+    if (!fp.isExistingFile()) {
+      return std::nullopt;
+    }
+    const std::unique_ptr<const SExpression> root =
+        SExpression::parse(FileUtils::readFile(fp), fp);  // can throw
+    QHash<Uuid, QVector<Path>> planes;
+    for (const SExpression* planeNode : root->getChildren("plane")) {
+      QVector<Path>& fragments =
+          planes[deserialize<Uuid>(planeNode->getChild("@0"))];
+      for (const SExpression* fragmentNode :
+           planeNode->getChildren("fragment")) {
+        fragments.append(Path(*fragmentNode));
+      }
+    }
+
+    // Mark the entry as recently used, see pruneCache().
+    QFile file(fp.toStr());
+    if (file.open(QIODevice::Append)) {
+      file.setFileTime(QDateTime::currentDateTime(),
+                       QFileDevice::FileModificationTime);
+    }
+    return planes;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to load cached plane fragments:" << e.getMsg();
+    return std::nullopt;
+  }
+}
+
+void BoardPlaneFragmentsBuilder::saveToCache(
+    const FilePath& fp, const QHash<Uuid, QVector<Path>>& planes) noexcept {
+  try {
+    std::unique_ptr<SExpression> root =
+        SExpression::createList("librepcb_plane_fragments");
+    // Sort by UUID to get deterministic files.
+    QList<Uuid> uuids = planes.keys();
+    std::sort(uuids.begin(), uuids.end());
+    for (const Uuid& uuid : uuids) {
+      root->ensureLineBreak();
+      SExpression& planeNode = root->appendList("plane");
+      planeNode.appendChild(uuid);
+      for (const Path& fragment : planes.value(uuid)) {
+        planeNode.ensureLineBreak();
+        fragment.serialize(planeNode.appendList("fragment"));
+      }
+      planeNode.ensureLineBreak();
+    }
+    root->ensureLineBreak();
+    FileUtils::writeFile(fp, root->toByteArray());  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to cache plane fragments:" << e.getMsg();
+  }
+}
+
+void BoardPlaneFragmentsBuilder::pruneCache(const FilePath& dir,
+                                            qint64 maxSize) noexcept {
+  // Keep the most recently used entries until the size limit is reached,
+  // remove all others. Cache hits update the modification time of entries.
+  const QDateTime minTime =
+      QDateTime::currentDateTime().addDays(-sCacheMaxAgeDays);
+  const QFileInfoList files = QDir(dir.toStr()).entryInfoList(
+      {"*.lp"}, QDir::Files, QDir::Time);  // Newest first.
+  qint64 size = 0;
+  for (const QFileInfo& info : files) {
+    size += info.size();
+    if ((size > maxSize) || (info.lastModified() < minTime)) {
+      // Might fail if another builder removed it already, which is fine.
+      QFile::remove(info.absoluteFilePath());
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
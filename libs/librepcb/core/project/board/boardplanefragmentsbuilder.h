@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../fileio/filepath.h"
 #include "../../geometry/path.h"
 #include "../../geometry/zone.h"
 #include "../../types/uuid.h"
@@ -56,6 +57,10 @@ class BoardPlaneFragmentsBuilder final : public QObject {
   Q_OBJECT
 
 public:
+  // Constants
+  static constexpr qint64 sDefaultCacheMaxSize = 200 * 1024 * 1024;
+  static constexpr int sCacheMaxAgeDays = 30;
+
   // Types
   struct Result {
     QPointer<Board> board;  ///< The board of the calculated planes.
@@ -70,7 +75,7 @@ public:
     /// Apply the results to the board
     ///
     /// @return Whether any plane has been modified or not
-    bool applyToBoard() noexcept;
+    bool applyToBoard() const noexcept;
   };
 
   // Constructors / Destructor
@@ -78,6 +83,51 @@ public:
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
+  // Setters
+
+  /**
+   * @brief Enable a persistent cache of calculated plane fragments
+   *
+   * If a cache directory is set, a hash of all inputs of each layer (plane
+   * properties, board outline, copper objects, holes, keepout zones, ...) is
+   * calculated before filling the planes of that layer. If the cache
+   * contains fragments for that hash, they are restored instead of being
+   * calculated. Since any modification of an input leads to a different
+   * hash, cache entries never need to be invalidated explicitly.
+   *
+   * To bound the cache, the least recently used entries are removed after
+   * writing new entries if the total size of the cache exceeds the limit
+   * set by #setCacheMaxSize(). Entries not used for #sCacheMaxAgeDays days
+   * are removed as well.
+   *
+   * New cache entries are only written for full rebuilds (i.e. without layer
+   * filter), to avoid flooding the cache with intermediate states while a
+   * board is being edited.
+   *
+   * @param dir   The cache directory, or an invalid path to disable caching
+   *              (the default).
+   */
+  void setCacheDirectory(const FilePath& dir) noexcept { mCacheDir = dir; }
+
+  /**
+   * @brief Set the maximum total size of the persistent cache
+   *
+   * @param bytes   Maximum size of all cache entries in bytes (defaults to
+   *                #sDefaultCacheMaxSize).
+   */
+  void setCacheMaxSize(qint64 bytes) noexcept { mCacheMaxSize = bytes; }
+
+  /**
+   * @brief Set the cache directory used by newly created builders
+   *
+   * Intended to be called once at application startup, before any builder
+   * is created. See #setCacheDirectory() for details.
+   *
+   * @param dir   The cache directory, or an invalid path to disable caching
+   *              (the default).
+   */
+  static void setDefaultCacheDirectory(const FilePath& dir) noexcept;
+
   // General Methods
 
   /**
@@ -213,6 +263,9 @@ private:  // Methods
     QList<std::tuple<Transform, PositiveLength, NonEmptyPath>> holes;
     QList<TraceData> traces;  // Converted to polygons after preprocessing.
     std::shared_ptr<ClipperLib::Paths> boardArea;  // Populated in preprocessing
+    FilePath cacheDir;  // Invalid if caching is disabled.
+    qint64 cacheMaxSize = 0;  // Maximum total size of the cache in bytes.
+    bool updateCache = false;  // Whether to write new cache entries.
   };
 
   struct LayerJobResult {
@@ -227,6 +280,13 @@ private:  // Methods
                           const Layer* layer) noexcept;
   static QVector<std::pair<Point, Angle>> determineThermalSpokes(
       const PadGeometry& geometry) noexcept;
+  static QByteArray calcLayerHash(const JobData& data,
+                                  const Layer& layer) noexcept;
+  static std::optional<QHash<Uuid, QVector<Path>>> loadFromCache(
+      const FilePath& fp) noexcept;
+  static void saveToCache(const FilePath& fp,
+                          const QHash<Uuid, QVector<Path>>& planes) noexcept;
+  static void pruneCache(const FilePath& dir, qint64 maxSize) noexcept;
 
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs. Do not
@@ -238,6 +298,8 @@ private:  // Methods
   }
 
 private:  // Data
+  FilePath mCacheDir;
+  qint64 mCacheMaxSize;
   QFuture<Result> mFuture;
   bool mAbort;
 };
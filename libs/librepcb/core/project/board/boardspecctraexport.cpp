@@ -57,6 +57,111 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class BoardSpecctraExport::DsnWriter
+ ******************************************************************************/
+
+/**
+ * @brief Streaming writer for the DSN output
+ *
+ * Produces exactly the same output as SExpression::toByteArray() in
+ * SExpression::Mode::Permissive. Line breaks are only emitted once the
+ * next child or the end of the list is known, since a line break before
+ * the closing parenthesis is indented one level less.
+ */
+class BoardSpecctraExport::DsnWriter final {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param depth   Number of lists this output will be nested in. Used to
+   *                write parts of a list to a separate buffer which can
+   *                be appended later with #appendRaw().
+   */
+  explicit DsnWriter(int depth = 0) noexcept
+    : mDepth(depth), mLineBreak(false) {}
+
+  const QByteArray& getData() const noexcept { return mData; }
+
+  void beginList(const QString& name) {
+    writeSeparator();
+    mData += '(';
+    mData += name.toUtf8();
+    ++mDepth;
+  }
+
+  void endList() noexcept {
+    Q_ASSERT(mDepth > 0);
+    --mDepth;
+    if (mLineBreak) {
+      writeNewLine(mDepth);
+    }
+    mData += ')';
+  }
+
+  void ensureLineBreak() noexcept { mLineBreak = true; }
+
+  void appendToken(const QString& token) {
+    if (!SExpression::isValidToken(token, SExpression::Mode::Permissive)) {
+      throw LogicError(__FILE__, __LINE__,
+                       QString("Invalid S-Expression token: %1").arg(token));
+    }
+    writeSeparator();
+    mData += token.toUtf8();
+  }
+
+  void appendToken(const Length& length) { appendToken(length.toMmString()); }
+
+  void appendString(const QString& string) {
+    writeSeparator();
+    mData += '"';
+    mData += SExpression::escapeString(string).toUtf8();
+    mData += '"';
+  }
+
+  void appendToken(const QString& name, const QString& token) {
+    beginList(name);
+    appendToken(token);
+    endList();
+  }
+
+  void appendString(const QString& name, const QString& string) {
+    beginList(name);
+    appendString(string);
+    endList();
+  }
+
+  /**
+   * @brief Append the output of another writer
+   *
+   * @param data    Output of a writer created with the current depth of this
+   *                writer. Any pending line break of that writer is lost.
+   */
+  void appendRaw(const QByteArray& data) noexcept {
+    Q_ASSERT(!mLineBreak);
+    mData += data;
+  }
+
+private:
+  void writeSeparator() noexcept {
+    if (mLineBreak) {
+      writeNewLine(mDepth);
+    } else if (mDepth > 0) {
+      mData += ' ';
+    }
+  }
+
+  void writeNewLine(int indent) noexcept {
+    mData += '\n';
+    mData.append(indent, ' ');
+    mLineBreak = false;
+  }
+
+  QByteArray mData;
+  int mDepth;  ///< Number of currently open lists
+  bool mLineBreak;  ///< Whether a line break is pending
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -73,21 +178,23 @@ BoardSpecctraExport::~BoardSpecctraExport() noexcept {
  ******************************************************************************/
 
 QByteArray BoardSpecctraExport::generate() const {
-  // Add all via pad stacks.
-  std::vector<std::unique_ptr<SExpression>> fptPadStacks;
-  std::vector<std::unique_ptr<SExpression>> viaPadStacks;
+  // Collect all via pad stacks.
+  ViaPadStacks viaPadStacks;
+  QSet<QString> viaPadStackIds;
   for (const auto& segment : mBoard.getNetSegments()) {
     for (const auto& via : segment->getVias()) {
-      addToPadStacks(viaPadStacks, genWiringPadStack(*via));
+      const QString id = getWiringPadStackId(*via);
+      if (!viaPadStackIds.contains(id)) {
+        viaPadStackIds.insert(id);
+        viaPadStacks.append(std::make_pair(id, via));
+      }
     }
   }
   // Sort for a more natural order of vias.
   Toolbox::sortNumeric(
       viaPadStacks,
-      [](const QCollator& cmp, const std::unique_ptr<SExpression>& a,
-         const std::unique_ptr<SExpression>& b) {
-        return cmp(a->getChild(0).getValue(), b->getChild(0).getValue());
-      });
+      [](const QCollator& cmp, const ViaPadStacks::value_type& a,
+         const ViaPadStacks::value_type& b) { return cmp(a.first, b.first); });
 
   // Project name must not contain spaces since quotation is not activated
   // until the "parser" node appears.
@@ -100,262 +207,264 @@ QByteArray BoardSpecctraExport::generate() const {
                                        true, false, false, "-", -1);
   if (name.isEmpty()) name = "unnamed";
 
-  // Build the file.
-  std::unique_ptr<SExpression> root = SExpression::createList("pcb");
-  root->appendChild(SExpression::createToken(name));
-  root->ensureLineBreak();
-  root->appendChild(genParser());
-  root->ensureLineBreak();
-  root->appendChild(genResolution());
-  root->ensureLineBreak();
-  root->appendChild("unit", SExpression::createToken("mm"));
-  root->ensureLineBreak();
-  root->appendChild(genStructure(viaPadStacks));
-  root->ensureLineBreak();
-  root->appendChild(genPlacement());
-  root->ensureLineBreak();
-  root->appendChild(genLibrary(fptPadStacks, viaPadStacks));
-  root->ensureLineBreak();
-  root->appendChild(genNetwork());
-  root->ensureLineBreak();
-  root->appendChild(genWiring());
-  root->ensureLineBreak();
-  return root->toByteArray(SExpression::Mode::Permissive);
+  // Write the file.
+  DsnWriter out;
+  out.beginList("pcb");
+  out.appendToken(name);
+  out.ensureLineBreak();
+  genParser(out);
+  out.ensureLineBreak();
+  genResolution(out);
+  out.ensureLineBreak();
+  out.appendToken("unit", "mm");
+  out.ensureLineBreak();
+  genStructure(out, viaPadStacks);
+  out.ensureLineBreak();
+  genPlacement(out);
+  out.ensureLineBreak();
+  genLibrary(out, viaPadStacks);
+  out.ensureLineBreak();
+  genNetwork(out);
+  out.ensureLineBreak();
+  genWiring(out);
+  out.ensureLineBreak();
+  out.endList();
+  return out.getData() + '\n';  // Newline at end of file.
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genParser() const {
-  std::unique_ptr<SExpression> root = SExpression::createList("parser");
-  root->ensureLineBreak();
-  root->appendChild("string_quote", SExpression::createToken("\""));
-  root->ensureLineBreak();
-  root->appendChild("space_in_quoted_tokens", SExpression::createToken("on"));
-  root->ensureLineBreak();
-  root->appendChild("host_cad", qApp->applicationName());
-  root->ensureLineBreak();
-  root->appendChild("host_version", qApp->applicationVersion());
-  root->ensureLineBreak();
-  return root;
+void BoardSpecctraExport::genParser(DsnWriter& out) const {
+  out.beginList("parser");
+  out.ensureLineBreak();
+  out.appendToken("string_quote", "\"");
+  out.ensureLineBreak();
+  out.appendToken("space_in_quoted_tokens", "on");
+  out.ensureLineBreak();
+  out.appendString("host_cad", qApp->applicationName());
+  out.ensureLineBreak();
+  out.appendString("host_version", qApp->applicationVersion());
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genResolution() const {
-  std::unique_ptr<SExpression> root = SExpression::createList("resolution");
-  root->appendChild(SExpression::createToken("mm"));
-  root->appendChild(SExpression::createToken("1000000"));
-  return root;
+void BoardSpecctraExport::genResolution(DsnWriter& out) const {
+  out.beginList("resolution");
+  out.appendToken("mm");
+  out.appendToken("1000000");
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genStructure(
-    std::vector<std::unique_ptr<SExpression>>& viaPadStacks) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("structure");
+void BoardSpecctraExport::genStructure(DsnWriter& out,
+                                       const ViaPadStacks& viaPadStacks) const {
+  out.beginList("structure");
 
   // Layers.
   for (int i = 0; i < (mBoard.getInnerLayerCount() + 2); ++i) {
-    root->ensureLineBreak();
-    auto& node = root->appendList("layer");
+    out.ensureLineBreak();
+    out.beginList("layer");
     if (i == 0) {
-      node.appendChild(SExpression::createToken(Layer::topCopper().getId()));
+      out.appendToken(Layer::topCopper().getId());
     } else if (i <= mBoard.getInnerLayerCount()) {
-      node.appendChild(
-          SExpression::createToken(Layer::innerCopper(i)->getId()));
+      out.appendToken(Layer::innerCopper(i)->getId());
     } else {
-      node.appendChild(SExpression::createToken(Layer::botCopper().getId()));
+      out.appendToken(Layer::botCopper().getId());
     }
-    node.appendChild("type", SExpression::createToken("signal"));
+    out.appendToken("type", "signal");
+    out.endList();
   }
 
   // PCB boundary.
   foreach (const auto& polygon, mBoard.getPolygons()) {
     if (polygon->getData().getLayer() == Layer::boardOutlines()) {
-      root->ensureLineBreak();
-      auto& node = root->appendList("boundary");
-      node.ensureLineBreak();
-      node.appendChild(
-          toPath("pcb", UnsignedLength(0), polygon->getData().getPath(), true));
-      node.ensureLineBreak();
+      out.ensureLineBreak();
+      out.beginList("boundary");
+      out.ensureLineBreak();
+      writePath(out, "pcb", UnsignedLength(0), polygon->getData().getPath(),
+                true);
+      out.ensureLineBreak();
+      out.endList();
     }
   }
 
   // Planes.
   foreach (const auto& plane, mBoard.getPlanes()) {
     if (auto net = plane->getNetSignal()) {
-      root->ensureLineBreak();
-      auto& node = root->appendList("plane");
-      node.appendChild(net->getName());
-      node.ensureLineBreak();
-      node.appendChild(toPolygon(plane->getLayer().getId(), UnsignedLength(0),
-                                 plane->getOutline(), true));
-      node.ensureLineBreak();
+      out.ensureLineBreak();
+      out.beginList("plane");
+      out.appendString(*net->getName());
+      out.ensureLineBreak();
+      writePolygon(out, plane->getLayer().getId(), UnsignedLength(0),
+                   plane->getOutline(), true);
+      out.ensureLineBreak();
+      out.endList();
     }
   }
 
   // Keepout areas.
   foreach (const auto& polygon, mBoard.getPolygons()) {
     if (polygon->getData().getLayer() == Layer::boardCutouts()) {
-      root->ensureLineBreak();
-      root->appendChild(
-          toKeepout("cutout:" + polygon->getData().getUuid().toStr(),
-                    polygon->getData().getPath(), {}));
+      out.ensureLineBreak();
+      writeKeepout(out, "cutout:" + polygon->getData().getUuid().toStr(),
+                   polygon->getData().getPath(), {});
     }
   }
   for (const auto& hole : mBoard.getHoles()) {
-    root->ensureLineBreak();
-    root->appendChild(toKeepout("hole:" + hole->getData().getUuid().toStr(),
-                                hole->getData()));
+    out.ensureLineBreak();
+    writeKeepout(out, "hole:" + hole->getData().getUuid().toStr(),
+                 hole->getData());
   }
   foreach (const auto& zone, mBoard.getZones()) {
     if (zone->getData().getRules().testFlag(Zone::Rule::NoCopper)) {
-      root->ensureLineBreak();
-      root->appendChild(toKeepout("zone:" + zone->getData().getUuid().toStr(),
-                                  zone->getData().getOutline(),
-                                  zone->getData().getLayers()));
+      out.ensureLineBreak();
+      writeKeepout(out, "zone:" + zone->getData().getUuid().toStr(),
+                   zone->getData().getOutline(), zone->getData().getLayers());
     }
   }
 
   // Vias.
-  root->ensureLineBreak();
-  {
-    auto& node = root->appendList("via");
-    for (const auto& padStack : viaPadStacks) {
-      node.ensureLineBreak();
-      node.appendChild(padStack->getChild(0).getValue());
-    }
-    node.ensureLineBreak();
-  }
-
-  root->ensureLineBreak();
-  root->appendChild(genStructureRule());
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.beginList("via");
+  for (const auto& padStack : viaPadStacks) {
+    out.ensureLineBreak();
+    out.appendString(padStack.first);
+  }
+  out.ensureLineBreak();
+  out.endList();
+
+  out.ensureLineBreak();
+  genStructureRule(out);
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genStructureRule() const {
-  std::unique_ptr<SExpression> root = SExpression::createList("rule");
-  root->ensureLineBreak();
-  root->appendChild("width",
-                    toToken(*mBoard.getDrcSettings().getMinCopperWidth()));
-  root->ensureLineBreak();
-  root->appendChild(
-      "clearance",
-      toToken(*mBoard.getDrcSettings().getMinCopperCopperClearance()));
-  root->ensureLineBreak();
-  {
-    auto& node = root->appendList("clearance");
-    node.appendChild(toToken(Length(0)));
-    node.appendChild("type", SExpression::createToken("smd_via_same_net"));
-  }
-  root->ensureLineBreak();
-  {
-    auto& node = root->appendList("clearance");
-    node.appendChild(toToken(Length(0)));
-    node.appendChild("type", SExpression::createToken("via_via_same_net"));
-  }
-  root->ensureLineBreak();
-  return root;
+void BoardSpecctraExport::genStructureRule(DsnWriter& out) const {
+  out.beginList("rule");
+  out.ensureLineBreak();
+  out.beginList("width");
+  out.appendToken(*mBoard.getDrcSettings().getMinCopperWidth());
+  out.endList();
+  out.ensureLineBreak();
+  out.beginList("clearance");
+  out.appendToken(*mBoard.getDrcSettings().getMinCopperCopperClearance());
+  out.endList();
+  out.ensureLineBreak();
+  out.beginList("clearance");
+  out.appendToken(Length(0));
+  out.appendToken("type", "smd_via_same_net");
+  out.endList();
+  out.ensureLineBreak();
+  out.beginList("clearance");
+  out.appendToken(Length(0));
+  out.appendToken("type", "via_via_same_net");
+  out.endList();
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genPlacement() const {
-  std::unique_ptr<SExpression> root = SExpression::createList("placement");
+void BoardSpecctraExport::genPlacement(DsnWriter& out) const {
+  out.beginList("placement");
   for (const BI_Device* dev : mBoard.getDeviceInstances()) {
     const QString imageId = *dev->getComponentInstance().getName() % ":" %
         *dev->getLibPackage().getNames().getDefaultValue();
-    root->ensureLineBreak();
-    auto& componentNode = root->appendList("component");
-    componentNode.appendChild(imageId);
-    componentNode.ensureLineBreak();
-    auto& placeNode = componentNode.appendList("place");
-    placeNode.appendChild(*dev->getComponentInstance().getName());
-    placeNode.appendChild(toToken(dev->getPosition().getX()));
-    placeNode.appendChild(toToken(dev->getPosition().getY()));
-    if (!dev->getMirrored()) {
-      placeNode.appendChild(SExpression::createToken("front"));
-    } else {
-      placeNode.appendChild(SExpression::createToken("back"));
-    }
-    placeNode.appendChild(
-        SExpression::createToken(dev->getRotation().toDegString()));
-    componentNode.ensureLineBreak();
-  }
-  root->ensureLineBreak();
-  return root;
+    out.ensureLineBreak();
+    out.beginList("component");
+    out.appendString(imageId);
+    out.ensureLineBreak();
+    out.beginList("place");
+    out.appendString(*dev->getComponentInstance().getName());
+    out.appendToken(dev->getPosition().getX());
+    out.appendToken(dev->getPosition().getY());
+    out.appendToken(dev->getMirrored() ? "back" : "front");
+    out.appendToken(dev->getRotation().toDegString());
+    out.endList();
+    out.ensureLineBreak();
+    out.endList();
+  }
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genLibrary(
-    std::vector<std::unique_ptr<SExpression>>& fptPadStacks,
-    std::vector<std::unique_ptr<SExpression>>& viaPadStacks) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("library");
+void BoardSpecctraExport::genLibrary(DsnWriter& out,
+                                     const ViaPadStacks& viaPadStacks) const {
+  out.beginList("library");
+  FootprintPadStacks fptPadStacks;
   for (const BI_Device* dev : mBoard.getDeviceInstances()) {
-    root->ensureLineBreak();
-    root->appendChild(genLibraryImage(*dev, fptPadStacks));
-  }
-  root->ensureLineBreak();
-  for (std::size_t i = 0; i < fptPadStacks.size(); ++i) {
-    fptPadStacks[i]->getChild(0).setValue(
-        fptPadStacks[i]->getChild(0).getValue() + QString::number(i));
-    root->ensureLineBreak();
-    root->appendChild(std::move(fptPadStacks[i]));
-  }
-  for (std::size_t i = 0; i < viaPadStacks.size(); ++i) {
-    root->ensureLineBreak();
-    root->appendChild(std::move(viaPadStacks[i]));
-  }
-  fptPadStacks.clear();
-  viaPadStacks.clear();
-  root->ensureLineBreak();
-  return root;
+    out.ensureLineBreak();
+    genLibraryImage(out, *dev, fptPadStacks);
+  }
+  out.ensureLineBreak();
+  QVector<const QByteArray*> fptPadStacksSorted(fptPadStacks.count());
+  for (auto it = fptPadStacks.cbegin(); it != fptPadStacks.cend(); ++it) {
+    fptPadStacksSorted[it.value()] = &it.key();
+  }
+  for (int i = 0; i < fptPadStacksSorted.count(); ++i) {
+    out.ensureLineBreak();
+    out.beginList("padstack");
+    out.appendString("pad-" % QString::number(i));
+    out.appendRaw(*fptPadStacksSorted.at(i));
+    out.ensureLineBreak();
+    out.endList();
+  }
+  for (const auto& padStack : viaPadStacks) {
+    out.ensureLineBreak();
+    genWiringPadStack(out, padStack.first, *padStack.second);
+  }
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genLibraryImage(
-    const BI_Device& dev,
-    std::vector<std::unique_ptr<SExpression>>& fptPadStacks) const {
+void BoardSpecctraExport::genLibraryImage(
+    DsnWriter& out, const BI_Device& dev,
+    FootprintPadStacks& fptPadStacks) const {
   const QString id = *dev.getComponentInstance().getName() % ":" %
       *dev.getLibPackage().getNames().getDefaultValue();
 
-  std::unique_ptr<SExpression> root = SExpression::createList("image");
-  root->appendChild(id);
+  out.beginList("image");
+  out.appendString(id);
   for (const auto& polygon : dev.getLibFootprint().getPolygons()) {
     if (polygon.getLayer() == Layer::topDocumentation()) {
-      root->ensureLineBreak();
-      auto& outlineNode = root->appendList("outline");
+      out.ensureLineBreak();
+      out.beginList("outline");
       Path path = polygon.getPath();
       if (polygon.getLayer().getPolygonsRepresentAreas()) {
         path.close();
       }
-      outlineNode.appendChild(
-          toPath("signal", polygon.getLineWidth(), path, true));
-      outlineNode.ensureLineBreak();
+      writePath(out, "signal", polygon.getLineWidth(), path, true);
+      out.ensureLineBreak();
+      out.endList();
     } else if (polygon.getLayer() == Layer::boardCutouts()) {
-      root->ensureLineBreak();
-      root->appendChild(toKeepout(*dev.getComponentInstance().getName() + ":" +
-                                      "cutout:" + polygon.getUuid().toStr(),
-                                  polygon.getPath(), {}));
+      out.ensureLineBreak();
+      writeKeepout(out,
+                   *dev.getComponentInstance().getName() + ":" + "cutout:" +
+                       polygon.getUuid().toStr(),
+                   polygon.getPath(), {});
     }
   }
   for (const auto& pad : dev.getPads()) {
     const QString id = "pad-" +
         QString::number(addToPadStacks(fptPadStacks, genLibraryPadStack(*pad)));
-    root->ensureLineBreak();
-    auto& pinNode = root->appendList("pin");
-    pinNode.appendChild(id);
-    pinNode.appendChild(
-        "rotate",
-        SExpression::createToken(pad->getLibPad().getRotation().toDegString()));
-    pinNode.appendChild(pad->getLibPadUuid().toStr().replace("-", ""));
-    pinNode.appendChild(toToken(pad->getLibPad().getPosition().getX()));
-    pinNode.appendChild(toToken(pad->getLibPad().getPosition().getY()));
+    out.ensureLineBreak();
+    out.beginList("pin");
+    out.appendString(id);
+    out.appendToken("rotate", pad->getLibPad().getRotation().toDegString());
+    out.appendString(pad->getLibPadUuid().toStr().replace("-", ""));
+    out.appendToken(pad->getLibPad().getPosition().getX());
+    out.appendToken(pad->getLibPad().getPosition().getY());
+    out.endList();
   }
   for (const auto& hole : dev.getLibFootprint().getHoles()) {
-    root->ensureLineBreak();
-    root->appendChild(toKeepout(*dev.getComponentInstance().getName() + ":" +
-                                    "hole:" + hole.getUuid().toStr(),
-                                hole));
+    out.ensureLineBreak();
+    writeKeepout(out,
+                 *dev.getComponentInstance().getName() + ":" + "hole:" +
+                     hole.getUuid().toStr(),
+                 hole);
   }
   for (const auto& zone : dev.getLibFootprint().getZones()) {
     if (zone.getRules().testFlag(Zone::Rule::NoCopper)) {
-      root->ensureLineBreak();
+      out.ensureLineBreak();
       QSet<const Layer*> layers;
       if (zone.getLayers().testFlag(Zone::Layer::Top)) {
         layers.insert(&Layer::topCopper());
@@ -368,20 +477,24 @@ std::unique_ptr<SExpression> BoardSpecctraExport::genLibraryImage(
       if (zone.getLayers().testFlag(Zone::Layer::Bottom)) {
         layers.insert(&Layer::botCopper());
       }
-      root->appendChild(toKeepout(*dev.getComponentInstance().getName() + ":" +
-                                      "zone:" + zone.getUuid().toStr(),
-                                  zone.getOutline(), layers));
+      writeKeepout(out,
+                   *dev.getComponentInstance().getName() + ":" + "zone:" +
+                       zone.getUuid().toStr(),
+                   zone.getOutline(), layers);
     }
   }
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genLibraryPadStack(
+QByteArray BoardSpecctraExport::genLibraryPadStack(
     const BI_FootprintPad& pad) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("padstack");
-  root->appendChild(QString("pad-"));
-  root->ensureLineBreak();
+  // Only the content after the pad stack ID is written since the ID is not
+  // known yet. It is also used to de-duplicate the pad stacks, thus it is
+  // written with the indentation of "pcb" -> "library" -> "padstack". The
+  // line break before the closing parenthesis is added by genLibrary().
+  DsnWriter out(3);
+  out.ensureLineBreak();
   const Transform transform(pad);
 
   // Determine pad shape.
@@ -418,152 +531,164 @@ std::unique_ptr<SExpression> BoardSpecctraExport::genLibraryPadStack(
       if ((s == PadGeometry::Shape::RoundedRect) && (w > 0) && (h > 0) &&
           (r == 0)) {
         // Rectangular pad.
-        root->ensureLineBreak();
-        auto& node = root->appendList("shape");
-        auto& child = node.appendList("rect");
-        child.appendChild(SExpression::createToken(pair.first->getId()));
-        child.appendChild(toToken(-w / 2));
-        child.appendChild(toToken(-h / 2));
-        child.appendChild(toToken(w / 2));
-        child.appendChild(toToken(h / 2));
+        out.ensureLineBreak();
+        out.beginList("shape");
+        out.beginList("rect");
+        out.appendToken(pair.first->getId());
+        out.appendToken(-w / 2);
+        out.appendToken(-h / 2);
+        out.appendToken(w / 2);
+        out.appendToken(h / 2);
+        out.endList();
+        out.endList();
       } else if (((s == PadGeometry::Shape::RoundedRect) ||
                   (s == PadGeometry::Shape::RoundedOctagon)) &&
                  (w == h) && (w > 0) && (r >= (w / 2))) {
         // Circular pad.
-        root->ensureLineBreak();
-        auto& node = root->appendList("shape");
-        node.appendChild(toCircle(pair.first->getId(), PositiveLength(w)));
+        out.ensureLineBreak();
+        out.beginList("shape");
+        writeCircle(out, pair.first->getId(), PositiveLength(w));
+        out.endList();
       } else if ((s == PadGeometry::Shape::Stroke) &&
                  (geometry.getPath().getVertices().count() == 1) && (w > 0)) {
         // Circular pad.
-        root->ensureLineBreak();
-        auto& node = root->appendList("shape");
-        node.appendChild(toCircle(pair.first->getId(), PositiveLength(w)));
+        out.ensureLineBreak();
+        out.beginList("shape");
+        writeCircle(out, pair.first->getId(), PositiveLength(w));
+        out.endList();
       } else if (((s == PadGeometry::Shape::RoundedRect) ||
                   (s == PadGeometry::Shape::RoundedOctagon)) &&
                  (w > h) && (h > 0) && (r >= (h / 2))) {
         // Oblong pad (horizontal).
-        root->ensureLineBreak();
-        auto& node = root->appendList("shape");
-        node.appendChild(toPath(
-            pair.first->getId(), UnsignedLength(h),
-            Path::line(Point(-(w - h) / 2, 0), Point((w - h) / 2, 0)), false));
+        out.ensureLineBreak();
+        out.beginList("shape");
+        writePath(out, pair.first->getId(), UnsignedLength(h),
+                  Path::line(Point(-(w - h) / 2, 0), Point((w - h) / 2, 0)),
+                  false);
+        out.endList();
       } else if (((s == PadGeometry::Shape::RoundedRect) ||
                   (s == PadGeometry::Shape::RoundedOctagon)) &&
                  (h > w) && (w > 0) && (r >= (w / 2))) {
         // Oblong pad (vertical).
-        root->ensureLineBreak();
-        auto& node = root->appendList("shape");
-        node.appendChild(toPath(
-            pair.first->getId(), UnsignedLength(w),
-            Path::line(Point(0, (h - w) / 2), Point(0, (h - w) / 2)), false));
+        out.ensureLineBreak();
+        out.beginList("shape");
+        writePath(out, pair.first->getId(), UnsignedLength(w),
+                  Path::line(Point(0, (h - w) / 2), Point(0, (h - w) / 2)),
+                  false);
+        out.endList();
       } else if ((s == PadGeometry::Shape::Stroke) &&
                  (geometry.getPath().getVertices().count() > 1) && (w > 0)) {
         // Circular stroke pad.
-        root->ensureLineBreak();
-        auto& node = root->appendList("shape");
-        node.appendChild(toPath(pair.first->getId(), UnsignedLength(w),
-                                geometry.getPath(), false));
+        out.ensureLineBreak();
+        out.beginList("shape");
+        writePath(out, pair.first->getId(), UnsignedLength(w),
+                  geometry.getPath(), false);
+        out.endList();
       } else {
         // Fallback: Arbitrary pads as polygons.
         for (const Path& p : geometry.toOutlines()) {
-          root->ensureLineBreak();
-          auto& node = root->appendList("shape");
-          node.appendChild(
-              toPolygon(pair.first->getId(), UnsignedLength(0), p, true));
+          out.ensureLineBreak();
+          out.beginList("shape");
+          writePolygon(out, pair.first->getId(), UnsignedLength(0), p, true);
+          out.endList();
         }
       }
     }
   }
-  root->ensureLineBreak();
-  root->appendChild("attach", SExpression::createToken("off"));
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.appendToken("attach", "off");
+  return out.getData();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genNetwork() const {
-  std::unique_ptr<SExpression> root = SExpression::createList("network");
+void BoardSpecctraExport::genNetwork(DsnWriter& out) const {
+  out.beginList("network");
   for (const auto& net : mBoard.getProject().getCircuit().getNetSignals()) {
-    root->ensureLineBreak();
-    auto& netNode = root->appendList("net");
-    netNode.appendChild(net->getName());
-    netNode.ensureLineBreak();
-    auto& pinsNode = netNode.appendList("pins");
+    out.ensureLineBreak();
+    out.beginList("net");
+    out.appendString(*net->getName());
+    out.ensureLineBreak();
+    out.beginList("pins");
     for (const auto& cmpSig : net->getComponentSignals()) {
       const QString cmpName = *cmpSig->getComponentInstance().getName();
       for (const auto& pad : cmpSig->getRegisteredFootprintPads()) {
         const QString padId = pad->getLibPadUuid().toStr().replace("-", "");
-        pinsNode.ensureLineBreak();
-        pinsNode.appendChild(SExpression::createToken(cmpName + "-" + padId));
+        out.ensureLineBreak();
+        out.appendToken(cmpName + "-" + padId);
       }
     }
-    pinsNode.ensureLineBreak();
-    netNode.ensureLineBreak();
+    out.ensureLineBreak();
+    out.endList();
+    out.ensureLineBreak();
+    out.endList();
   }
 
   // For net segments without a net, add a separate dummy net for each of them.
   for (const auto& segment : mBoard.getNetSegments()) {
     if (!segment->getNetSignal()) {
-      root->ensureLineBreak();
-      auto& netNode = root->appendList("net");
-      netNode.appendChild(getNetName(*segment));
+      out.ensureLineBreak();
+      out.appendString("net", getNetName(*segment));
     }
   }
 
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genWiring() const {
+void BoardSpecctraExport::genWiring(DsnWriter& out) const {
   // Not sure if required, but let's export all wires first, then all vias.
-  std::unique_ptr<SExpression> root = SExpression::createList("wiring");
+  out.beginList("wiring");
   for (const auto& segment : mBoard.getNetSegments()) {
+    const QString netName = getNetName(*segment);
     for (const auto& trace : segment->getNetLines()) {
-      root->ensureLineBreak();
-      auto& wireNode = root->appendList("wire");
-      wireNode.appendChild(toPath(
-          trace->getLayer().getId(), positiveToUnsigned(trace->getWidth()),
-          Path::line(trace->getStartPoint().getPosition(),
-                     trace->getEndPoint().getPosition()),
-          false));
-      wireNode.appendChild("net", getNetName(*segment));
-      wireNode.appendChild("type", SExpression::createToken("route"));
+      out.ensureLineBreak();
+      out.beginList("wire");
+      writePath(out, trace->getLayer().getId(),
+                positiveToUnsigned(trace->getWidth()),
+                Path::line(trace->getStartPoint().getPosition(),
+                           trace->getEndPoint().getPosition()),
+                false);
+      out.appendString("net", netName);
+      out.appendToken("type", "route");
+      out.endList();
     }
   }
   for (const auto& segment : mBoard.getNetSegments()) {
+    const QString netName = getNetName(*segment);
     for (const auto& via : segment->getVias()) {
-      root->ensureLineBreak();
-      auto& viaNode = root->appendList("via");
-      viaNode.appendChild(getWiringPadStackId(*via));
-      viaNode.appendChild(toToken(via->getPosition().getX()));
-      viaNode.appendChild(toToken(via->getPosition().getY()));
-      viaNode.appendChild("net", getNetName(*segment));
-      viaNode.appendChild("type", SExpression::createToken("route"));
+      out.ensureLineBreak();
+      out.beginList("via");
+      out.appendString(getWiringPadStackId(*via));
+      out.appendToken(via->getPosition().getX());
+      out.appendToken(via->getPosition().getY());
+      out.appendString("net", netName);
+      out.appendToken("type", "route");
+      out.endList();
     }
   }
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::genWiringPadStack(
-    const BI_Via& via) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("padstack");
-  root->appendChild(getWiringPadStackId(via));
+void BoardSpecctraExport::genWiringPadStack(DsnWriter& out, const QString& id,
+                                            const BI_Via& via) const {
+  out.beginList("padstack");
+  out.appendString(id);
   QList<const Layer*> layers = Toolbox::sortedQSet(
       mBoard.getCopperLayers(), [](const Layer* a, const Layer* b) {
         return a->getCopperNumber() < b->getCopperNumber();
       });
   for (const Layer* layer : layers) {
     if (via.getVia().isOnLayer(*layer)) {
-      root->ensureLineBreak();
-      auto& node = root->appendList("shape");
-      node.appendChild(toCircle(layer->getId(), via.getSize()));
+      out.ensureLineBreak();
+      out.beginList("shape");
+      writeCircle(out, layer->getId(), via.getSize());
+      out.endList();
     }
   }
-  root->ensureLineBreak();
-  root->appendChild("attach", SExpression::createToken("off"));
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.appendToken("attach", "off");
+  out.ensureLineBreak();
+  out.endList();
 }
 
 QString BoardSpecctraExport::getWiringPadStackId(const BI_Via& via) const {
@@ -598,28 +723,28 @@ QString BoardSpecctraExport::getWiringPadStackId(const BI_Via& via) const {
 }
 
 template <typename THole>
-std::unique_ptr<SExpression> BoardSpecctraExport::toKeepout(
-    const QString& id, const THole& hole) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("keepout");
-  root->appendChild(id);
-  root->ensureLineBreak();
+void BoardSpecctraExport::writeKeepout(DsnWriter& out, const QString& id,
+                                       const THole& hole) const {
+  out.beginList("keepout");
+  out.appendString(id);
+  out.ensureLineBreak();
   const PositiveLength width(
       hole.getDiameter() +
       mBoard.getDrcSettings().getMinCopperNpthClearance() * 2);
   if (hole.isSlot()) {
-    root->appendChild(
-        toPath("signal", positiveToUnsigned(width), *hole.getPath(), true));
+    writePath(out, "signal", positiveToUnsigned(width), *hole.getPath(),
+              true);
   } else {
-    root->appendChild(toCircle("signal", width,
-                               hole.getPath()->getVertices().first().getPos()));
+    writeCircle(out, "signal", width,
+                hole.getPath()->getVertices().first().getPos());
   }
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::toKeepout(
-    const QString& id, const Path& path,
-    const QSet<const Layer*>& layers) const {
+void BoardSpecctraExport::writeKeepout(DsnWriter& out, const QString& id,
+                                       const Path& path,
+                                       const QSet<const Layer*>& layers) const {
   const Length offset =
       *mBoard.getDrcSettings().getMinCopperBoardClearance() + maxArcTolerance();
   ClipperLib::Paths paths{ClipperHelpers::convert(path, maxArcTolerance())};
@@ -639,58 +764,52 @@ std::unique_ptr<SExpression> BoardSpecctraExport::toKeepout(
     layersSorted.append(nullptr);  // All layers.
   }
 
-  std::unique_ptr<SExpression> root = SExpression::createList("keepout");
-  root->appendChild(id);
+  const Path outline = ClipperHelpers::convert(paths.at(0));
+  out.beginList("keepout");
+  out.appendString(id);
   for (const Layer* layer : layersSorted) {
-    root->ensureLineBreak();
-    root->appendChild(toPolygon(layer ? layer->getId() : "signal",
-                                UnsignedLength(0),
-                                ClipperHelpers::convert(paths.at(0)), true));
+    out.ensureLineBreak();
+    writePolygon(out, layer ? layer->getId() : "signal", UnsignedLength(0),
+                 outline, true);
   }
-  root->ensureLineBreak();
-  return root;
+  out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::toPolygon(
-    const QString& layer, const UnsignedLength& width, const Path& path,
-    bool multiline) const {
-  std::unique_ptr<SExpression> root = toPath(layer, width, path, multiline);
-  root->setName("polygon");
-  return root;
+void BoardSpecctraExport::writePolygon(DsnWriter& out, const QString& layer,
+                                       const UnsignedLength& width,
+                                       const Path& path, bool multiline) const {
+  writePath(out, layer, width, path, multiline, "polygon");
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::toPath(
-    const QString& layer, const UnsignedLength& width, const Path& path,
-    bool multiline) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("path");
-  root->appendChild(SExpression::createToken(layer));
-  root->appendChild(toToken(*width));
+void BoardSpecctraExport::writePath(DsnWriter& out, const QString& layer,
+                                    const UnsignedLength& width,
+                                    const Path& path, bool multiline,
+                                    const QString& name) const {
+  out.beginList(name);
+  out.appendToken(layer);
+  out.appendToken(*width);
   const Path flattenedPath = path.flattenedArcs(PositiveLength(5000));
-  foreach (const auto& vertex, flattenedPath.getVertices()) {
-    if (multiline) root->ensureLineBreak();
-    root->appendChild(toToken(vertex.getPos().getX()));
-    root->appendChild(toToken(vertex.getPos().getY()));
+  for (const auto& vertex : flattenedPath.getVertices()) {
+    if (multiline) out.ensureLineBreak();
+    out.appendToken(vertex.getPos().getX());
+    out.appendToken(vertex.getPos().getY());
   }
-  if (multiline) root->ensureLineBreak();
-  return root;
+  if (multiline) out.ensureLineBreak();
+  out.endList();
 }
 
-std::unique_ptr<SExpression> BoardSpecctraExport::toCircle(
-    const QString& layer, const PositiveLength& diameter,
-    const Point& pos) const {
-  std::unique_ptr<SExpression> root = SExpression::createList("circle");
-  root->appendChild(SExpression::createToken(layer));
-  root->appendChild(toToken(*diameter));
+void BoardSpecctraExport::writeCircle(DsnWriter& out, const QString& layer,
+                                      const PositiveLength& diameter,
+                                      const Point& pos) const {
+  out.beginList("circle");
+  out.appendToken(layer);
+  out.appendToken(*diameter);
   if (!pos.isOrigin()) {
-    root->appendChild(toToken(pos.getX()));
-    root->appendChild(toToken(pos.getY()));
+    out.appendToken(pos.getX());
+    out.appendToken(pos.getY());
   }
-  return root;
-}
-
-std::unique_ptr<SExpression> BoardSpecctraExport::toToken(
-    const Length& length) const {
-  return SExpression::createToken(length.toMmString());
+  out.endList();
 }
 
 QString BoardSpecctraExport::getNetName(const BI_NetSegment& ns) noexcept {
@@ -702,16 +821,13 @@ QString BoardSpecctraExport::getNetName(const BI_NetSegment& ns) noexcept {
   }
 }
 
-std::size_t BoardSpecctraExport::addToPadStacks(
-    std::vector<std::unique_ptr<SExpression>>& padStacks,
-    std::unique_ptr<SExpression> padStack) {
-  for (std::size_t i = 0; i < padStacks.size(); ++i) {
-    if (*padStacks.at(i) == *padStack) {
-      return i;
-    }
+std::size_t BoardSpecctraExport::addToPadStacks(FootprintPadStacks& padStacks,
+                                                const QByteArray& padStack) {
+  auto it = padStacks.constFind(padStack);
+  if (it == padStacks.constEnd()) {
+    it = padStacks.insert(padStack, padStacks.count());
   }
-  padStacks.emplace_back(std::move(padStack));
-  return padStacks.size() - 1;
+  return it.value();
 }
 
 /*******************************************************************************
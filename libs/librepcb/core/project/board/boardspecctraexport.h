@@ -27,9 +27,7 @@
 
 #include <QtCore>
 
-#include <map>
 #include <memory>
-#include <vector>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -45,7 +43,6 @@ class Hole;
 class Layer;
 class Path;
 class Point;
-class SExpression;
 
 /*******************************************************************************
  *  Class BoardSpecctraExport
@@ -53,6 +50,11 @@ class SExpression;
 
 /**
  * @brief Specctra DSN Export
+ *
+ * The DSN file is streamed directly into the output buffer while walking
+ * through the board, without building an ::librepcb::SExpression tree
+ * first. The output is formatted exactly like an ::librepcb::SExpression
+ * serialized in ::librepcb::SExpression::Mode::Permissive.
  */
 class BoardSpecctraExport final : public QObject {
   Q_OBJECT
@@ -71,46 +73,46 @@ public:
   BoardSpecctraExport& operator=(const BoardSpecctraExport& rhs) = delete;
 
 private:
-  std::unique_ptr<SExpression> genParser() const;
-  std::unique_ptr<SExpression> genResolution() const;
-  std::unique_ptr<SExpression> genStructure(
-      std::vector<std::unique_ptr<SExpression>>& viaPadStacks) const;
-  std::unique_ptr<SExpression> genStructureRule() const;
-  std::unique_ptr<SExpression> genPlacement() const;
-  std::unique_ptr<SExpression> genLibrary(
-      std::vector<std::unique_ptr<SExpression>>& fptPadStacks,
-      std::vector<std::unique_ptr<SExpression>>& viaPadStacks) const;
-  std::unique_ptr<SExpression> genLibraryImage(
-      const BI_Device& dev,
-      std::vector<std::unique_ptr<SExpression>>& fptPadStacks) const;
-  std::unique_ptr<SExpression> genLibraryPadStack(
-      const BI_FootprintPad& pad) const;
-  std::unique_ptr<SExpression> genNetwork() const;
-  std::unique_ptr<SExpression> genWiring() const;
-  std::unique_ptr<SExpression> genWiringPadStack(const BI_Via& via) const;
+  class DsnWriter;
+
+  /// Via pad stack IDs with one via of each pad stack
+  typedef QList<std::pair<QString, const BI_Via*>> ViaPadStacks;
+
+  /// Serialized footprint pad stacks mapped to their index
+  typedef QHash<QByteArray, std::size_t> FootprintPadStacks;
+
+  void genParser(DsnWriter& out) const;
+  void genResolution(DsnWriter& out) const;
+  void genStructure(DsnWriter& out, const ViaPadStacks& viaPadStacks) const;
+  void genStructureRule(DsnWriter& out) const;
+  void genPlacement(DsnWriter& out) const;
+  void genLibrary(DsnWriter& out, const ViaPadStacks& viaPadStacks) const;
+  void genLibraryImage(DsnWriter& out, const BI_Device& dev,
+                       FootprintPadStacks& fptPadStacks) const;
+  QByteArray genLibraryPadStack(const BI_FootprintPad& pad) const;
+  void genNetwork(DsnWriter& out) const;
+  void genWiring(DsnWriter& out) const;
+  void genWiringPadStack(DsnWriter& out, const QString& id,
+                         const BI_Via& via) const;
   QString getWiringPadStackId(const BI_Via& via) const;
 
   template <typename THole>
-  std::unique_ptr<SExpression> toKeepout(const QString& id,
-                                         const THole& hole) const;
-  std::unique_ptr<SExpression> toKeepout(
-      const QString& id, const Path& path,
-      const QSet<const Layer*>& layers) const;
-  std::unique_ptr<SExpression> toPolygon(const QString& layer,
-                                         const UnsignedLength& width,
-                                         const Path& path,
-                                         bool multiline) const;
-  std::unique_ptr<SExpression> toPath(const QString& layer,
-                                      const UnsignedLength& width,
-                                      const Path& path, bool multiline) const;
-  std::unique_ptr<SExpression> toCircle(const QString& layer,
-                                        const PositiveLength& diameter,
-                                        const Point& pos = Point()) const;
-  std::unique_ptr<SExpression> toToken(const Length& length) const;
+  void writeKeepout(DsnWriter& out, const QString& id,
+                    const THole& hole) const;
+  void writeKeepout(DsnWriter& out, const QString& id, const Path& path,
+                    const QSet<const Layer*>& layers) const;
+  void writePolygon(DsnWriter& out, const QString& layer,
+                    const UnsignedLength& width, const Path& path,
+                    bool multiline) const;
+  void writePath(DsnWriter& out, const QString& layer,
+                 const UnsignedLength& width, const Path& path,
+                 bool multiline, const QString& name = "path") const;
+  void writeCircle(DsnWriter& out, const QString& layer,
+                   const PositiveLength& diameter,
+                   const Point& pos = Point()) const;
   static QString getNetName(const BI_NetSegment& ns) noexcept;
-  static std::size_t addToPadStacks(
-      std::vector<std::unique_ptr<SExpression>>& padStacks,
-      std::unique_ptr<SExpression> padStack);
+  static std::size_t addToPadStacks(FootprintPadStacks& padStacks,
+                                    const QByteArray& padStack);
 
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs.
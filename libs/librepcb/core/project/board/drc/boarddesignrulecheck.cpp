@@ -40,12 +40,24 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class BoardDesignRuleCheck::Result
+ ******************************************************************************/
+
+bool BoardDesignRuleCheck::Result::applyPlanesToBoard() const noexcept {
+  if (planes && planes->applyToBoard() && planes->board) {
+    planes->board->forceAirWiresRebuild();
+    return true;
+  }
+  return false;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 BoardDesignRuleCheck::BoardDesignRuleCheck(QObject* parent) noexcept
-  : QObject(parent) {
+  : QObject(parent), mPlaneBuilder(new BoardPlaneFragmentsBuilder()) {
 }
 
 BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
@@ -69,33 +81,22 @@ void BoardDesignRuleCheck::start(Board& board,
   auto timer = std::make_shared<QElapsedTimer>();
   timer->start();
 
-  // Force rebuilding planes. Not parallelized with DRC check yet because
-  // it's very tricky. Planes haven an impact on air wires which we have
-  // to collect right now as the board cannot be accessed later from a thread.
+  // Start rebuilding planes in a separate thread. Only the jobs depending
+  // on planes (or air wires, which depend on planes too) will wait for the
+  // result, all other jobs are started immediately.
+  bool rebuildingPlanes = false;
   if (!quick) {
-    emitStatus(tr("Rebuild planes..."));
-    BoardPlaneFragmentsBuilder builder;
-    if (builder.start(board)) {
-      BoardPlaneFragmentsBuilder::Result result = builder.waitForFinished();
-      result.applyToBoard();
-    }
+    rebuildingPlanes = mPlaneBuilder->start(board);
   }
-  emitProgress(7);
-
-  // The "checkForMissingConnections()" check requires up-to-date airwires,
-  // but this has not been parallelized yet so we have to run it synchronously
-  // in the main thread now.
-  if (!quick) {
-    board.forceAirWiresRebuild();
-  }
-  emitProgress(10);
+  emitProgress(5);
 
   // Copy all relevant data for thread-safe access.
   std::shared_ptr<Data> data = std::make_shared<Data>(board, settings, quick);
-  emitProgress(12);
+  emitProgress(10);
 
   // Pass data to new thread.
-  mFuture = QtConcurrent::run(&BoardDesignRuleCheck::run, this, data, timer);
+  mFuture = QtConcurrent::run(&BoardDesignRuleCheck::run, this, data, timer,
+                              rebuildingPlanes);
 }
 
 bool BoardDesignRuleCheck::isRunning() const noexcept {
@@ -116,6 +117,7 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::waitForFinished()
 
 void BoardDesignRuleCheck::cancel() noexcept {
   mAbort = true;
+  mPlaneBuilder->cancel();
   mFuture.waitForFinished();
   mAbort = false;
 }
@@ -147,8 +149,8 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::tryRunJob(
 }
 
 BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
-    std::shared_ptr<const Data> data,
-    std::shared_ptr<QElapsedTimer> timer) noexcept {
+    std::shared_ptr<Data> data, std::shared_ptr<QElapsedTimer> timer,
+    bool rebuildingPlanes) noexcept {
   emitProgress(15);
 
   // Prepare calculated job data.
@@ -157,53 +159,75 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
 
   // Jobs are organized and run in the following way:
   //
+  // - Planes are rebuilt in a separate thread, started together with the DRC.
+  //   Jobs depending on planes (or on air wires, which are calculated from
+  //   planes) must not be started before the planes are finished.
   // - A subset of jobs, called "stage 1", is run in parallel to calculate data
   //   which other jobs depend on (e.g. copper areas on each layer).
   // - Jobs depending on this data, called "stage 2", are started after all
   //   jobs of stage 1 completed. Stage 2 jobs are run in parallel then too.
   // - A third set of jobs, called "independent", does not depend on stage 1
-  //   jobs output data and is thus run in parallel to stage 1 & 2 jobs.
+  //   jobs output data and is thus run in parallel to stage 1 & 2 jobs. Those
+  //   not depending on planes are started immediately.
   // - Very trivial (CPU inexpensive) jobs are run sequentially in this thread
-  //   to avoid spawning a large amount of threads. They are run sequentially,
-  //   but in parallel to stage 2 jobs since this thread has no other work to
-  //   do then.
+  //   to avoid spawning a large amount of threads. Those not depending on
+  //   planes are run while waiting for the planes, the others are run in
+  //   parallel to stage 2 jobs since this thread has no other work to do then.
   //
-  //        ▲                           ┌────────────────────────────────┐
-  //        │                         ┌►│        Independent jobs        │
-  //        │                         │ └────────────────────────────────┤
-  // Threads│                         │                                  │
-  //  2..n  │                         │ ┌────────────┐   ┌───────────────┤
-  //        │                         ├►│Stage 1 jobs│ ┌►│ Stage 2 jobs  │
-  //        │                         │ └────────────┤ │ └───────────────┤
-  //        │                         │              ▼ │                 │
-  //        │              ┌──────────┤              ┌─┤ ┌───────────────┤
-  //  run() │            ┌►│Spawn jobs│--------------│ ├►│Sequential jobs│
-  // Thread │            │ └──────────┘              └─┘ └───────────────┤
-  //        │            │                                               ▼
-  //        │ ┌──────────┤                                               ┌───┐
-  //  Main  │ │Copy board│-----------------------------------------------│End│
-  // Thread │ └──────────┘                                               └───┘
+  //        ▲           ┌─────────────────────────────────────────────────┐
+  //        │         ┌►│    Independent jobs (not depending on planes)   │
+  //        │         │ └─────────────────────────────────────────────────┤
+  //        │         │ ┌──────────────┐  ┌───────────────────────────────┤
+  // Threads│         ├►│Rebuild planes│┌►│Independent jobs (with planes) │
+  //  2..n  │         │ └──────────────┤│ └───────────────────────────────┤
+  //        │         │                ││ ┌────────────┐   ┌──────────────┤
+  //        │         │                │├►│Stage 1 jobs│ ┌►│ Stage 2 jobs │
+  //        │         │                ││ └────────────┤ │ └──────────────┤
+  //        │         │                ▼│              ▼ │                │
+  //        │         │ ┌──────────────┬┤              ┌─┤ ┌──────────────┤
+  //  run() │       ┌─┴►│  Seq. jobs   ││--------------│ ├►│  Seq. jobs   │
+  // Thread │       │   │ & air wires  ││              │ │ │              │
+  //        │       │   └──────────────┴┘              └─┘ └──────────────┤
+  //        │       │                                                     ▼
+  //        │ ┌─────┴───┐                                               ┌───┐
+  //  Main  │ │Copy data│-----------------------------------------------│End│
+  // Thread │ └─────────┘                                               └───┘
   //        └────────────────────────────────────────────────────────────────► t
 
   // Data structure and helpers to define the job list.
   enum class Stage { Independent, Stage1, Stage2, Sequential };
+  typedef std::function<RuleCheckMessageList(const Data&)> DataJobFunc;
   struct Job {
     BoardDesignRuleCheck* drc;
-    JobFunc function;
+    DataJobFunc function;
     Stage stage;
+    bool requiresPlanes;
     int weight = 1;
     QFuture<Result> future;
 
-    Job(BoardDesignRuleCheck* drc, JobFunc function, Stage stage, int weight)
-      : drc(drc), function(function), stage(stage), weight(weight), future() {}
-    void run(Result& result) {
-      const Result jobResult = drc->tryRunJob(function, weight);
+    Job(BoardDesignRuleCheck* drc, DataJobFunc function, Stage stage,
+        bool requiresPlanes, int weight)
+      : drc(drc),
+        function(function),
+        stage(stage),
+        requiresPlanes(requiresPlanes),
+        weight(weight),
+        future() {}
+    void run(std::shared_ptr<const Data> data, Result& result) {
+      // Run synchronously, so we don't need to copy the data structure.
+      const DataJobFunc func = function;
+      const Result jobResult =
+          drc->tryRunJob([func, data]() { return func(*data); }, weight);
       result.messages.append(jobResult.messages);
       result.errors.append(jobResult.errors);
     }
-    void start() {
+    void start(std::shared_ptr<const Data> data) {
+      // Run in other thread, so we have to copy the whole data structure.
+      auto jobData = std::make_shared<const Data>(*data);
+      const DataJobFunc func = function;
+      const JobFunc jobFunc = [func, jobData]() { return func(*jobData); };
       future = QtConcurrent::run(
-          std::bind(&BoardDesignRuleCheck::tryRunJob, drc, function, weight));
+          std::bind(&BoardDesignRuleCheck::tryRunJob, drc, jobFunc, weight));
     }
     void fetchResult(Result& result) {
       const Result jobResult = future.result();
@@ -213,41 +237,36 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
   };
   QList<Job> jobs;
   auto addToStage1 = [&](Stage1Func func, int weight) {
-    // Run in other thread, so we have to copy the whole data structure.
-    auto jobData = std::make_shared<const Data>(*data);
     jobs.append(Job(
         this,
-        [func, jobData, calcData]() {
-          func(*jobData, *calcData);
+        [func, calcData](const Data& data) {
+          func(data, *calcData);
           return RuleCheckMessageList();
         },
-        Stage::Stage1, weight));
+        Stage::Stage1, true, weight));
   };
   auto addToStage2 = [&](Stage2Func func, int weight) {
-    // Run in other thread, so we have to copy the whole data structure.
-    auto jobData = std::make_shared<const Data>(*data);
     jobs.append(Job(
         this,
-        [this, func, jobData, calcData]() {
-          return (this->*func)(*jobData, *calcData);
+        [this, func, calcData](const Data& data) {
+          return (this->*func)(data, *calcData);
         },
-        Stage::Stage2, weight));
+        Stage::Stage2, true, weight));
   };
-  auto addIndependent = [&](IndependentStageFunc func, int weight) {
-    // Run in other thread, so we have to copy the whole data structure.
-    auto jobData = std::make_shared<const Data>(*data);
+  auto addIndependent = [&](IndependentStageFunc func, int weight,
+                            bool requiresPlanes) {
     jobs.append(Job(
-        this, [this, func, jobData]() { return (this->*func)(*jobData); },
-        Stage::Independent, weight));
+        this, [this, func](const Data& data) { return (this->*func)(data); },
+        Stage::Independent, requiresPlanes, weight));
   };
-  auto addSequential = [&](IndependentStageFunc func) {
-    // Run synchronously, so we don't need to copy the data structure.
+  auto addSequential = [&](IndependentStageFunc func, bool requiresPlanes) {
     jobs.append(Job(
-        this, [this, func, data]() { return (this->*func)(*data); },
-        Stage::Sequential, 1));
+        this, [this, func](const Data& data) { return (this->*func)(data); },
+        Stage::Sequential, requiresPlanes, 1));
   };
 
-  // Determine jobs to execute, in the order how they should be started.
+  // Determine jobs to execute, in the order how they should be started. The
+  // last argument specifies whether a job depends on planes or air wires.
   for (const Layer* layer : data->copperLayers) {
     // Calculate copper paths for each layer.
     addToStage1(
@@ -261,32 +280,34 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
   if (!data->quick) {
     addToStage2(&BoardDesignRuleCheck::checkMinimumPthAnnularRing, 2);
   }
-  addIndependent(&BoardDesignRuleCheck::checkCopperCopperClearances, 5);
-  addIndependent(&BoardDesignRuleCheck::checkCopperBoardClearances, 3);
+  addIndependent(&BoardDesignRuleCheck::checkCopperCopperClearances, 5, true);
+  addIndependent(&BoardDesignRuleCheck::checkCopperBoardClearances, 3, true);
   if (!data->quick) {
-    addIndependent(&BoardDesignRuleCheck::checkDrillDrillClearances, 2);
-    addIndependent(&BoardDesignRuleCheck::checkDrillBoardClearances, 2);
-    addIndependent(&BoardDesignRuleCheck::checkSilkscreenStopmaskClearances, 2);
-    addIndependent(&BoardDesignRuleCheck::checkZones, 2);
-    addIndependent(&BoardDesignRuleCheck::checkInvalidPadConnections, 2);
-    addIndependent(&BoardDesignRuleCheck::checkDeviceClearances, 2);
-    addIndependent(&BoardDesignRuleCheck::checkBoardOutline, 1);
-    addIndependent(&BoardDesignRuleCheck::checkVias, 1);
-  }
-  addSequential(&BoardDesignRuleCheck::checkMinimumCopperWidth);
+    addIndependent(&BoardDesignRuleCheck::checkDrillDrillClearances, 2, false);
+    addIndependent(&BoardDesignRuleCheck::checkDrillBoardClearances, 2, false);
+    addIndependent(&BoardDesignRuleCheck::checkSilkscreenStopmaskClearances, 2,
+                   false);
+    addIndependent(&BoardDesignRuleCheck::checkZones, 2, false);
+    addIndependent(&BoardDesignRuleCheck::checkInvalidPadConnections, 2, false);
+    addIndependent(&BoardDesignRuleCheck::checkDeviceClearances, 2, false);
+    addIndependent(&BoardDesignRuleCheck::checkBoardOutline, 1, false);
+    addIndependent(&BoardDesignRuleCheck::checkVias, 1, true);
+  }
+  addSequential(&BoardDesignRuleCheck::checkMinimumCopperWidth, true);
   if (!data->quick) {
-    addSequential(&BoardDesignRuleCheck::checkAllowedNpthSlots);
-    addSequential(&BoardDesignRuleCheck::checkAllowedPthSlots);
-    addSequential(&BoardDesignRuleCheck::checkUsedLayers);
-    addSequential(&BoardDesignRuleCheck::checkForUnplacedComponents);
-    addSequential(&BoardDesignRuleCheck::checkForMissingConnections);
-    addSequential(&BoardDesignRuleCheck::checkForStaleObjects);
-    addSequential(&BoardDesignRuleCheck::checkMinimumSilkscreenWidth);
-    addSequential(&BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight);
-    addSequential(&BoardDesignRuleCheck::checkMinimumNpthDrillDiameter);
-    addSequential(&BoardDesignRuleCheck::checkMinimumNpthSlotWidth);
-    addSequential(&BoardDesignRuleCheck::checkMinimumPthDrillDiameter);
-    addSequential(&BoardDesignRuleCheck::checkMinimumPthSlotWidth);
+    addSequential(&BoardDesignRuleCheck::checkAllowedNpthSlots, false);
+    addSequential(&BoardDesignRuleCheck::checkAllowedPthSlots, false);
+    addSequential(&BoardDesignRuleCheck::checkUsedLayers, true);
+    addSequential(&BoardDesignRuleCheck::checkForUnplacedComponents, false);
+    addSequential(&BoardDesignRuleCheck::checkForMissingConnections, true);
+    addSequential(&BoardDesignRuleCheck::checkForStaleObjects, false);
+    addSequential(&BoardDesignRuleCheck::checkMinimumSilkscreenWidth, false);
+    addSequential(&BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight,
+                  false);
+    addSequential(&BoardDesignRuleCheck::checkMinimumNpthDrillDiameter, false);
+    addSequential(&BoardDesignRuleCheck::checkMinimumNpthSlotWidth, false);
+    addSequential(&BoardDesignRuleCheck::checkMinimumPthDrillDiameter, false);
+    addSequential(&BoardDesignRuleCheck::checkMinimumPthSlotWidth, false);
   }
 
   // Calculate total jobs weight. After this, progress is determined by the
@@ -298,17 +319,57 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
   }
   emitProgress(20);
 
-  // Start all stage 1 & independent jobs. Stage 1 jobs are started first
-  // because they are at the front of the list.
+  // Start all independent jobs not depending on planes. They get a copy of
+  // the data before the planes are updated, which is fine since they don't
+  // access the planes.
   for (Job& job : jobs) {
-    if ((job.stage == Stage::Stage1) || (job.stage == Stage::Independent)) {
-      job.start();
+    if ((job.stage == Stage::Independent) && (!job.requiresPlanes)) {
+      job.start(data);
     }
   }
 
-  // Collect results of stage 1 jobs.
+  // Run all trivial jobs not depending on planes synchronously while the
+  // planes are being rebuilt.
   Result result;
   result.quick = data->quick;
+  for (Job& job : jobs) {
+    if ((job.stage == Stage::Sequential) && (!job.requiresPlanes)) {
+      job.run(data, result);
+    }
+  }
+
+  // Wait for the planes and update the data with the new fragments. Note
+  // that the already started jobs are not affected by this modification
+  // since they work on their own copy of the data.
+  if (rebuildingPlanes) {
+    emitStatus(tr("Rebuild planes..."));
+    result.planes = mPlaneBuilder->waitForFinished();
+    result.errors.append(result.planes->errors);
+    data->setPlaneFragments(result.planes->planes);
+  }
+
+  // The "checkForMissingConnections()" check requires up-to-date airwires,
+  // which we calculate from the copied data to not access the board.
+  if (!data->quick) {
+    emitStatus(tr("Calculate air wires..."));
+    try {
+      data->calculateAirWires();
+    } catch (const Exception& e) {
+      qCritical() << "Failed to calculate air wires:" << e.getMsg();
+      result.errors.append(e.getMsg());
+    }
+  }
+
+  // Start all stage 1 & remaining independent jobs. Stage 1 jobs are started
+  // first because they are at the front of the list.
+  for (Job& job : jobs) {
+    if ((job.stage == Stage::Stage1) ||
+        ((job.stage == Stage::Independent) && job.requiresPlanes)) {
+      job.start(data);
+    }
+  }
+
+  // Collect results of stage 1 jobs.
   for (Job& job : jobs) {
     if (job.stage == Stage::Stage1) {
       job.fetchResult(result);  // Blocks until finished.
@@ -318,14 +379,14 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
   // Start all stage 2 jobs.
   for (Job& job : jobs) {
     if (job.stage == Stage::Stage2) {
-      job.start();
+      job.start(data);
     }
   }
 
-  // Run all trivial jobs synchronously.
+  // Run all remaining trivial jobs synchronously.
   for (Job& job : jobs) {
-    if (job.stage == Stage::Sequential) {
-      job.run(result);
+    if ((job.stage == Stage::Sequential) && job.requiresPlanes) {
+      job.run(data, result);
     }
   }
 
@@ -2005,8 +2066,8 @@ RuleCheckMessageList BoardDesignRuleCheck::checkForMissingConnections(
     }
   };
 
-  // No check based on copper paths implemented yet -> return existing airwires
-  // instead (they have been rebuilt when starting the DRC).
+  // No check based on copper paths implemented yet -> return the airwires
+  // instead (they have been calculated before starting this job).
   RuleCheckMessageList messages;
   for (const Data::AirWire& aw : data.airWires) {
     const QVector<Path> locations{
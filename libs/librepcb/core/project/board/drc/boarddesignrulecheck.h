@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "../../../rulecheck/rulecheckmessage.h"
 #include "../../../utils/transform.h"
+#include "../boardplanefragmentsbuilder.h"
 #include "boarddesignrulecheckdata.h"
 
 #include <polyclipping/clipper.hpp>
@@ -66,6 +67,15 @@ public:
     QStringList errors;  // Empty on success.
     bool quick = false;
     qint64 elapsedTimeMs = 0;
+    std::optional<BoardPlaneFragmentsBuilder::Result> planes;  ///< Rebuilt
+
+    /// Apply the rebuilt planes (if any) to the board and rebuild its air
+    /// wires if any plane has been modified
+    ///
+    /// @attention Must be called in the thread the board belongs to.
+    ///
+    /// @return Whether any plane has been modified or not
+    bool applyPlanesToBoard() const noexcept;
   };
 
   // Constructors / Destructor
@@ -73,6 +83,23 @@ public:
   ~BoardDesignRuleCheck() noexcept;
 
   // General Methods
+
+  /**
+   * @brief Start the check asynchronously
+   *
+   * Only copies the board data and then returns immediately. For a full
+   * check, planes are rebuilt in a separate thread while all checks which
+   * do not depend on planes are already running. The calculated plane
+   * fragments are not applied to the board automatically since the board
+   * must not be modified from worker threads. Use
+   * ::librepcb::BoardDesignRuleCheck::Result::applyPlanesToBoard() in the
+   * main thread to apply them.
+   *
+   * @param board     The board to check.
+   * @param settings  The DRC settings to use.
+   * @param quick     If `true`, only a subset of checks is run and planes
+   *                  are not rebuilt.
+   */
   void start(Board& board, const BoardDesignRuleCheckSettings& settings,
              bool quick) noexcept;
 
@@ -105,8 +132,8 @@ private:  // Methods
       const Data&);
 
   Result tryRunJob(JobFunc function, int weight) noexcept;
-  Result run(std::shared_ptr<const Data> data,
-             std::shared_ptr<QElapsedTimer> timer) noexcept;
+  Result run(std::shared_ptr<Data> data, std::shared_ptr<QElapsedTimer> timer,
+             bool rebuildingPlanes) noexcept;
   void prepareCopperPaths(const Data& data, CalculatedJobData& calcData,
                           const Layer& layer);
   RuleCheckMessageList checkCopperCopperClearances(const Data& data);
@@ -172,6 +199,7 @@ private:  // Data
   int mProgressTotal = 0;  // Only for progress range 20..100%
   int mProgressCounter = 0;  // 0..mProgressTotal
   QFuture<Result> mFuture;
+  std::unique_ptr<BoardPlaneFragmentsBuilder> mPlaneBuilder;
   bool mAbort = false;
 };
 
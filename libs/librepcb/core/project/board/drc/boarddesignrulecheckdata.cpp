@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boarddesignrulecheckdata.h"
 
+#include "../../../exceptions.h"
 #include "../../../geometry/hole.h"
 #include "../../../geometry/stroketext.h"
 #include "../../../geometry/via.h"
@@ -29,13 +30,14 @@
 #include "../../../library/pkg/footprint.h"
 #include "../../../library/pkg/footprintpad.h"
 #include "../../../library/pkg/packagepad.h"
+#include "../../../types/layer.h"
 #include "../../../utils/clipperhelpers.h"
 #include "../../circuit/circuit.h"
 #include "../../circuit/componentinstance.h"
 #include "../../circuit/netsignal.h"
 #include "../../project.h"
 #include "../board.h"
-#include "../items/bi_airwire.h"
+#include "../boardairwiresbuilder.h"
 #include "../items/bi_device.h"
 #include "../items/bi_footprintpad.h"
 #include "../items/bi_hole.h"
@@ -67,6 +69,23 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
   copperLayers = board.getCopperLayers();
   silkscreenLayersTop = board.getSilkscreenLayersTop();
   silkscreenLayersBot = board.getSilkscreenLayersBot();
+  auto convertAnchor = [](const BI_NetLineAnchor& a) {
+    AirWireAnchor ret;
+    ret.position = a.getPosition();
+    if (const BI_FootprintPad* pad = dynamic_cast<const BI_FootprintPad*>(&a)) {
+      ret.device = pad->getDevice().getComponentInstanceUuid();
+      ret.pad = pad->getLibPadUuid();
+    } else if (const BI_NetPoint* np = dynamic_cast<const BI_NetPoint*>(&a)) {
+      ret.segment = np->getNetSegment().getUuid();
+      ret.junction = np->getUuid();
+    } else if (const BI_Via* via = dynamic_cast<const BI_Via*>(&a)) {
+      ret.segment = via->getNetSegment().getUuid();
+      ret.via = via->getUuid();
+    } else {
+      qCritical() << "Unknown anchor type, DRC will fail later.";
+    }
+    return ret;
+  };
   foreach (const BI_NetSegment* ns, board.getNetSegments()) {
     const NetSignal* net = ns->getNetSignal();
     Segment nsd{
@@ -78,14 +97,17 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
         {},
     };
     foreach (const BI_NetPoint* np, ns->getNetPoints()) {
-      nsd.junctions.insert(np->getUuid(),
-                           Junction{np->getUuid(), np->getPosition(),
-                                    np->getNetLines().count()});
+      nsd.junctions.insert(
+          np->getUuid(),
+          Junction{np->getUuid(), np->getPosition(), np->getNetLines().count(),
+                   np->getLayerOfTraces()});
     }
     foreach (const BI_NetLine* nl, ns->getNetLines()) {
       nsd.traces.append(Trace{nl->getUuid(), nl->getStartPoint().getPosition(),
                               nl->getEndPoint().getPosition(), nl->getWidth(),
-                              &nl->getLayer()});
+                              &nl->getLayer(),
+                              convertAnchor(nl->getStartPoint()),
+                              convertAnchor(nl->getEndPoint())});
     }
     foreach (const BI_Via* biVia, ns->getVias()) {
       QSet<const Layer*> connectedLayers;
@@ -173,6 +195,10 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
           pad->getLibPad().getCopperClearance(),
           net ? std::make_optional(net->getUuid()) : std::optional<Uuid>(),
           net ? *net->getName() : QString(),
+          pad->getLibPad().isTht() ? &Layer::topCopper()
+                                   : &pad->getSolderLayer(),
+          pad->getLibPad().isTht() ? &Layer::botCopper()
+                                   : &pad->getSolderLayer(),
       };
       for (const PadHole& hole : pad->getLibPad().getHoles()) {
         pd.holes.append(Hole{hole.getUuid(), hole.getDiameter(), hole.getPath(),
@@ -213,28 +239,6 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
     }
     devices.insert(dev->getComponentInstanceUuid(), dd);
   }
-  auto convertAnchor = [](const BI_NetLineAnchor& a) {
-    AirWireAnchor ret;
-    ret.position = a.getPosition();
-    if (const BI_FootprintPad* pad = dynamic_cast<const BI_FootprintPad*>(&a)) {
-      ret.device = pad->getDevice().getComponentInstanceUuid();
-      ret.pad = pad->getLibPadUuid();
-    } else if (const BI_NetPoint* np = dynamic_cast<const BI_NetPoint*>(&a)) {
-      ret.segment = np->getNetSegment().getUuid();
-      ret.junction = np->getUuid();
-    } else if (const BI_Via* via = dynamic_cast<const BI_Via*>(&a)) {
-      ret.segment = via->getNetSegment().getUuid();
-      ret.via = via->getUuid();
-    } else {
-      qCritical() << "Unknown anchor type, DRC will fail later.";
-    }
-    return ret;
-  };
-  foreach (const BI_AirWire* aw, board.getAirWires()) {
-    airWires.append(AirWire{convertAnchor(aw->getP1()),
-                            convertAnchor(aw->getP2()),
-                            *aw->getNetSignal().getName()});
-  }
   foreach (const ComponentInstance* cmp,
            board.getProject().getCircuit().getComponentInstances()) {
     // A bit unusual, but the actual check is already done here to avoid
@@ -247,6 +251,136 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
   }
 }
 
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardDesignRuleCheckData::setPlaneFragments(
+    const QHash<Uuid, QVector<Path>>& fragments) noexcept {
+  for (Plane& plane : planes) {
+    auto it = fragments.find(plane.uuid);
+    if (it != fragments.end()) {
+      plane.fragments = *it;
+    }
+  }
+}
+
+void BoardDesignRuleCheckData::calculateAirWires() {
+  // Group all connectable items by net. A QMap is used to get a deterministic
+  // order of the resulting air wires.
+  struct NetItems {
+    QString name;
+    QList<std::pair<const Device*, const Pad*>> pads;
+    QList<const Segment*> segments;
+    QList<const Plane*> planes;
+  };
+  QMap<Uuid, NetItems> nets;
+  for (const Device& device : devices) {
+    for (const Pad& pad : device.pads) {
+      if (pad.net) {
+        NetItems& net = nets[*pad.net];
+        net.name = pad.netName;
+        net.pads.append(std::make_pair(&device, &pad));
+      }
+    }
+  }
+  for (const Segment& segment : segments) {
+    if (segment.net) {
+      NetItems& net = nets[*segment.net];
+      net.name = segment.netName;
+      net.segments.append(&segment);
+    }
+  }
+  for (const Plane& plane : planes) {
+    if (plane.net) {
+      NetItems& net = nets[*plane.net];
+      net.name = plane.netName;
+      net.planes.append(&plane);
+    }
+  }
+
+  airWires.clear();
+  for (const NetItems& net : nets) {
+    QVector<BoardAirWiresBuilder::Anchor> points;
+    BoardAirWiresBuilder::Connections connections;
+    QVector<BoardAirWiresBuilder::Plane> netPlanes;
+
+    // Anchors by index, and map from (parent UUID, item UUID) to index
+    QVector<AirWireAnchor> anchors;
+    QHash<std::pair<Uuid, Uuid>, int> anchorIds;
+    auto getAnchorKey = [](const AirWireAnchor& a) {
+      if (a.device && a.pad) {
+        return std::make_pair(*a.device, *a.pad);
+      } else if (a.segment && a.junction) {
+        return std::make_pair(*a.segment, *a.junction);
+      } else if (a.segment && a.via) {
+        return std::make_pair(*a.segment, *a.via);
+      } else {
+        throw LogicError(__FILE__, __LINE__, "Invalid air wire anchor!");
+      }
+    };
+    auto addAnchor = [&](const AirWireAnchor& anchor, const Layer& startLayer,
+                         const Layer& endLayer) {
+      anchorIds[getAnchorKey(anchor)] = anchors.count();
+      points.append(BoardAirWiresBuilder::Anchor{anchor.position,
+                                                 startLayer.getCopperNumber(),
+                                                 endLayer.getCopperNumber()});
+      anchors.append(anchor);
+    };
+
+    // pads
+    for (const auto& pair : net.pads) {
+      AirWireAnchor anchor;
+      anchor.position = pair.second->position;
+      anchor.device = pair.first->uuid;
+      anchor.pad = pair.second->uuid;
+      addAnchor(anchor, *pair.second->startLayer, *pair.second->endLayer);
+    }
+
+    // vias, junctions, traces
+    for (const Segment* segment : net.segments) {
+      for (const Via& via : segment->vias) {
+        AirWireAnchor anchor;
+        anchor.position = via.position;
+        anchor.segment = segment->uuid;
+        anchor.via = via.uuid;
+        addAnchor(anchor, *via.startLayer, *via.endLayer);
+      }
+      for (const Junction& junction : segment->junctions) {
+        if (junction.layer) {
+          AirWireAnchor anchor;
+          anchor.position = junction.position;
+          anchor.segment = segment->uuid;
+          anchor.junction = junction.uuid;
+          addAnchor(anchor, *junction.layer, *junction.layer);
+        }
+      }
+      for (const Trace& trace : segment->traces) {
+        const int startId =
+            anchorIds.value(getAnchorKey(trace.startAnchor), -1);
+        const int endId = anchorIds.value(getAnchorKey(trace.endAnchor), -1);
+        if ((startId < 0) || (endId < 0)) {
+          throw LogicError(__FILE__, __LINE__, "Unknown trace anchor.");
+        }
+        connections.append(std::make_pair(startId, endId));
+      }
+    }
+
+    // planes
+    for (const Plane* plane : net.planes) {
+      netPlanes.append(BoardAirWiresBuilder::Plane{
+          plane->layer->getCopperNumber(), plane->fragments});
+    }
+
+    // Calculate the airwires and convert them back to the result type.
+    for (const auto& airWire :
+         BoardAirWiresBuilder::buildAirWires(points, connections, netPlanes)) {
+      airWires.append(AirWire{anchors.at(airWire.first),
+                              anchors.at(airWire.second), net.name});
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
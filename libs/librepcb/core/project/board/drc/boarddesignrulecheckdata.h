@@ -46,10 +46,19 @@ class Layer;
  * @brief Input data structure for ::librepcb::BoardDesignRuleCheck
  */
 struct BoardDesignRuleCheckData final {
+  struct AirWireAnchor {
+    Point position;
+    std::optional<Uuid> device;  // If it's a pad.
+    std::optional<Uuid> pad;  // If it's a pad.
+    std::optional<Uuid> segment;  // If it's a junction or via.
+    std::optional<Uuid> junction;  // If it's a junction.
+    std::optional<Uuid> via;  // If it's a via.
+  };
   struct Junction {
     Uuid uuid;
     Point position;
     qsizetype traces;
+    const Layer* layer;  // Layer of connected traces, nullptr if none.
   };
   struct Trace {
     Uuid uuid;
@@ -57,6 +66,8 @@ struct BoardDesignRuleCheckData final {
     Point endPosition;
     PositiveLength width;
     const Layer* layer;
+    AirWireAnchor startAnchor;
+    AirWireAnchor endAnchor;
   };
   struct Via {
     Uuid uuid;
@@ -81,14 +92,6 @@ struct BoardDesignRuleCheckData final {
     QList<Trace> traces;
     QHash<Uuid, Via> vias;
   };
-  struct AirWireAnchor {
-    Point position;
-    std::optional<Uuid> device;  // If it's a pad.
-    std::optional<Uuid> pad;  // If it's a pad.
-    std::optional<Uuid> segment;  // If it's a junction or via.
-    std::optional<Uuid> junction;  // If it's a junction.
-    std::optional<Uuid> via;  // If it's a via.
-  };
   struct AirWire {
     AirWireAnchor p1;
     AirWireAnchor p2;
@@ -153,6 +156,8 @@ struct BoardDesignRuleCheckData final {
     UnsignedLength copperClearance;
     std::optional<Uuid> net;
     QString netName;  // Empty if no net.
+    const Layer* startLayer;  // Copper layer span of electrical connection.
+    const Layer* endLayer;  // Copper layer span of electrical connection.
   };
   struct Device {
     Uuid uuid;
@@ -183,13 +188,34 @@ struct BoardDesignRuleCheckData final {
   QList<Hole> holes;
   QList<Zone> zones;
   QHash<Uuid, Device> devices;
-  QList<AirWire> airWires;
+  QList<AirWire> airWires;  // Only filled by #calculateAirWires().
   QMap<Uuid, QString> unplacedComponents;  // UUID and name.
 
   // Constructors / Destructor
   BoardDesignRuleCheckData(const Board& board,
                            const BoardDesignRuleCheckSettings& drcSettings,
                            bool quickCheck) noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Update the fragments of all planes
+   *
+   * @param fragments   Calculated plane fragments. Planes not contained in
+   *                    this map are not modified.
+   */
+  void setPlaneFragments(const QHash<Uuid, QVector<Path>>& fragments) noexcept;
+
+  /**
+   * @brief Calculate the air wires of all nets and store them in #airWires
+   *
+   * Uses the same algorithm as ::librepcb::BoardAirWiresBuilder, but only
+   * on the copied data so it can be called from any thread. Plane fragments
+   * should be up to date before calling this.
+   *
+   * @throws Exception in case of an internal error.
+   */
+  void calculateAirWires();
 };
 
 /*******************************************************************************
@@ -50,7 +50,8 @@ BI_StrokeText::BI_StrokeText(Board& board, const BoardStrokeTextData& data)
         mBoard.getDefaultFontName())),
     mDevice(nullptr) {
   // Connect to the "attributes changed" signal of the board.
-  connect(&mBoard, &Board::attributesChanged, this, &BI_StrokeText::updateText);
+  connect(&mBoard, &Board::attributesChanged, this,
+          &BI_StrokeText::attributesChanged);
 
   updateText();
 }
@@ -191,7 +192,7 @@ void BI_StrokeText::setDevice(BI_Device* device) noexcept {
 
   if (mDevice) {
     disconnect(mDevice, &BI_Device::attributesChanged, this,
-               &BI_StrokeText::updateText);
+               &BI_StrokeText::attributesChanged);
   }
 
   mDevice = device;
@@ -199,7 +200,7 @@ void BI_StrokeText::setDevice(BI_Device* device) noexcept {
   // Text might need to be updated if device attributes have changed.
   if (mDevice) {
     connect(mDevice, &BI_Device::attributesChanged, this,
-            &BI_StrokeText::updateText);
+            &BI_StrokeText::attributesChanged);
   }
 
   updateText();
@@ -225,12 +226,25 @@ void BI_StrokeText::removeFromBoard() {
  *  Private Methods
  ******************************************************************************/
 
+ProjectAttributeLookup BI_StrokeText::getAttributeLookup() const noexcept {
+  return mDevice ? ProjectAttributeLookup(
+                       *mDevice, mDevice->getParts(std::nullopt).value(0))
+                 : ProjectAttributeLookup(mBoard, nullptr);
+}
+
+void BI_StrokeText::attributesChanged() noexcept {
+  // Attribute changes are not reported per key, but re-evaluating only the
+  // keys this text depends on is much cheaper than a full substitution. Texts
+  // without any variables have no dependencies at all.
+  if (AttributeSubstitutor::dependenciesChanged(mTextDependencies,
+                                                getAttributeLookup())) {
+    updateText();
+  }
+}
+
 void BI_StrokeText::updateText() noexcept {
   const QString text = AttributeSubstitutor::substitute(
-      mData.getText(),
-      mDevice ? ProjectAttributeLookup(*mDevice,
-                                       mDevice->getParts(std::nullopt).value(0))
-              : ProjectAttributeLookup(mBoard, nullptr));
+      mData.getText(), getAttributeLookup(), nullptr, &mTextDependencies);
   if (text != mSubstitutedText) {
     mSubstitutedText = text;
     updatePaths();
@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../attribute/attributesubstitutor.h"
 #include "../../../utils/signalslot.h"
 #include "../boardstroketextdata.h"
 #include "bi_base.h"
@@ -37,6 +38,7 @@ namespace librepcb {
 class BI_Device;
 class Board;
 class Path;
+class ProjectAttributeLookup;
 class StrokeFont;
 
 /*******************************************************************************
@@ -100,6 +102,8 @@ public:
   BI_StrokeText& operator=(const BI_StrokeText& rhs) = delete;
 
 private:  // Methods
+  ProjectAttributeLookup getAttributeLookup() const noexcept;
+  void attributesChanged() noexcept;
   void updateText() noexcept;
   void updatePaths() noexcept;
   void invalidatePlanes(const Layer& layer) noexcept;
@@ -111,6 +115,7 @@ private:  // Data
 
   // Cached Attributes
   QString mSubstitutedText;
+  AttributeSubstitutor::Dependencies mTextDependencies;
   QVector<Path> mPaths;  ///< Without transformation (position/rotation/mirror)
 };
 
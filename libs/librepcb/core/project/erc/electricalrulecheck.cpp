@@ -22,19 +22,6 @@
  ******************************************************************************/
 #include "electricalrulecheck.h"
 
-#include "../../library/cmp/component.h"
-#include "../../library/cmp/componentsignal.h"
-#include "../circuit/circuit.h"
-#include "../circuit/componentinstance.h"
-#include "../circuit/componentsignalinstance.h"
-#include "../circuit/netclass.h"
-#include "../circuit/netsignal.h"
-#include "../project.h"
-#include "../schematic/items/si_netpoint.h"
-#include "../schematic/items/si_netsegment.h"
-#include "../schematic/items/si_symbol.h"
-#include "../schematic/items/si_symbolpin.h"
-#include "../schematic/schematic.h"
 #include "electricalrulecheckmessages.h"
 
 #include <QtCore>
@@ -48,8 +35,8 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-ElectricalRuleCheck::ElectricalRuleCheck(const Project& project) noexcept
-  : mProject(project) {
+ElectricalRuleCheck::ElectricalRuleCheck() noexcept
+  : mCache(), mCheckedObjectsCount(0) {
 }
 
 ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
@@ -59,142 +46,157 @@ ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
  *  General Methods
  ******************************************************************************/
 
-RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
-  mOpenNetSignals.clear();
-
+RuleCheckMessageList ElectricalRuleCheck::runChecks(const Data& data) noexcept {
+  mCheckedObjectsCount = 0;
+  Cache cache;
   RuleCheckMessageList msgs;
-  checkNetClasses(msgs);
-  checkNetSignals(msgs);
-  checkComponents(msgs);
-  checkSchematics(msgs);
-  return msgs;
-}
-
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
 
-void ElectricalRuleCheck::checkNetClasses(RuleCheckMessageList& msgs) const {
-  // Don't warn if there's only one netclass, as we need one to be used as
-  // default when adding a new wire.
-  if (mProject.getCircuit().getNetClasses().count() <= 1) {
-    return;
+  // Don't warn about unused net classes if there's only one netclass, as we
+  // need one to be used as default when adding a new wire.
+  if (data.netClasses.count() > 1) {
+    for (const Data::NetClass& nc : data.netClasses) {
+      check(
+          mCache.netClasses, cache.netClasses, nc.uuid, nc,
+          [&nc](RuleCheckMessageList& m) { checkNetClass(nc, m); }, msgs);
+    }
   }
 
-  foreach (const NetClass* netClass, mProject.getCircuit().getNetClasses()) {
-    if (!netClass->isUsed()) {
-      msgs.append(std::make_shared<ErcMsgUnusedNetClass>(*netClass));
+  QSet<Uuid> openNets;
+  for (const Data::NetSignal& net : data.netSignals) {
+    check(
+        mCache.netSignals, cache.netSignals, net.uuid, net,
+        [&net](RuleCheckMessageList& m) { checkNetSignal(net, m); }, msgs);
+    if (net.realComponentSignals < 2) {
+      openNets.insert(net.uuid);
     }
   }
-}
 
-void ElectricalRuleCheck::checkNetSignals(RuleCheckMessageList& msgs) const {
-  foreach (const NetSignal* net, mProject.getCircuit().getNetSignals()) {
-    // Raise a warning if the net signal is connected to less then two component
-    // signals. But do not count component signals of schematic-only components
-    // since these are just "virtual" connections, i.e. not represented by a
-    // real pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
-    const QList<ComponentSignalInstance*>& sigs = net->getComponentSignals();
-    int registeredRealComponentCount = sigs.count();
-    if (registeredRealComponentCount >= 2) {  // Optimization
-      foreach (const ComponentSignalInstance* sig, sigs) {
-        if (sig->getComponentInstance().getLibComponent().isSchematicOnly()) {
-          --registeredRealComponentCount;
-        }
-      }
+  for (const Data::Component& cmp : data.components) {
+    check(
+        mCache.components, cache.components, cmp.uuid, cmp,
+        [&cmp](RuleCheckMessageList& m) { checkComponent(cmp, m); }, msgs);
+  }
+
+  for (const Data::Schematic& schematic : data.schematics) {
+    for (const Data::Symbol& symbol : schematic.symbols) {
+      check(
+          mCache.symbols, cache.symbols,
+          std::make_pair(schematic.uuid, symbol.uuid), symbol,
+          [&](RuleCheckMessageList& m) { checkSymbol(schematic, symbol, m); },
+          msgs);
     }
-    if (registeredRealComponentCount < 2) {
-      mOpenNetSignals.insert(net);
-      msgs.append(std::make_shared<ErcMsgOpenNet>(*net));
+    for (const Data::NetSegment& segment : schematic.netSegments) {
+      const bool openNet = openNets.contains(segment.net);
+      check(
+          mCache.netSegments, cache.netSegments,
+          std::make_pair(schematic.uuid, segment.uuid),
+          std::make_pair(segment, openNet),
+          [&](RuleCheckMessageList& m) {
+            checkNetSegment(schematic, segment, openNet, m);
+          },
+          msgs);
     }
   }
+
+  // Only keep the objects of this run to release removed objects.
+  mCache = cache;
+  return msgs;
 }
 
-void ElectricalRuleCheck::checkComponents(RuleCheckMessageList& msgs) const {
-  foreach (const ComponentInstance* cmp,
-           mProject.getCircuit().getComponentInstances()) {
-    checkComponentSignals(*cmp, msgs);
-
-    // Check for unplaced gates.
-    for (const ComponentSymbolVariantItem& gate :
-         cmp->getSymbolVariant().getSymbolItems()) {
-      if (!cmp->getSymbols().contains(gate.getUuid())) {
-        if (gate.isRequired()) {
-          msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(*cmp, gate));
-        } else {
-          msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(*cmp, gate));
-        }
-      }
-    }
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+template <typename K, typename T>
+void ElectricalRuleCheck::check(
+    const QHash<K, CacheEntry<T>>& oldCache, QHash<K, CacheEntry<T>>& newCache,
+    const K& key, const T& data,
+    std::function<void(RuleCheckMessageList&)> func,
+    RuleCheckMessageList& msgs) noexcept {
+  RuleCheckMessageList objMsgs;
+  auto it = oldCache.constFind(key);
+  if ((it != oldCache.constEnd()) && (it->data == data)) {
+    objMsgs = it->messages;
+  } else {
+    func(objMsgs);
+    ++mCheckedObjectsCount;
   }
+  msgs.append(objMsgs);
+  newCache.insert(key, CacheEntry<T>{data, objMsgs});
 }
 
-void ElectricalRuleCheck::checkComponentSignals(
-    const ComponentInstance& cmp, RuleCheckMessageList& msgs) const {
-  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
-    // Check for forced net name conflict.
-    const QString netName =
-        sig->getNetSignal() ? (*sig->getNetSignal()->getName()) : QString();
-    if ((sig->getCompSignal().isRequired()) && (!sig->getNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(*sig));
-    } else if (sig->isNetSignalNameForced() &&
-               (sig->getForcedNetSignalName() != netName)) {
-      msgs.append(std::make_shared<ErcMsgForcedNetSignalNameConflict>(*sig));
-    }
+void ElectricalRuleCheck::checkNetClass(const Data::NetClass& netClass,
+                                        RuleCheckMessageList& msgs) noexcept {
+  if (!netClass.used) {
+    msgs.append(std::make_shared<ErcMsgUnusedNetClass>(netClass));
   }
 }
 
-void ElectricalRuleCheck::checkSchematics(RuleCheckMessageList& msgs) const {
-  foreach (const Schematic* schematic, mProject.getSchematics()) {
-    checkSymbols(*schematic, msgs);
-    checkNetSegments(*schematic, msgs);
+void ElectricalRuleCheck::checkNetSignal(const Data::NetSignal& net,
+                                         RuleCheckMessageList& msgs) noexcept {
+  // Raise a warning if the net signal is connected to less then two component
+  // signals. But do not count component signals of schematic-only components
+  // since these are just "virtual" connections, i.e. not represented by a
+  // real pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
+  if (net.realComponentSignals < 2) {
+    msgs.append(std::make_shared<ErcMsgOpenNet>(net));
   }
 }
 
-void ElectricalRuleCheck::checkSymbols(const Schematic& schematic,
-                                       RuleCheckMessageList& msgs) const {
-  foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
-    checkPins(*symbol, msgs);
+void ElectricalRuleCheck::checkComponent(const Data::Component& cmp,
+                                         RuleCheckMessageList& msgs) noexcept {
+  for (const Data::ComponentSignal& sig : cmp.componentSignals) {
+    // Check for forced net name conflict.
+    if (sig.required && (!sig.netName)) {
+      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(cmp, sig));
+    } else if (sig.forcedNetName &&
+               (*sig.forcedNetName != sig.netName.value_or(QString()))) {
+      msgs.append(
+          std::make_shared<ErcMsgForcedNetSignalNameConflict>(cmp, sig));
+    }
   }
-}
 
-void ElectricalRuleCheck::checkPins(const SI_Symbol& symbol,
-                                    RuleCheckMessageList& msgs) const {
-  foreach (const SI_SymbolPin* pin, symbol.getPins()) {
-    if ((pin->getNetLines().isEmpty()) && (pin->getCompSigInstNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(*pin));
+  // Check for unplaced gates.
+  for (const Data::Gate& gate : cmp.gates) {
+    if (!gate.placed) {
+      if (gate.required) {
+        msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(cmp, gate));
+      } else {
+        msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(cmp, gate));
+      }
     }
   }
 }
 
-void ElectricalRuleCheck::checkNetSegments(const Schematic& schematic,
-                                           RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetSegment* netSegment, schematic.getNetSegments()) {
-    checkNetPoints(*netSegment, msgs);
-
-    // If there are no net labels, check for any open wire. But only if there's
-    // no "open net" warning on the net raised, since this would be quite a
-    // duplicate warning.
-    if (netSegment->getNetLabels().isEmpty() &&
-        (!mOpenNetSignals.contains(&netSegment->getNetSignal()))) {
-      foreach (const SI_NetLine* netLine, netSegment->getNetLines()) {
-        if (netLine->getStartPoint().isOpen() ||
-            netLine->getEndPoint().isOpen()) {
-          msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(*netSegment));
-          break;
-        }
-      }
+void ElectricalRuleCheck::checkSymbol(const Data::Schematic& schematic,
+                                      const Data::Symbol& symbol,
+                                      RuleCheckMessageList& msgs) noexcept {
+  for (const Data::Pin& pin : symbol.pins) {
+    if ((!pin.hasWires) && pin.hasNet) {
+      msgs.append(
+          std::make_shared<ErcMsgConnectedPinWithoutWire>(schematic, symbol,
+                                                          pin));
     }
   }
 }
 
-void ElectricalRuleCheck::checkNetPoints(const SI_NetSegment& netSegment,
-                                         RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetPoint* netPoint, netSegment.getNetPoints()) {
-    if (netPoint->getNetLines().isEmpty()) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(*netPoint));
+void ElectricalRuleCheck::checkNetSegment(const Data::Schematic& schematic,
+                                          const Data::NetSegment& netSegment,
+                                          bool openNet,
+                                          RuleCheckMessageList& msgs) noexcept {
+  for (const Data::Junction& junction : netSegment.junctions) {
+    if (!junction.hasWires) {
+      msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(
+          schematic, netSegment, junction));
     }
   }
+
+  // If there are no net labels, check for any open wire. But only if there's
+  // no "open net" warning on the net raised, since this would be quite a
+  // duplicate warning.
+  if ((!netSegment.hasNetLabels) && (!openNet) && netSegment.hasOpenWire) {
+    msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(netSegment));
+  }
 }
 
 /*******************************************************************************
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "electricalrulecheckdata.h"
 
 #include <QtCore>
 
@@ -32,48 +33,97 @@
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class NetSignal;
-class Project;
-class SI_NetSegment;
-class SI_Symbol;
-class Schematic;
-
 /*******************************************************************************
  *  Class ElectricalRuleCheck
  ******************************************************************************/
 
 /**
- * @brief The ElectricalRuleCheck class checks a ::librepcb::Board for
- *        design rule violations
+ * @brief The ElectricalRuleCheck class checks a ::librepcb::Project for
+ *        electrical rule violations
+ *
+ * The check operates on a ::librepcb::ElectricalRuleCheckData snapshot, thus
+ * it can run in any thread. The messages of each checked object (net signal,
+ * component, symbol, ...) are kept together with the object's data. On
+ * subsequent runs, objects whose data has not changed are not checked again,
+ * their messages from the previous run are reused instead. The result is
+ * always identical to a check with a new object.
+ *
+ * @note This class is not thread-safe, i.e. #runChecks() must not be called
+ *       concurrently on the same object.
  */
 class ElectricalRuleCheck final {
 public:
+  // Types
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
-  explicit ElectricalRuleCheck(const Project& project) noexcept;
+  ElectricalRuleCheck() noexcept;
+  ElectricalRuleCheck(const ElectricalRuleCheck& other) = delete;
   ~ElectricalRuleCheck() noexcept;
 
+  // Getters
+
+  /**
+   * @brief Get the number of objects actually checked by the last run
+   *
+   * @return Number of objects which were not skipped due to being unmodified
+   */
+  int getCheckedObjectsCount() const noexcept { return mCheckedObjectsCount; }
+
   // General Methods
-  RuleCheckMessageList runChecks() const;
+
+  /**
+   * @brief Run the checks
+   *
+   * @param data  Snapshot of the project to check.
+   *
+   * @return All emitted messages
+   */
+  RuleCheckMessageList runChecks(const Data& data) noexcept;
+
+  // Operator Overloadings
+  ElectricalRuleCheck& operator=(const ElectricalRuleCheck& rhs) = delete;
+
+private:  // Types
+  template <typename T>
+  struct CacheEntry {
+    T data;
+    RuleCheckMessageList messages;
+  };
+  using SchematicItemKey = std::pair<Uuid, Uuid>;  // Schematic & item UUID.
+  using NetSegmentData = std::pair<Data::NetSegment, bool>;  // Bool: open net
+
+  struct Cache {
+    QHash<Uuid, CacheEntry<Data::NetClass>> netClasses;
+    QHash<Uuid, CacheEntry<Data::NetSignal>> netSignals;
+    QHash<Uuid, CacheEntry<Data::Component>> components;
+    QHash<SchematicItemKey, CacheEntry<Data::Symbol>> symbols;
+    QHash<SchematicItemKey, CacheEntry<NetSegmentData>> netSegments;
+  };
 
 private:  // Methods
-  void checkNetClasses(RuleCheckMessageList& msgs) const;
-  void checkNetSignals(RuleCheckMessageList& msgs) const;
-  void checkComponents(RuleCheckMessageList& msgs) const;
-  void checkComponentSignals(const ComponentInstance& cmp,
-                             RuleCheckMessageList& msgs) const;
-  void checkSchematics(RuleCheckMessageList& msgs) const;
-  void checkSymbols(const Schematic& schematic,
-                    RuleCheckMessageList& msgs) const;
-  void checkPins(const SI_Symbol& symbol, RuleCheckMessageList& msgs) const;
-  void checkNetSegments(const Schematic& schematic,
-                        RuleCheckMessageList& msgs) const;
-  void checkNetPoints(const SI_NetSegment& netSegment,
-                      RuleCheckMessageList& msgs) const;
+  template <typename K, typename T>
+  void check(const QHash<K, CacheEntry<T>>& oldCache,
+             QHash<K, CacheEntry<T>>& newCache, const K& key, const T& data,
+             std::function<void(RuleCheckMessageList&)> func,
+             RuleCheckMessageList& msgs) noexcept;
+  static void checkNetClass(const Data::NetClass& netClass,
+                            RuleCheckMessageList& msgs) noexcept;
+  static void checkNetSignal(const Data::NetSignal& net,
+                             RuleCheckMessageList& msgs) noexcept;
+  static void checkComponent(const Data::Component& cmp,
+                             RuleCheckMessageList& msgs) noexcept;
+  static void checkSymbol(const Data::Schematic& schematic,
+                          const Data::Symbol& symbol,
+                          RuleCheckMessageList& msgs) noexcept;
+  static void checkNetSegment(const Data::Schematic& schematic,
+                              const Data::NetSegment& netSegment,
+                              bool openNet,
+                              RuleCheckMessageList& msgs) noexcept;
 
 private:  // Data
-  const Project& mProject;
-  mutable QSet<const NetSignal*> mOpenNetSignals;
+  Cache mCache;
+  int mCheckedObjectsCount;
 };
 
 /*******************************************************************************
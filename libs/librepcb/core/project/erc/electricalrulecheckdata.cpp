@@ -0,0 +1,165 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "electricalrulecheckdata.h"
+
+#include "../../library/cmp/component.h"
+#include "../../library/cmp/componentsignal.h"
+#include "../circuit/circuit.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include "../project.h"
+#include "../schematic/items/si_netline.h"
+#include "../schematic/items/si_netpoint.h"
+#include "../schematic/items/si_netsegment.h"
+#include "../schematic/items/si_symbol.h"
+#include "../schematic/items/si_symbolpin.h"
+#include "../schematic/schematic.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ElectricalRuleCheckData::ElectricalRuleCheckData() noexcept {
+}
+
+ElectricalRuleCheckData::ElectricalRuleCheckData(
+    const Project& project) noexcept {
+  const Circuit& circuit = project.getCircuit();
+  foreach (const librepcb::NetClass* nc, circuit.getNetClasses()) {
+    netClasses.insert(nc->getUuid(), fromNetClass(*nc));
+  }
+  foreach (const librepcb::NetSignal* net, circuit.getNetSignals()) {
+    netSignals.insert(net->getUuid(), fromNetSignal(*net));
+  }
+  foreach (const ComponentInstance* cmp, circuit.getComponentInstances()) {
+    components.insert(cmp->getUuid(), fromComponent(*cmp));
+  }
+  foreach (const librepcb::Schematic* schematic, project.getSchematics()) {
+    schematics.append(fromSchematic(*schematic));
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ElectricalRuleCheckData::NetClass ElectricalRuleCheckData::fromNetClass(
+    const librepcb::NetClass& nc) noexcept {
+  return NetClass{nc.getUuid(), *nc.getName(), nc.isUsed()};
+}
+
+ElectricalRuleCheckData::NetSignal ElectricalRuleCheckData::fromNetSignal(
+    const librepcb::NetSignal& net) noexcept {
+  int realComponentSignals = 0;
+  foreach (const ComponentSignalInstance* sig, net.getComponentSignals()) {
+    if (!sig->getComponentInstance().getLibComponent().isSchematicOnly()) {
+      ++realComponentSignals;
+    }
+  }
+  return NetSignal{net.getUuid(), *net.getName(), realComponentSignals};
+}
+
+ElectricalRuleCheckData::Component ElectricalRuleCheckData::fromComponent(
+    const ComponentInstance& cmp) noexcept {
+  Component cmpData{cmp.getUuid(), *cmp.getName(), {}, {}};
+  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
+    const librepcb::NetSignal* net = sig->getNetSignal();
+    cmpData.componentSignals.append(ComponentSignal{
+        sig->getCompSignal().getUuid(),
+        *sig->getCompSignal().getName(),
+        sig->getCompSignal().isRequired(),
+        net ? std::make_optional(*net->getName()) : std::nullopt,
+        sig->isNetSignalNameForced()
+            ? std::make_optional(sig->getForcedNetSignalName())
+            : std::nullopt,
+    });
+  }
+  for (const ComponentSymbolVariantItem& gate :
+       cmp.getSymbolVariant().getSymbolItems()) {
+    cmpData.gates.append(Gate{gate.getUuid(), *gate.getSuffix(),
+                              gate.isRequired(),
+                              cmp.getSymbols().contains(gate.getUuid())});
+  }
+  return cmpData;
+}
+
+ElectricalRuleCheckData::Symbol ElectricalRuleCheckData::fromSymbol(
+    const SI_Symbol& symbol) noexcept {
+  Symbol symbolData{symbol.getUuid(), symbol.getName(), {}};
+  foreach (const SI_SymbolPin* pin, symbol.getPins()) {
+    symbolData.pins.append(Pin{pin->getLibPinUuid(), pin->getName(),
+                               !pin->getNetLines().isEmpty(),
+                               pin->getCompSigInstNetSignal() != nullptr});
+  }
+  return symbolData;
+}
+
+ElectricalRuleCheckData::NetSegment ElectricalRuleCheckData::fromNetSegment(
+    const SI_NetSegment& segment) noexcept {
+  bool hasOpenWire = false;
+  foreach (const SI_NetLine* netLine, segment.getNetLines()) {
+    if (netLine->getStartPoint().isOpen() || netLine->getEndPoint().isOpen()) {
+      hasOpenWire = true;
+      break;
+    }
+  }
+  NetSegment segmentData{segment.getUuid(),
+                         segment.getNetSignal().getUuid(),
+                         *segment.getNetSignal().getName(),
+                         !segment.getNetLabels().isEmpty(),
+                         hasOpenWire,
+                         {}};
+  foreach (const SI_NetPoint* netPoint, segment.getNetPoints()) {
+    segmentData.junctions.append(
+        Junction{netPoint->getUuid(), !netPoint->getNetLines().isEmpty()});
+  }
+  return segmentData;
+}
+
+ElectricalRuleCheckData::Schematic ElectricalRuleCheckData::fromSchematic(
+    const librepcb::Schematic& schematic) noexcept {
+  Schematic schematicData{schematic.getUuid(), {}, {}};
+  foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
+    schematicData.symbols.insert(symbol->getUuid(), fromSymbol(*symbol));
+  }
+  foreach (const SI_NetSegment* segment, schematic.getNetSegments()) {
+    schematicData.netSegments.insert(segment->getUuid(),
+                                     fromNetSegment(*segment));
+  }
+  return schematicData;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
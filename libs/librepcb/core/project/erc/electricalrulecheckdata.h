@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_ELECTRICALRULECHECKDATA_H
+#define LIBREPCB_CORE_ELECTRICALRULECHECKDATA_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../types/uuid.h"
+
+#include <QtCore>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class ComponentInstance;
+class NetClass;
+class NetSignal;
+class Project;
+class SI_NetSegment;
+class SI_Symbol;
+class Schematic;
+
+/*******************************************************************************
+ *  Class ElectricalRuleCheckData
+ ******************************************************************************/
+
+/**
+ * @brief Input data structure for ::librepcb::ElectricalRuleCheck
+ *
+ * Contains a copy of all the project data relevant for the ERC, so the check
+ * can run in a separate thread. The structures are comparable to allow
+ * skipping the check of objects which have not been modified since the last
+ * run. All objects are stored sorted by UUID, i.e. in the same order as in the
+ * ::librepcb::Circuit and ::librepcb::Schematic objects.
+ *
+ * @see ::librepcb::ElectricalRuleCheckDataTracker to update only modified
+ *      objects instead of copying the whole project.
+ */
+struct ElectricalRuleCheckData final {
+  struct NetClass {
+    Uuid uuid;
+    QString name;
+    bool used;
+
+    bool operator==(const NetClass& rhs) const noexcept = default;
+  };
+  struct NetSignal {
+    Uuid uuid;
+    QString name;
+    int realComponentSignals;  // Without those of schematic-only components.
+
+    bool operator==(const NetSignal& rhs) const noexcept = default;
+  };
+  struct ComponentSignal {
+    Uuid uuid;
+    QString name;
+    bool required;
+    std::optional<QString> netName;  // std::nullopt if not connected.
+    std::optional<QString> forcedNetName;  // std::nullopt if not forced.
+
+    bool operator==(const ComponentSignal& rhs) const noexcept = default;
+  };
+  struct Gate {
+    Uuid uuid;
+    QString suffix;
+    bool required;
+    bool placed;
+
+    bool operator==(const Gate& rhs) const noexcept = default;
+  };
+  struct Component {
+    Uuid uuid;
+    QString name;
+    QList<ComponentSignal> componentSignals;
+    QList<Gate> gates;
+
+    bool operator==(const Component& rhs) const noexcept = default;
+  };
+  struct Pin {
+    Uuid uuid;  // Library pin UUID.
+    QString name;
+    bool hasWires;
+    bool hasNet;  // Whether the component signal is connected to a net.
+
+    bool operator==(const Pin& rhs) const noexcept = default;
+  };
+  struct Symbol {
+    Uuid uuid;
+    QString name;
+    QList<Pin> pins;
+
+    bool operator==(const Symbol& rhs) const noexcept = default;
+  };
+  struct Junction {
+    Uuid uuid;
+    bool hasWires;
+
+    bool operator==(const Junction& rhs) const noexcept = default;
+  };
+  struct NetSegment {
+    Uuid uuid;
+    Uuid net;
+    QString netName;
+    bool hasNetLabels;
+    bool hasOpenWire;  // Any wire with an unconnected end.
+    QList<Junction> junctions;
+
+    bool operator==(const NetSegment& rhs) const noexcept = default;
+  };
+  struct Schematic {
+    Uuid uuid;
+    QMap<Uuid, Symbol> symbols;
+    QMap<Uuid, NetSegment> netSegments;
+  };
+
+  // NOTE: Copying this structure is a lightweight operation thanks to the
+  // implicitly shared Qt containers.
+  QMap<Uuid, NetClass> netClasses;
+  QMap<Uuid, NetSignal> netSignals;
+  QMap<Uuid, Component> components;
+  QList<Schematic> schematics;  // Same order as in the project.
+
+  // Constructors / Destructor
+  ElectricalRuleCheckData() noexcept;
+  explicit ElectricalRuleCheckData(const Project& project) noexcept;
+
+  // Static Methods
+  static NetClass fromNetClass(const librepcb::NetClass& nc) noexcept;
+  static NetSignal fromNetSignal(const librepcb::NetSignal& net) noexcept;
+  static Component fromComponent(const ComponentInstance& cmp) noexcept;
+  static Symbol fromSymbol(const SI_Symbol& symbol) noexcept;
+  static NetSegment fromNetSegment(const SI_NetSegment& segment) noexcept;
+  static Schematic fromSchematic(const librepcb::Schematic& schematic) noexcept;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
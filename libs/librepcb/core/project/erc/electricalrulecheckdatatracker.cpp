@@ -0,0 +1,335 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "electricalrulecheckdatatracker.h"
+
+#include "../circuit/circuit.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include "../project.h"
+#include "../schematic/items/si_netline.h"
+#include "../schematic/items/si_netsegment.h"
+#include "../schematic/items/si_symbol.h"
+#include "../schematic/items/si_symbolpin.h"
+#include "../schematic/schematic.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ElectricalRuleCheckDataTracker::ElectricalRuleCheckDataTracker(
+    const Project& project, QObject* parent) noexcept
+  : QObject(parent),
+    mProject(project),
+    mData(),
+    mFullUpdateRequired(true),
+    mModifiedNetSignals(),
+    mModifiedComponents(),
+    mModifiedSymbols(),
+    mModifiedNetSegments(),
+    mUpdatedObjectsCount(0) {
+  const Circuit& circuit = mProject.getCircuit();
+  connect(&circuit, &Circuit::netSignalAdded, this,
+          &ElectricalRuleCheckDataTracker::netSignalAdded);
+  connect(&circuit, &Circuit::netSignalRemoved, this,
+          [this](NetSignal& net) { netSignalModified(&net); });
+  connect(&circuit, &Circuit::componentAdded, this,
+          &ElectricalRuleCheckDataTracker::componentAdded);
+  connect(&circuit, &Circuit::componentRemoved, this,
+          [this](ComponentInstance& cmp) {
+            componentModified(cmp);
+            componentNetSignalsModified(cmp);
+          });
+  connect(&mProject, &Project::schematicAdded, this,
+          &ElectricalRuleCheckDataTracker::schematicAdded);
+  connect(&mProject, &Project::schematicRemoved, this,
+          [this]() { mFullUpdateRequired = true; });
+
+  foreach (NetSignal* net, circuit.getNetSignals()) {
+    netSignalAdded(*net);
+  }
+  foreach (ComponentInstance* cmp, circuit.getComponentInstances()) {
+    componentAdded(*cmp);
+  }
+  for (int i = 0; i < mProject.getSchematics().count(); ++i) {
+    schematicAdded(i);
+  }
+}
+
+ElectricalRuleCheckDataTracker::~ElectricalRuleCheckDataTracker() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+ElectricalRuleCheckData
+    ElectricalRuleCheckDataTracker::takeSnapshot() noexcept {
+  using Data = ElectricalRuleCheckData;
+
+  if (mFullUpdateRequired) {
+    mData = Data(mProject);
+    mUpdatedObjectsCount = mData.netSignals.count() + mData.components.count();
+    for (const Data::Schematic& schematic : mData.schematics) {
+      mUpdatedObjectsCount +=
+          schematic.symbols.count() + schematic.netSegments.count();
+    }
+  } else {
+    mUpdatedObjectsCount = 0;
+    const Circuit& circuit = mProject.getCircuit();
+    mData.netClasses.clear();
+    foreach (const NetClass* nc, circuit.getNetClasses()) {
+      mData.netClasses.insert(nc->getUuid(), Data::fromNetClass(*nc));
+    }
+    for (const Uuid& uuid : mModifiedNetSignals) {
+      if (const NetSignal* net = circuit.getNetSignals().value(uuid)) {
+        mData.netSignals.insert(uuid, Data::fromNetSignal(*net));
+        ++mUpdatedObjectsCount;
+      } else {
+        mData.netSignals.remove(uuid);
+      }
+    }
+    for (const Uuid& uuid : mModifiedComponents) {
+      if (const ComponentInstance* cmp =
+              circuit.getComponentInstances().value(uuid)) {
+        mData.components.insert(uuid, Data::fromComponent(*cmp));
+        ++mUpdatedObjectsCount;
+      } else {
+        mData.components.remove(uuid);
+      }
+    }
+
+    // Since adding or removing schematics leads to a full update, the
+    // schematics are the same as in the last snapshot. Items of schematics
+    // which are no longer part of the project are ignored.
+    QHash<Uuid, int> schematicIndices;
+    for (int i = 0; i < mData.schematics.count(); ++i) {
+      schematicIndices.insert(mData.schematics.at(i).uuid, i);
+    }
+    for (const SchematicItemKey& key : mModifiedSymbols) {
+      const int index = schematicIndices.value(key.first, -1);
+      const Schematic* schematic = mProject.getSchematicByUuid(key.first);
+      if ((index < 0) || (!schematic)) {
+        continue;
+      }
+      QMap<Uuid, Data::Symbol>& symbols = mData.schematics[index].symbols;
+      if (const SI_Symbol* symbol = schematic->getSymbols().value(key.second)) {
+        symbols.insert(key.second, Data::fromSymbol(*symbol));
+        ++mUpdatedObjectsCount;
+      } else {
+        symbols.remove(key.second);
+      }
+    }
+    for (const SchematicItemKey& key : mModifiedNetSegments) {
+      const int index = schematicIndices.value(key.first, -1);
+      const Schematic* schematic = mProject.getSchematicByUuid(key.first);
+      if ((index < 0) || (!schematic)) {
+        continue;
+      }
+      QMap<Uuid, Data::NetSegment>& segments =
+          mData.schematics[index].netSegments;
+      if (const SI_NetSegment* segment =
+              schematic->getNetSegments().value(key.second)) {
+        segments.insert(key.second, Data::fromNetSegment(*segment));
+        ++mUpdatedObjectsCount;
+      } else {
+        segments.remove(key.second);
+      }
+    }
+  }
+
+  mFullUpdateRequired = false;
+  mModifiedNetSignals.clear();
+  mModifiedComponents.clear();
+  mModifiedSymbols.clear();
+  mModifiedNetSegments.clear();
+  return mData;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ElectricalRuleCheckDataTracker::schematicAdded(int newIndex) noexcept {
+  Schematic* schematic = mProject.getSchematicByIndex(newIndex);
+  Q_ASSERT(schematic);
+  if (!schematic) {
+    return;
+  }
+
+  // Avoid duplicate connections if a removed schematic is added again.
+  disconnect(schematic, nullptr, this, nullptr);
+  connect(schematic, &Schematic::symbolAdded, this,
+          &ElectricalRuleCheckDataTracker::symbolAddedOrRemoved);
+  connect(schematic, &Schematic::symbolRemoved, this,
+          &ElectricalRuleCheckDataTracker::symbolAddedOrRemoved);
+  connect(schematic, &Schematic::netSegmentAdded, this,
+          &ElectricalRuleCheckDataTracker::netSegmentAdded);
+  connect(schematic, &Schematic::netSegmentRemoved, this,
+          [this](SI_NetSegment& segment) {
+            netSegmentModified(segment);
+            netLinesModified(segment.getNetLines().values());
+          });
+  foreach (SI_NetSegment* segment, schematic->getNetSegments()) {
+    netSegmentAdded(*segment);
+  }
+  mFullUpdateRequired = true;
+}
+
+void ElectricalRuleCheckDataTracker::netSignalAdded(NetSignal& net) noexcept {
+  disconnect(&net, nullptr, this, nullptr);
+  connect(&net, &NetSignal::nameChanged, this, [this, &net]() {
+    // The net name is part of the component, pin and net segment data.
+    netSignalModified(&net);
+    foreach (const ComponentSignalInstance* sig, net.getComponentSignals()) {
+      componentModified(sig->getComponentInstance());
+      symbolsOfComponentModified(sig->getComponentInstance());
+    }
+    foreach (const SI_NetSegment* segment, net.getSchematicNetSegments()) {
+      netSegmentModified(*segment);
+    }
+  });
+  netSignalModified(&net);
+}
+
+void ElectricalRuleCheckDataTracker::componentAdded(
+    ComponentInstance& cmp) noexcept {
+  // Attributes may affect the component name, symbol names and forced net
+  // names.
+  disconnect(&cmp, nullptr, this, nullptr);
+  connect(&cmp, &ComponentInstance::attributesChanged, this, [this, &cmp]() {
+    componentModified(cmp);
+    symbolsOfComponentModified(cmp);
+  });
+  foreach (ComponentSignalInstance* sig, cmp.getSignals()) {
+    disconnect(sig, nullptr, this, nullptr);
+    connect(sig, &ComponentSignalInstance::netSignalChanged, this,
+            [this, &cmp](NetSignal* from, NetSignal* to) {
+              netSignalModified(from);
+              netSignalModified(to);
+              componentModified(cmp);
+              symbolsOfComponentModified(cmp);
+            });
+  }
+  componentModified(cmp);
+  componentNetSignalsModified(cmp);
+}
+
+void ElectricalRuleCheckDataTracker::symbolAddedOrRemoved(
+    SI_Symbol& symbol) noexcept {
+  // The component data contains whether its gates are placed or not.
+  symbolModified(symbol);
+  componentModified(symbol.getComponentInstance());
+}
+
+void ElectricalRuleCheckDataTracker::netSegmentAdded(
+    SI_NetSegment& segment) noexcept {
+  disconnect(&segment, nullptr, this, nullptr);
+  connect(&segment, &SI_NetSegment::netSignalChanged, this,
+          [this, &segment]() { netSegmentModified(segment); });
+  connect(&segment, &SI_NetSegment::netPointsAndNetLinesAdded, this,
+          [this, &segment](const QList<SI_NetPoint*>&,
+                           const QList<SI_NetLine*>& netLines) {
+            netSegmentModified(segment);
+            netLinesModified(netLines);
+          });
+  connect(&segment, &SI_NetSegment::netPointsAndNetLinesRemoved, this,
+          [this, &segment](const QList<SI_NetPoint*>&,
+                           const QList<SI_NetLine*>& netLines) {
+            netSegmentModified(segment);
+            netLinesModified(netLines);
+          });
+  connect(&segment, &SI_NetSegment::netLabelAdded, this,
+          [this, &segment]() { netSegmentModified(segment); });
+  connect(&segment, &SI_NetSegment::netLabelRemoved, this,
+          [this, &segment]() { netSegmentModified(segment); });
+  netSegmentModified(segment);
+  netLinesModified(segment.getNetLines().values());
+}
+
+void ElectricalRuleCheckDataTracker::netSignalModified(
+    const NetSignal* net) noexcept {
+  if (net) {
+    mModifiedNetSignals.insert(net->getUuid());
+  }
+}
+
+void ElectricalRuleCheckDataTracker::componentModified(
+    const ComponentInstance& cmp) noexcept {
+  mModifiedComponents.insert(cmp.getUuid());
+}
+
+void ElectricalRuleCheckDataTracker::componentNetSignalsModified(
+    const ComponentInstance& cmp) noexcept {
+  // Adding or removing a component (un)registers its signals from their nets.
+  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
+    netSignalModified(sig->getNetSignal());
+  }
+}
+
+void ElectricalRuleCheckDataTracker::symbolsOfComponentModified(
+    const ComponentInstance& cmp) noexcept {
+  foreach (const SI_Symbol* symbol, cmp.getSymbols()) {
+    symbolModified(*symbol);
+  }
+}
+
+void ElectricalRuleCheckDataTracker::symbolModified(
+    const SI_Symbol& symbol) noexcept {
+  mModifiedSymbols.insert(
+      std::make_pair(symbol.getSchematic().getUuid(), symbol.getUuid()));
+}
+
+void ElectricalRuleCheckDataTracker::netSegmentModified(
+    const SI_NetSegment& segment) noexcept {
+  mModifiedNetSegments.insert(
+      std::make_pair(segment.getSchematic().getUuid(), segment.getUuid()));
+}
+
+void ElectricalRuleCheckDataTracker::netLinesModified(
+    const QList<SI_NetLine*>& netLines) noexcept {
+  // Symbol pins know whether wires are attached or not.
+  for (const SI_NetLine* netLine : netLines) {
+    for (SI_NetLineAnchor* anchor :
+         {&netLine->getStartPoint(), &netLine->getEndPoint()}) {
+      if (const SI_SymbolPin* pin = dynamic_cast<SI_SymbolPin*>(anchor)) {
+        symbolModified(pin->getSymbol());
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
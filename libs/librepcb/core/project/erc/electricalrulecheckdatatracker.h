@@ -0,0 +1,134 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CORE_ELECTRICALRULECHECKDATATRACKER_H
+#define LIBREPCB_CORE_ELECTRICALRULECHECKDATATRACKER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "electricalrulecheckdata.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class ComponentInstance;
+class NetSignal;
+class Project;
+class SI_NetLine;
+class SI_NetSegment;
+class SI_Symbol;
+class Schematic;
+
+/*******************************************************************************
+ *  Class ElectricalRuleCheckDataTracker
+ ******************************************************************************/
+
+/**
+ * @brief Keeps a ::librepcb::ElectricalRuleCheckData snapshot of a project
+ *        up to date
+ *
+ * Taking a complete snapshot of a large project takes a noticeable time, and
+ * it must be done in the main thread. This class therefore observes the
+ * project's change signals and remembers which net signals, components,
+ * symbols and net segments have been modified. #takeSnapshot() then only
+ * copies these objects again and reuses everything else from the previous
+ * snapshot.
+ *
+ * Net classes are always copied completely since there are only a few of
+ * them and their usage state is not observable. Adding or removing a
+ * schematic leads to a complete snapshot.
+ *
+ * @note The project must outlive this object.
+ */
+class ElectricalRuleCheckDataTracker final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  ElectricalRuleCheckDataTracker() = delete;
+  ElectricalRuleCheckDataTracker(const ElectricalRuleCheckDataTracker& other) =
+      delete;
+  explicit ElectricalRuleCheckDataTracker(const Project& project,
+                                          QObject* parent = nullptr) noexcept;
+  ~ElectricalRuleCheckDataTracker() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get the number of objects copied by the last #takeSnapshot() call
+   *
+   * @return Number of copied net signals, components, symbols and net
+   *         segments (net classes are not counted)
+   */
+  int getUpdatedObjectsCount() const noexcept { return mUpdatedObjectsCount; }
+
+  // General Methods
+
+  /**
+   * @brief Update the snapshot with all modifications since the last call
+   *
+   * @return Snapshot of the current project state, identical to
+   *         ElectricalRuleCheckData(const Project&)
+   */
+  ElectricalRuleCheckData takeSnapshot() noexcept;
+
+  // Operator Overloadings
+  ElectricalRuleCheckDataTracker& operator=(
+      const ElectricalRuleCheckDataTracker& rhs) = delete;
+
+private:  // Methods
+  void schematicAdded(int newIndex) noexcept;
+  void netSignalAdded(NetSignal& net) noexcept;
+  void componentAdded(ComponentInstance& cmp) noexcept;
+  void symbolAddedOrRemoved(SI_Symbol& symbol) noexcept;
+  void netSegmentAdded(SI_NetSegment& segment) noexcept;
+  void netSignalModified(const NetSignal* net) noexcept;
+  void componentModified(const ComponentInstance& cmp) noexcept;
+  void componentNetSignalsModified(const ComponentInstance& cmp) noexcept;
+  void symbolsOfComponentModified(const ComponentInstance& cmp) noexcept;
+  void symbolModified(const SI_Symbol& symbol) noexcept;
+  void netSegmentModified(const SI_NetSegment& segment) noexcept;
+  void netLinesModified(const QList<SI_NetLine*>& netLines) noexcept;
+
+private:  // Data
+  using SchematicItemKey = std::pair<Uuid, Uuid>;  // Schematic & item UUID.
+
+  const Project& mProject;
+  ElectricalRuleCheckData mData;
+  bool mFullUpdateRequired;
+  QSet<Uuid> mModifiedNetSignals;
+  QSet<Uuid> mModifiedComponents;
+  QSet<SchematicItemKey> mModifiedSymbols;
+  QSet<SchematicItemKey> mModifiedNetSegments;
+  int mUpdatedObjectsCount;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
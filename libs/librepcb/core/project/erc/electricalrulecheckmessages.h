@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "electricalrulecheckdata.h"
 
 #include <QtCore>
 
@@ -32,15 +33,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class ComponentSignalInstance;
-class ComponentSymbolVariantItem;
-class NetClass;
-class NetSignal;
-class SI_NetPoint;
-class SI_NetSegment;
-class SI_SymbolPin;
-
 /*******************************************************************************
  *  Class ErcMsgUnusedNetClass
  ******************************************************************************/
@@ -54,7 +46,8 @@ class ErcMsgUnusedNetClass final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnusedNetClass() = delete;
-  explicit ErcMsgUnusedNetClass(const NetClass& netClass) noexcept;
+  explicit ErcMsgUnusedNetClass(
+      const ElectricalRuleCheckData::NetClass& netClass) noexcept;
   ErcMsgUnusedNetClass(const ErcMsgUnusedNetClass& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnusedNetClass() noexcept {}
@@ -73,7 +66,8 @@ class ErcMsgOpenNet final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgOpenNet() = delete;
-  explicit ErcMsgOpenNet(const NetSignal& net) noexcept;
+  explicit ErcMsgOpenNet(
+      const ElectricalRuleCheckData::NetSignal& net) noexcept;
   ErcMsgOpenNet(const ErcMsgOpenNet& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgOpenNet() noexcept {}
@@ -92,7 +86,8 @@ class ErcMsgOpenWireInSegment final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgOpenWireInSegment() = delete;
-  explicit ErcMsgOpenWireInSegment(const SI_NetSegment& segment) noexcept;
+  explicit ErcMsgOpenWireInSegment(
+      const ElectricalRuleCheckData::NetSegment& segment) noexcept;
   ErcMsgOpenWireInSegment(const ErcMsgOpenWireInSegment& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgOpenWireInSegment() noexcept {}
@@ -111,8 +106,9 @@ class ErcMsgUnconnectedRequiredSignal final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnconnectedRequiredSignal() = delete;
-  explicit ErcMsgUnconnectedRequiredSignal(
-      const ComponentSignalInstance& signal) noexcept;
+  ErcMsgUnconnectedRequiredSignal(
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::ComponentSignal& signal) noexcept;
   ErcMsgUnconnectedRequiredSignal(
       const ErcMsgUnconnectedRequiredSignal& other) noexcept
     : RuleCheckMessage(other) {}
@@ -132,15 +128,13 @@ class ErcMsgForcedNetSignalNameConflict final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgForcedNetSignalNameConflict() = delete;
-  explicit ErcMsgForcedNetSignalNameConflict(
-      const ComponentSignalInstance& signal) noexcept;
+  ErcMsgForcedNetSignalNameConflict(
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::ComponentSignal& signal) noexcept;
   ErcMsgForcedNetSignalNameConflict(
       const ErcMsgForcedNetSignalNameConflict& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgForcedNetSignalNameConflict() noexcept {}
-
-private:
-  static QString getSignalNet(const ComponentSignalInstance& signal) noexcept;
 };
 
 /*******************************************************************************
@@ -156,9 +150,9 @@ class ErcMsgUnplacedRequiredGate final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnplacedRequiredGate() = delete;
-  explicit ErcMsgUnplacedRequiredGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+  ErcMsgUnplacedRequiredGate(
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::Gate& gate) noexcept;
   ErcMsgUnplacedRequiredGate(const ErcMsgUnplacedRequiredGate& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnplacedRequiredGate() noexcept {}
@@ -177,9 +171,9 @@ class ErcMsgUnplacedOptionalGate final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnplacedOptionalGate() = delete;
-  explicit ErcMsgUnplacedOptionalGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+  ErcMsgUnplacedOptionalGate(
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::Gate& gate) noexcept;
   ErcMsgUnplacedOptionalGate(const ErcMsgUnplacedOptionalGate& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnplacedOptionalGate() noexcept {}
@@ -198,7 +192,10 @@ class ErcMsgConnectedPinWithoutWire final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgConnectedPinWithoutWire() = delete;
-  explicit ErcMsgConnectedPinWithoutWire(const SI_SymbolPin& pin) noexcept;
+  ErcMsgConnectedPinWithoutWire(
+      const ElectricalRuleCheckData::Schematic& schematic,
+      const ElectricalRuleCheckData::Symbol& symbol,
+      const ElectricalRuleCheckData::Pin& pin) noexcept;
   ErcMsgConnectedPinWithoutWire(
       const ErcMsgConnectedPinWithoutWire& other) noexcept
     : RuleCheckMessage(other) {}
@@ -218,7 +215,10 @@ class ErcMsgUnconnectedJunction final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnconnectedJunction() = delete;
-  explicit ErcMsgUnconnectedJunction(const SI_NetPoint& netPoint) noexcept;
+  ErcMsgUnconnectedJunction(
+      const ElectricalRuleCheckData::Schematic& schematic,
+      const ElectricalRuleCheckData::NetSegment& netSegment,
+      const ElectricalRuleCheckData::Junction& junction) noexcept;
   ErcMsgUnconnectedJunction(const ErcMsgUnconnectedJunction& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnconnectedJunction() noexcept {}
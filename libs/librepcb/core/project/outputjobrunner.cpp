@@ -552,8 +552,7 @@ void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
         ibom->setShowFabrication(job.getShowFabrication());
         ibom->setShowPads(job.getShowPads());
         ibom->setCheckBoxes(job.getCheckBoxes());
-        const QString html = ibom->generateHtml();  // can throw
-        FileUtils::writeFile(fp, html.toUtf8());  // can throw
+        ibom->writeHtml(fp);  // can throw
       } else {
         throw RuntimeError(__FILE__, __LINE__,
                            QString("Unsupported interactive BOM format: '%1'")
@@ -106,6 +106,19 @@ Project::~Project() noexcept {
   qDebug().nospace() << "Closed project " << getFilepath().toNative() << ".";
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+const QSet<RuleCheckMessage::Fingerprint>&
+    Project::getErcMessageApprovalFingerprints() const noexcept {
+  if (!mErcMessageApprovalFingerprints) {
+    mErcMessageApprovalFingerprints =
+        RuleCheckMessage::calcFingerprints(mErcMessageApprovals);
+  }
+  return *mErcMessageApprovalFingerprints;
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -186,6 +199,7 @@ bool Project::setErcMessageApprovals(
     const QSet<SExpression>& approvals) noexcept {
   if (approvals != mErcMessageApprovals) {
     mErcMessageApprovals = approvals;
+    mErcMessageApprovalFingerprints.reset();
     emit ercMessageApprovalsChanged(mErcMessageApprovals);
     return true;
   } else {
@@ -197,10 +211,12 @@ bool Project::setErcMessageApproved(const SExpression& approval,
                                     bool approved) noexcept {
   if (approved && (!mErcMessageApprovals.contains(approval))) {
     mErcMessageApprovals.insert(approval);
+    mErcMessageApprovalFingerprints.reset();
     emit ercMessageApprovalsChanged(mErcMessageApprovals);
     return true;
   } else if ((!approved) && mErcMessageApprovals.contains(approval)) {
     mErcMessageApprovals.remove(approval);
+    mErcMessageApprovalFingerprints.reset();
     emit ercMessageApprovalsChanged(mErcMessageApprovals);
     return true;
   }
@@ -27,6 +27,7 @@
 #include "../fileio/directorylock.h"
 #include "../fileio/transactionaldirectory.h"
 #include "../job/outputjob.h"
+#include "../rulecheck/rulecheckmessage.h"
 #include "../types/elementname.h"
 #include "../types/fileproofname.h"
 #include "../types/uuid.h"
@@ -254,6 +255,17 @@ public:
     return mErcMessageApprovals;
   }
 
+  /**
+   * @brief Get the fingerprints of all ERC message approvals
+   *
+   * Calculated on first access and cached until the approvals are modified,
+   * so repeated ERC runs don't need to hash all approvals again.
+   *
+   * @return Approval fingerprints
+   */
+  const QSet<RuleCheckMessage::Fingerprint>& getErcMessageApprovalFingerprints()
+      const noexcept;
+
   /**
    * @brief Get the primary board (the first one)
    *
@@ -646,6 +658,10 @@ private:  // Data
   /// All approved ERC messages
   QSet<SExpression> mErcMessageApprovals;
 
+  /// Fingerprints of #mErcMessageApprovals, lazily calculated
+  mutable std::optional<QSet<RuleCheckMessage::Fingerprint>>
+      mErcMessageApprovalFingerprints;
+
   // Cached properties
   QPointer<Board> mPrimaryBoard;
 };
@@ -148,7 +148,9 @@ void SI_NetSegment::setNetSignal(NetSignal& netsignal) {
       netsignal.registerSchematicNetSegment(*this);  // can throw
       sg.dismiss();
     }
+    NetSignal& old = *mNetSignal;
     mNetSignal = &netsignal;
+    emit netSignalChanged(old, netsignal);
   }
 }
 
@@ -111,6 +111,7 @@ public:
   bool operator!=(const SI_NetSegment& rhs) noexcept { return (this != &rhs); }
 
 signals:
+  void netSignalChanged(NetSignal& from, NetSignal& to);
   void netPointsAndNetLinesAdded(const QList<SI_NetPoint*>& netPoints,
                                  const QList<SI_NetLine*>& netLines);
   void netPointsAndNetLinesRemoved(const QList<SI_NetPoint*>& netPoints,
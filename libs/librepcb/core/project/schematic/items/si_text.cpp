@@ -52,7 +52,7 @@ SI_Text::SI_Text(Schematic& schematic, const Text& text)
 
   // Connect to the "attributes changed" signal of the schematic.
   connect(&mSchematic, &Schematic::attributesChanged, this,
-          &SI_Text::updateText);
+          &SI_Text::attributesChanged);
 
   updateText();
 }
@@ -71,14 +71,15 @@ void SI_Text::setSymbol(SI_Symbol* symbol) noexcept {
 
   if (mSymbol) {
     disconnect(mSymbol, &SI_Symbol::attributesChanged, this,
-               &SI_Text::updateText);
+               &SI_Text::attributesChanged);
   }
 
   mSymbol = symbol;
 
   // Text might need to be updated if symbol attributes have changed.
   if (mSymbol) {
-    connect(mSymbol, &SI_Symbol::attributesChanged, this, &SI_Text::updateText);
+    connect(mSymbol, &SI_Symbol::attributesChanged, this,
+            &SI_Text::attributesChanged);
   }
 
   updateText();
@@ -122,21 +123,31 @@ void SI_Text::textEdited(const Text& text, Text::Event event) noexcept {
   }
 }
 
+ProjectAttributeLookup SI_Text::getAttributeLookup() const noexcept {
+  if (mSymbol) {
+    QPointer<const BI_Device> device =
+        mSymbol->getComponentInstance().getPrimaryDevice();
+    std::shared_ptr<const Part> part = device
+        ? device->getParts(std::nullopt).value(0)
+        : mSymbol->getComponentInstance().getParts(std::nullopt).value(0);
+    return ProjectAttributeLookup(*mSymbol, device, part, nullptr);
+  } else {
+    return ProjectAttributeLookup(mSchematic, nullptr);
+  }
+}
+
+void SI_Text::attributesChanged() noexcept {
+  // Same as in BI_StrokeText: only re-substitute if any looked up key
+  // evaluates differently now.
+  if (AttributeSubstitutor::dependenciesChanged(mTextDependencies,
+                                                getAttributeLookup())) {
+    updateText();
+  }
+}
+
 void SI_Text::updateText() noexcept {
-  auto getLookup = [this]() {
-    if (mSymbol) {
-      QPointer<const BI_Device> device =
-          mSymbol->getComponentInstance().getPrimaryDevice();
-      std::shared_ptr<const Part> part = device
-          ? device->getParts(std::nullopt).value(0)
-          : mSymbol->getComponentInstance().getParts(std::nullopt).value(0);
-      return ProjectAttributeLookup(*mSymbol, device, part, nullptr);
-    } else {
-      return ProjectAttributeLookup(mSchematic, nullptr);
-    }
-  };
-  const QString text =
-      AttributeSubstitutor::substitute(mTextObj.getText(), getLookup());
+  const QString text = AttributeSubstitutor::substitute(
+      mTextObj.getText(), getAttributeLookup(), nullptr, &mTextDependencies);
   if (text != mText) {
     mText = text;
     onEdited.notify(Event::TextChanged);
@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../attribute/attributesubstitutor.h"
 #include "../../../geometry/text.h"
 #include "../../../utils/signalslot.h"
 #include "si_base.h"
@@ -35,6 +36,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class ProjectAttributeLookup;
 class SI_Symbol;
 class Schematic;
 
@@ -83,6 +85,8 @@ public:
 
 private:  // Methods
   void textEdited(const Text& text, Text::Event event) noexcept;
+  ProjectAttributeLookup getAttributeLookup() const noexcept;
+  void attributesChanged() noexcept;
   void updateText() noexcept;
 
 private:  // Attributes
@@ -91,6 +95,7 @@ private:  // Attributes
 
   // Cached Attributes
   QString mText;
+  AttributeSubstitutor::Dependencies mTextDependencies;
 
   // Slots
   Text::OnEditedSlot mOnTextEditedSlot;
@@ -36,7 +36,9 @@ RuleCheckMessage::RuleCheckMessage(const RuleCheckMessage& other) noexcept
     mMessage(other.mMessage),
     mDescription(other.mDescription),
     mApproval(new SExpression(*other.mApproval)),
-    mLocations(other.mLocations) {
+    mLocations(other.mLocations),
+    mApprovalFingerprintFlag(),
+    mApprovalFingerprint() {
 }
 
 RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
@@ -47,7 +49,9 @@ RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
     mMessage(msg),
     mDescription(description),
     mApproval(SExpression::createList("approved")),
-    mLocations(locations) {
+    mLocations(locations),
+    mApprovalFingerprintFlag(),
+    mApprovalFingerprint() {
   mApproval->appendChild(SExpression::createToken(approvalName));  // snake_case
 }
 
@@ -62,6 +66,14 @@ const QIcon& RuleCheckMessage::getSeverityIcon() const noexcept {
   return getSeverityIcon(mSeverity);
 }
 
+const RuleCheckMessage::Fingerprint& RuleCheckMessage::getApprovalFingerprint()
+    const noexcept {
+  std::call_once(mApprovalFingerprintFlag, [this]() {
+    mApprovalFingerprint = calcFingerprint(*mApproval);
+  });
+  return mApprovalFingerprint;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -99,6 +111,65 @@ QSet<SExpression> RuleCheckMessage::getAllApprovals(
   return approvals;
 }
 
+QSet<RuleCheckMessage::Fingerprint>
+    RuleCheckMessage::getAllApprovalFingerprints(
+        const QVector<std::shared_ptr<const RuleCheckMessage>>&
+            messages) noexcept {
+  QSet<Fingerprint> fingerprints;
+  fingerprints.reserve(messages.size());
+  foreach (const auto& msg, messages) {
+    Q_ASSERT(msg);
+    fingerprints.insert(msg->getApprovalFingerprint());
+  }
+  return fingerprints;
+}
+
+RuleCheckMessage::Fingerprint RuleCheckMessage::calcFingerprint(
+    const SExpression& approval) noexcept {
+  // Hash the node tree with the same semantics as SExpression::operator==(),
+  // i.e. type, value and children of each node (length-prefixed to avoid
+  // ambiguities).
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  auto addInt = [&hash](qint64 value) {
+    hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  auto addStr = [&hash, &addInt](const QString& str) {
+    const QByteArray utf8 = str.toUtf8();
+    addInt(utf8.size());
+    hash.addData(utf8);
+  };
+  std::function<void(const SExpression&)> addNode =
+      [&](const SExpression& node) {
+        addInt(static_cast<int>(node.getType()));
+        if (node.isList()) {
+          addStr(node.getName());
+        } else if (!node.isLineBreak()) {
+          addStr(node.getValue());
+        }
+        addInt(node.getChildCount());
+        for (int i = 0; i < static_cast<int>(node.getChildCount()); ++i) {
+          addNode(node.getChild(i));
+        }
+      };
+  addNode(approval);
+  const QByteArray result = hash.result();
+  Q_ASSERT(result.size() == 16);
+  Fingerprint fp;
+  fp.high = qFromBigEndian<quint64>(result.constData());
+  fp.low = qFromBigEndian<quint64>(result.constData() + 8);
+  return fp;
+}
+
+QSet<RuleCheckMessage::Fingerprint> RuleCheckMessage::calcFingerprints(
+    const QSet<SExpression>& approvals) noexcept {
+  QSet<Fingerprint> fingerprints;
+  fingerprints.reserve(approvals.size());
+  for (const SExpression& approval : approvals) {
+    fingerprints.insert(calcFingerprint(approval));
+  }
+  return fingerprints;
+}
+
 /*******************************************************************************
  *  Operator Overloads
  ******************************************************************************/
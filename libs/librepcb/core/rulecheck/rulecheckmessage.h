@@ -29,6 +29,7 @@
 #include <QtCore>
 
 #include <memory>
+#include <mutex>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -53,6 +54,21 @@ public:
     Error = 2,
   };
 
+  /**
+   * @brief 128-bit fingerprint of a message approval
+   *
+   * Allows fast lookup and comparison of approvals without hashing and
+   * comparing whole ::librepcb::SExpression trees. Two approvals have the
+   * same fingerprint if and only if they compare equal (except for the
+   * negligible probability of a hash collision).
+   */
+  struct Fingerprint {
+    quint64 high = 0;
+    quint64 low = 0;
+
+    bool operator==(const Fingerprint& rhs) const noexcept = default;
+  };
+
   // Constructors / Destructor
   RuleCheckMessage() = delete;
 
@@ -63,6 +79,7 @@ public:
   const QString& getMessage() const noexcept { return mMessage; }
   const QString& getDescription() const noexcept { return mDescription; }
   const SExpression& getApproval() const noexcept { return *mApproval; }
+  const Fingerprint& getApprovalFingerprint() const noexcept;
   const QVector<Path>& getLocations() const noexcept { return mLocations; }
 
   // General Methods
@@ -81,6 +98,12 @@ public:
   static QSet<SExpression> getAllApprovals(
       const QVector<std::shared_ptr<const RuleCheckMessage>>&
           messages) noexcept;
+  static QSet<Fingerprint> getAllApprovalFingerprints(
+      const QVector<std::shared_ptr<const RuleCheckMessage>>&
+          messages) noexcept;
+  static Fingerprint calcFingerprint(const SExpression& approval) noexcept;
+  static QSet<Fingerprint> calcFingerprints(
+      const QSet<SExpression>& approvals) noexcept;
 
   // Operator Overloads
   bool operator==(const RuleCheckMessage& rhs) const noexcept;
@@ -99,8 +122,19 @@ protected:  // Data
   QString mDescription;
   std::unique_ptr<SExpression> mApproval;
   QVector<Path> mLocations;
+
+private:  // Data
+  // Lazy calculated since derived classes build the approval in their
+  // constructor. Thread-safe since messages are created in worker threads.
+  mutable std::once_flag mApprovalFingerprintFlag;
+  mutable Fingerprint mApprovalFingerprint;
 };
 
+inline std::size_t qHash(const RuleCheckMessage::Fingerprint& key,
+                         std::size_t seed = 0) noexcept {
+  return ::qHash(key.low ^ key.high, seed);
+}
+
 typedef QVector<std::shared_ptr<const RuleCheckMessage>> RuleCheckMessageList;
 
 /*******************************************************************************
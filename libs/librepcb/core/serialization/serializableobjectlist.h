@@ -54,7 +54,8 @@ namespace librepcb {
  *   librepcb::SExpression.
  * - Iterators (for example to use in C++11 range based for loops).
  * - Methods to find elements by UUID and/or name (if supported by template type
- *   `T`).
+ *   `T`). Lookups by UUID use a lazily built hash index for larger lists, see
+ *   #indexOf(const Uuid&) for details.
  * - Method #sortedByUuid() to create a copy of the list with elements sorted by
  *   UUID.
  * - Signals to get notified about added, removed and modified elements.
@@ -224,13 +225,37 @@ public:
     }
     return -1;
   }
+  /**
+   * @brief Get the index of the first element with a given UUID
+   *
+   * For small lists, the elements are simply scanned linearly. For larger
+   * lists, a hash index is built lazily and updated incrementally: Appending
+   * elements or modifying them (without changing their UUID) keeps the
+   * existing index valid, while inserting, removing or changing the UUID of
+   * an element only invalidates the index from that element's position on.
+   * This way, lookups are O(1) in the typical use cases (e.g. loading a
+   * package with thousands of pads, then querying and editing pads by UUID).
+   *
+   * @note  The index is protected by a mutex, so concurrent lookups on a
+   *        const list are thread-safe (as they were before).
+   *
+   * @param key   The UUID to look for.
+   *
+   * @return The index of the element, or -1 if not found.
+   */
   int indexOf(const Uuid& key) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getUuid() == key) {
-        return i;
+    if (count() < sUuidIndexMinCount) {
+      for (int i = 0; i < count(); ++i) {
+        if (mObjects[i]->getUuid() == key) {
+          return i;
+        }
       }
+      return -1;
     }
-    return -1;
+    QMutexLocker lock(&mUuidIndexMutex);
+    updateUuidIndex();
+    const int index = mUuidIndex.value(key, -1);
+    return isValidUuidIndexEntry(key, index, mUuidIndexCount) ? index : -1;
   }
   int indexOf(const QString& name,
               Qt::CaseSensitivity cs = Qt::CaseSensitive) const noexcept {
@@ -276,9 +301,15 @@ public:
   std::shared_ptr<const T> at(int index) const noexcept {
     return std::const_pointer_cast<const T>(mObjects.at(index));
   }  // always read-only!
-  std::shared_ptr<T>& first() noexcept { return mObjects.first(); }
+  std::shared_ptr<T>& first() noexcept {
+    invalidateUuidIndex(0);  // Pointer might be replaced by the caller.
+    return mObjects.first();
+  }
   std::shared_ptr<const T> first() const noexcept { return mObjects.first(); }
-  std::shared_ptr<T>& last() noexcept { return mObjects.last(); }
+  std::shared_ptr<T>& last() noexcept {
+    invalidateUuidIndex(count() - 1);  // Pointer might be replaced by caller.
+    return mObjects.last();
+  }
   std::shared_ptr<const T> last() const noexcept { return mObjects.last(); }
   std::shared_ptr<T> get(const T* obj) {
     std::shared_ptr<T> ptr = find(obj);
@@ -447,18 +478,20 @@ public:
 
 protected:  // Methods
   void insertElement(int index, const std::shared_ptr<T>& obj) noexcept {
+    invalidateUuidIndex(index);
     mObjects.insert(index, obj);
     obj->onEdited.attach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementAdded);
   }
   std::shared_ptr<T> takeElement(int index) noexcept {
+    invalidateUuidIndex(index);
     std::shared_ptr<T> obj = mObjects.takeAt(index);
     obj->onEdited.detach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementRemoved);
     return obj;
   }
   void elementEditedHandler(const T& obj, OnEditedArgs... args) noexcept {
-    int index = indexOf(&obj);
+    int index = indexOfEditedElement(obj);
     if (contains(index)) {
       onElementEdited.notify(index, at(index), args...);
       onEdited.notify(index, at(index), Event::ElementEdited);
@@ -501,10 +534,71 @@ private:  // Internal Helper Methods
     return *obj;
   }
   inline const QString& asStr(const QString& obj) const noexcept { return obj; }
+  int indexOfEditedElement(const T& obj) noexcept {
+    if constexpr (requires { obj.getUuid(); }) {
+      // Find the element through the UUID index to avoid a linear search on
+      // every edit. Plain edits keep the index valid, so looking up elements
+      // by UUID and editing them stays fast even for large lists. Only if the
+      // UUID was changed (or is a duplicate), a linear search is needed and
+      // the index gets invalidated from the element on.
+      const int index = indexOf(obj.getUuid());
+      if (contains(index) && (mObjects.at(index).get() == &obj)) {
+        return index;
+      }
+      const int actualIndex = indexOf(&obj);
+      if (contains(actualIndex)) {
+        invalidateUuidIndex(actualIndex);
+      }
+      return actualIndex;
+    } else {
+      return indexOf(&obj);
+    }
+  }
+  void invalidateUuidIndex(int index) noexcept {
+    // Note: Called only from non-const methods, thus no locking required.
+    mUuidIndexCount = std::max(std::min(mUuidIndexCount, index), 0);
+  }
+  void updateUuidIndex() const noexcept {
+    // Drop stale entries of removed elements from time to time.
+    if ((mUuidIndexCount == 0) || (mUuidIndex.count() > (2 * count()))) {
+      mUuidIndex.clear();
+      mUuidIndexCount = 0;
+    }
+    // Index all elements not indexed yet. For duplicate UUIDs, the index of
+    // the first element is kept to be consistent with a linear search.
+    for (int i = mUuidIndexCount; i < count(); ++i) {
+      const Uuid& uuid = mObjects.at(i)->getUuid();
+      auto it = mUuidIndex.find(uuid);
+      if (it == mUuidIndex.end()) {
+        mUuidIndex.insert(uuid, i);
+      } else if (!isValidUuidIndexEntry(uuid, *it, i)) {
+        *it = i;
+      }
+    }
+    mUuidIndexCount = count();
+  }
+  bool isValidUuidIndexEntry(const Uuid& uuid, int index,
+                             int indexedCount) const noexcept {
+    return (index >= 0) && (index < indexedCount) &&
+        (mObjects.at(index)->getUuid() == uuid);
+  }
 
 protected:  // Data
   QVector<std::shared_ptr<T>> mObjects;
   Slot<T, OnEditedArgs...> mOnEditedSlot;
+
+private:  // Data
+  /// Minimum number of elements to use #mUuidIndex for UUID lookups
+  static constexpr int sUuidIndexMinCount = 16;
+
+  /// Protects #mUuidIndex and #mUuidIndexCount for lookups on const lists
+  mutable QMutex mUuidIndexMutex;
+
+  /// Lazily built UUID index, might contain stale entries
+  mutable QHash<Uuid, int> mUuidIndex;
+
+  /// Number of elements (from the beginning) which are indexed in #mUuidIndex
+  mutable int mUuidIndexCount = 0;
 };
 
 }  // namespace librepcb
@@ -203,6 +203,8 @@ public:
   static std::unique_ptr<SExpression> parse(const QByteArray& content,
                                             const FilePath& filePath,
                                             Mode mode = Mode::LibrePCB);
+  static QString escapeString(const QString& string) noexcept;
+  static bool isValidToken(const QString& token, Mode mode) noexcept;
 
 private:  // Methods
   SExpression(Type type, const QString& value);
@@ -224,8 +226,6 @@ private:  // Methods
                              const FilePath& filePath);
   static void skipWhitespaceAndComments(const QString& content, int& index,
                                         bool skipNewline = false);
-  static QString escapeString(const QString& string) noexcept;
-  static bool isValidToken(const QString& token, Mode mode) noexcept;
   static bool isValidTokenChar(const QChar& c, Mode mode) noexcept;
   QString toString(int indent, Mode mode) const;
 
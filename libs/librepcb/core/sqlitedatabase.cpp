@@ -93,6 +93,7 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, QObject* parent)
 }
 
 SQLiteDatabase::~SQLiteDatabase() noexcept {
+  mQueryCache.clear();  // Release prepared statements before closing.
   mDb.close();
 }
 
@@ -152,6 +153,22 @@ QSqlQuery SQLiteDatabase::prepareQuery(QString query,
   return q;
 }
 
+QSqlQuery& SQLiteDatabase::prepareCachedQuery(
+    QString query, const Replacements& replacements) const {
+  for (auto it = replacements.begin(); it != replacements.end(); it++) {
+    query.replace(it->first, it->second);
+  }
+
+  auto it = mQueryCache.find(query);
+  if (it == mQueryCache.end()) {
+    it = mQueryCache.insert(
+        query, std::make_shared<QSqlQuery>(prepareQuery(query)));  // can throw
+  } else {
+    (*it)->finish();  // Reset, in case it wasn't finished by the last user.
+  }
+  return **it;
+}
+
 int SQLiteDatabase::count(QSqlQuery& query) {
   exec(query);  // can throw
 
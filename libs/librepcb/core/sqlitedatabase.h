@@ -28,6 +28,8 @@
 #include <QtCore>
 #include <QtSql>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -75,6 +77,28 @@ public:
   // General Methods
   QSqlQuery prepareQuery(QString query,
                          const Replacements& replacements = {}) const;
+
+  /**
+   * @brief Get a prepared query from the cache, or prepare it if not cached
+   *
+   * Same as #prepareQuery(), but the prepared statement is kept and reused
+   * for subsequent calls with the same SQL. This avoids parsing the same SQL
+   * again and again for frequently executed queries.
+   *
+   * @attention The returned query is shared by all callers of the same SQL,
+   *            thus it must not be used recursively. In addition, it must be
+   *            finished (see QSqlQuery::finish()) or fully read after
+   *            execution, otherwise it keeps the read transaction open and
+   *            changes made by other database connections won't be visible.
+   *
+   * @param query         The SQL query.
+   * @param replacements  Replacements to apply on the SQL query.
+   *
+   * @return Reference to the cached query, valid as long as this database
+   *         object exists.
+   */
+  QSqlQuery& prepareCachedQuery(QString query,
+                                const Replacements& replacements = {}) const;
   int count(QSqlQuery& query);
   int insert(QSqlQuery& query);
   void exec(QSqlQuery& query);
@@ -106,6 +130,7 @@ private:  // Methods
 
 private:  // Data
   QSqlDatabase mDb;
+  mutable QHash<QString, std::shared_ptr<QSqlQuery>> mQueryCache;
 };
 
 /*******************************************************************************
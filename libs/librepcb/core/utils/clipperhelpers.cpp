@@ -325,7 +325,10 @@ QVector<Path> ClipperHelpers::convert(const ClipperLib::Paths& paths) noexcept {
 }
 
 Path ClipperHelpers::convert(const ClipperLib::Path& path) noexcept {
+  // Reserve the exact size to avoid overallocation of the vertex storage,
+  // the resulting paths (e.g. plane fragments) are often large and long-lived.
   Path p;
+  p.getVertices().reserve(path.size() + 1);  // +1 for closing the path
   for (const ClipperLib::IntPoint& point : path) {
     p.addVertex(convert(point));
   }
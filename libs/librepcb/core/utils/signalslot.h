@@ -25,7 +25,13 @@
  ******************************************************************************/
 #include <QtCore>
 
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -35,6 +41,85 @@ namespace librepcb {
 template <typename Tsender, typename... Args>
 class Slot;
 
+/*******************************************************************************
+ *  Class SignalBatch
+ ******************************************************************************/
+
+/**
+ * @brief The SignalBatch class defers and coalesces notifications of batched
+ *        slots within its scope
+ *
+ * As long as an instance of this class exists, notifications to slots with
+ * batching enabled (see ::librepcb::Slot::setBatched()) are not delivered
+ * immediately. Instead, they are queued and delivered when the outermost
+ * batch gets destroyed. Identical notifications (same signal and same
+ * arguments) to the same slot are delivered only once. Slots without batching
+ * enabled are not affected at all, they are still called synchronously.
+ *
+ * This is intended for expensive receivers which only reflect the state of
+ * the sender, e.g. graphics items. When moving hundreds of objects at once,
+ * each of them then gets updated only once instead of once per modification.
+ *
+ * Batches can be nested, and like ::librepcb::Signal they are not thread-safe
+ * (the queue is thread-local though).
+ */
+class SignalBatch final {
+  template <typename Tsender, typename... Args>
+  friend class Slot;
+
+public:
+  // Constructors / Destructor
+  SignalBatch(const SignalBatch& other) = delete;
+  SignalBatch() noexcept { ++sDepth; }
+  ~SignalBatch() noexcept {
+    if (--sDepth == 0) {
+      // Note: The queue might be modified by the callbacks (e.g. if slots get
+      // destroyed or new batches are created), thus it must be accessed by
+      // index and each entry is consumed before calling it.
+      for (std::size_t i = 0; i < sQueue.size(); ++i) {
+        const std::function<void()> flush = std::move(sQueue[i].flush);
+        sQueue[i].flush = nullptr;
+        if (flush) {
+          flush();
+        }
+      }
+      sQueue.clear();
+    }
+  }
+
+  /**
+   * @brief Check whether a batch is currently active
+   *
+   * @retval true   If notifications to batched slots are deferred.
+   * @retval false  If all notifications are delivered immediately.
+   */
+  static bool isActive() noexcept { return sDepth > 0; }
+
+  // Operator Overloadings
+  SignalBatch& operator=(const SignalBatch& rhs) = delete;
+
+private:
+  struct Entry {
+    const void* slot;
+    std::function<void()> flush;
+  };
+  static void enqueue(const void* slot,
+                      const std::function<void()>& flush) noexcept {
+    sQueue.push_back(Entry{slot, flush});
+  }
+  static void dequeue(const void* slot) noexcept {
+    // Don't remove the entry since we might be flushing the queue right now.
+    for (Entry& entry : sQueue) {
+      if (entry.slot == slot) {
+        entry.flush = nullptr;
+      }
+    }
+  }
+
+  static inline thread_local int sDepth = 0;
+  static inline thread_local std::vector<Entry> sQueue;
+};
+
 /*******************************************************************************
  *  Class Signal
  ******************************************************************************/
@@ -85,6 +170,9 @@ public:
   ~Signal() noexcept {
     for (auto slot : mSlots) {
       slot->mSignals.remove(this);
+      if (slot->mDiscardPendingNotifications) {
+        slot->mDiscardPendingNotifications(this);
+      }
     }
   }
 
@@ -131,7 +219,11 @@ public:
       // Check existence of the slot again because we must not call it if it
       // was detached (i.e. removed from the container) in the meantime.
       if (mSlots.contains(slot)) {
-        slot->mCallback(mSender, args...);
+        if (slot->mBatchedCallback && SignalBatch::isActive()) {
+          slot->mBatchedCallback(*this, args...);
+        } else {
+          slot->mCallback(mSender, args...);
+        }
       }
     }
   }
@@ -205,7 +297,10 @@ public:
    *
    * Automatically disconnects from all signals.
    */
-  ~Slot() noexcept { detachAll(); }
+  ~Slot() noexcept {
+    detachAll();
+    SignalBatch::dequeue(this);
+  }
 
   /**
    * @brief Get the count of registered signals
@@ -222,6 +317,71 @@ public:
       signal->mSlots.remove(this);
     }
     mSignals.clear();
+    if (mDiscardPendingNotifications) {
+      mDiscardPendingNotifications(nullptr);
+    }
+  }
+
+  /**
+   * @brief Enable or disable batching of notifications
+   *
+   * If enabled, notifications received while a ::librepcb::SignalBatch is
+   * active are deferred until the batch ends, and duplicate notifications
+   * are delivered only once. Only the order of the first occurrence of each
+   * notification is kept.
+   *
+   * @note  The arguments of the signal are copied for deferring, thus they
+   *        must be copyable and comparable.
+   *
+   * @param batched   Whether batching is enabled or not.
+   */
+  void setBatched(bool batched) noexcept {
+    if (!batched) {
+      mBatchedCallback = nullptr;
+      return;
+    }
+
+    // Note: The pending notifications are stored in a type defined only
+    // here to not require copyable and comparable arguments for all slots.
+    struct PendingNotification {
+      const Signal<Tsender, Args...>* signal;
+      const Tsender* sender;
+      std::tuple<std::decay_t<Args>...> args;
+    };
+    auto pending = std::make_shared<std::vector<PendingNotification>>();
+    mBatchedCallback = [this, pending](const Signal<Tsender, Args...>& signal,
+                                       Args... args) {
+      PendingNotification notification{&signal, &signal.mSender,
+                                       std::make_tuple(args...)};
+      for (const PendingNotification& p : *pending) {
+        if ((p.signal == notification.signal) &&
+            (p.args == notification.args)) {
+          return;  // Already pending, coalesce.
+        }
+      }
+      if (pending->empty()) {
+        SignalBatch::enqueue(this, [this, pending]() {
+          const std::vector<PendingNotification> notifications =
+              std::move(*pending);
+          pending->clear();
+          for (const PendingNotification& n : notifications) {
+            std::apply(
+                [this, &n](const auto&... args) {
+                  mCallback(*n.sender, args...);
+                },
+                n.args);
+          }
+        });
+      }
+      pending->push_back(std::move(notification));
+    };
+    mDiscardPendingNotifications = [pending](const void* signal) {
+      pending->erase(std::remove_if(pending->begin(), pending->end(),
+                                    [signal](const PendingNotification& n) {
+                                      return (!signal) || (n.signal == signal);
+                                    }),
+                     pending->end());
+    };
   }
 
   // Operator Overloadings
@@ -233,6 +393,13 @@ private:
 
   /// The registered callback function
   std::function<void(const Tsender&, Args...)> mCallback;
+
+  /// Callback to defer notifications, only set if batching is enabled
+  std::function<void(const Signal<Tsender, Args...>&, Args...)>
+      mBatchedCallback;
+
+  /// Discards deferred notifications of a signal (or of all if `nullptr`)
+  std::function<void(const void*)> mDiscardPendingNotifications;
 };
 
 /*******************************************************************************
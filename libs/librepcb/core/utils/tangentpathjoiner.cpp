@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "tangentpathjoiner.h"
 
+#include <algorithm>
 #include <functional>
 
 /*******************************************************************************
@@ -33,8 +34,7 @@ namespace librepcb {
  *  General Methods
  ******************************************************************************/
 
-QVector<Path> TangentPathJoiner::join(QVector<Path> paths, qint64 timeoutMs,
-                                      bool* timedOut) noexcept {
+QVector<Path> TangentPathJoiner::join(QVector<Path> paths) noexcept {
   QVector<Path> result;
 
   // Return closed paths as-is and skip invalid paths.
@@ -117,52 +117,97 @@ QVector<Path> TangentPathJoiner::join(QVector<Path> paths, qint64 timeoutMs,
     }
   }
 
-  // Find all paths and sort by relevance.
+  // Index the remaining paths by their endpoints.
+  Graph graph;
+  for (int i = 0; i < paths.count(); ++i) {
+    graph[paths.at(i).getVertices().first().getPos()].append(i);
+    graph[paths.at(i).getVertices().last().getPos()].append(i);
+  }
+
+  auto compare = [&paths](const Result& r1, const Result& r2) {
+    // Prio 1: Closed paths
+    if (r1.isClosed() != r2.isClosed()) {
+      return r1.isClosed();
+    }
+    // Prio 2: Long open paths or closed paths with a large area,
+    // to get the outest most polygons instead of polygons inside
+    // e.g. a symbol body
+    const qreal l1 = r1.calcLengthOrArea(paths);
+    const qreal l2 = r2.calcLengthOrArea(paths);
+    if (l1 != l2) {
+      return l1 > l2;
+    }
+    // Prio 3: Paths consisting of many joints
+    int c1 = r1.segments.count();
+    int c2 = r2.segments.count();
+    if (c1 != c2) {
+      return c1 > c2;
+    }
+    // Prio 4: Lower, non-reversed indices
+    for (int i = 0; i < c1; ++i) {
+      if (r1.segments.at(i).reverse != r2.segments.at(i).reverse) {
+        return r2.segments.at(i).reverse;
+      }
+      if (r1.segments.at(i).index != r2.segments.at(i).index) {
+        return r1.segments.at(i).index < r2.segments.at(i).index;
+      }
+    }
+    return false;
+  };
+
+  // Paths of different connected groups can never be joined, thus every
+  // group is solved separately. To get a deterministic result, the groups
+  // are collected in the order of the path indices.
   QVector<Result> found;
-  QElapsedTimer timer;
-  timer.start();
-  findAllPaths(found, paths, timer, timeoutMs, Result(), timedOut);
-  std::sort(found.begin(), found.end(),
-            [&paths](const Result& r1, const Result& r2) {
-              // Prio 1: Closed paths
-              if (r1.isClosed() != r2.isClosed()) {
-                return r1.isClosed();
-              }
-              // Prio 2: Long open paths or closed paths with a large area,
-              // to get the outest most polygons instead of polygons inside
-              // e.g. a symbol body
-              const qreal l1 = r1.calcLengthOrArea(paths);
-              const qreal l2 = r2.calcLengthOrArea(paths);
-              if (l1 != l2) {
-                return l1 > l2;
-              }
-              // Prio 3: Paths consisting of many joints
-              int c1 = r1.segments.count();
-              int c2 = r2.segments.count();
-              if (c1 != c2) {
-                return c1 > c2;
-              }
-              // Prio 4: Lower, non-reversed indices
-              for (int i = 0; i < c1; ++i) {
-                if (r1.segments.at(i).reverse != r2.segments.at(i).reverse) {
-                  return r2.segments.at(i).reverse;
-                }
-                if (r1.segments.at(i).index != r2.segments.at(i).index) {
-                  return r1.segments.at(i).index < r2.segments.at(i).index;
-                }
-              }
-              return false;
-            });
-
-  // Add found paths to result.
-  QSet<int> consumedIndices;
-  foreach (const auto& f, found) {
-    if ((f.indices & consumedIndices).isEmpty()) {
-      result.append(f.buildPath(paths));
-      consumedIndices.unite(f.indices);
+  QVector<bool> visitedPaths(paths.count(), false);
+  QSet<Point> visitedPositions;
+  for (int i = 0; i < paths.count(); ++i) {
+    if (visitedPaths.at(i)) {
+      continue;
+    }
+    QVector<int> group = {i};
+    visitedPaths[i] = true;
+    for (int k = 0; k < group.count(); ++k) {
+      const Path& path = paths.at(group.at(k));
+      for (const Point& pos : {path.getVertices().first().getPos(),
+                               path.getVertices().last().getPos()}) {
+        if (!visitedPositions.contains(pos)) {
+          visitedPositions.insert(pos);
+          foreach (int index, graph.value(pos)) {
+            if (!visitedPaths.at(index)) {
+              visitedPaths[index] = true;
+              group.append(index);
+            }
+          }
+        }
+      }
+    }
+    std::sort(group.begin(), group.end());
+
+    // Try to find the optimal solution by evaluating all possible paths,
+    // but fall back to the greedy algorithm if there are too many of them.
+    QVector<Result> candidates;
+    int budget = 10000;
+    if (findAllPaths(candidates, paths, graph, group, Result(), budget)) {
+      std::sort(candidates.begin(), candidates.end(), compare);
+      QSet<int> consumedIndices;
+      foreach (const auto& c, candidates) {
+        if ((c.indices & consumedIndices).isEmpty()) {
+          found.append(c);
+          consumedIndices.unite(c.indices);
+        }
+      }
+    } else {
+      findGreedyPaths(found, paths, group);
     }
   }
 
+  // Add found paths to result, sorted by relevance.
+  std::sort(found.begin(), found.end(), compare);
+  foreach (const auto& f, found) {
+    result.append(f.buildPath(paths));
+  }
+
   return result;
 }
 
@@ -170,27 +215,105 @@ QVector<Path> TangentPathJoiner::join(QVector<Path> paths, qint64 timeoutMs,
  *  Private Methods
  ******************************************************************************/
 
-void TangentPathJoiner::findAllPaths(QVector<Result>& result,
+bool TangentPathJoiner::findAllPaths(QVector<Result>& result,
                                      const QVector<Path>& paths,
-                                     const QElapsedTimer& timer,
-                                     qint64 timeoutMs, const Result& prefix,
-                                     bool* timedOut) noexcept {
-  for (int i = 0; i < paths.count(); ++i) {
-    if ((timeoutMs >= 0) && (timer.elapsed() > timeoutMs)) {
-      qWarning() << "Tangent path joining algorithm aborted due to timeout.";
-      if (timedOut) *timedOut = true;
-      break;
-    }
+                                     const Graph& graph,
+                                     const QVector<int>& indices,
+                                     const Result& prefix,
+                                     int& budget) noexcept {
+  foreach (int i, indices) {
     if (!prefix.indices.contains(i)) {
       for (bool reverse : {false, true}) {
         if (std::optional<Result> r = join(paths, prefix, i, reverse)) {
+          if (--budget < 0) {
+            return false;
+          }
           result.append(*r);
-          if (!r->isClosed()) {
-            findAllPaths(result, paths, timer, timeoutMs, *r);
+          if ((!r->isClosed()) &&
+              (!findAllPaths(result, paths, graph, graph.value(r->endPos), *r,
+                             budget))) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void TangentPathJoiner::findGreedyPaths(QVector<Result>& result,
+                                        const QVector<Path>& paths,
+                                        const QVector<int>& indices) noexcept {
+  // Build the graph of this group only, since consumed paths get removed from
+  // it while walking along.
+  Graph graph;
+  QHash<int, qreal> lengths;
+  QVector<std::pair<qreal, int>> order;
+  foreach (int i, indices) {
+    const Path& path = paths.at(i);
+    graph[path.getVertices().first().getPos()].append(i);
+    graph[path.getVertices().last().getPos()].append(i);
+    const qreal length = path.getTotalStraightLength()->toMm();
+    lengths.insert(i, length);
+    order.append(std::make_pair(-length, i));
+  }
+
+  // Start with the longest path and extend it at both ends as long as
+  // possible, preferring to close the path, otherwise the longest next path.
+  std::sort(order.begin(), order.end());
+  QSet<int> consumedIndices;
+  for (const auto& item : order) {
+    if (consumedIndices.contains(item.second)) {
+      continue;
+    }
+    Result r = *join(paths, Result(), item.second, false);
+    consumedIndices.insert(item.second);
+    for (int pass = 0; (pass < 2) && (!r.isClosed()); ++pass) {
+      if (pass == 1) {
+        r = r.reversed(paths);
+      }
+      while (!r.isClosed()) {
+        QVector<int>& candidates = graph[r.endPos];
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [&](int index) {
+                                          return consumedIndices.contains(
+                                              index);
+                                        }),
+                         candidates.end());
+        int bestIndex = -1;
+        bool bestReverse = false;
+        bool bestCloses = false;
+        foreach (int index, candidates) {
+          const Path& path = paths.at(index);
+          const bool reverse =
+              (path.getVertices().first().getPos() != r.endPos);
+          const Point& end = reverse ? path.getVertices().first().getPos()
+                                     : path.getVertices().last().getPos();
+          const bool closes = (end == r.startPos);
+          if (((!closes) && r.junctions.contains(end)) ||
+              ((bestIndex >= 0) && bestCloses)) {
+            continue;
           }
+          if ((bestIndex < 0) || closes ||
+              (lengths.value(index) > lengths.value(bestIndex))) {
+            bestIndex = index;
+            bestReverse = reverse;
+            bestCloses = closes;
+          }
+        }
+        if (bestIndex < 0) {
+          break;
         }
+        const Path& path = paths.at(bestIndex);
+        r.append(bestIndex, bestReverse,
+                 bestReverse ? path.getVertices().last().getPos()
+                             : path.getVertices().first().getPos(),
+                 bestReverse ? path.getVertices().first().getPos()
+                             : path.getVertices().last().getPos());
+        consumedIndices.insert(bestIndex);
       }
     }
+    result.append(r);
   }
 }
 
@@ -45,14 +45,17 @@ namespace librepcb {
  *
  *   - Invalid paths (less than 2 vertices) are removed.
  *   - Any already closed path is returned as-is.
- *   - Any joined, closed paths are searched, starting with the longest path.
- *   - Then joined, open paths are searched, starting with the longest path.
+ *   - Paths meeting unambiguously at a common endpoint are joined together.
+ *   - The remaining paths are indexed by their endpoints and split into
+ *     connected groups. For each group, joined closed paths are searched
+ *     first, then joined open paths, each starting with the longest path.
  *   - Any remaining (non tangent) paths are returned as-is.
  *
- * @note If there are many possible solutions (many paths located at the same
- *       coordinate), finding the solution can take a lot of time. Therefore
- *       a timeout can be specified to abort a too long operation, then a non-
- *       optimal (but still valid) result is returned.
+ * @note Groups with only few possible solutions are solved exhaustively to
+ *       get the optimal result. Groups with too many possible solutions (many
+ *       paths located at the same coordinate) are solved by a greedy walk
+ *       along the endpoint graph instead, which might be non-optimal but is
+ *       still valid, deterministic and takes only near-linear time.
  */
 class TangentPathJoiner {
   Q_DECLARE_TR_FUNCTIONS(TangentPathJoiner)
@@ -64,8 +67,7 @@ public:
   ~TangentPathJoiner() = delete;
 
   // General Methods
-  static QVector<Path> join(QVector<Path> paths, qint64 timeoutMs = -1,
-                            bool* timedOut = nullptr) noexcept;
+  static QVector<Path> join(QVector<Path> paths) noexcept;
 
   // Operator Overloadings
   TangentPathJoiner& operator=(const TangentPathJoiner& rhs) = delete;
@@ -106,16 +108,34 @@ private:
       return lengthAreaCache;
     }
 
+    void append(int index, bool reverse, const Point& start,
+                const Point& end) {
+      if (segments.isEmpty()) {
+        startPos = start;
+      }
+      segments.append(Segment{index, reverse});
+      indices.insert(index);
+      junctions.insert(end);
+      endPos = end;
+      lengthAreaCache = 0;
+    }
+
     Result sub(int index, bool reverse, const Point& start,
                const Point& end) const {
       Result r(*this);
-      r.segments.append(Segment{index, reverse});
-      r.indices.insert(index);
-      r.junctions.insert(end);
-      if (segments.isEmpty()) {
-        r.startPos = start;
+      r.append(index, reverse, start, end);
+      return r;
+    }
+
+    Result reversed(const QVector<Path>& paths) const {
+      Result r;
+      for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        const Path& path = paths.at(it->index);
+        const Point& first = path.getVertices().first().getPos();
+        const Point& last = path.getVertices().last().getPos();
+        r.append(it->index, !it->reverse, it->reverse ? first : last,
+                 it->reverse ? last : first);
       }
-      r.endPos = end;
       return r;
     }
 
@@ -135,10 +155,15 @@ private:
     }
   };
 
-  static void findAllPaths(QVector<Result>& result, const QVector<Path>& paths,
-                           const QElapsedTimer& timer, qint64 timeoutMs,
-                           const Result& prefix = Result(),
-                           bool* timedOut = nullptr) noexcept;
+  /// Indices of all paths starting or ending at a particular position
+  typedef QHash<Point, QVector<int>> Graph;
+
+  static bool findAllPaths(QVector<Result>& result, const QVector<Path>& paths,
+                           const Graph& graph, const QVector<int>& indices,
+                           const Result& prefix, int& budget) noexcept;
+  static void findGreedyPaths(QVector<Result>& result,
+                              const QVector<Path>& paths,
+                              const QVector<int>& indices) noexcept;
 
   static std::optional<Result> join(const QVector<Path>& paths,
                                     const Result& prefix, int index,
@@ -36,7 +36,9 @@
 #include "../library/sym/symbol.h"
 #include "../serialization/sexpression.h"
 #include "../sqlitedatabase.h"
+#include "../utils/scopeguard.h"
 #include "workspacelibrarydbwriter.h"
+#include "workspacelibraryelementcache.h"
 #include "workspacelibraryscanner.h"
 
 #include <QtCore>
@@ -47,6 +49,14 @@
  ******************************************************************************/
 namespace librepcb {
 
+/// Context of the function currently executed by
+/// librepcb::WorkspaceLibraryDb::runAsync() in the worker thread
+struct AsyncQueryContext {
+  const WorkspaceLibraryDb* db;
+  const std::function<bool()>* isCanceled;
+};
+static thread_local const AsyncQueryContext* sAsyncQueryContext = nullptr;
+
 static inline std::size_t qHash(const WorkspaceLibraryDb::Part& key,
                                 std::size_t seed = 0) noexcept {
   return ::qHash(qMakePair(key.mpn, key.manufacturer), seed);
@@ -81,6 +91,19 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
     writer.addInternalData("version", sCurrentDbVersion);  // can throw
   }
 
+  // Create the worker thread for asynchronous queries. It never expires to
+  // keep its database connection alive, since connections are thread-bound.
+  mAsyncPool.reset(new QThreadPool());
+  mAsyncPool->setMaxThreadCount(1);
+  mAsyncPool->setExpiryTimeout(-1);
+
+  // Create the element cache and drop outdated elements after every scan.
+  // Connected before anyone else can connect to scanSucceeded(), so other
+  // receivers already get the updated elements.
+  mElementCache.reset(new WorkspaceLibraryElementCache(*this));
+  connect(this, &WorkspaceLibraryDb::scanSucceeded, this,
+          [this]() { mElementCache->validate(); });
+
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mLibrariesPath, mFilePath));
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanStarted, this,
@@ -101,6 +124,10 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
 }
 
 WorkspaceLibraryDb::~WorkspaceLibraryDb() noexcept {
+  // The worker connection must be closed within the thread which opened it.
+  QtConcurrent::run(mAsyncPool.data(), [this]() { mAsyncDb.reset(); })
+      .waitForFinished();
+  mAsyncPool->waitForDone();
 }
 
 /*******************************************************************************
@@ -128,7 +155,7 @@ template QList<Uuid> WorkspaceLibraryDb::find<Device>(
 template <>
 QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
   // ATTENTION: Keep SQL in sync with the generig find() method below!
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT packages.uuid FROM packages "
       "LEFT JOIN packages_tr "
       "ON packages.id = packages_tr.element_id "
@@ -142,7 +169,7 @@ QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
       "ORDER BY packages_tr.name ASC");
   query.bindValue(":keyword", keyword);
   query.bindValue(":escapedKeyword", "%" + keyword + "%");
-  mDb->exec(query);
+  db().exec(query);
 
   QList<Uuid> uuids;
   while (query.next()) {
@@ -153,7 +180,7 @@ QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
 
 QList<Uuid> WorkspaceLibraryDb::findDevicesOfParts(
     const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT devices.uuid FROM devices "
       "LEFT JOIN parts "
       "ON devices.id = parts.device_id "
@@ -164,7 +191,7 @@ QList<Uuid> WorkspaceLibraryDb::findDevicesOfParts(
       "GROUP BY devices.uuid "
       "ORDER BY devices_tr.name ASC");
   query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
+  db().exec(query);
 
   QList<Uuid> uuids;
   while (query.next()) {
@@ -175,9 +202,9 @@ QList<Uuid> WorkspaceLibraryDb::findDevicesOfParts(
 
 QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::findPartsOfDevice(
     const Uuid& device, const QString& keyword) const {
-  SQLiteDatabase::TransactionScopeGuard sg(*mDb);  // Atomic attributes query!
+  SQLiteDatabase::TransactionScopeGuard sg(db());  // Atomic attributes query!
 
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT parts.id, mpn, manufacturer FROM parts "
       "LEFT JOIN devices "
       "ON devices.id = parts.device_id "
@@ -185,7 +212,7 @@ QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::findPartsOfDevice(
       "AND (parts.mpn LIKE :keyword OR parts.manufacturer LIKE :keyword)");
   query.bindValue(":device", device.toStr());
   query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
+  db().exec(query);
 
   QSet<Part> parts;
   while (query.next()) {
@@ -198,12 +225,12 @@ QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::findPartsOfDevice(
 bool WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
                                             QPixmap* icon,
                                             QString* manufacturer) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT icon_png, manufacturer FROM libraries "
       "WHERE filepath = :filepath "
       "LIMIT 1");
   query.bindValue(":filepath", libDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  db().exec(query);
 
   if (!query.next()) {
     qWarning() << "Library not found in database:" << libDir.toStr();
@@ -221,12 +248,12 @@ bool WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
 
 bool WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
                                            Uuid* cmpUuid, Uuid* pkgUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery& query = db().prepareCachedQuery(
       "SELECT component_uuid, package_uuid FROM devices "
       "WHERE filepath = :filepath "
       "LIMIT 1");
   query.bindValue(":filepath", devDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  db().exec(query);
 
   if (!query.next()) {
     qWarning() << "Device not found in database:" << devDir.toStr();
@@ -239,41 +266,103 @@ bool WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
   if (pkgUuid) {
     *pkgUuid = Uuid::fromString(query.value(1).toString());  // can throw
   }
+  query.finish();
   return true;
 }
 
+QHash<FilePath, std::pair<Uuid, Uuid>> WorkspaceLibraryDb::getDeviceMetadata(
+    const QList<FilePath>& devDirs) const {
+  QHash<QString, FilePath> filePaths;
+  foreach (const FilePath& fp, devDirs) {
+    filePaths.insert(fp.toRelative(mLibrariesPath), fp);
+  }
+
+  QHash<FilePath, std::pair<Uuid, Uuid>> result;
+  execBulkQuery(
+      "SELECT filepath, component_uuid, package_uuid FROM devices "
+      "WHERE filepath IN (%values)",
+      {}, filePaths.keys(), [&](QSqlQuery& query) {
+        result.insert(
+            filePaths.value(query.value(0).toString()),
+            std::make_pair(
+                Uuid::fromString(query.value(1).toString()),  // can throw
+                Uuid::fromString(query.value(2).toString())));  // can throw
+      });
+  return result;
+}
+
 /*******************************************************************************
  *  Getters: Special
  ******************************************************************************/
 
 QSet<Uuid> WorkspaceLibraryDb::getComponentDevices(
     const Uuid& component) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT uuid FROM devices "
       "WHERE component_uuid = :uuid "
       "GROUP BY uuid");
   query.bindValue(":uuid", component.toStr());
-  mDb->exec(query);
+  db().exec(query);
   return getUuidSet(query);
 }
 
 QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::getDeviceParts(
     const Uuid& device) const {
-  SQLiteDatabase::TransactionScopeGuard sg(*mDb);  // Atomic attributes query!
+  return getDeviceParts(QSet<Uuid>{device}).value(device);
+}
 
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT parts.id, mpn, manufacturer FROM parts "
-      "LEFT JOIN devices ON devices.id = parts.device_id "
-      "WHERE devices.uuid = :device");
-  query.bindValue(":device", device.toStr());
-  mDb->exec(query);
+QHash<Uuid, QList<WorkspaceLibraryDb::Part>> WorkspaceLibraryDb::getDeviceParts(
+    const QSet<Uuid>& devices) const {
+  SQLiteDatabase::TransactionScopeGuard sg(db());  // Atomic attributes query!
+
+  QStringList uuids;
+  foreach (const Uuid& uuid, devices) {
+    uuids.append(uuid.toStr());
+  }
+
+  // Fetch parts together with their attributes, ordered by ID to keep the
+  // attributes in the same order as they were added.
+  QMap<int, std::pair<Uuid, Part>> parts;
+  execBulkQuery(
+      "SELECT devices.uuid, parts.id, parts.mpn, parts.manufacturer, "
+      "parts_attr.key, parts_attr.type, parts_attr.value, parts_attr.unit "
+      "FROM parts "
+      "INNER JOIN devices ON devices.id = parts.device_id "
+      "LEFT JOIN parts_attr ON parts.id = parts_attr.part_id "
+      "WHERE devices.uuid IN (%values) "
+      "ORDER BY parts.id, parts_attr.id",
+      {}, uuids, [&parts](QSqlQuery& query) {
+        const int partId = query.value(1).toInt();
+        auto it = parts.find(partId);
+        if (it == parts.end()) {
+          it = parts.insert(
+              partId,
+              std::make_pair(
+                  Uuid::fromString(query.value(0).toString()),  // can throw
+                  Part{query.value(2).toString(), query.value(3).toString(),
+                       AttributeList()}));
+        }
+        if (!query.value(4).isNull()) {
+          const AttributeKey key(query.value(4).toString());  // can throw
+          const AttributeType* type = &AttributeType::fromString(
+              query.value(5).toString());  // can throw
+          const QString value = query.value(6).toString();
+          const AttributeUnit* unit =
+              type->getUnitFromString(query.value(7).toString());
+          it->second.attributes.append(
+              std::make_shared<Attribute>(key, *type, value, unit));
+        }
+      });
 
-  QSet<Part> parts;
-  while (query.next()) {
-    parts.insert(Part{query.value(1).toString(), query.value(2).toString(),
-                      getPartAttributes(query.value(0).toInt())});
+  QHash<Uuid, QSet<Part>> partsPerDevice;
+  foreach (const auto& pair, parts) {
+    partsPerDevice[pair.first].insert(pair.second);
   }
-  return Toolbox::sortedQSet(parts);
+  QHash<Uuid, QList<Part>> result;
+  for (auto it = partsPerDevice.begin(); it != partsPerDevice.end(); it++) {
+    result.insert(it.key(), Toolbox::sortedQSet(it.value()));
+  }
+  return result;
 }
 
 /*******************************************************************************
@@ -284,6 +373,11 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept {
   mLibraryScanner->startScan();
 }
 
+void WorkspaceLibraryDb::startSingleLibraryRescan(
+    const FilePath& libDir) noexcept {
+  mLibraryScanner->startScan(libDir);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -313,14 +407,14 @@ QMultiMap<Version, FilePath> WorkspaceLibraryDb::getAll(
     sql += "WHERE " % conditions.join(" AND ") % " ";
   }
 
-  QSqlQuery query = mDb->prepareQuery(sql, {{"%elements", elementsTable}});
+  QSqlQuery query = db().prepareQuery(sql, {{"%elements", elementsTable}});
   if (uuid) {
     query.bindValue(":uuid", uuid->toStr());
   }
   if (lib.isValid()) {
     query.bindValue(":filepath", lib.toRelative(mLibrariesPath));
   }
-  mDb->exec(query);
+  db().exec(query);
 
   QMultiMap<Version, FilePath> elements;
   while (query.next()) {
@@ -345,10 +439,46 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
     return list.last();  // highest version number
 }
 
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatest(
+    const QString& elementsTable, const QSet<Uuid>& uuids) const {
+  QStringList values;
+  foreach (const Uuid& uuid, uuids) {
+    values.append(uuid.toStr());
+  }
+
+  QHash<Uuid, std::pair<Version, FilePath>> elements;
+  execBulkQuery(
+      "SELECT uuid, version, filepath FROM %elements "
+      "WHERE uuid IN (%values)",
+      {{"%elements", elementsTable}}, values, [&](QSqlQuery& query) {
+        const Uuid uuid =
+            Uuid::fromString(query.value(0).toString());  // can throw
+        const Version version =
+            Version::fromString(query.value(1).toString());  // can throw
+        const FilePath filepath(
+            FilePath::fromRelative(mLibrariesPath, query.value(2).toString()));
+        if (!filepath.isValid()) {
+          throw LogicError(__FILE__, __LINE__);
+        }
+        auto it = elements.find(uuid);
+        if (it == elements.end()) {
+          elements.insert(uuid, std::make_pair(version, filepath));
+        } else if (version > it->first) {
+          *it = std::make_pair(version, filepath);
+        }
+      });
+
+  QHash<Uuid, FilePath> result;
+  for (auto it = elements.begin(); it != elements.end(); it++) {
+    result.insert(it.key(), it.value().second);
+  }
+  return result;
+}
+
 QList<Uuid> WorkspaceLibraryDb::find(const QString& elementsTable,
                                      const QString& keyword) const {
   // ATTENTION: Keep SQL in sync with the find<Package>() method above!
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT %elements.uuid FROM %elements "
       "LEFT JOIN %elements_tr "
       "ON %elements.id = %elements_tr.element_id "
@@ -362,7 +492,7 @@ QList<Uuid> WorkspaceLibraryDb::find(const QString& elementsTable,
       });
   query.bindValue(":keyword", keyword);
   query.bindValue(":escapedKeyword", "%" + keyword + "%");
-  mDb->exec(query);
+  db().exec(query);
 
   QList<Uuid> uuids;
   while (query.next()) {
@@ -376,7 +506,7 @@ bool WorkspaceLibraryDb::getTranslations(const QString& elementsTable,
                                          const QStringList& localeOrder,
                                          QString* name, QString* description,
                                          QString* keywords) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery& query = db().prepareCachedQuery(
       "SELECT locale, name, description, keywords FROM %elements_tr "
       "INNER JOIN %elements "
       "ON %elements.id = %elements_tr.element_id "
@@ -385,7 +515,7 @@ bool WorkspaceLibraryDb::getTranslations(const QString& elementsTable,
           {"%elements", elementsTable},
       });
   query.bindValue(":filepath", elemDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  db().exec(query);
 
   // Using LocalizedDescriptionMap for all values since it allows empty strings
   // (in contrast to LocalizedNameMap, which is more restrictive).
@@ -410,10 +540,71 @@ bool WorkspaceLibraryDb::getTranslations(const QString& elementsTable,
   return elementFound;
 }
 
+QHash<FilePath, WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfos(const QString& elementsTable,
+                                        const QList<FilePath>& elemDirs,
+                                        const QStringList& localeOrder) const {
+  struct Translation {
+    QString locale;
+    QString name;
+    QString description;
+    QString keywords;
+  };
+  struct Element {
+    bool deprecated = false;
+    QVector<Translation> translations;
+  };
+
+  QHash<QString, FilePath> filePaths;
+  foreach (const FilePath& fp, elemDirs) {
+    filePaths.insert(fp.toRelative(mLibrariesPath), fp);
+  }
+
+  QHash<QString, Element> elements;
+  execBulkQuery(
+      "SELECT %elements.filepath, %elements.deprecated, %elements_tr.locale, "
+      "%elements_tr.name, %elements_tr.description, %elements_tr.keywords "
+      "FROM %elements "
+      "LEFT JOIN %elements_tr "
+      "ON %elements.id = %elements_tr.element_id "
+      "WHERE %elements.filepath IN (%values)",
+      {{"%elements", elementsTable}}, filePaths.keys(),
+      [&elements](QSqlQuery& query) {
+        Element& element = elements[query.value(0).toString()];
+        element.deprecated = query.value(1).toBool();
+        if (!query.value(2).isNull()) {
+          element.translations.append(Translation{
+              query.value(2).toString(), query.value(3).toString(),
+              query.value(4).toString(), query.value(5).toString()});
+        }
+      });
+
+  // Same logic as in getTranslations().
+  QHash<FilePath, ElementInfo> result;
+  for (auto it = elements.begin(); it != elements.end(); it++) {
+    LocalizedDescriptionMap nameMap(QString{});
+    LocalizedDescriptionMap descriptionMap(QString{});
+    LocalizedDescriptionMap keywordsMap(QString{});
+    foreach (const Translation& t, it.value().translations) {
+      if (!t.name.isNull()) nameMap.insert(t.locale, t.name);
+      if (!t.description.isNull()) {
+        descriptionMap.insert(t.locale, t.description);
+      }
+      if (!t.keywords.isNull()) keywordsMap.insert(t.locale, t.keywords);
+    }
+    result.insert(filePaths.value(it.key()),
+                  ElementInfo{nameMap.value(localeOrder),
+                              descriptionMap.value(localeOrder),
+                              keywordsMap.value(localeOrder),
+                              it.value().deprecated});
+  }
+  return result;
+}
+
 bool WorkspaceLibraryDb::getMetadata(const QString& elementsTable,
                                      const FilePath elemDir, Uuid* uuid,
                                      Version* version, bool* deprecated) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery& query = db().prepareCachedQuery(
       "SELECT uuid, version, deprecated FROM %elements "
       "WHERE filepath = :filepath "
       "LIMIT 1",
@@ -421,7 +612,7 @@ bool WorkspaceLibraryDb::getMetadata(const QString& elementsTable,
           {"%elements", elementsTable},
       });
   query.bindValue(":filepath", elemDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  db().exec(query);
 
   if (!query.next()) {
     qWarning() << "Element not found in database:" << elemDir.toStr();
@@ -437,13 +628,14 @@ bool WorkspaceLibraryDb::getMetadata(const QString& elementsTable,
   if (deprecated) {
     *deprecated = query.value(2).toBool();
   }
+  query.finish();
   return true;
 }
 
 bool WorkspaceLibraryDb::getCategoryMetadata(
     const QString& categoriesTable, const FilePath catDir,
     std::optional<Uuid>* parent) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery& query = db().prepareCachedQuery(
       "SELECT parent_uuid FROM %categories "
       "WHERE filepath = :filepath "
       "LIMIT 1",
@@ -451,7 +643,7 @@ bool WorkspaceLibraryDb::getCategoryMetadata(
           {"%categories", categoriesTable},
       });
   query.bindValue(":filepath", catDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  db().exec(query);
 
   if (!query.next()) {
     qWarning() << "Category not found in database:" << catDir.toStr();
@@ -461,15 +653,16 @@ bool WorkspaceLibraryDb::getCategoryMetadata(
   if (parent) {
     *parent = Uuid::tryFromString(query.value(0).toString());
   }
+  query.finish();
   return true;
 }
 
 AttributeList WorkspaceLibraryDb::getPartAttributes(int partId) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT key, type, value, unit FROM parts_attr "
       "WHERE part_id = :part_id");
   query.bindValue(":part_id", partId);
-  mDb->exec(query);
+  db().exec(query);
 
   AttributeList attributes;
   while (query.next()) {
@@ -492,14 +685,14 @@ QSet<Uuid> WorkspaceLibraryDb::getChilds(
       {"%categories", categoriesTable},
   };
   if (categoryUuid) {
-    query = mDb->prepareQuery(
+    query = db().prepareQuery(
         "SELECT uuid FROM %categories "
         "WHERE parent_uuid = :category_uuid "
         "GROUP BY uuid",
         replacements);
     query.bindValue(":category_uuid", categoryUuid->toStr());
   } else {
-    query = mDb->prepareQuery(
+    query = db().prepareQuery(
         "SELECT children.uuid FROM %categories AS children "
         "LEFT JOIN %categories AS parents "
         "ON children.parent_uuid = parents.uuid "
@@ -507,7 +700,7 @@ QSet<Uuid> WorkspaceLibraryDb::getChilds(
         "GROUP BY children.uuid",
         replacements);
   }
-  mDb->exec(query);
+  db().exec(query);
   return getUuidSet(query);
 }
 
@@ -521,7 +714,7 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(
   };
   if (category) {
     // Find all elements assigned to the specified category.
-    query = mDb->prepareQuery(
+    query = db().prepareQuery(
         "SELECT %elements.uuid FROM %elements "
         "INNER JOIN %elements_cat "
         "ON %elements.id = %elements_cat.element_id "
@@ -532,7 +725,7 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(
     query.bindValue(":uuid", category->toStr());
   } else {
     // Find all elements with no (existent) category.
-    query = mDb->prepareQuery(
+    query = db().prepareQuery(
         "SELECT %elements.uuid FROM %elements "
         "LEFT JOIN %elements_cat "
         "ON %elements.id = %elements_cat.element_id "
@@ -544,7 +737,7 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(
         replacements);
   }
   query.bindValue(":limit", limit);
-  mDb->exec(query);
+  db().exec(query);
   return getUuidSet(query);
 }
 
@@ -555,7 +748,7 @@ QSet<Uuid> WorkspaceLibraryDb::getGenerated(const QString& elementsTable,
   }
 
   QSqlQuery query;
-  query = mDb->prepareQuery(
+  query = db().prepareQuery(
       "SELECT uuid FROM %elements "
       "WHERE generated_by = :generated_by "
       "GROUP BY uuid",
@@ -563,13 +756,29 @@ QSet<Uuid> WorkspaceLibraryDb::getGenerated(const QString& elementsTable,
           {"%elements", elementsTable},
       });
   query.bindValue(":generated_by", generatedBy);
-  mDb->exec(query);
+  db().exec(query);
   return getUuidSet(query);
 }
 
+QSet<QString> WorkspaceLibraryDb::getAllGeneratedBy(
+    const QString& elementsTable) const {
+  QSqlQuery query = db().prepareQuery(
+      "SELECT DISTINCT generated_by FROM %elements "
+      "WHERE generated_by IS NOT NULL AND generated_by != ''",
+      {
+          {"%elements", elementsTable},
+      });
+  db().exec(query);
+  QSet<QString> result;
+  while (query.next()) {
+    result.insert(query.value(0).toString());
+  }
+  return result;
+}
+
 ResourceList WorkspaceLibraryDb::getResources(const QString& elementsTable,
                                               const FilePath& elemDir) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = db().prepareQuery(
       "SELECT name, media_type, url FROM %elements_res "
       "LEFT JOIN %elements ON %elements.id = %elements_res.element_id "
       "WHERE %elements.filepath = :filepath",
@@ -577,7 +786,7 @@ ResourceList WorkspaceLibraryDb::getResources(const QString& elementsTable,
           {"%elements", elementsTable},
       });
   query.bindValue(":filepath", elemDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  db().exec(query);
 
   ResourceList res;
   while (query.next()) {
@@ -589,6 +798,81 @@ ResourceList WorkspaceLibraryDb::getResources(const QString& elementsTable,
   return res;
 }
 
+void WorkspaceLibraryDb::execBulkQuery(
+    const QString& sql, const SQLiteDatabase::Replacements& replacements,
+    const QStringList& values,
+    const std::function<void(QSqlQuery&)>& callback) const {
+  if (values.isEmpty()) {
+    return;
+  }
+
+  // To be able to cache the prepared statement, the number of placeholders
+  // is fixed. Values are bound in chunks, padded with NULL which never
+  // matches in an IN() clause.
+  QStringList placeholders;
+  for (int i = 0; i < sBulkQueryChunkSize; ++i) {
+    placeholders.append(":value" % QString::number(i));
+  }
+  SQLiteDatabase::Replacements allReplacements = replacements;
+  allReplacements.append(
+      std::make_pair(QString("%values"), placeholders.join(", ")));
+  QSqlQuery& query =
+      db().prepareCachedQuery(sql, allReplacements);  // can throw
+  try {
+    for (int offset = 0; offset < values.count();
+         offset += sBulkQueryChunkSize) {
+      for (int i = 0; i < sBulkQueryChunkSize; ++i) {
+        const int index = offset + i;
+        query.bindValue(placeholders.at(i),
+                        (index < values.count()) ? QVariant(values.at(index))
+                                                 : QVariant());
+      }
+      db().exec(query);  // can throw
+      while (query.next()) {
+        callback(query);  // can throw
+      }
+    }
+    query.finish();
+  } catch (...) {
+    query.finish();  // Don't keep the read transaction open.
+    throw;
+  }
+}
+
+void WorkspaceLibraryDb::execAsync(
+    const std::function<void()>& func, const std::function<bool()>& isCanceled,
+    const std::function<void(const QException&)>& setException)
+    const noexcept {
+  try {
+    if (isCanceled()) {
+      return;
+    }
+    if (!mAsyncDb) {
+      mAsyncDb.reset(new SQLiteDatabase(mFilePath));  // can throw
+    }
+    const AsyncQueryContext context{this, &isCanceled};
+    sAsyncQueryContext = &context;
+    auto sg = scopeGuard([]() { sAsyncQueryContext = nullptr; });
+    func();  // can throw
+  } catch (const UserCanceled&) {
+    // Aborted by db() since the future has been canceled, nothing to do.
+  } catch (const Exception& e) {
+    setException(e);
+  } catch (const std::exception& e) {
+    setException(LogicError(__FILE__, __LINE__, e.what()));
+  }
+}
+
+SQLiteDatabase& WorkspaceLibraryDb::db() const {
+  if (sAsyncQueryContext && (sAsyncQueryContext->db == this)) {
+    if ((*sAsyncQueryContext->isCanceled)()) {
+      throw UserCanceled(__FILE__, __LINE__);
+    }
+    return *mAsyncDb;
+  }
+  return *mDb;
+}
+
 QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
   QSet<Uuid> uuids;
   while (query.next()) {
@@ -599,10 +883,10 @@ QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
 
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = db().prepareQuery(
         "SELECT value_int FROM internal "
         "WHERE key = 'version'");
-    mDb->exec(query);
+    db().exec(query);
     if (query.next()) {
       bool ok = false;
       int version = query.value(0).toInt(&ok);
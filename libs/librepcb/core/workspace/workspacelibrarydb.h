@@ -30,8 +30,11 @@
 #include "../types/uuid.h"
 #include "../types/version.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -46,6 +49,7 @@ class Package;
 class PackageCategory;
 class SQLiteDatabase;
 class Symbol;
+class WorkspaceLibraryElementCache;
 class WorkspaceLibraryScanner;
 
 /*******************************************************************************
@@ -102,6 +106,13 @@ public:
     }
   };
 
+  struct ElementInfo {
+    QString name;
+    QString description;
+    QString keywords;
+    bool deprecated = false;
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb() = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -142,6 +153,17 @@ public:
    */
   int getScanProgressPercent() const noexcept;
 
+  /**
+   * @brief Get the shared cache of opened library elements
+   *
+   * The cache is validated automatically after each library scan.
+   *
+   * @return Element cache (thread-safe).
+   */
+  WorkspaceLibraryElementCache& getElementCache() const noexcept {
+    return *mElementCache;
+  }
+
   /**
    * @brief Get elements, optionally matching some criteria
    *
@@ -174,6 +196,22 @@ public:
     return getLatestVersionFilePath(getAll<ElementType>(uuid));
   }
 
+  /**
+   * @brief Get elements of specific UUIDs and the highest version
+   *
+   * Same as #getLatest(const Uuid&), but for many elements at once with
+   * only few database queries.
+   *
+   * @param uuids The UUIDs of the elements to get.
+   *
+   * @return  Filepaths of the elements with the highest version number,
+   *          for all UUIDs which were found in the database.
+   */
+  template <typename ElementType>
+  QHash<Uuid, FilePath> getLatest(const QSet<Uuid>& uuids) const {
+    return getLatest(getTable<ElementType>(), uuids);
+  }
+
   /**
    * @brief Find elements by keyword
    *
@@ -238,6 +276,27 @@ public:
                            description, keywords);
   }
 
+  /**
+   * @brief Get translations and metadata of several elements at once
+   *
+   * Same as calling #getTranslations() and #getMetadata() for each element,
+   * but with only few database queries, which is much faster for many
+   * elements.
+   *
+   * @tparam ElementType  Type of the library element.
+   *
+   * @param elemDirs      Library element directories.
+   * @param localeOrder   Locale order (highest priority first).
+   *
+   * @return  Translated name, description, keywords and deprecation flag
+   *          of all elements which were found in the database.
+   */
+  template <typename ElementType>
+  QHash<FilePath, ElementInfo> getElementInfos(
+      const QList<FilePath>& elemDirs, const QStringList& localeOrder) const {
+    return getElementInfos(getTable<ElementType>(), elemDirs, localeOrder);
+  }
+
   /**
    * @brief Get metadata of a specific element
    *
@@ -314,6 +373,20 @@ public:
   bool getDeviceMetadata(const FilePath& devDir, Uuid* cmpUuid = nullptr,
                          Uuid* pkgUuid = nullptr) const;
 
+  /**
+   * @brief Get additional metadata of several devices at once
+   *
+   * Same as #getDeviceMetadata(), but for many devices at once with only
+   * few database queries.
+   *
+   * @param devDirs       Device directories.
+   *
+   * @return  Component UUID and package UUID of all devices which were found
+   *          in the database.
+   */
+  QHash<FilePath, std::pair<Uuid, Uuid>> getDeviceMetadata(
+      const QList<FilePath>& devDirs) const;
+
   /**
    * @brief Get children categories of a specific category
    *
@@ -384,6 +457,26 @@ public:
     return getGenerated(getTable<ElementType>(), generatedBy);
   }
 
+  /**
+   * @brief Get all "generated_by" identifiers of a given element type
+   *
+   * Allows to check many identifiers at once without querying the database
+   * for each of them with #getGenerated().
+   *
+   * @tparam ElementType  Type of the library element.
+   *
+   * @return All non-empty "generated_by" identifiers.
+   */
+  template <typename ElementType>
+  QSet<QString> getAllGeneratedBy() const {
+    static_assert(std::is_same<ElementType, Symbol>::value ||
+                      std::is_same<ElementType, Package>::value ||
+                      std::is_same<ElementType, Component>::value ||
+                      std::is_same<ElementType, Device>::value,
+                  "Unsupported ElementType");
+    return getAllGeneratedBy(getTable<ElementType>());
+  }
+
   /**
    * @brief Get resources of a specific library element
    *
@@ -419,13 +512,67 @@ public:
    */
   QList<Part> getDeviceParts(const Uuid& device) const;
 
+  /**
+   * @brief Get all parts of several devices at once
+   *
+   * Same as #getDeviceParts(const Uuid&), but for many devices at once with
+   * only few database queries.
+   *
+   * @param devices     Device UUIDs to get the parts of.
+   *
+   * @return All parts of all devices which contain any parts.
+   */
+  QHash<Uuid, QList<Part>> getDeviceParts(const QSet<Uuid>& devices) const;
+
   // General Methods
 
+  /**
+   * @brief Run database queries asynchronously in a worker thread
+   *
+   * The passed function is executed in a dedicated worker thread which has
+   * its own connection to the database, thus the calling thread is not
+   * blocked. Within the function, all the getters of the passed database
+   * object can be used as usual. Queries are executed one after the other,
+   * in the order they were started.
+   *
+   * Canceling the returned future (e.g. because the search term has been
+   * changed in the meantime) aborts the function at its next database
+   * access. The future then does not contain any result. Exceptions thrown
+   * by the function are reported through the future.
+   *
+   * @tparam T    Result type of the function.
+   *
+   * @param func  Function to execute in the worker thread. Attention: It
+   *              must not access any objects of the calling thread.
+   *
+   * @return Future of the function result.
+   */
+  template <typename T>
+  QFuture<T> runAsync(
+      const std::function<T(const WorkspaceLibraryDb&)>& func) const {
+    return QtConcurrent::run(
+        mAsyncPool.data(), [this, func](QPromise<T>& promise) {
+          execAsync([&]() { promise.addResult(func(*this)); },
+                    [&]() { return promise.isCanceled(); },
+                    [&](const QException& e) { promise.setException(e); });
+        });
+  }
+
   /**
    * @brief Rescan the whole library directory and update the SQLite database
    */
   void startLibraryRescan() noexcept;
 
+  /**
+   * @brief Rescan a single library and update the SQLite database
+   *
+   * Faster alternative to #startLibraryRescan() if only the elements of one
+   * library have been modified.
+   *
+   * @param libDir  Directory of the library to rescan.
+   */
+  void startSingleLibraryRescan(const FilePath& libDir) noexcept;
+
   // Operator Overloadings
   WorkspaceLibraryDb& operator=(const WorkspaceLibraryDb& rhs) = delete;
 
@@ -444,10 +591,15 @@ private:
                                       const FilePath& lib) const;
   FilePath getLatestVersionFilePath(
       const QMultiMap<Version, FilePath>& list) const noexcept;
+  QHash<Uuid, FilePath> getLatest(const QString& elementsTable,
+                                  const QSet<Uuid>& uuids) const;
   QList<Uuid> find(const QString& elementsTable, const QString& keyword) const;
   bool getTranslations(const QString& elementsTable, const FilePath& elemDir,
                        const QStringList& localeOrder, QString* name,
                        QString* description, QString* keywords) const;
+  QHash<FilePath, ElementInfo> getElementInfos(
+      const QString& elementsTable, const QList<FilePath>& elemDirs,
+      const QStringList& localeOrder) const;
   bool getMetadata(const QString& elementsTable, const FilePath elemDir,
                    Uuid* uuid, Version* version, bool* deprecated) const;
   bool getCategoryMetadata(const QString& categoriesTable,
@@ -462,8 +614,18 @@ private:
                            int limit) const;
   QSet<Uuid> getGenerated(const QString& elementsTable,
                           const QString& generatedBy) const;
+  QSet<QString> getAllGeneratedBy(const QString& elementsTable) const;
   ResourceList getResources(const QString& elementsTable,
                             const FilePath& elemDir) const;
+  void execBulkQuery(const QString& sql,
+                     const QVector<std::pair<QString, QString>>& replacements,
+                     const QStringList& values,
+                     const std::function<void(QSqlQuery&)>& callback) const;
+  void execAsync(const std::function<void()>& func,
+                 const std::function<bool()>& isCanceled,
+                 const std::function<void(const QException&)>& setException)
+      const noexcept;
+  SQLiteDatabase& db() const;
   static QSet<Uuid> getUuidSet(QSqlQuery& query);
   int getDbVersion() const noexcept;
   template <typename ElementType>
@@ -475,10 +637,14 @@ private:
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
   const FilePath mFilePath;  ///< Path to the SQLite database file.
   QScopedPointer<SQLiteDatabase> mDb;  ///< The SQLite database.
+  QScopedPointer<QThreadPool> mAsyncPool;  ///< Single thread for #runAsync().
+  mutable QScopedPointer<SQLiteDatabase> mAsyncDb;  ///< Worker connection.
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  QScopedPointer<WorkspaceLibraryElementCache> mElementCache;
 
   // Constants
   static const int sCurrentDbVersion = 7;
+  static const int sBulkQueryChunkSize = 100;  ///< Values bound per query
 };
 
 /*******************************************************************************
@@ -551,6 +551,18 @@ void WorkspaceLibraryDbWriter::removeAllElements(const QString& elementsTable) {
   mDb.clearTable(elementsTable);
 }
 
+void WorkspaceLibraryDbWriter::removeAllElements(const QString& elementsTable,
+                                                 int libId) {
+  QSqlQuery query = mDb.prepareQuery(
+      "DELETE FROM %elements "
+      "WHERE library_id = :library_id",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":library_id", libId);
+  mDb.exec(query);
+}
+
 int WorkspaceLibraryDbWriter::addTranslation(
     const QString& elementsTable, int elementId, const QString& locale,
     const std::optional<ElementName>& name,
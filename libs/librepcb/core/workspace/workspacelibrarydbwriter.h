@@ -219,6 +219,20 @@ public:
     removeAllElements(getElementTable<ElementType>());
   }
 
+  /**
+   * @brief Remove all library elements of a specific type and library
+   *
+   * @note  This will automatically remove their translations and categories
+   *        as well.
+   *
+   * @tparam ElementType  Type of elements to remove.
+   * @param libId         Library ID of the elements to remove.
+   */
+  template <typename ElementType>
+  void removeAllElements(int libId) {
+    removeAllElements(getElementTable<ElementType>(), libId);
+  }
+
   /**
    * @brief Add a translation for a library element
    *
@@ -332,6 +346,7 @@ private:  // Methods
                   const std::optional<Uuid>& parent);
   void removeElement(const QString& elementsTable, const FilePath& fp);
   void removeAllElements(const QString& elementsTable);
+  void removeAllElements(const QString& elementsTable, int libId);
   int addTranslation(const QString& elementsTable, int elementId,
                      const QString& locale,
                      const std::optional<ElementName>& name,
@@ -0,0 +1,318 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibraryelementcache.h"
+
+#include "../exceptions.h"
+#include "../fileio/transactionaldirectory.h"
+#include "../fileio/transactionalfilesystem.h"
+#include "../library/cat/componentcategory.h"
+#include "../library/cat/packagecategory.h"
+#include "../library/cmp/component.h"
+#include "../library/dev/device.h"
+#include "../library/pkg/package.h"
+#include "../library/sym/symbol.h"
+#include "workspacelibrarydb.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+template <typename ElementType>
+static bool getVersionFromDb(const WorkspaceLibraryDb& db,
+                             const FilePath& elemDir, Version& version) {
+  return db.getMetadata<ElementType>(elemDir, nullptr, &version);
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+WorkspaceLibraryElementCache::WorkspaceLibraryElementCache(
+    const WorkspaceLibraryDb& db) noexcept
+  : mDb(db), mMutex(), mElements(sDefaultCapacity), mLatest(), mPrefetchPool() {
+}
+
+WorkspaceLibraryElementCache::~WorkspaceLibraryElementCache() noexcept {
+  mPrefetchPool.clear();
+  mPrefetchPool.waitForDone();
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+int WorkspaceLibraryElementCache::getCapacity() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mElements.maxCost();
+}
+
+int WorkspaceLibraryElementCache::getCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mElements.count();
+}
+
+bool WorkspaceLibraryElementCache::contains(
+    const FilePath& elemDir) const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mElements.contains(elemDir);
+}
+
+template <typename ElementType>
+std::shared_ptr<const ElementType> WorkspaceLibraryElementCache::get(
+    const FilePath& elemDir) const {
+  if (auto element =
+          std::dynamic_pointer_cast<const ElementType>(getCached(elemDir))) {
+    return element;
+  }
+
+  // Open the element without holding the lock to not block other threads.
+  // If several threads open the same element at the same time, the last one
+  // wins, which doesn't harm. The modification time is determined before
+  // opening, so a modification in the meantime is detected by #validate().
+  const QString fileName = ElementType::getLongElementName() % ".lp";
+  const QDateTime lastModified = getLastModified(elemDir, fileName);
+  std::shared_ptr<const ElementType> element =
+      ElementType::open(std::unique_ptr<TransactionalDirectory>(
+          new TransactionalDirectory(
+              TransactionalFileSystem::openRO(elemDir))));  // can throw
+  insert(elemDir,
+         new Entry{element, fileName, lastModified, element->getVersion(),
+                   &getVersionFromDb<ElementType>});
+  return element;
+}
+
+template <typename ElementType>
+std::shared_ptr<const ElementType> WorkspaceLibraryElementCache::getLatest(
+    const Uuid& uuid) const {
+  const QString type = ElementType::getShortElementName();
+  FilePath elemDir;
+  {
+    QMutexLocker lock(&mMutex);
+    elemDir = mLatest.value(type).value(uuid);
+  }
+  if (!elemDir.isValid()) {
+    elemDir = mDb.getLatest<ElementType>(uuid);  // can throw
+    if (!elemDir.isValid()) {
+      return nullptr;  // Not memoized since it might be added by a scan.
+    }
+    QMutexLocker lock(&mMutex);
+    mLatest[type].insert(uuid, elemDir);
+  }
+  return get<ElementType>(elemDir);  // can throw
+}
+
+// explicit template instantiations
+template std::shared_ptr<const ComponentCategory>
+    WorkspaceLibraryElementCache::get<ComponentCategory>(
+        const FilePath& elemDir) const;
+template std::shared_ptr<const PackageCategory>
+    WorkspaceLibraryElementCache::get<PackageCategory>(
+        const FilePath& elemDir) const;
+template std::shared_ptr<const Symbol>
+    WorkspaceLibraryElementCache::get<Symbol>(const FilePath& elemDir) const;
+template std::shared_ptr<const Package>
+    WorkspaceLibraryElementCache::get<Package>(const FilePath& elemDir) const;
+template std::shared_ptr<const Component>
+    WorkspaceLibraryElementCache::get<Component>(
+        const FilePath& elemDir) const;
+template std::shared_ptr<const Device>
+    WorkspaceLibraryElementCache::get<Device>(const FilePath& elemDir) const;
+template std::shared_ptr<const ComponentCategory>
+    WorkspaceLibraryElementCache::getLatest<ComponentCategory>(
+        const Uuid& uuid) const;
+template std::shared_ptr<const PackageCategory>
+    WorkspaceLibraryElementCache::getLatest<PackageCategory>(
+        const Uuid& uuid) const;
+template std::shared_ptr<const Symbol>
+    WorkspaceLibraryElementCache::getLatest<Symbol>(const Uuid& uuid) const;
+template std::shared_ptr<const Package>
+    WorkspaceLibraryElementCache::getLatest<Package>(const Uuid& uuid) const;
+template std::shared_ptr<const Component>
+    WorkspaceLibraryElementCache::getLatest<Component>(
+        const Uuid& uuid) const;
+template std::shared_ptr<const Device>
+    WorkspaceLibraryElementCache::getLatest<Device>(const Uuid& uuid) const;
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void WorkspaceLibraryElementCache::setCapacity(int capacity) noexcept {
+  QMutexLocker lock(&mMutex);
+  mElements.setMaxCost(std::max(capacity, 0));
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+template <typename ElementType>
+void WorkspaceLibraryElementCache::prefetch(
+    const QList<FilePath>& elemDirs) const noexcept {
+  // Only the latest request is relevant (e.g. the currently selected category
+  // in a dialog), so drop all not yet started requests to not flood the
+  // pool when the user switches quickly between categories.
+  mPrefetchPool.clear();
+  int count = 0;
+  foreach (const FilePath& elemDir, elemDirs) {
+    if (count >= sMaxPrefetchCount) {
+      break;
+    }
+    if (contains(elemDir)) {
+      continue;
+    }
+    ++count;
+    mPrefetchPool.start([this, elemDir]() {
+      try {
+        get<ElementType>(elemDir);  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Failed to prefetch library element:" << e.getMsg();
+      }
+    });
+  }
+}
+
+// explicit template instantiations
+template void WorkspaceLibraryElementCache::prefetch<Symbol>(
+    const QList<FilePath>& elemDirs) const noexcept;
+template void WorkspaceLibraryElementCache::prefetch<Package>(
+    const QList<FilePath>& elemDirs) const noexcept;
+template void WorkspaceLibraryElementCache::prefetch<Component>(
+    const QList<FilePath>& elemDirs) const noexcept;
+template void WorkspaceLibraryElementCache::prefetch<Device>(
+    const QList<FilePath>& elemDirs) const noexcept;
+
+void WorkspaceLibraryElementCache::invalidate(
+    const FilePath& elemDir) noexcept {
+  QMutexLocker lock(&mMutex);
+  mElements.remove(elemDir);
+  for (QHash<Uuid, FilePath>& latest : mLatest) {
+    for (auto it = latest.begin(); it != latest.end();) {
+      if (it.value() == elemDir) {
+        it = latest.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void WorkspaceLibraryElementCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mElements.clear();
+  mLatest.clear();
+}
+
+void WorkspaceLibraryElementCache::validate() noexcept {
+  // Take a snapshot of the entries to check, so the lock is not held while
+  // querying the database and the file system. Otherwise all threads
+  // requesting elements would be blocked during the validation.
+  struct Item {
+    FilePath elemDir;
+    std::shared_ptr<const LibraryBaseElement> element;
+    Entry entry;
+  };
+  QVector<Item> items;
+  {
+    // Note: Accessing the entries of QCache marks them as recently used, so
+    // the LRU order of the remaining elements is lost. That's acceptable
+    // since it only happens once per library scan.
+    QMutexLocker lock(&mMutex);
+    mLatest.clear();  // The latest versions may have been changed.
+    items.reserve(mElements.count());
+    foreach (const FilePath& elemDir, mElements.keys()) {
+      const Entry* entry = mElements.object(elemDir);
+      items.append(Item{elemDir, entry->element, *entry});
+    }
+  }
+
+  // Check all entries without holding the lock.
+  QVector<Item> outdated;
+  for (const Item& item : items) {
+    bool valid = false;
+    try {
+      const Entry& entry = item.entry;
+      Version version = entry.version;
+      valid = entry.getMetadata(mDb, item.elemDir, version) &&  // can throw
+          (version == entry.version) &&
+          (getLastModified(item.elemDir, entry.fileName) ==
+           entry.lastModified);
+    } catch (const Exception& e) {
+      qWarning() << "Failed to validate cached library element:"
+                 << e.getMsg();
+    }
+    if (!valid) {
+      outdated.append(item);
+    }
+  }
+
+  // Remove the outdated entries, unless they have been replaced in the
+  // meantime (then the new entry is up-to-date anyway).
+  int removed = 0;
+  {
+    QMutexLocker lock(&mMutex);
+    for (const Item& item : outdated) {
+      const Entry* entry = mElements.object(item.elemDir);
+      if (entry && (entry->element == item.element)) {
+        mElements.remove(item.elemDir);
+        ++removed;
+      }
+    }
+  }
+  if (removed > 0) {
+    qDebug() << "Removed" << removed
+             << "outdated library elements from the cache.";
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<const LibraryBaseElement>
+    WorkspaceLibraryElementCache::getCached(
+        const FilePath& elemDir) const noexcept {
+  QMutexLocker lock(&mMutex);
+  const Entry* entry = mElements.object(elemDir);
+  return entry ? entry->element : nullptr;
+}
+
+void WorkspaceLibraryElementCache::insert(const FilePath& elemDir,
+                                          Entry* entry) const noexcept {
+  QMutexLocker lock(&mMutex);
+  mElements.insert(elemDir, entry);  // Takes ownership.
+}
+
+QDateTime WorkspaceLibraryElementCache::getLastModified(
+    const FilePath& elemDir, const QString& fileName) noexcept {
+  return QFileInfo(elemDir.getPathTo(fileName).toStr()).lastModified();
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,231 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_WORKSPACELIBRARYELEMENTCACHE_H
+#define LIBREPCB_CORE_WORKSPACELIBRARYELEMENTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+#include "../types/uuid.h"
+#include "../types/version.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class LibraryBaseElement;
+class WorkspaceLibraryDb;
+
+/*******************************************************************************
+ *  Class WorkspaceLibraryElementCache
+ ******************************************************************************/
+
+/**
+ * @brief Thread-safe cache of opened workspace library elements
+ *
+ * Opening library elements from disk is rather expensive, so all the editors
+ * and dialogs share this cache (owned by ::librepcb::WorkspaceLibraryDb)
+ * instead of opening the same elements again and again. Elements are opened
+ * read-only and are handed out as immutable shared pointers, so they can be
+ * used from any thread. The least recently used elements are evicted once
+ * the capacity of the cache is exceeded.
+ *
+ * After every library scan, #validate() is called to drop all elements whose
+ * version in the database or whose file on disk has been changed.
+ */
+class WorkspaceLibraryElementCache final {
+public:
+  // Constructors / Destructor
+  WorkspaceLibraryElementCache() = delete;
+  WorkspaceLibraryElementCache(const WorkspaceLibraryElementCache& other) =
+      delete;
+  explicit WorkspaceLibraryElementCache(const WorkspaceLibraryDb& db) noexcept;
+  ~WorkspaceLibraryElementCache() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get the maximum number of cached elements
+   *
+   * @return Capacity of the cache.
+   */
+  int getCapacity() const noexcept;
+
+  /**
+   * @brief Get the number of currently cached elements
+   *
+   * @return Number of elements.
+   */
+  int getCount() const noexcept;
+
+  /**
+   * @brief Check if an element is currently cached
+   *
+   * @param elemDir   Library element directory.
+   *
+   * @return Whether the element is cached or not.
+   */
+  bool contains(const FilePath& elemDir) const noexcept;
+
+  /**
+   * @brief Get a library element by its directory
+   *
+   * If the element is not cached yet, it is opened (read-only) from disk.
+   * This method can be called from any thread.
+   *
+   * @tparam ElementType  Type of the library element.
+   *
+   * @param elemDir       Library element directory.
+   *
+   * @return The opened element (never nullptr).
+   *
+   * @throw Exception If the element could not be opened.
+   */
+  template <typename ElementType>
+  std::shared_ptr<const ElementType> get(const FilePath& elemDir) const;
+
+  /**
+   * @brief Get the latest version of a library element by its UUID
+   *
+   * The file path is resolved with
+   * ::librepcb::WorkspaceLibraryDb::getLatest(), thus this method must be
+   * called either in the thread the database belongs to, or within
+   * ::librepcb::WorkspaceLibraryDb::runAsync().
+   *
+   * @tparam ElementType  Type of the library element.
+   *
+   * @param uuid          UUID of the element.
+   *
+   * @return The opened element, or nullptr if it doesn't exist.
+   *
+   * @throw Exception If the element could not be opened.
+   */
+  template <typename ElementType>
+  std::shared_ptr<const ElementType> getLatest(const Uuid& uuid) const;
+
+  // Setters
+
+  /**
+   * @brief Set the maximum number of cached elements
+   *
+   * @param capacity  New capacity. If lower than the current number of
+   *                  cached elements, the least recently used elements
+   *                  are evicted immediately.
+   */
+  void setCapacity(int capacity) noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Open elements in the background
+   *
+   * Opens the passed elements in worker threads and adds them to the cache,
+   * so subsequent calls to #get() return immediately. Elements which are
+   * already cached or which fail to open are skipped. Pending elements of
+   * previous calls which are not opened yet are discarded, and at most
+   * #sMaxPrefetchCount elements are opened per call.
+   *
+   * @tparam ElementType  Type of the library elements.
+   *
+   * @param elemDirs      Library element directories.
+   */
+  template <typename ElementType>
+  void prefetch(const QList<FilePath>& elemDirs) const noexcept;
+
+  /**
+   * @brief Remove a single element from the cache
+   *
+   * @param elemDir   Library element directory.
+   */
+  void invalidate(const FilePath& elemDir) noexcept;
+
+  /**
+   * @brief Remove all elements from the cache
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Remove all outdated elements from the cache
+   *
+   * Compares the version of each cached element with the database and the
+   * modification time of its file on disk. Elements which have been
+   * modified, moved or removed are evicted. Must be called in the thread
+   * the database belongs to, typically after a library scan.
+   */
+  void validate() noexcept;
+
+  // Operator Overloadings
+  WorkspaceLibraryElementCache& operator=(
+      const WorkspaceLibraryElementCache& rhs) = delete;
+
+private:  // Types
+  typedef bool (*MetadataGetter)(const WorkspaceLibraryDb& db,
+                                 const FilePath& elemDir, Version& version);
+
+  struct Entry {
+    std::shared_ptr<const LibraryBaseElement> element;
+    QString fileName;  ///< Name of the main file within the element dir.
+    QDateTime lastModified;  ///< Modification time of the main file.
+    Version version;  ///< Version of the element at the time it was opened.
+    MetadataGetter getMetadata;  ///< Reads the version from the database.
+  };
+
+private:  // Methods
+  std::shared_ptr<const LibraryBaseElement> getCached(
+      const FilePath& elemDir) const noexcept;
+  void insert(const FilePath& elemDir, Entry* entry) const noexcept;
+  static QDateTime getLastModified(const FilePath& elemDir,
+                                   const QString& fileName) noexcept;
+
+private:  // Data
+  const WorkspaceLibraryDb& mDb;
+
+  /// Protects #mElements and #mLatest, since elements may be requested from
+  /// several threads at the same time.
+  mutable QMutex mMutex;
+
+  /// Opened elements (LRU cache), indexed by their directory.
+  mutable QCache<FilePath, Entry> mElements;
+
+  /// Memoized results of ::librepcb::WorkspaceLibraryDb::getLatest(),
+  /// indexed by element type name and UUID. Cleared by #validate().
+  mutable QHash<QString, QHash<Uuid, FilePath>> mLatest;
+
+  /// Worker threads for #prefetch().
+  mutable QThreadPool mPrefetchPool;
+
+  // Constants
+  static const int sDefaultCapacity = 1000;
+  static const int sMaxPrefetchCount = 100;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -52,6 +52,9 @@ WorkspaceLibraryScanner::WorkspaceLibraryScanner(
     mLibrariesPath(librariesPath),
     mDbFilePath(dbFilePath),
     mSemaphore(0),
+    mRequestMutex(),
+    mFullScanRequested(false),
+    mRequestedLibraries(),
     mAbort(false),
     mLastProgressPercent(100) {
   connect(
@@ -83,6 +86,14 @@ WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept {
  ******************************************************************************/
 
 void WorkspaceLibraryScanner::startScan() noexcept {
+  QMutexLocker lock(&mRequestMutex);
+  mFullScanRequested = true;
+  mSemaphore.release();
+}
+
+void WorkspaceLibraryScanner::startScan(const FilePath& libDir) noexcept {
+  QMutexLocker lock(&mRequestMutex);
+  mRequestedLibraries.insert(libDir);
   mSemaphore.release();
 }
 
@@ -97,21 +108,44 @@ void WorkspaceLibraryScanner::run() noexcept {
     mSemaphore.acquire();
     if (mAbort) {
       break;
-    } else {
-      scan();
+    }
+
+    // Take over all pending requests. A full scan includes all libraries.
+    QMutexLocker lock(&mRequestMutex);
+    const bool fullScan = mFullScanRequested;
+    const QSet<FilePath> libDirs = mRequestedLibraries;
+    mFullScanRequested = false;
+    mRequestedLibraries.clear();
+    lock.unlock();
+    if ((!fullScan) && libDirs.isEmpty()) {
+      continue;  // Already handled by the previous scan.
+    }
+
+    // If the scan was aborted due to a new request, scan the libraries of
+    // this request again together with the new request.
+    if ((!scan(fullScan ? QSet<FilePath>() : libDirs)) && (!mAbort)) {
+      lock.relock();
+      mFullScanRequested = mFullScanRequested || fullScan;
+      mRequestedLibraries |= libDirs;
     }
   }
 
   qDebug() << "Workspace library scanner thread stopped.";
 }
 
-void WorkspaceLibraryScanner::scan() noexcept {
+bool WorkspaceLibraryScanner::scan(const QSet<FilePath>& libDirs) noexcept {
+  bool success = false;
   try {
     QElapsedTimer timer;
     timer.start();
     emit scanStarted();
     emit scanProgressUpdate(0);
-    qDebug() << "Start workspace library scan in worker thread...";
+    if (libDirs.isEmpty()) {
+      qDebug() << "Start workspace library scan in worker thread...";
+    } else {
+      qDebug() << "Start workspace library scan of" << libDirs.count()
+               << "libraries in worker thread...";
+    }
 
     // open SQLite database
     SQLiteDatabase db(mDbFilePath);  // can throw
@@ -131,13 +165,31 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    writer.removeAllElements<ComponentCategory>();
-    writer.removeAllElements<PackageCategory>();
-    writer.removeAllElements<Symbol>();
-    writer.removeAllElements<Package>();
-    writer.removeAllElements<Component>();
-    writer.removeAllElements<Device>();
+    // clear all tables, or only the elements of the libraries to scan
+    if (libDirs.isEmpty()) {
+      writer.removeAllElements<ComponentCategory>();
+      writer.removeAllElements<PackageCategory>();
+      writer.removeAllElements<Symbol>();
+      writer.removeAllElements<Package>();
+      writer.removeAllElements<Component>();
+      writer.removeAllElements<Device>();
+    } else {
+      QList<std::shared_ptr<Library>> filtered;
+      foreach (const std::shared_ptr<Library>& lib, libraries) {
+        const FilePath fp = lib->getDirectory().getAbsPath();
+        if (libDirs.contains(fp)) {
+          const int libId = libIds.value(fp);
+          writer.removeAllElements<ComponentCategory>(libId);
+          writer.removeAllElements<PackageCategory>(libId);
+          writer.removeAllElements<Symbol>(libId);
+          writer.removeAllElements<Package>(libId);
+          writer.removeAllElements<Component>(libId);
+          writer.removeAllElements<Device>(libId);
+          filtered.append(lib);
+        }
+      }
+      libraries = filtered;
+    }
 
     // scan all libraries
     int count = 0;
@@ -178,6 +230,7 @@ void WorkspaceLibraryScanner::scan() noexcept {
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms.";
       emit scanSucceeded(count);
+      success = true;
     } else {
       qDebug() << "Workspace library scan aborted after" << timer.elapsed()
                << "ms.";
@@ -188,6 +241,7 @@ void WorkspaceLibraryScanner::scan() noexcept {
   }
   emit scanProgressUpdate(100);
   emit scanFinished();
+  return success;
 }
 
 void WorkspaceLibraryScanner::getLibrariesOfDirectory(
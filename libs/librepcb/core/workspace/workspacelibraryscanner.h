@@ -63,8 +63,23 @@ public:
   int getProgressPercent() const noexcept { return mLastProgressPercent; }
 
   // General Methods
+
+  /**
+   * @brief Start scanning all libraries
+   */
   void startScan() noexcept;
 
+  /**
+   * @brief Start scanning only a single library
+   *
+   * Much faster than a full scan if only the elements of one library have
+   * been modified, e.g. after importing elements into a library. The list
+   * of libraries is updated as well.
+   *
+   * @param libDir  Directory of the library to scan.
+   */
+  void startScan(const FilePath& libDir) noexcept;
+
   // Operator Overloadings
   WorkspaceLibraryScanner& operator=(const WorkspaceLibraryScanner& rhs) =
       delete;
@@ -79,7 +94,7 @@ signals:
 
 private:  // Methods
   void run() noexcept override;
-  void scan() noexcept;
+  bool scan(const QSet<FilePath>& libDirs) noexcept;
   void getLibrariesOfDirectory(const QString& root,
                                QList<std::shared_ptr<Library>>& libs) noexcept;
 
@@ -108,6 +123,9 @@ private:  // Data
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
   const FilePath mDbFilePath;  ///< Path to the SQLite database file.
   QSemaphore mSemaphore;
+  QMutex mRequestMutex;  ///< Protects the scan requests below.
+  bool mFullScanRequested;
+  QSet<FilePath> mRequestedLibraries;  ///< Libraries to scan (if not full).
   volatile bool mAbort;
   int mLastProgressPercent;
 };
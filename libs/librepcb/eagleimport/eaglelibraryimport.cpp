@@ -25,10 +25,9 @@
 #include "eaglelibraryconverter.h"
 #include "eagletypeconverter.h"
 
-#include <librepcb/core/fileio/transactionaldirectory.h>
-#include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/cmp/component.h>
 #include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/libraryelementwriter.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/utils/messagelogger.h>
@@ -319,8 +318,18 @@ void EagleLibraryImport::run() noexcept {
   // Note: This method is called from a different thread, thus be careful with
   //       calling other methods to only call thread-safe methods!
 
+  // The conversion is done sequentially since the converter builds up the
+  // UUID mappings needed by dependent elements, but serializing and writing
+  // the converted elements to disk is done in parallel by the writer.
   std::shared_ptr<MessageLogger> globalLog = mLogger;
   EagleLibraryConverter converter(*mSettings, this);
+  LibraryElementWriter writer(mDestinationLibraryFp);
+  auto writeError = [globalLog](const QString& group, const QString& msg) {
+    // Called from a worker thread, so don't capture any local logger.
+    return [globalLog, group, msg](const QString& error) {
+      MessageLogger(globalLog.get(), group).critical(msg.arg(error));
+    };
+  };
 
   int totalCount = getCheckedElementsCount();
   int count = 0;
@@ -337,12 +346,9 @@ void EagleLibraryImport::run() noexcept {
       emit progressStatus(sym.displayName);
       auto symbol = converter.createSymbol(QString(), QString(), *sym.symbol,
                                            log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Symbol::getShortElementName())
-              .getPathTo(symbol->getUuid().toStr())));
-      symbol->saveTo(dir);
-      dir.getFileSystem()->save();
+      writer.write(std::move(symbol),
+                   writeError(sym.displayName,
+                              tr("Skipped symbol due to error: %1")));
     } catch (const Exception& e) {
       log.critical(tr("Skipped symbol due to error: %1").arg(e.getMsg()));
     }
@@ -362,12 +368,9 @@ void EagleLibraryImport::run() noexcept {
       emit progressStatus(pkg.displayName);
       auto package = converter.createPackage(QString(), QString(), *pkg.package,
                                              log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Package::getShortElementName())
-              .getPathTo(package->getUuid().toStr())));
-      package->saveTo(dir);
-      dir.getFileSystem()->save();
+      writer.write(std::move(package),
+                   writeError(pkg.displayName,
+                              tr("Skipped package due to error: %1")));
     } catch (const Exception& e) {
       log.critical(tr("Skipped package due to error: %1").arg(e.getMsg()));
     }
@@ -388,12 +391,9 @@ void EagleLibraryImport::run() noexcept {
       auto component =
           converter.createComponent(QString(), QString(), *cmp.deviceSet,
                                     log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Component::getShortElementName())
-              .getPathTo(component->getUuid().toStr())));
-      component->saveTo(dir);
-      dir.getFileSystem()->save();
+      writer.write(std::move(component),
+                   writeError(cmp.displayName,
+                              tr("Skipped component due to error: %1")));
     } catch (const Exception& e) {
       log.critical(tr("Skipped component due to error: %1").arg(e.getMsg()));
     }
@@ -414,12 +414,9 @@ void EagleLibraryImport::run() noexcept {
       auto device = converter.createDevice(QString(), QString(), *dev.deviceSet,
                                            *dev.device, QString(), QString(),
                                            log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Device::getShortElementName())
-              .getPathTo(device->getUuid().toStr())));
-      device->saveTo(dir);
-      dir.getFileSystem()->save();
+      writer.write(std::move(device),
+                   writeError(dev.displayName,
+                              tr("Skipped device due to error: %1")));
     } catch (const Exception& e) {
       log.critical(tr("Skipped device due to error: %1").arg(e.getMsg()));
     }
@@ -427,10 +424,13 @@ void EagleLibraryImport::run() noexcept {
     emit progressPercent((100 * count) / std::max(totalCount, 1));
   }
 
+  // Wait until all elements are written.
+  writer.waitForFinished();
+
   emit progressPercent(100);
   emit progressStatus(tr("Finished: %1 of %2 element(s) imported",
                          "Placeholders are numbers", totalCount)
-                          .arg(count)
+                          .arg(writer.getWrittenCount())
                           .arg(totalCount));
   emit finished();
 }
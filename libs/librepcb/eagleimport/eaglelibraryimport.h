@@ -101,6 +101,9 @@ public:
   // Getters
   std::shared_ptr<MessageLogger> getLogger() const noexcept { return mLogger; }
   const FilePath& getLoadedFilePath() const noexcept { return mLoadedFilePath; }
+  const FilePath& getDestinationLibraryPath() const noexcept {
+    return mDestinationLibraryFp;
+  }
   int getTotalElementsCount() const noexcept;
   int getCheckedElementsCount() const noexcept;
   int getCheckedSymbolsCount() const noexcept;
@@ -67,6 +67,7 @@
 #include <parseagle/board/board.h>
 #include <parseagle/schematic/schematic.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -101,6 +102,9 @@ int EagleProjectImport::getSheetCount() const noexcept {
  ******************************************************************************/
 
 void EagleProjectImport::reset() noexcept {
+  mParts.clear();
+  mTechnologies.clear();
+  mDevices.clear();
   mNetSignalMap.clear();
   mSchematicDirNames.clear();
   mComponentMap.clear();
@@ -121,10 +125,31 @@ void EagleProjectImport::reset() noexcept {
 QStringList EagleProjectImport::open(const FilePath& sch, const FilePath& brd) {
   reset();
 
+  QElapsedTimer timer;
+  timer.start();
+
+  // The board file is independent of the schematic file, so parse it in a
+  // worker thread while the schematic is parsed in this thread.
+  struct BoardResult {
+    std::unique_ptr<parseagle::Board> board;
+    QStringList warnings;
+    QString error;
+  };
+  auto boardResult = std::make_shared<BoardResult>();
+  QFuture<void> boardFuture;
+  if (brd.isValid()) {
+    boardFuture = QtConcurrent::run([brd, boardResult]() {
+      try {
+        boardResult->board.reset(
+            new parseagle::Board(brd.toStr(), &boardResult->warnings));
+      } catch (const std::exception& e) {
+        boardResult->error = e.what();
+      }
+    });
+  }
+
   QStringList warnings;
   std::unique_ptr<parseagle::Schematic> schematic;
-  std::unique_ptr<parseagle::Board> board;
-
   try {
     schematic.reset(new parseagle::Schematic(sch.toStr(), &warnings));
     if (schematic->getSheets().isEmpty()) {
@@ -138,21 +163,30 @@ QStringList EagleProjectImport::open(const FilePath& sch, const FilePath& brd) {
       warnings.append(
           tr("Project contains buses which are not supported yet!"));
     }
-    if (brd.isValid()) {
-      board.reset(new parseagle::Board(brd.toStr(), &warnings));
-    }
   } catch (const std::exception& e) {
     qWarning() << "Failed to parse EAGLE project:" << e.what();
+    boardFuture.waitForFinished();
     throw RuntimeError(__FILE__, __LINE__, e.what());
   }
 
+  // Index the schematic libraries while the board is still being parsed.
   mProjectName = sch.getCompleteBasename();
   mSchematic.reset(schematic.release());
-  mBoard.reset(board.release());
   importLibraries(mSchematic->getLibraries(), false);
+
+  boardFuture.waitForFinished();
+  if (!boardResult->error.isEmpty()) {
+    qWarning() << "Failed to parse EAGLE project:" << boardResult->error;
+    reset();
+    throw RuntimeError(__FILE__, __LINE__, boardResult->error);
+  }
+  warnings += boardResult->warnings;
+  mBoard.reset(boardResult->board.release());
   if (mBoard) {
     importLibraries(mBoard->getLibraries(), true);
   }
+  buildIndex();
+  qDebug() << "Parsed EAGLE project in" << timer.elapsed() << "ms.";
   return warnings;
 }
 
@@ -202,10 +236,9 @@ void EagleProjectImport::import(Project& project) {
       }
       AttributeList attributes = cmp->getAttributes();
       C::tryConvertAttributes(part.getAttributes(), attributes, log);
-      auto eagleDevSet = getDeviceSet(part.getLibrary(), part.getLibraryUrn(),
-                                      part.getDeviceSet());
-      const parseagle::Device eagleDev =
-          getDevice(*eagleDevSet, part.getDevice());
+      const parseagle::Device& eagleDev =
+          getDevice(part.getLibrary(), part.getLibraryUrn(),
+                    part.getDeviceSet(), part.getDevice());
       if (const parseagle::Technology* eagleTech =
               tryGetTechnology(eagleDev, part.getTechnology())) {
         C::tryConvertAttributes(eagleTech->getAttributes(), attributes, log);
@@ -345,7 +378,8 @@ const Device& EagleProjectImport::importLibraryDevice(
   auto it = mLibDeviceMap.find(key);
   if (it == mLibDeviceMap.end()) {
     auto eagleDevSet = getDeviceSet(libName, libUrn, devSetName);
-    const parseagle::Device& eagleDev = getDevice(*eagleDevSet, devName);
+    const parseagle::Device& eagleDev =
+        getDevice(libName, libUrn, devSetName, devName);
     importLibraryPackage(converter, library, pkgLibName, pkgLibUrn,
                          eagleDev.getPackage());
     MessageLogger log(mLogger.get(), eagleDev.getName());
@@ -384,6 +418,36 @@ void EagleProjectImport::importLibraries(const QList<parseagle::Library>& libs,
   }
 }
 
+void EagleProjectImport::buildIndex() noexcept {
+  // The indexed objects are owned by mDeviceSets resp. mSchematic, which are
+  // not modified anymore until the next reset(). Note that we must iterate
+  // over references to the owning containers (not over copies as foreach
+  // would do), otherwise the stored pointers would dangle.
+  for (auto it = mDeviceSets.cbegin(); it != mDeviceSets.cend(); ++it) {
+    const QList<parseagle::Device>& devices = (*it)->getDevices();
+    for (const parseagle::Device& dev : devices) {
+      const QStringList devKey = it.key() + QStringList{dev.getName()};
+      if (!mDevices.contains(devKey)) {
+        mDevices.insert(devKey, &dev);
+      }
+      const QList<parseagle::Technology>& technologies =
+          dev.getTechnologies();
+      for (const parseagle::Technology& tech : technologies) {
+        const auto techKey = std::make_pair(&dev, tech.getName());
+        if (!mTechnologies.contains(techKey)) {
+          mTechnologies.insert(techKey, &tech);
+        }
+      }
+    }
+  }
+  const QList<parseagle::Part>& parts = mSchematic->getParts();
+  for (const parseagle::Part& part : parts) {
+    if (!mParts.contains(part.getName())) {
+      mParts.insert(part.getName(), &part);
+    }
+  }
+}
+
 void EagleProjectImport::importSchematic(Project& project,
                                          EagleLibraryConverter& converter,
                                          const parseagle::Sheet& sheet) {
@@ -1321,32 +1385,25 @@ std::shared_ptr<const parseagle::DeviceSet> EagleProjectImport::getDeviceSet(
 }
 
 const parseagle::Device& EagleProjectImport::getDevice(
-    const parseagle::DeviceSet& devSet, const QString& name) const {
-  foreach (const parseagle::Device& obj, devSet.getDevices()) {
-    if (obj.getName() == name) {
-      return obj;
-    }
+    const QString& libName, const QString& libUrn, const QString& devSetName,
+    const QString& name) const {
+  const QStringList key{libName, libUrn, devSetName, name};
+  if (const parseagle::Device* ptr = mDevices.value(key)) {
+    return *ptr;
   }
   throw RuntimeError(
       __FILE__, __LINE__,
-      QString("Device not found in embedded library: %1").arg(name));
+      QString("Device not found in embedded library: %1").arg(key.join("::")));
 }
 
 const parseagle::Technology* EagleProjectImport::tryGetTechnology(
     const parseagle::Device& dev, const QString& name) const {
-  foreach (const parseagle::Technology& obj, dev.getTechnologies()) {
-    if (obj.getName() == name) {
-      return &obj;
-    }
-  }
-  return nullptr;
+  return mTechnologies.value(std::make_pair(&dev, name));
 }
 
 const parseagle::Part& EagleProjectImport::getPart(const QString& name) const {
-  foreach (const parseagle::Part& obj, mSchematic->getParts()) {
-    if (obj.getName() == name) {
-      return obj;
-    }
+  if (const parseagle::Part* ptr = mParts.value(name)) {
+    return *ptr;
   }
   throw RuntimeError(__FILE__, __LINE__,
                      QString("Part not found: %1").arg(name));
@@ -120,6 +120,7 @@ private:  // Methods
       const QString& pkgLibName, const QString& pkgLibUrn);
   NetSignal& importNet(Project& project, const parseagle::Net& net);
   void importLibraries(const QList<parseagle::Library>& libs, bool isBoard);
+  void buildIndex() noexcept;
   void importSchematic(Project& project, EagleLibraryConverter& converter,
                        const parseagle::Sheet& sheet);
   void importBoard(Project& project, EagleLibraryConverter& converter);
@@ -134,7 +135,9 @@ private:  // Methods
       const QString& libName, const QString& libUrn, const QString& name) const;
   std::shared_ptr<const parseagle::DeviceSet> getDeviceSet(
       const QString& libName, const QString& libUrn, const QString& name) const;
-  const parseagle::Device& getDevice(const parseagle::DeviceSet& devSet,
+  const parseagle::Device& getDevice(const QString& libName,
+                                     const QString& libUrn,
+                                     const QString& devSetName,
                                      const QString& name) const;
   const parseagle::Technology* tryGetTechnology(const parseagle::Device& dev,
                                                 const QString& name) const;
@@ -155,6 +158,17 @@ private:  // Data
   /// Key={libName, libUrn, devSetName}
   QHash<QStringList, std::shared_ptr<const parseagle::DeviceSet>> mDeviceSets;
 
+  /// Key={libName, libUrn, devSetName, devName}, Value=Device in #mDeviceSets
+  QHash<QStringList, const parseagle::Device*> mDevices;
+
+  /// Key={device, techName}, Value=Technology in #mDeviceSets
+  QHash<std::pair<const parseagle::Device*, QString>,
+        const parseagle::Technology*>
+      mTechnologies;
+
+  /// Key=partName, Value=Part in #mSchematic
+  QHash<QString, const parseagle::Part*> mParts;
+
   /// Key={libName, libUrn, symName}, Value=libSymUuid
   QHash<QStringList, Uuid> mLibSymbolMap;
 
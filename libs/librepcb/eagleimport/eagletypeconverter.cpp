@@ -487,7 +487,6 @@ QList<EagleTypeConverter::Geometry> EagleTypeConverter::convertAndJoinWires(
   }
 
   QList<Geometry> polygons;
-  bool timedOut = false;
   for (auto it = joinableWires.begin(); it != joinableWires.end(); it++) {
     try {
       QVector<Path> paths;
@@ -505,7 +504,7 @@ QList<EagleTypeConverter::Geometry> EagleTypeConverter::convertAndJoinWires(
               tr("Flat line end is not supported, converting to round."));
         }
       }
-      foreach (const Path& p, TangentPathJoiner::join(paths, 5000, &timedOut)) {
+      foreach (const Path& p, TangentPathJoiner::join(paths)) {
         polygons.append(Geometry{
             it.value().first().getLayer(),  // Layer
             convertLineWidth(it.value().first().getWidth(),
@@ -520,11 +519,6 @@ QList<EagleTypeConverter::Geometry> EagleTypeConverter::convertAndJoinWires(
       log.warning(QString("Failed to convert wires: %1").arg(e.getMsg()));
     }
   }
-  if (timedOut) {
-    log.info(
-        "Aborted joining tangent line segments to polygons due to timeout, "
-        "keeping them separate.");
-  }
   return polygons;
 }
 
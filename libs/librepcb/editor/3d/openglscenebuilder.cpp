@@ -278,9 +278,10 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
     // Add/update devices.
     QSet<Uuid> deviceUuids;
     if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
+      QHash<QString, QByteArray> fileHashes;  // Read each file only once.
       for (const auto& obj : data->getDevices()) {
-        const QByteArray content = fs->readIfExists(obj.stepFile);
-        publishDevice(obj, content, d + 0.067, scaleFactor,
+        const StepModel& model = getStepModel(obj, *fs, fileHashes);
+        publishDevice(obj, model, d + 0.067, scaleFactor,
                       data->getStepAlphaValue());
         deviceUuids.insert(obj.uuid);
         if (mAbort) return;
@@ -421,25 +422,39 @@ void OpenGlSceneBuilder::publishTriangleData(
   }
 }
 
-void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
-                                       const QByteArray& stepContent, qreal z,
-                                       qreal scaleFactor, qreal alpha) {
-  StepModel model;
-  if (mStepModels.contains(stepContent)) {
-    model = mStepModels.value(stepContent);
-  } else {
-    if (stepContent.size()) {
-      try {
-        std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
-        model = occModel->tesselate();
-      } catch (const Exception& e) {
-        qCritical().nospace()
-            << "Failed to draw 3D model of " << obj.name << ": " << e.getMsg();
+const OpenGlSceneBuilder::StepModel& OpenGlSceneBuilder::getStepModel(
+    const SceneData3D::DeviceData& obj, FileSystem& fs,
+    QHash<QString, QByteArray>& fileHashes) {
+  // Models are cached by content hash rather than by content to avoid keeping
+  // the (potentially huge) STEP files in memory. The content is only needed
+  // temporarily, until the model is tesselated.
+  auto it = fileHashes.find(obj.stepFile);
+  if (it == fileHashes.end()) {
+    const QByteArray content = fs.readIfExists(obj.stepFile);
+    const QByteArray hash = content.isEmpty()
+        ? QByteArray()
+        : QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+    if (!mStepModels.contains(hash)) {
+      StepModel model;
+      if (!content.isEmpty()) {
+        try {
+          std::unique_ptr<OccModel> occModel = OccModel::loadStep(content);
+          model = occModel->tesselate();
+        } catch (const Exception& e) {
+          qCritical().nospace() << "Failed to draw 3D model of " << obj.name
+                                << ": " << e.getMsg();
+        }
       }
+      mStepModels.insert(hash, model);
     }
-    mStepModels.insert(stepContent, model);
+    it = fileHashes.insert(obj.stepFile, hash);
   }
+  return mStepModels[*it];
+}
 
+void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
+                                       const StepModel& model, qreal z,
+                                       qreal scaleFactor, qreal alpha) {
   QMatrix4x4 m;
   m.scale(scaleFactor);
   m.translate(obj.transform.getPosition().getX().toMm(),
@@ -36,6 +36,9 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
+
+class FileSystem;
+
 namespace editor {
 
 class OpenGlTriangleObject;
@@ -107,9 +110,11 @@ private:  // Methods
   void publishTriangleData(const QString& id, OpenGlObject::Type type,
                            const QColor& color,
                            const QVector<QVector3D>& triangles);
-  void publishDevice(const SceneData3D::DeviceData& obj,
-                     const QByteArray& stepContent, qreal z, qreal scaleFactor,
-                     qreal alpha);
+  const StepModel& getStepModel(const SceneData3D::DeviceData& obj,
+                                FileSystem& fs,
+                                QHash<QString, QByteArray>& fileHashes);
+  void publishDevice(const SceneData3D::DeviceData& obj, const StepModel& model,
+                     qreal z, qreal scaleFactor, qreal alpha);
 
 private:  // Data
   const PositiveLength mMaxArcTolerance;
@@ -119,7 +124,7 @@ private:  // Data
   // Thread data.
   QHash<QString, std::shared_ptr<OpenGlTriangleObject>> mBoardObjects;
   QHash<Uuid, QMap<Color, std::shared_ptr<OpenGlTriangleObject>>> mDevices;
-  QHash<QByteArray, StepModel> mStepModels;  ///< Cache
+  QHash<QByteArray, StepModel> mStepModels;  ///< Key: STEP content hash
 };
 
 /*******************************************************************************
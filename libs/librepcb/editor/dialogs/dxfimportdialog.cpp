@@ -27,6 +27,7 @@
 #include "ui_dxfimportdialog.h"
 
 #include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/tangentpathjoiner.h>
 
 #include <QtCore>
 
@@ -62,6 +63,19 @@ DxfImportDialog::DxfImportDialog(const QSet<const Layer*>& layers,
           &QCheckBox::setDisabled);
   connect(mUi->cbxInteractivePlacement, &QCheckBox::toggled, mUi->edtPosY,
           &QCheckBox::setDisabled);
+  const QList<std::pair<LengthEdit*, QString>> areaEdits = {
+      {mUi->edtAreaX1, "/area_x1"},
+      {mUi->edtAreaY1, "/area_y1"},
+      {mUi->edtAreaX2, "/area_x2"},
+      {mUi->edtAreaY2, "/area_y2"},
+  };
+  for (const auto& pair : areaEdits) {
+    pair.first->configure(lengthUnit, LengthEditBase::Steps::generic(),
+                          settingsPrefix % pair.second);
+    pair.first->setEnabled(false);
+    connect(mUi->cbxLimitArea, &QCheckBox::toggled, pair.first,
+            &LengthEdit::setEnabled);
+  }
 
   // Load initial values and window geometry.
   try {
@@ -86,6 +100,18 @@ DxfImportDialog::DxfImportDialog(const QSet<const Layer*>& layers,
     mUi->cbxCirclesAsDrills->setChecked(
         clientSettings.value(settingsPrefix % "/circles_as_drills", false)
             .toBool());
+    mUi->edtDxfLayers->setText(
+        clientSettings.value(settingsPrefix % "/dxf_layers").toString());
+    mUi->cbxLimitArea->setChecked(
+        clientSettings.value(settingsPrefix % "/limit_area", false).toBool());
+    mUi->edtAreaX1->setValue(Length::fromMm(
+        clientSettings.value(settingsPrefix % "/area_x1", "0").toString()));
+    mUi->edtAreaY1->setValue(Length::fromMm(
+        clientSettings.value(settingsPrefix % "/area_y1", "0").toString()));
+    mUi->edtAreaX2->setValue(Length::fromMm(
+        clientSettings.value(settingsPrefix % "/area_x2", "0").toString()));
+    mUi->edtAreaY2->setValue(Length::fromMm(
+        clientSettings.value(settingsPrefix % "/area_y2", "0").toString()));
     restoreGeometry(clientSettings.value(settingsPrefix % "/window_geometry")
                         .toByteArray());
   } catch (const Exception& e) {
@@ -113,6 +139,18 @@ DxfImportDialog::~DxfImportDialog() noexcept {
                           mUi->cbxJoinTangentPolylines->isChecked());
   clientSettings.setValue(mSettingsPrefix % "/circles_as_drills",
                           mUi->cbxCirclesAsDrills->isChecked());
+  clientSettings.setValue(mSettingsPrefix % "/dxf_layers",
+                          mUi->edtDxfLayers->text());
+  clientSettings.setValue(mSettingsPrefix % "/limit_area",
+                          mUi->cbxLimitArea->isChecked());
+  clientSettings.setValue(mSettingsPrefix % "/area_x1",
+                          mUi->edtAreaX1->getValue().toMmString());
+  clientSettings.setValue(mSettingsPrefix % "/area_y1",
+                          mUi->edtAreaY1->getValue().toMmString());
+  clientSettings.setValue(mSettingsPrefix % "/area_x2",
+                          mUi->edtAreaX2->getValue().toMmString());
+  clientSettings.setValue(mSettingsPrefix % "/area_y2",
+                          mUi->edtAreaY2->getValue().toMmString());
   clientSettings.setValue(mSettingsPrefix % "/window_geometry", saveGeometry());
 }
 
@@ -152,6 +190,28 @@ bool DxfImportDialog::getImportCirclesAsDrills() const noexcept {
   return mUi->cbxCirclesAsDrills->isChecked();
 }
 
+QSet<QString> DxfImportDialog::getDxfLayers() const noexcept {
+  QSet<QString> layers;
+  foreach (const QString& name,
+           mUi->edtDxfLayers->text().split(",", Qt::SkipEmptyParts)) {
+    if (!name.trimmed().isEmpty()) {
+      layers.insert(name.trimmed());
+    }
+  }
+  return layers;
+}
+
+std::optional<std::pair<Point, Point>> DxfImportDialog::getArea()
+    const noexcept {
+  if (mUi->cbxLimitArea->isChecked()) {
+    return std::make_pair(
+        Point(mUi->edtAreaX1->getValue(), mUi->edtAreaY1->getValue()),
+        Point(mUi->edtAreaX2->getValue(), mUi->edtAreaY2->getValue()));
+  } else {
+    return std::nullopt;
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -168,6 +228,40 @@ FilePath DxfImportDialog::chooseFile() const noexcept {
   return fp;
 }
 
+DxfImportDialog::Objects DxfImportDialog::readFile(const FilePath& fp) const {
+  DxfReader reader;
+  reader.setScaleFactor(getScaleFactor());
+  reader.setLayerFilter(getDxfLayers());
+  reader.setBoundingBoxFilter(getArea());
+  reader.setJoinPaths(getJoinTangentPolylines());
+
+  // Stream the objects directly into the result and show the progress, since
+  // large files can take some time.
+  QProgressDialog progress(tr("Reading DXF file..."), QString(), 0, 100,
+                           parentWidget());
+  progress.setWindowModality(Qt::WindowModal);
+  progress.setMinimumDuration(500);
+  Objects objects;
+  DxfReader::Callbacks callbacks;
+  callbacks.circle = [&objects](const DxfReader::Circle& circle) {
+    objects.circles.append(circle);
+  };
+  callbacks.polygon = [&objects](const Path& path) {
+    objects.polygons.append(path);
+  };
+  callbacks.progress = [&progress](int percent) { progress.setValue(percent); };
+  reader.parse(fp, callbacks);  // can throw
+  progress.setValue(100);
+
+  // The reader joins paths only in file order at exactly matching end points,
+  // so let the tangent path joiner find the best solution for the remaining
+  // open paths.
+  if (getJoinTangentPolylines()) {
+    objects.polygons = TangentPathJoiner::join(objects.polygons);
+  }
+  return objects;
+}
+
 void DxfImportDialog::throwNoObjectsImportedError() {
   throw RuntimeError(
       __FILE__, __LINE__,
@@ -24,6 +24,8 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/types/length.h>
 #include <librepcb/core/types/point.h>
 
@@ -57,6 +59,12 @@ class DxfImportDialog final : public QDialog {
   Q_OBJECT
 
 public:
+  // Types
+  struct Objects {
+    QVector<Path> polygons;
+    QList<DxfReader::Circle> circles;
+  };
+
   // Constructors / Destructor
   DxfImportDialog() = delete;
   DxfImportDialog(const DxfImportDialog& other) = delete;
@@ -74,9 +82,12 @@ public:
   std::optional<Point> getPlacementPosition() const noexcept;
   bool getJoinTangentPolylines() const noexcept;
   bool getImportCirclesAsDrills() const noexcept;
+  QSet<QString> getDxfLayers() const noexcept;
+  std::optional<std::pair<Point, Point>> getArea() const noexcept;
 
   // General Methods
   FilePath chooseFile() const noexcept;
+  Objects readFile(const FilePath& fp) const;
   static void throwNoObjectsImportedError();
 
   // Operator Overloadings
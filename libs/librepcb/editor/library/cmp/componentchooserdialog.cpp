@@ -31,6 +31,7 @@
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/cmp/component.h>
 #include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacesettings.h>
@@ -99,6 +100,7 @@ ComponentChooserDialog::ComponentChooserDialog(const Workspace& ws,
 }
 
 ComponentChooserDialog::~ComponentChooserDialog() noexcept {
+  abortSearch();
   setSelectedComponent(std::nullopt);
 }
 
@@ -149,60 +151,95 @@ void ComponentChooserDialog::listComponents_itemDoubleClicked(
 }
 
 void ComponentChooserDialog::searchComponents(const QString& input) {
+  abortSearch();
   setSelectedComponent(std::nullopt);
   mUi->listComponents->clear();
   mCategorySelected = false;
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> components = mWorkspace.getLibraryDb().find<Component>(input);
-    foreach (const Uuid& uuid, components) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatest<Component>(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getTranslations<Component>(fp, localeOrder(),
-                                                           &name);  // can throw
-      bool deprecated = false;
-      mWorkspace.getLibraryDb().getMetadata<Component>(
-          fp, nullptr, nullptr, &deprecated);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-      item->setData(Qt::UserRole, uuid.toStr());
-      mUi->listComponents->addItem(item);
+    // Run the queries in the worker thread of the library database to keep
+    // the UI responsive while typing.
+    const QStringList locales = localeOrder();
+    mSearchWatcher.reset(new QFutureWatcher<QList<SearchResultItem>>());
+    connect(mSearchWatcher.get(),
+            &QFutureWatcher<QList<SearchResultItem>>::finished, this,
+            &ComponentChooserDialog::searchFinished);
+    mSearchWatcher->setFuture(
+        mWorkspace.getLibraryDb().runAsync<QList<SearchResultItem>>(
+            [input, locales](const WorkspaceLibraryDb& db) {
+              return search(db, input, locales);  // can throw
+            }));
+  }
+}
+
+void ComponentChooserDialog::searchFinished() noexcept {
+  if (!mSearchWatcher) return;
+  const QFuture<QList<SearchResultItem>> future = mSearchWatcher->future();
+  try {
+    future.waitForFinished();  // can throw
+    if (future.resultCount() > 0) {
+      foreach (const SearchResultItem& result, future.result()) {
+        QListWidgetItem* item = new QListWidgetItem(result.name);
+        item->setForeground(result.deprecated ? QBrush(Qt::red) : QBrush());
+        item->setData(Qt::UserRole, result.uuid.toStr());
+        mUi->listComponents->addItem(item);
+      }
     }
+  } catch (const Exception& e) {
+    QMessageBox::critical(this, tr("Error"), e.getMsg());
   }
 }
 
+void ComponentChooserDialog::abortSearch() noexcept {
+  if (mSearchWatcher) {
+    mSearchWatcher->cancel();  // Stops the queries at the next opportunity.
+    mSearchWatcher.reset();
+  }
+}
+
+QList<ComponentChooserDialog::SearchResultItem> ComponentChooserDialog::search(
+    const WorkspaceLibraryDb& db, const QString& input,
+    const QStringList& localeOrder) {
+  const QList<Uuid> components = db.find<Component>(input);  // can throw
+  const QHash<Uuid, FilePath> fps =
+      db.getLatest<Component>(Toolbox::toSet(components));  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+      db.getElementInfos<Component>(fps.values(), localeOrder);  // can throw
+  QList<SearchResultItem> result;
+  foreach (const Uuid& uuid, components) {
+    const WorkspaceLibraryDb::ElementInfo info = infos.value(fps.value(uuid));
+    result.append(SearchResultItem{uuid, info.name, info.deprecated});
+  }
+  return result;
+}
+
 void ComponentChooserDialog::setSelectedCategory(
     const std::optional<Uuid>& uuid) noexcept {
   if ((mCategorySelected) && (uuid == mSelectedCategoryUuid)) return;
 
+  abortSearch();
   setSelectedComponent(std::nullopt);
   mUi->listComponents->clear();
   mSelectedCategoryUuid = uuid;
   mCategorySelected = true;
 
   try {
-    QSet<Uuid> components =
-        mWorkspace.getLibraryDb().getByCategory<Component>(uuid);  // can throw
+    const WorkspaceLibraryDb& db = mWorkspace.getLibraryDb();
+    const QSet<Uuid> components =
+        db.getByCategory<Component>(uuid);  // can throw
+    const QHash<Uuid, FilePath> fps =
+        db.getLatest<Component>(components);  // can throw
+    const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+        db.getElementInfos<Component>(fps.values(),
+                                      localeOrder());  // can throw
     foreach (const Uuid& cmpUuid, components) {
-      try {
-        FilePath fp = mWorkspace.getLibraryDb().getLatest<Component>(
-            cmpUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getTranslations<Component>(
-            fp, localeOrder(),
-            &name);  // can throw
-        bool deprecated = false;
-        mWorkspace.getLibraryDb().getMetadata<Component>(
-            fp, nullptr, nullptr, &deprecated);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-        item->setData(Qt::UserRole, cmpUuid.toStr());
-        mUi->listComponents->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+      const FilePath fp = fps.value(cmpUuid);
+      const WorkspaceLibraryDb::ElementInfo info = infos.value(fp);
+      QListWidgetItem* item = new QListWidgetItem(info.name);
+      item->setForeground(info.deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, cmpUuid.toStr());
+      mUi->listComponents->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load components"), e.getMsg());
@@ -39,6 +39,7 @@ namespace librepcb {
 class Component;
 class Symbol;
 class Workspace;
+class WorkspaceLibraryDb;
 
 namespace editor {
 
@@ -60,6 +61,13 @@ class ComponentChooserDialog;
 class ComponentChooserDialog final : public QDialog {
   Q_OBJECT
 
+  // Types
+  struct SearchResultItem {
+    Uuid uuid;
+    QString name;
+    bool deprecated;
+  };
+
 public:
   // Constructors / Destructor
   ComponentChooserDialog() = delete;
@@ -84,6 +92,11 @@ private:  // Methods
                                          QListWidgetItem* previous) noexcept;
   void listComponents_itemDoubleClicked(QListWidgetItem* item) noexcept;
   void searchComponents(const QString& input);
+  void searchFinished() noexcept;
+  void abortSearch() noexcept;
+  static QList<SearchResultItem> search(const WorkspaceLibraryDb& db,
+                                        const QString& input,
+                                        const QStringList& localeOrder);
   void setSelectedCategory(const std::optional<Uuid>& uuid) noexcept;
   void setSelectedComponent(const std::optional<Uuid>& uuid) noexcept;
   void updatePreview(const FilePath& fp) noexcept;
@@ -96,6 +109,7 @@ private:  // Data
   QScopedPointer<Ui::ComponentChooserDialog> mUi;
   QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
   bool mCategorySelected;
+  std::unique_ptr<QFutureWatcher<QList<SearchResultItem>>> mSearchWatcher;
   std::optional<Uuid> mSelectedCategoryUuid;
   std::optional<Uuid> mSelectedComponentUuid;
 
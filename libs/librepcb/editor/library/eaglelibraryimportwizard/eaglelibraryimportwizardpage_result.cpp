@@ -59,9 +59,11 @@ EagleLibraryImportWizardPage_Result::EagleLibraryImportWizardPage_Result(
 
   // Connect finished signal directly with library scanner to get it emitted
   // even when closing this wizard while the import is still in progress.
-  connect(&mContext->getImport(), &EagleLibraryImport::finished,
-          &mContext->getWorkspace().getLibraryDb(),
-          &WorkspaceLibraryDb::startLibraryRescan);
+  // Only the destination library needs to be rescanned.
+  WorkspaceLibraryDb& db = mContext->getWorkspace().getLibraryDb();
+  const FilePath libFp = mContext->getImport().getDestinationLibraryPath();
+  connect(&mContext->getImport(), &EagleLibraryImport::finished, &db,
+          [&db, libFp]() { db.startSingleLibraryRescan(libFp); });
 }
 
 EagleLibraryImportWizardPage_Result::
@@ -33,6 +33,7 @@
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -62,7 +63,16 @@ EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
     mIsInterfaceBroken(false),
     mStatusBarMessage(),
     mSupportedApprovals(),
-    mDisappearedApprovals() {
+    mDisappearedApprovals(),
+    mBackgroundChecksWatcher(),
+    mBackgroundChecksAbort(),
+    mModificationCounter(0),
+    mCheckedModification(-1),
+    mBackgroundCheckModification(-1) {
+  connect(&mBackgroundChecksWatcher,
+          &QFutureWatcher<RuleCheckMessageList>::finished, this,
+          &EditorWidgetBase::backgroundChecksFinished);
+
   mUndoStack.reset(new UndoStack());
   connect(mUndoStack.data(), &UndoStack::cleanChanged, this,
           &EditorWidgetBase::undoStackCleanChanged);
@@ -76,6 +86,11 @@ EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
 }
 
 EditorWidgetBase::~EditorWidgetBase() noexcept {
+  // Let running background checks finish as soon as possible. There's no need
+  // to wait for them since they don't access the editor.
+  if (mBackgroundChecksAbort) {
+    *mBackgroundChecksAbort = true;
+  }
 }
 
 /*******************************************************************************
@@ -211,6 +226,11 @@ void EditorWidgetBase::undoStackStateModified() noexcept {
       emit interfaceBrokenChanged(mIsInterfaceBroken);
     }
   }
+  ++mModificationCounter;
+  if (mBackgroundChecksAbort) {
+    // The result of running background checks is outdated now, so abort them.
+    *mBackgroundChecksAbort = true;
+  }
   scheduleLibraryElementChecks();
 }
 
@@ -285,21 +305,35 @@ void EditorWidgetBase::scheduleLibraryElementChecks() noexcept {
 }
 
 void EditorWidgetBase::updateCheckMessages() noexcept {
+  if (mBackgroundChecksWatcher.isRunning()) {
+    // Checks are still running in the background. If the element was modified
+    // in the meantime, they are being aborted and the checks are run again
+    // once they are finished.
+    return;
+  }
+  if (mCheckedModification == mModificationCounter) {
+    // Messages are still up to date, no need to run the checks again. This
+    // happens if several modifications are made within the check delay.
+    return;
+  }
+
   try {
+    CheckFunction function;
     RuleCheckMessageList msgs;
-    if (runChecks(msgs)) {  // can throw
-      const QSet<SExpression> approvals =
-          RuleCheckMessage::getAllApprovals(msgs);
-      mSupportedApprovals |= approvals;
-      mDisappearedApprovals = mSupportedApprovals - approvals;
-
-      int errors = 0;
-      foreach (const auto& msg, msgs) {
-        if (msg->getSeverity() == RuleCheckMessage::Severity::Error) {
-          ++errors;
-        }
-      }
-      emit errorsAvailableChanged(errors > 0);
+    if (!prepareChecks(function)) {  // can throw
+      // Failed to prepare checks (for example because a command is active),
+      // try it later again.
+      scheduleLibraryElementChecks();
+    } else if (function) {
+      std::shared_ptr<std::atomic_bool> abort =
+          std::make_shared<std::atomic_bool>(false);
+      mBackgroundCheckModification = mModificationCounter;
+      mBackgroundChecksAbort = abort;
+      mBackgroundChecksWatcher.setFuture(
+          QtConcurrent::run([function, abort]() { return function(*abort); }));
+    } else if (runChecks(msgs)) {  // can throw
+      mCheckedModification = mModificationCounter;
+      processCheckMessages(msgs);
     } else {
       // Failed to run checks (for example because a command is active), try it
       // later again.
@@ -310,6 +344,41 @@ void EditorWidgetBase::updateCheckMessages() noexcept {
   }
 }
 
+void EditorWidgetBase::backgroundChecksFinished() noexcept {
+  if (mBackgroundCheckModification != mModificationCounter) {
+    // The element was modified while the checks were running, so the checks
+    // were aborted or their result is outdated. Discard it and run the checks
+    // again (delayed, as for any other modification).
+    scheduleLibraryElementChecks();
+    return;
+  }
+
+  try {
+    const RuleCheckMessageList msgs =
+        mBackgroundChecksWatcher.result();  // can throw
+    mCheckedModification = mBackgroundCheckModification;
+    setCheckMessages(msgs);
+    processCheckMessages(msgs);
+  } catch (const Exception& e) {
+    qCritical() << "Failed to run library element checks:" << e.getMsg();
+  }
+}
+
+void EditorWidgetBase::processCheckMessages(
+    const RuleCheckMessageList& msgs) noexcept {
+  const QSet<SExpression> approvals = RuleCheckMessage::getAllApprovals(msgs);
+  mSupportedApprovals |= approvals;
+  mDisappearedApprovals = mSupportedApprovals - approvals;
+
+  int errors = 0;
+  foreach (const auto& msg, msgs) {
+    if (msg->getSeverity() == RuleCheckMessage::Severity::Error) {
+      ++errors;
+    }
+  }
+  emit errorsAvailableChanged(errors > 0);
+}
+
 bool EditorWidgetBase::ruleCheckFixAvailable(
     std::shared_ptr<const RuleCheckMessage> msg) noexcept {
   try {
@@ -32,6 +32,9 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <atomic>
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -72,6 +75,10 @@ public:
     const Library* library;
   };
 
+  /// Library element checks to be run in a worker thread, with abort flag
+  using CheckFunction =
+      std::function<RuleCheckMessageList(const std::atomic_bool& abort)>;
+
   enum Tool {
     NONE,
     SELECT,
@@ -199,6 +206,33 @@ protected:  // Methods
     return false;
   }
   virtual bool runChecks(RuleCheckMessageList& msgs) const = 0;
+
+  /**
+   * @brief Prepare the library element checks to be run in a worker thread
+   *
+   * Editors of elements with expensive checks may override this method to
+   * return a function which runs the checks on a copy of the element. The
+   * function is executed in a worker thread, thus it must not access the
+   * edited element or the editor. Once finished, the messages are passed to
+   * #setCheckMessages(). If the element is modified in the meantime, the
+   * abort flag passed to the function gets set. The function should then
+   * stop as soon as possible, e.g. by throwing ::librepcb::UserCanceled.
+   *
+   * The default implementation returns no function, which makes the checks
+   * run synchronously with #runChecks() instead.
+   *
+   * @param function    Function to be run in the worker thread.
+   *
+   * @retval true   Checks prepared (or to be run synchronously).
+   * @retval false  Checks cannot be run now (e.g. a tool is active).
+   */
+  virtual bool prepareChecks(CheckFunction& function) const {
+    function = nullptr;
+    return true;
+  }
+  virtual void setCheckMessages(const RuleCheckMessageList& msgs) noexcept {
+    Q_UNUSED(msgs);
+  }
   void setMessageApproved(LibraryBaseElement& element,
                           std::shared_ptr<const RuleCheckMessage> msg,
                           bool approve) noexcept;
@@ -215,6 +249,7 @@ protected:  // Methods
 
 private slots:
   void updateCheckMessages() noexcept;
+  void backgroundChecksFinished() noexcept;
 
 private:  // Methods
   /**
@@ -231,6 +266,7 @@ private:  // Methods
   void toolRequested(int tool, const QVariant& mode) noexcept;
   void undoStackCleanChanged(bool clean) noexcept;
   void scheduleLibraryElementChecks() noexcept;
+  void processCheckMessages(const RuleCheckMessageList& msgs) noexcept;
   virtual bool processRuleCheckMessage(
       std::shared_ptr<const RuleCheckMessage> msg, bool applyFix) = 0;
   bool ruleCheckFixAvailable(
@@ -268,6 +304,13 @@ protected:  // Data
   // Memorized message approvals
   QSet<SExpression> mSupportedApprovals;
   QSet<SExpression> mDisappearedApprovals;
+
+  // Library element checks
+  QFutureWatcher<RuleCheckMessageList> mBackgroundChecksWatcher;
+  std::shared_ptr<std::atomic_bool> mBackgroundChecksAbort;
+  int mModificationCounter;  ///< Incremented on every undo stack change
+  int mCheckedModification;  ///< Counter value of the current messages
+  int mBackgroundCheckModification;  ///< Counter value of running checks
 };
 
 inline std::size_t qHash(const EditorWidgetBase::Feature& feature,
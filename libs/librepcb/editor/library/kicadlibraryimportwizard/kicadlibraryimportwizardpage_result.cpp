@@ -64,9 +64,11 @@ KiCadLibraryImportWizardPage_Result::KiCadLibraryImportWizardPage_Result(
 
   // Connect finished signal directly with library scanner to get it emitted
   // even when closing this wizard while the import is still in progress.
-  connect(&mContext->getImport(), &KiCadLibraryImport::importFinished,
-          &mContext->getWorkspace().getLibraryDb(),
-          &WorkspaceLibraryDb::startLibraryRescan);
+  // Only the destination library needs to be rescanned.
+  WorkspaceLibraryDb& db = mContext->getWorkspace().getLibraryDb();
+  const FilePath libFp = mContext->getImport().getDestinationLibraryPath();
+  connect(&mContext->getImport(), &KiCadLibraryImport::importFinished, &db,
+          [&db, libFp]() { db.startSingleLibraryRescan(libFp); });
 }
 
 KiCadLibraryImportWizardPage_Result::
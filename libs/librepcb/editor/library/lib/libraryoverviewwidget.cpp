@@ -419,13 +419,12 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
         mContext.workspace.getLibraryDb().getAll<ElementType>(
             std::nullopt,
             mLibrary->getDirectory().getAbsPath());  // can throw
+    const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+        mContext.workspace.getLibraryDb().getElementInfos<ElementType>(
+            dbElements.values(), getLibLocaleOrder());  // can throw
     foreach (const FilePath& filepath, dbElements) {
-      Element element;
-      mContext.workspace.getLibraryDb().getMetadata<ElementType>(
-          filepath, nullptr, nullptr, &element.deprecated);  // can throw
-      mContext.workspace.getLibraryDb().getTranslations<ElementType>(
-          filepath, getLibLocaleOrder(), &element.name);  // can throw
-      elements.insert(filepath, element);
+      const WorkspaceLibraryDb::ElementInfo info = infos.value(filepath);
+      elements.insert(filepath, Element{info.name, info.deprecated});
     }
   } catch (const Exception& e) {
     listWidget.clear();
@@ -22,8 +22,6 @@
  ******************************************************************************/
 #include "libraryelementcache.h"
 
-#include <librepcb/core/fileio/transactionaldirectory.h>
-#include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/cat/componentcategory.h>
 #include <librepcb/core/library/cat/packagecategory.h>
 #include <librepcb/core/library/cmp/component.h>
@@ -32,6 +30,7 @@
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacelibraryelementcache.h>
 
 #include <QtCore>
 
@@ -58,32 +57,32 @@ LibraryElementCache::~LibraryElementCache() noexcept {
 
 std::shared_ptr<const ComponentCategory>
     LibraryElementCache::getComponentCategory(const Uuid& uuid) const noexcept {
-  return getElement(mCmpCat, uuid);
+  return getElement<ComponentCategory>(uuid);
 }
 
 std::shared_ptr<const PackageCategory> LibraryElementCache::getPackageCategory(
     const Uuid& uuid) const noexcept {
-  return getElement(mPkgCat, uuid);
+  return getElement<PackageCategory>(uuid);
 }
 
 std::shared_ptr<const Symbol> LibraryElementCache::getSymbol(
     const Uuid& uuid) const noexcept {
-  return getElement(mSym, uuid);
+  return getElement<Symbol>(uuid);
 }
 
 std::shared_ptr<const Package> LibraryElementCache::getPackage(
     const Uuid& uuid) const noexcept {
-  return getElement(mPkg, uuid);
+  return getElement<Package>(uuid);
 }
 
 std::shared_ptr<const Component> LibraryElementCache::getComponent(
     const Uuid& uuid) const noexcept {
-  return getElement(mCmp, uuid);
+  return getElement<Component>(uuid);
 }
 
 std::shared_ptr<const Device> LibraryElementCache::getDevice(
     const Uuid& uuid) const noexcept {
-  return getElement(mDev, uuid);
+  return getElement<Device>(uuid);
 }
 
 /*******************************************************************************
@@ -92,17 +91,11 @@ std::shared_ptr<const Device> LibraryElementCache::getDevice(
 
 template <typename T>
 std::shared_ptr<const T> LibraryElementCache::getElement(
-    QHash<Uuid, std::shared_ptr<const T>>& container,
     const Uuid& uuid) const noexcept {
-  std::shared_ptr<const T> element = container.value(uuid);
-  if ((!element) && mDb) {
+  std::shared_ptr<const T> element;
+  if (mDb) {
     try {
-      FilePath fp = mDb->getLatest<T>(uuid);
-      element.reset(T::open(std::unique_ptr<TransactionalDirectory>(
-                                new TransactionalDirectory(
-                                    TransactionalFileSystem::openRO(fp))))
-                        .release());
-      container.insert(uuid, element);
+      element = mDb->getElementCache().getLatest<T>(uuid);
     } catch (const Exception& e) {
       qWarning() << "Failed to open library element:" << e.getMsg();
     }
@@ -51,6 +51,11 @@ namespace editor {
 
 /**
  * @brief Cache for fast access to library elements
+ *
+ * Provides access to the latest version of library elements by UUID. The
+ * elements are retrieved from the workspace library element cache
+ * (::librepcb::WorkspaceLibraryElementCache), so they are shared with all
+ * other editors and dialogs.
  */
 class LibraryElementCache final {
   Q_DECLARE_TR_FUNCTIONS(LibraryElementCache)
@@ -78,18 +83,10 @@ public:
 
 private:  // Methods
   template <typename T>
-  std::shared_ptr<const T> getElement(
-      QHash<Uuid, std::shared_ptr<const T>>& container,
-      const Uuid& uuid) const noexcept;
+  std::shared_ptr<const T> getElement(const Uuid& uuid) const noexcept;
 
 private:  // Data
   QPointer<const WorkspaceLibraryDb> mDb;
-  mutable QHash<Uuid, std::shared_ptr<const ComponentCategory>> mCmpCat;
-  mutable QHash<Uuid, std::shared_ptr<const PackageCategory>> mPkgCat;
-  mutable QHash<Uuid, std::shared_ptr<const Symbol>> mSym;
-  mutable QHash<Uuid, std::shared_ptr<const Package>> mPkg;
-  mutable QHash<Uuid, std::shared_ptr<const Component>> mCmp;
-  mutable QHash<Uuid, std::shared_ptr<const Device>> mDev;
 };
 
 /*******************************************************************************
@@ -56,11 +56,9 @@
 #include "../footprintpadpropertiesdialog.h"
 #include "../packageeditorwidget.h"
 
-#include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/utils/clipperhelpers.h>
 #include <librepcb/core/utils/scopeguard.h>
-#include <librepcb/core/utils/tangentpathjoiner.h>
 #include <librepcb/core/utils/transform.h>
 
 #include <QtCore>
@@ -637,28 +635,21 @@ bool PackageEditorState_Select::processImportDxf() noexcept {
     auto cursorScopeGuard =
         scopeGuard([this]() { mContext.editorWidget.unsetCursor(); });
 
-    // Read DXF file.
-    DxfReader import;
-    import.setScaleFactor(dialog.getScaleFactor());
-    import.parse(fp);  // can throw
-
-    // If enabled, join tangent paths.
-    QVector<Path> paths = import.getPolygons().toVector();
-    if (dialog.getJoinTangentPolylines()) {
-      paths = TangentPathJoiner::join(paths, 2000);
-    }
+    // Read DXF file with the chosen filters (and joining tangent paths, if
+    // enabled).
+    const DxfImportDialog::Objects objects = dialog.readFile(fp);  // can throw
 
     // Build elements to import. ALthough this has nothing to do with the
     // clipboard, we use FootprintClipboardData since it works very well :-)
     std::unique_ptr<FootprintClipboardData> data(
         new FootprintClipboardData(mContext.currentFootprint->getUuid(),
                                    mContext.package.getPads(), Point(0, 0)));
-    foreach (const auto& path, paths) {
+    foreach (const auto& path, objects.polygons) {
       data->getPolygons().append(
           std::make_shared<Polygon>(Uuid::createRandom(), dialog.getLayer(),
                                     dialog.getLineWidth(), false, false, path));
     }
-    for (const auto& circle : import.getCircles()) {
+    for (const auto& circle : objects.circles) {
       if (dialog.getImportCirclesAsDrills()) {
         data->getHoles().append(std::make_shared<Hole>(
             Uuid::createRandom(), circle.diameter,
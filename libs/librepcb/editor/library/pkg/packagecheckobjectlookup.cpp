@@ -0,0 +1,89 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "packagecheckobjectlookup.h"
+
+#include <librepcb/core/library/pkg/package.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+PackageCheckObjectLookup::PackageCheckObjectLookup(Package& package) noexcept
+  : mPackage(package) {
+}
+
+PackageCheckObjectLookup::~PackageCheckObjectLookup() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+std::shared_ptr<Footprint> PackageCheckObjectLookup::getFootprint(
+    const Footprint& footprint) const {
+  return mPackage.getFootprints().get(footprint.getUuid());  // can throw
+}
+
+std::shared_ptr<FootprintPad> PackageCheckObjectLookup::getPad(
+    const Footprint& footprint, const FootprintPad& pad) const {
+  return getFootprint(footprint)->getPads().get(pad.getUuid());  // can throw
+}
+
+std::shared_ptr<Hole> PackageCheckObjectLookup::getHole(
+    const Footprint& footprint, const Hole& hole) const {
+  return getFootprint(footprint)->getHoles().get(hole.getUuid());  // can throw
+}
+
+std::shared_ptr<Polygon> PackageCheckObjectLookup::getPolygon(
+    const Footprint& footprint, const Polygon& polygon) const {
+  return getFootprint(footprint)->getPolygons().get(
+      polygon.getUuid());  // can throw
+}
+
+std::shared_ptr<Circle> PackageCheckObjectLookup::getCircle(
+    const Footprint& footprint, const Circle& circle) const {
+  return getFootprint(footprint)->getCircles().get(
+      circle.getUuid());  // can throw
+}
+
+std::shared_ptr<StrokeText> PackageCheckObjectLookup::getStrokeText(
+    const Footprint& footprint, const StrokeText& text) const {
+  return getFootprint(footprint)->getStrokeTexts().get(
+      text.getUuid());  // can throw
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_EDITOR_PACKAGECHECKOBJECTLOOKUP_H
+#define LIBREPCB_EDITOR_PACKAGECHECKOBJECTLOOKUP_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Circle;
+class Footprint;
+class FootprintPad;
+class Hole;
+class Package;
+class Polygon;
+class StrokeText;
+
+namespace editor {
+
+/*******************************************************************************
+ *  Class PackageCheckObjectLookup
+ ******************************************************************************/
+
+/**
+ * @brief Look up the package objects referenced by package check messages
+ *
+ * The package editor runs the checks on a copy of the package (see
+ * ::librepcb::Package::clone()), so the objects referenced by the messages
+ * are not the objects being edited. This class looks up the corresponding
+ * objects of the edited package by their UUIDs. It works for messages of
+ * checks run on the package itself too.
+ *
+ * All methods throw an exception if the object does not exist (anymore).
+ */
+class PackageCheckObjectLookup final {
+public:
+  // Constructors / Destructor
+  PackageCheckObjectLookup() = delete;
+  PackageCheckObjectLookup(const PackageCheckObjectLookup& other) = delete;
+  explicit PackageCheckObjectLookup(Package& package) noexcept;
+  ~PackageCheckObjectLookup() noexcept;
+
+  // General Methods
+  std::shared_ptr<Footprint> getFootprint(const Footprint& footprint) const;
+  std::shared_ptr<FootprintPad> getPad(const Footprint& footprint,
+                                       const FootprintPad& pad) const;
+  std::shared_ptr<Hole> getHole(const Footprint& footprint,
+                                const Hole& hole) const;
+  std::shared_ptr<Polygon> getPolygon(const Footprint& footprint,
+                                      const Polygon& polygon) const;
+  std::shared_ptr<Circle> getCircle(const Footprint& footprint,
+                                    const Circle& circle) const;
+  std::shared_ptr<StrokeText> getStrokeText(const Footprint& footprint,
+                                            const StrokeText& text) const;
+
+  // Operator Overloadings
+  PackageCheckObjectLookup& operator=(const PackageCheckObjectLookup& rhs) =
+      delete;
+
+private:  // Data
+  Package& mPackage;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
@@ -31,6 +31,7 @@
 #include <librepcb/core/application.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacesettings.h>
@@ -97,6 +98,7 @@ PackageChooserDialog::PackageChooserDialog(const Workspace& ws,
 }
 
 PackageChooserDialog::~PackageChooserDialog() noexcept {
+  abortSearch();
   setSelectedPackage(std::nullopt);
 }
 
@@ -146,59 +148,93 @@ void PackageChooserDialog::listPackages_itemDoubleClicked(
 }
 
 void PackageChooserDialog::searchPackages(const QString& input) {
+  abortSearch();
   setSelectedPackage(std::nullopt);
   mUi->listPackages->clear();
   mCategorySelected = false;
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> packages = mWorkspace.getLibraryDb().find<Package>(input);
-    foreach (const Uuid& uuid, packages) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatest<Package>(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getTranslations<Package>(fp, localeOrder(),
-                                                         &name);  // can throw
-      bool deprecated = false;
-      mWorkspace.getLibraryDb().getMetadata<Package>(fp, nullptr, nullptr,
-                                                     &deprecated);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-      item->setData(Qt::UserRole, uuid.toStr());
-      mUi->listPackages->addItem(item);
+    // Run the queries in the worker thread of the library database to keep
+    // the UI responsive while typing.
+    const QStringList locales = localeOrder();
+    mSearchWatcher.reset(new QFutureWatcher<QList<SearchResultItem>>());
+    connect(mSearchWatcher.get(),
+            &QFutureWatcher<QList<SearchResultItem>>::finished, this,
+            &PackageChooserDialog::searchFinished);
+    mSearchWatcher->setFuture(
+        mWorkspace.getLibraryDb().runAsync<QList<SearchResultItem>>(
+            [input, locales](const WorkspaceLibraryDb& db) {
+              return search(db, input, locales);  // can throw
+            }));
+  }
+}
+
+void PackageChooserDialog::searchFinished() noexcept {
+  if (!mSearchWatcher) return;
+  const QFuture<QList<SearchResultItem>> future = mSearchWatcher->future();
+  try {
+    future.waitForFinished();  // can throw
+    if (future.resultCount() > 0) {
+      foreach (const SearchResultItem& result, future.result()) {
+        QListWidgetItem* item = new QListWidgetItem(result.name);
+        item->setForeground(result.deprecated ? QBrush(Qt::red) : QBrush());
+        item->setData(Qt::UserRole, result.uuid.toStr());
+        mUi->listPackages->addItem(item);
+      }
     }
+  } catch (const Exception& e) {
+    QMessageBox::critical(this, tr("Error"), e.getMsg());
   }
 }
 
+void PackageChooserDialog::abortSearch() noexcept {
+  if (mSearchWatcher) {
+    mSearchWatcher->cancel();  // Stops the queries at the next opportunity.
+    mSearchWatcher.reset();
+  }
+}
+
+QList<PackageChooserDialog::SearchResultItem> PackageChooserDialog::search(
+    const WorkspaceLibraryDb& db, const QString& input,
+    const QStringList& localeOrder) {
+  const QList<Uuid> packages = db.find<Package>(input);  // can throw
+  const QHash<Uuid, FilePath> fps =
+      db.getLatest<Package>(Toolbox::toSet(packages));  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+      db.getElementInfos<Package>(fps.values(), localeOrder);  // can throw
+  QList<SearchResultItem> result;
+  foreach (const Uuid& uuid, packages) {
+    const WorkspaceLibraryDb::ElementInfo info = infos.value(fps.value(uuid));
+    result.append(SearchResultItem{uuid, info.name, info.deprecated});
+  }
+  return result;
+}
+
 void PackageChooserDialog::setSelectedCategory(
     const std::optional<Uuid>& uuid) noexcept {
   if ((mCategorySelected) && (uuid == mSelectedCategoryUuid)) return;
 
+  abortSearch();
   setSelectedPackage(std::nullopt);
   mUi->listPackages->clear();
   mSelectedCategoryUuid = uuid;
   mCategorySelected = true;
 
   try {
-    QSet<Uuid> packages =
-        mWorkspace.getLibraryDb().getByCategory<Package>(uuid);  // can throw
+    const WorkspaceLibraryDb& db = mWorkspace.getLibraryDb();
+    const QSet<Uuid> packages = db.getByCategory<Package>(uuid);  // can throw
+    const QHash<Uuid, FilePath> fps =
+        db.getLatest<Package>(packages);  // can throw
+    const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+        db.getElementInfos<Package>(fps.values(), localeOrder());  // can throw
     foreach (const Uuid& pkgUuid, packages) {
-      try {
-        FilePath fp =
-            mWorkspace.getLibraryDb().getLatest<Package>(pkgUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getTranslations<Package>(fp, localeOrder(),
-                                                           &name);  // can throw
-        bool deprecated = false;
-        mWorkspace.getLibraryDb().getMetadata<Package>(
-            fp, nullptr, nullptr, &deprecated);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-        item->setData(Qt::UserRole, pkgUuid.toStr());
-        mUi->listPackages->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+      const FilePath fp = fps.value(pkgUuid);
+      const WorkspaceLibraryDb::ElementInfo info = infos.value(fp);
+      QListWidgetItem* item = new QListWidgetItem(info.name);
+      item->setForeground(info.deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, pkgUuid.toStr());
+      mUi->listPackages->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load packages"), e.getMsg());
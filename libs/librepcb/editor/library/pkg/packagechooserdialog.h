@@ -38,6 +38,7 @@ namespace librepcb {
 
 class Package;
 class Workspace;
+class WorkspaceLibraryDb;
 
 namespace editor {
 
@@ -59,6 +60,13 @@ class PackageChooserDialog;
 class PackageChooserDialog final : public QDialog {
   Q_OBJECT
 
+  // Types
+  struct SearchResultItem {
+    Uuid uuid;
+    QString name;
+    bool deprecated;
+  };
+
 public:
   // Constructors / Destructor
   PackageChooserDialog() = delete;
@@ -83,6 +91,11 @@ private:  // Methods
                                        QListWidgetItem* previous) noexcept;
   void listPackages_itemDoubleClicked(QListWidgetItem* item) noexcept;
   void searchPackages(const QString& input);
+  void searchFinished() noexcept;
+  void abortSearch() noexcept;
+  static QList<SearchResultItem> search(const WorkspaceLibraryDb& db,
+                                        const QString& input,
+                                        const QStringList& localeOrder);
   void setSelectedCategory(const std::optional<Uuid>& uuid) noexcept;
   void setSelectedPackage(const std::optional<Uuid>& uuid) noexcept;
   void updatePreview(const FilePath& fp) noexcept;
@@ -95,6 +108,7 @@ private:  // Data
   QScopedPointer<Ui::PackageChooserDialog> mUi;
   QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
   bool mCategorySelected;
+  std::unique_ptr<QFutureWatcher<QList<SearchResultItem>>> mSearchWatcher;
   std::optional<Uuid> mSelectedCategoryUuid;
   std::optional<Uuid> mSelectedPackageUuid;
 
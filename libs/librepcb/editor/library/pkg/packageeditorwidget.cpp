@@ -41,6 +41,7 @@
 #include "../cmd/cmdfootprintpadedit.h"
 #include "../cmd/cmdpackageedit.h"
 #include "fsm/packageeditorfsm.h"
+#include "packagecheckobjectlookup.h"
 #include "ui_packageeditorwidget.h"
 
 #include <librepcb/core/application.h>
@@ -180,7 +181,8 @@ PackageEditorWidget::PackageEditorWidget(const Context& context,
     mUi(new Ui::PackageEditorWidget),
     mGraphicsScene(new GraphicsScene()),
     mOpenGlSceneBuildScheduled(false),
-    mBackgroundImageGraphicsItem(new QGraphicsPixmapItem()) {
+    mBackgroundImageGraphicsItem(new QGraphicsPixmapItem()),
+    mPadOutlineCache(std::make_shared<PackageCheck::PadOutlineCache>()) {
   mUi->setupUi(this);
   mUi->lstMessages->setHandler(this);
   mUi->lstMessages->setReadOnly(mContext.readOnly);
@@ -892,12 +894,19 @@ bool PackageEditorWidget::isInterfaceBroken() const noexcept {
   return false;
 }
 
+bool PackageEditorWidget::canRunChecks() const noexcept {
+  // Do not run checks if a tool is active because it could lead to annoying,
+  // flickering messages. For example when placing pads, they always overlap
+  // right after placing them, so we have to wait until the user has moved the
+  // cursor to place the pad at a different position.
+  return (mFsm->getCurrentTool() == NONE) || (mFsm->getCurrentTool() == SELECT);
+}
+
 bool PackageEditorWidget::runChecks(RuleCheckMessageList& msgs) const {
-  if ((mFsm->getCurrentTool() != NONE) && (mFsm->getCurrentTool() != SELECT)) {
-    // Do not run checks if a tool is active because it could lead to annoying,
-    // flickering messages. For example when placing pads, they always overlap
-    // right after placing them, so we have to wait until the user has moved the
-    // cursor to place the pad at a different position.
+  // Not used by EditorWidgetBase since the package editor only checks in the
+  // background (see prepareChecks()). Anyway, don't use mPadOutlineCache here
+  // since a background check might be using it right now.
+  if (!canRunChecks()) {
     return false;
   }
   msgs = mPackage->runChecks();  // can throw
@@ -905,6 +914,33 @@ bool PackageEditorWidget::runChecks(RuleCheckMessageList& msgs) const {
   return true;
 }
 
+bool PackageEditorWidget::prepareChecks(CheckFunction& function) const {
+  if (!canRunChecks()) {
+    return false;
+  }
+
+  // The pad clearance checks are expensive for packages with many pads, thus
+  // run them on a copy of the package in a worker thread to keep the editor
+  // responsive. Note that the messages then reference objects of the copy,
+  // so the fix handlers have to use PackageCheckObjectLookup. The pad outline
+  // cache is shared by all runs, which is safe since only one check runs at a
+  // time.
+  std::shared_ptr<const Package> copy = mPackage->clone();
+  std::shared_ptr<PackageCheck::PadOutlineCache> cache = mPadOutlineCache;
+  function = [copy, cache](const std::atomic_bool& abort) {
+    PackageCheck check(*copy);
+    check.setAbortFlag(&abort);
+    check.setPadOutlineCache(cache);
+    return check.runChecks();  // can throw
+  };
+  return true;
+}
+
+void PackageEditorWidget::setCheckMessages(
+    const RuleCheckMessageList& msgs) noexcept {
+  mUi->lstMessages->setMessages(msgs);
+}
+
 template <>
 void PackageEditorWidget::fixMsg(const MsgDeprecatedAssemblyType& msg) {
   Q_UNUSED(msg);
@@ -943,14 +979,12 @@ void PackageEditorWidget::fixMsg(const MsgMissingCategories& msg) {
 template <>
 void PackageEditorWidget::fixMsg(const MsgMissingPackageOutline& msg) {
   mUi->footprintEditorWidget->setCurrentIndex(
-      mPackage->getFootprints().indexOf(msg.getFootprint().get()));
+      mPackage->getFootprints().indexOf(msg.getFootprint()->getUuid()));
   mFsm->processGenerateOutline();
 }
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgMinimumWidthViolation& msg) {
-  if (!mCurrentFootprint) return;
-
   QDialog dlg(this);
   dlg.setWindowTitle(tr("New Line Width"));
   QVBoxLayout* vLayout = new QVBoxLayout(&dlg);
@@ -969,17 +1003,22 @@ void PackageEditorWidget::fixMsg(const MsgMinimumWidthViolation& msg) {
     return;
   }
 
-  if (auto p = mCurrentFootprint->getPolygons().find(msg.getPolygon().get())) {
+  const PackageCheckObjectLookup lookup(*mPackage);
+  if (msg.getPolygon()) {
+    std::shared_ptr<Polygon> p = lookup.getPolygon(
+        *msg.getFootprint(), *msg.getPolygon());  // can throw
     std::unique_ptr<CmdPolygonEdit> cmd(new CmdPolygonEdit(*p));
     cmd->setLineWidth(edtWidth->getValue(), false);
     mUndoStack->execCmd(cmd.release());
-  } else if (auto c =
-                 mCurrentFootprint->getCircles().find(msg.getCircle().get())) {
+  } else if (msg.getCircle()) {
+    std::shared_ptr<Circle> c = lookup.getCircle(
+        *msg.getFootprint(), *msg.getCircle());  // can throw
     std::unique_ptr<CmdCircleEdit> cmd(new CmdCircleEdit(*c));
     cmd->setLineWidth(edtWidth->getValue(), false);
     mUndoStack->execCmd(cmd.release());
-  } else if (auto t = mCurrentFootprint->getStrokeTexts().find(
-                 msg.getStrokeText().get())) {
+  } else if (msg.getStrokeText()) {
+    std::shared_ptr<StrokeText> t = lookup.getStrokeText(
+        *msg.getFootprint(), *msg.getStrokeText());  // can throw
     std::unique_ptr<CmdStrokeTextEdit> cmd(new CmdStrokeTextEdit(*t));
     cmd->setStrokeWidth(edtWidth->getValue(), false);
     mUndoStack->execCmd(cmd.release());
@@ -992,7 +1031,7 @@ void PackageEditorWidget::fixMsg(const MsgMinimumWidthViolation& msg) {
 template <>
 void PackageEditorWidget::fixMsg(const MsgMissingCourtyard& msg) {
   mUi->footprintEditorWidget->setCurrentIndex(
-      mPackage->getFootprints().indexOf(msg.getFootprint().get()));
+      mPackage->getFootprints().indexOf(msg.getFootprint()->getUuid()));
   mFsm->processGenerateCourtyard();
 }
 
@@ -1014,7 +1053,7 @@ template <>
 void PackageEditorWidget::fixMsg(const MsgMissingFootprintName& msg) {
   Q_UNUSED(msg);
   mUi->footprintEditorWidget->setCurrentIndex(
-      mPackage->getFootprints().indexOf(msg.getFootprint().get()));
+      mPackage->getFootprints().indexOf(msg.getFootprint()->getUuid()));
   mFsm->processStartAddingNames();
 }
 
@@ -1022,7 +1061,7 @@ template <>
 void PackageEditorWidget::fixMsg(const MsgMissingFootprintValue& msg) {
   Q_UNUSED(msg);
   mUi->footprintEditorWidget->setCurrentIndex(
-      mPackage->getFootprints().indexOf(msg.getFootprint().get()));
+      mPackage->getFootprints().indexOf(msg.getFootprint()->getUuid()));
   mFsm->processStartAddingValues();
 }
 
@@ -1031,7 +1070,7 @@ void PackageEditorWidget::fixMsg(const MsgFootprintOriginNotInCenter& msg) {
   mFsm->processAbortCommand();
   mFsm->processAbortCommand();
   currentFootprintChanged(
-      mPackage->getFootprints().indexOf(msg.getFootprint().get()));
+      mPackage->getFootprints().indexOf(msg.getFootprint()->getUuid()));
   mFsm->processSelectAll();
   mFsm->processMove(-msg.getCenter());
   mFsm->processAbortCommand();  // Clear selection.
@@ -1039,10 +1078,9 @@ void PackageEditorWidget::fixMsg(const MsgFootprintOriginNotInCenter& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgWrongFootprintTextLayer& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<StrokeText> text =
-      footprint->getStrokeTexts().get(msg.getText().get());
+      lookup.getStrokeText(*msg.getFootprint(), *msg.getText());  // can throw
   std::unique_ptr<CmdStrokeTextEdit> cmd(new CmdStrokeTextEdit(*text));
   cmd->setLayer(msg.getExpectedLayer(), false);
   mUndoStack->execCmd(cmd.release());
@@ -1050,10 +1088,9 @@ void PackageEditorWidget::fixMsg(const MsgWrongFootprintTextLayer& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgUnusedCustomPadOutline& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
   cmd->setCustomShapeOutline(Path());
   mUndoStack->execCmd(cmd.release());
@@ -1061,10 +1098,9 @@ void PackageEditorWidget::fixMsg(const MsgUnusedCustomPadOutline& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgInvalidCustomPadOutline& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
   cmd->setShape(FootprintPad::Shape::RoundedRect, false);
   mUndoStack->execCmd(cmd.release());
@@ -1072,10 +1108,9 @@ void PackageEditorWidget::fixMsg(const MsgInvalidCustomPadOutline& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgPadStopMaskOff& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
   cmd->setStopMaskConfig(MaskConfig::automatic(), false);
   mUndoStack->execCmd(cmd.release());
@@ -1083,10 +1118,9 @@ void PackageEditorWidget::fixMsg(const MsgPadStopMaskOff& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgSmtPadWithSolderPaste& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
   cmd->setSolderPasteConfig(MaskConfig::off());
   mUndoStack->execCmd(cmd.release());
@@ -1094,10 +1128,9 @@ void PackageEditorWidget::fixMsg(const MsgSmtPadWithSolderPaste& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgThtPadWithSolderPaste& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
   cmd->setSolderPasteConfig(MaskConfig::off());
   mUndoStack->execCmd(cmd.release());
@@ -1105,10 +1138,9 @@ void PackageEditorWidget::fixMsg(const MsgThtPadWithSolderPaste& msg) {
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgPadWithCopperClearance& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
   cmd->setCopperClearance(UnsignedLength(0));
   mUndoStack->execCmd(cmd.release());
@@ -1117,10 +1149,9 @@ void PackageEditorWidget::fixMsg(const MsgPadWithCopperClearance& msg) {
 template <>
 void PackageEditorWidget::fixMsg(
     const MsgFiducialClearanceLessThanStopMask& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
   std::shared_ptr<FootprintPad> pad =
-      footprint->getPads().get(msg.getPad().get());
+      lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
   const std::optional<Length> offset = pad->getStopMaskConfig().getOffset();
   if (offset && (*offset > 0)) {
     std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
@@ -1131,9 +1162,9 @@ void PackageEditorWidget::fixMsg(
 
 template <>
 void PackageEditorWidget::fixMsg(const MsgHoleWithoutStopMask& msg) {
-  std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
-  std::shared_ptr<Hole> hole = footprint->getHoles().get(msg.getHole().get());
+  const PackageCheckObjectLookup lookup(*mPackage);
+  std::shared_ptr<Hole> hole =
+      lookup.getHole(*msg.getFootprint(), *msg.getHole());  // can throw
   std::unique_ptr<CmdHoleEdit> cmd(new CmdHoleEdit(*hole));
   cmd->setStopMaskConfig(MaskConfig::automatic());
   mUndoStack->execCmd(cmd.release());
@@ -1188,10 +1219,9 @@ void PackageEditorWidget::fixPadFunction(const MessageType& msg) {
       }
       transaction.commit();
     } else {
-      std::shared_ptr<Footprint> footprint =
-          mPackage->getFootprints().get(msg.getFootprint().get());
+      const PackageCheckObjectLookup lookup(*mPackage);
       std::shared_ptr<FootprintPad> pad =
-          footprint->getPads().get(msg.getPad().get());
+          lookup.getPad(*msg.getFootprint(), *msg.getPad());  // can throw
       std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(*pad));
       cmd->setFunction(action->data().value<FootprintPad::Function>(), false);
       mUndoStack->execCmd(cmd.release());
@@ -28,6 +28,7 @@
 #include "../editorwidgetbase.h"
 
 #include <librepcb/core/library/pkg/footprint.h>
+#include <librepcb/core/library/pkg/packagecheck.h>
 #include <librepcb/core/types/lengthunit.h>
 #include <librepcb/core/workspace/theme.h>
 
@@ -155,7 +156,10 @@ private:  // Methods
   void updateOpenGlScene() noexcept;
   void memorizePackageInterface() noexcept;
   bool isInterfaceBroken() const noexcept override;
+  bool canRunChecks() const noexcept;
   bool runChecks(RuleCheckMessageList& msgs) const override;
+  bool prepareChecks(CheckFunction& function) const override;
+  void setCheckMessages(const RuleCheckMessageList& msgs) noexcept override;
   template <typename MessageType>
   void fixMsg(const MessageType& msg);
   template <typename MessageType>
@@ -195,6 +199,9 @@ private:  // Data
   QSet<Uuid> mOriginalPadUuids;
   FootprintList mOriginalFootprints;
 
+  /// Pad outlines reused by the background checks of all modifications
+  std::shared_ptr<PackageCheck::PadOutlineCache> mPadOutlineCache;
+
   /// Editor state machine
   QScopedPointer<PackageEditorFsm> mFsm;
 };
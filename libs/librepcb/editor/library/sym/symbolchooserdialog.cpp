@@ -30,6 +30,7 @@
 
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacesettings.h>
@@ -98,6 +99,7 @@ SymbolChooserDialog::SymbolChooserDialog(const Workspace& ws,
 }
 
 SymbolChooserDialog::~SymbolChooserDialog() noexcept {
+  abortSearch();
   setSelectedSymbol(FilePath());
 }
 
@@ -166,60 +168,94 @@ void SymbolChooserDialog::listSymbols_itemDoubleClicked(
 }
 
 void SymbolChooserDialog::searchSymbols(const QString& input) {
+  abortSearch();
   setSelectedSymbol(FilePath());
   mUi->listSymbols->clear();
   mCategorySelected = false;
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> symbols = mWorkspace.getLibraryDb().find<Symbol>(input);
-    foreach (const Uuid& uuid, symbols) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatest<Symbol>(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getTranslations<Symbol>(fp, localeOrder(),
-                                                        &name);  // can throw
-      bool deprecated = false;
-      mWorkspace.getLibraryDb().getMetadata<Symbol>(fp, nullptr, nullptr,
-                                                    &deprecated);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-      item->setData(Qt::UserRole, fp.toStr());
-      mUi->listSymbols->addItem(item);
+    // Run the queries in the worker thread of the library database to keep
+    // the UI responsive while typing.
+    const QStringList locales = localeOrder();
+    mSearchWatcher.reset(new QFutureWatcher<QList<SearchResultItem>>());
+    connect(mSearchWatcher.get(),
+            &QFutureWatcher<QList<SearchResultItem>>::finished, this,
+            &SymbolChooserDialog::searchFinished);
+    mSearchWatcher->setFuture(
+        mWorkspace.getLibraryDb().runAsync<QList<SearchResultItem>>(
+            [input, locales](const WorkspaceLibraryDb& db) {
+              return search(db, input, locales);  // can throw
+            }));
+  }
+}
+
+void SymbolChooserDialog::searchFinished() noexcept {
+  if (!mSearchWatcher) return;
+  const QFuture<QList<SearchResultItem>> future = mSearchWatcher->future();
+  try {
+    future.waitForFinished();  // can throw
+    if (future.resultCount() > 0) {
+      foreach (const SearchResultItem& result, future.result()) {
+        QListWidgetItem* item = new QListWidgetItem(result.name);
+        item->setForeground(result.deprecated ? QBrush(Qt::red) : QBrush());
+        item->setData(Qt::UserRole, result.fp.toStr());
+        mUi->listSymbols->addItem(item);
+      }
     }
+  } catch (const Exception& e) {
+    QMessageBox::critical(this, tr("Error"), e.getMsg());
   }
 }
 
+void SymbolChooserDialog::abortSearch() noexcept {
+  if (mSearchWatcher) {
+    mSearchWatcher->cancel();  // Stops the queries at the next opportunity.
+    mSearchWatcher.reset();
+  }
+}
+
+QList<SymbolChooserDialog::SearchResultItem> SymbolChooserDialog::search(
+    const WorkspaceLibraryDb& db, const QString& input,
+    const QStringList& localeOrder) {
+  const QList<Uuid> symbols = db.find<Symbol>(input);  // can throw
+  const QHash<Uuid, FilePath> fps =
+      db.getLatest<Symbol>(Toolbox::toSet(symbols));  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+      db.getElementInfos<Symbol>(fps.values(), localeOrder);  // can throw
+  QList<SearchResultItem> result;
+  foreach (const Uuid& uuid, symbols) {
+    const FilePath fp = fps.value(uuid);
+    const WorkspaceLibraryDb::ElementInfo info = infos.value(fp);
+    result.append(SearchResultItem{fp, info.name, info.deprecated});
+  }
+  return result;
+}
+
 void SymbolChooserDialog::setSelectedCategory(
     const std::optional<Uuid>& uuid) noexcept {
   if ((mCategorySelected) && (uuid == mSelectedCategoryUuid)) return;
 
+  abortSearch();
   setSelectedSymbol(FilePath());
   mUi->listSymbols->clear();
   mSelectedCategoryUuid = uuid;
   mCategorySelected = true;
 
   try {
-    QSet<Uuid> symbols =
-        mWorkspace.getLibraryDb().getByCategory<Symbol>(uuid);  // can throw
+    const WorkspaceLibraryDb& db = mWorkspace.getLibraryDb();
+    const QSet<Uuid> symbols = db.getByCategory<Symbol>(uuid);  // can throw
+    const QHash<Uuid, FilePath> fps =
+        db.getLatest<Symbol>(symbols);  // can throw
+    const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+        db.getElementInfos<Symbol>(fps.values(), localeOrder());  // can throw
     foreach (const Uuid& symbolUuid, symbols) {
-      try {
-        FilePath fp = mWorkspace.getLibraryDb().getLatest<Symbol>(
-            symbolUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getTranslations<Symbol>(fp, localeOrder(),
-                                                          &name);  // can throw
-        bool deprecated = false;
-        mWorkspace.getLibraryDb().getMetadata<Symbol>(
-            fp, nullptr, nullptr,
-            &deprecated);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-        item->setData(Qt::UserRole, fp.toStr());
-        mUi->listSymbols->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+      const FilePath fp = fps.value(symbolUuid);
+      const WorkspaceLibraryDb::ElementInfo info = infos.value(fp);
+      QListWidgetItem* item = new QListWidgetItem(info.name);
+      item->setForeground(info.deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, fp.toStr());
+      mUi->listSymbols->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load symbols"), e.getMsg());
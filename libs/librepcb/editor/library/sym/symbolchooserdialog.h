@@ -38,6 +38,7 @@ namespace librepcb {
 
 class Symbol;
 class Workspace;
+class WorkspaceLibraryDb;
 
 namespace editor {
 
@@ -59,6 +60,13 @@ class SymbolChooserDialog;
 class SymbolChooserDialog final : public QDialog {
   Q_OBJECT
 
+  // Types
+  struct SearchResultItem {
+    FilePath fp;
+    QString name;
+    bool deprecated;
+  };
+
 public:
   // Constructors / Destructor
   SymbolChooserDialog() = delete;
@@ -83,6 +91,11 @@ private:  // Methods
                                       QListWidgetItem* previous) noexcept;
   void listSymbols_itemDoubleClicked(QListWidgetItem* item) noexcept;
   void searchSymbols(const QString& input);
+  void searchFinished() noexcept;
+  void abortSearch() noexcept;
+  static QList<SearchResultItem> search(const WorkspaceLibraryDb& db,
+                                        const QString& input,
+                                        const QStringList& localeOrder);
   void setSelectedCategory(const std::optional<Uuid>& uuid) noexcept;
   void setSelectedSymbol(const FilePath& fp) noexcept;
   void accept() noexcept override;
@@ -95,6 +108,7 @@ private:  // Data
   QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
   QScopedPointer<GraphicsScene> mPreviewScene;
   bool mCategorySelected;
+  std::unique_ptr<QFutureWatcher<QList<SearchResultItem>>> mSearchWatcher;
   std::optional<Uuid> mSelectedCategoryUuid;
   std::unique_ptr<Symbol> mSelectedSymbol;
   QScopedPointer<SymbolGraphicsItem> mGraphicsItem;
@@ -45,8 +45,10 @@
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/theme.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacelibraryelementcache.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
 #include <QtCore>
@@ -258,6 +260,8 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
 }
 
 AddComponentDialog::~AddComponentDialog() noexcept {
+  abortSearch();
+
   // Save client settings.
   QSettings clientSettings;
   clientSettings.setValue("schematic_editor/add_component_dialog/add_more",
@@ -380,23 +384,15 @@ void AddComponentDialog::treeComponents_currentItemChanged(
       FilePath cmpFp = FilePath(cmpItem->data(0, Qt::UserRole).toString());
       if ((!mSelectedComponent) ||
           (mSelectedComponent->getDirectory().getAbsPath() != cmpFp)) {
-        std::shared_ptr<Component> component(
-            Component::open(std::unique_ptr<TransactionalDirectory>(
-                                new TransactionalDirectory(
-                                    TransactionalFileSystem::openRO(cmpFp))))
-                .release());
-        setSelectedComponent(component);
+        setSelectedComponent(
+            mDb.getElementCache().get<Component>(cmpFp));  // can throw
       }
       if (devItem) {
         FilePath devFp = FilePath(devItem->data(0, Qt::UserRole).toString());
         if ((!mSelectedDevice) ||
             (mSelectedDevice->getDirectory().getAbsPath() != devFp)) {
-          std::shared_ptr<Device> device(
-              Device::open(std::unique_ptr<TransactionalDirectory>(
-                               new TransactionalDirectory(
-                                   TransactionalFileSystem::openRO(devFp))))
-                  .release());
-          setSelectedDevice(device);
+          setSelectedDevice(
+              mDb.getElementCache().get<Device>(devFp));  // can throw
         }
         setSelectedPart(
             partItem
@@ -500,10 +496,57 @@ void AddComponentDialog::customComponentsContextMenuRequested(
 void AddComponentDialog::searchComponents(
     const QString& input, const std::optional<Uuid>& selectedDevice,
     bool selectFirstDevice) {
+  abortSearch();
   mCurrentSearchTerm = input;
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
+  // min. 2 chars to avoid freeze on entering first character due to huge result
+  if (input.length() > 1) {
+    // Run the queries in the worker thread of the library database to keep
+    // the UI responsive while typing. The search is aborted as soon as the
+    // search term is changed again.
+    const QStringList localeOrder = mLocaleOrder;
+    mSearchWatcher.reset(new QFutureWatcher<SearchResult>());
+    connect(mSearchWatcher.get(), &QFutureWatcher<SearchResult>::finished,
+            this, [this, input, selectedDevice, selectFirstDevice]() {
+              searchFinished(input, selectedDevice, selectFirstDevice);
+            });
+    mSearchWatcher->setFuture(mDb.runAsync<SearchResult>(
+        [input, localeOrder](const WorkspaceLibraryDb& db) {
+          return search(db, input, localeOrder);  // can throw
+        }));
+  } else {
+    showSearchResult(input, SearchResult(), selectedDevice, selectFirstDevice);
+  }
+}
+
+void AddComponentDialog::searchFinished(
+    const QString& input, const std::optional<Uuid>& selectedDevice,
+    bool selectFirstDevice) noexcept {
+  if (!mSearchWatcher) return;
+  const QFuture<SearchResult> future = mSearchWatcher->future();
+  try {
+    future.waitForFinished();  // can throw
+    if (future.resultCount() > 0) {
+      showSearchResult(input, future.result(), selectedDevice,
+                       selectFirstDevice);
+    }
+  } catch (const Exception& e) {
+    mUi->lblErrorMsg->setText(e.getMsg());
+  }
+}
+
+void AddComponentDialog::abortSearch() noexcept {
+  if (mSearchWatcher) {
+    mSearchWatcher->cancel();  // Stops the queries at the next opportunity.
+    mSearchWatcher.reset();
+  }
+}
+
+void AddComponentDialog::showSearchResult(
+    const QString& input, const SearchResult& result,
+    const std::optional<Uuid>& selectedDevice, bool selectFirstDevice) {
   // Temporarily disable update on expand for performance reasons.
   mUpdatePartInformationOnExpand = false;
   auto disableExpandSg =
@@ -511,48 +554,43 @@ void AddComponentDialog::searchComponents(
 
   QTreeWidgetItem* selectedDeviceItem = nullptr;
 
-  // min. 2 chars to avoid freeze on entering first character due to huge result
-  if (input.length() > 1) {
-    SearchResult result = search(input);
-    const bool expandAllDevices =
-        (result.partsCount <= 15) || (result.deviceCount <= 1);
-    const bool expandAllComponents =
-        (result.deviceCount <= 10) || (result.components.count() <= 1);
-    for (auto cmpIt = result.components.begin();
-         cmpIt != result.components.end(); ++cmpIt) {
-      QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
-      cmpItem->setIcon(0, QIcon(":/img/library/symbol.png"));
-      cmpItem->setText(0, cmpIt.value().name);
-      cmpItem->setForeground(
-          0, cmpIt.value().deprecated ? QBrush(Qt::red) : QBrush());
-      cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
-      for (auto devIt = cmpIt->devices.begin(); devIt != cmpIt->devices.end();
-           ++devIt) {
-        QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
-        devItem->setIcon(0, QIcon(":/img/library/device.png"));
-        devItem->setText(0, devIt.value().name);
-        devItem->setForeground(
-            0, devIt.value().deprecated ? QBrush(Qt::red) : QBrush());
-        devItem->setData(0, Qt::UserRole, devIt.key().toStr());
-        devItem->setText(1, devIt.value().pkgName);
-        devItem->setTextAlignment(1, Qt::AlignRight);
-        QFont font = devItem->font(1);
-        font.setItalic(true);
-        devItem->setFont(1, font);
-        for (const auto& partPtr : devIt->parts.values()) {
-          addPartItem(partPtr, devItem);
-        }
-        devItem->setExpanded(
-            ((!cmpIt.value().match) && (!devIt.value().match)) ||
-            expandAllDevices);
-        if (devIt.value().uuid == selectedDevice) {
-          selectedDeviceItem = devItem;
-        }
+  const bool expandAllDevices =
+      (result.partsCount <= 15) || (result.deviceCount <= 1);
+  const bool expandAllComponents =
+      (result.deviceCount <= 10) || (result.components.count() <= 1);
+  for (auto cmpIt = result.components.begin();
+       cmpIt != result.components.end(); ++cmpIt) {
+    QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
+    cmpItem->setIcon(0, QIcon(":/img/library/symbol.png"));
+    cmpItem->setText(0, cmpIt.value().name);
+    cmpItem->setForeground(
+        0, cmpIt.value().deprecated ? QBrush(Qt::red) : QBrush());
+    cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
+    for (auto devIt = cmpIt->devices.begin(); devIt != cmpIt->devices.end();
+         ++devIt) {
+      QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
+      devItem->setIcon(0, QIcon(":/img/library/device.png"));
+      devItem->setText(0, devIt.value().name);
+      devItem->setForeground(
+          0, devIt.value().deprecated ? QBrush(Qt::red) : QBrush());
+      devItem->setData(0, Qt::UserRole, devIt.key().toStr());
+      devItem->setText(1, devIt.value().pkgName);
+      devItem->setTextAlignment(1, Qt::AlignRight);
+      QFont font = devItem->font(1);
+      font.setItalic(true);
+      devItem->setFont(1, font);
+      for (const auto& partPtr : devIt->parts.values()) {
+        addPartItem(partPtr, devItem);
+      }
+      devItem->setExpanded(((!cmpIt.value().match) && (!devIt.value().match)) ||
+                           expandAllDevices);
+      if (devIt.value().uuid == selectedDevice) {
+        selectedDeviceItem = devItem;
       }
-      cmpItem->setText(1, QString("[%1]").arg(cmpIt.value().devices.count()));
-      cmpItem->setTextAlignment(1, Qt::AlignRight);
-      cmpItem->setExpanded((!cmpIt.value().match) || expandAllComponents);
     }
+    cmpItem->setText(1, QString("[%1]").arg(cmpIt.value().devices.count()));
+    cmpItem->setTextAlignment(1, Qt::AlignRight);
+    cmpItem->setExpanded((!cmpIt.value().match) || expandAllComponents);
   }
 
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
@@ -592,43 +630,70 @@ void AddComponentDialog::searchComponents(
 }
 
 AddComponentDialog::SearchResult AddComponentDialog::search(
-    const QString& input) {
+    const WorkspaceLibraryDb& db, const QString& input,
+    const QStringList& localeOrder) {
   SearchResult result;
 
   // Find in library database.
   const QList<Uuid> matchingComponents =
-      mDb.find<Component>(input);  // can throw
-  const QList<Uuid> matchingDevices = mDb.find<Device>(input);  // can throw
+      db.find<Component>(input);  // can throw
+  const QList<Uuid> matchingDevices = db.find<Device>(input);  // can throw
   const QList<Uuid> matchingPartDevices =
-      mDb.findDevicesOfParts(input);  // can throw
+      db.findDevicesOfParts(input);  // can throw
+
+  // Collect all involved devices to fetch their data with bulk queries.
+  QHash<Uuid, QSet<Uuid>> componentDevices;
+  QSet<Uuid> fullDevices = Toolbox::toSet(matchingDevices);
+  foreach (const Uuid& cmpUuid, matchingComponents) {
+    const QSet<Uuid> devices = db.getComponentDevices(cmpUuid);  // can throw
+    componentDevices.insert(cmpUuid, devices);
+    fullDevices |= devices;
+  }
+  const QHash<Uuid, FilePath> devFps = db.getLatest<Device>(
+      fullDevices | Toolbox::toSet(matchingPartDevices));  // can throw
+  const QHash<FilePath, std::pair<Uuid, Uuid>> devMetadata =
+      db.getDeviceMetadata(devFps.values());  // can throw
+  QSet<Uuid> cmpUuids = Toolbox::toSet(matchingComponents);
+  QSet<Uuid> pkgUuids;
+  foreach (const auto& metadata, devMetadata) {
+    cmpUuids.insert(metadata.first);
+    pkgUuids.insert(metadata.second);
+  }
+  const QHash<Uuid, FilePath> cmpFps =
+      db.getLatest<Component>(cmpUuids);  // can throw
+  const QHash<Uuid, FilePath> pkgFps =
+      db.getLatest<Package>(pkgUuids);  // can throw
+  const QHash<Uuid, QList<WorkspaceLibraryDb::Part>> devParts =
+      db.getDeviceParts(fullDevices);  // can throw
+  auto getPkgFp = [&](const FilePath& devFp) {
+    auto it = devMetadata.find(devFp);
+    return (it != devMetadata.end()) ? pkgFps.value(it->second) : FilePath();
+  };
+  auto addParts = [](SearchResultDevice& resDev,
+                     const QList<WorkspaceLibraryDb::Part>& parts) {
+    foreach (const WorkspaceLibraryDb::Part& part, parts) {
+      resDev.parts.append(std::make_shared<Part>(
+          SimpleString(part.mpn), SimpleString(part.manufacturer),
+          part.attributes));
+    }
+  };
 
   // Add matching components and all their devices and parts.
   QSet<Uuid> fullyAddedDevices;
   foreach (const Uuid& cmpUuid, matchingComponents) {
-    FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);  // can throw
+    const FilePath cmpFp = cmpFps.value(cmpUuid);
     if (!cmpFp.isValid()) continue;
-    QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);  // can throw
     SearchResultComponent& resCmp = result.components[cmpFp];
     resCmp.match = true;
-    foreach (const Uuid& devUuid, devices) {
-      FilePath devFp = mDb.getLatest<Device>(devUuid);  // can throw
+    foreach (const Uuid& devUuid, componentDevices.value(cmpUuid)) {
+      const FilePath devFp = devFps.value(devUuid);
       if (!devFp.isValid()) continue;
       if (resCmp.devices.contains(devFp)) continue;
-      Uuid pkgUuid = Uuid::createRandom();
-      mDb.getDeviceMetadata(devFp, nullptr,
-                            &pkgUuid);  // can throw
-      FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);  // can throw
       SearchResultDevice& resDev = resCmp.devices[devFp];
       resDev.uuid = devUuid;
-      resDev.pkgFp = pkgFp;
+      resDev.pkgFp = getPkgFp(devFp);
       resDev.match = matchingDevices.contains(devUuid);
-      const QList<WorkspaceLibraryDb::Part> parts =
-          mDb.getDeviceParts(devUuid);  // can throw
-      foreach (const WorkspaceLibraryDb::Part& part, parts) {
-        resDev.parts.append(std::make_shared<Part>(
-            SimpleString(part.mpn), SimpleString(part.manufacturer),
-            part.attributes));
-      }
+      addParts(resDev, devParts.value(devUuid));
       fullyAddedDevices.insert(devUuid);
     }
   }
@@ -646,59 +711,58 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
                                }),
                 devices.end());
   foreach (const Uuid& devUuid, devices) {
-    FilePath devFp = mDb.getLatest<Device>(devUuid);  // can throw
+    const FilePath devFp = devFps.value(devUuid);
     if (!devFp.isValid()) continue;
-    Uuid cmpUuid = Uuid::createRandom();
-    Uuid pkgUuid = Uuid::createRandom();
-    mDb.getDeviceMetadata(devFp, &cmpUuid,
-                          &pkgUuid);  // can throw
-    const FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);  // can throw
+    auto metadata = devMetadata.find(devFp);
+    if (metadata == devMetadata.end()) continue;
+    const FilePath cmpFp = cmpFps.value(metadata->first);
     if (!cmpFp.isValid()) continue;
     SearchResultDevice& resDev = result.components[cmpFp].devices[devFp];
-    FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);  // can throw
     resDev.uuid = devUuid;
-    resDev.pkgFp = pkgFp;
+    resDev.pkgFp = getPkgFp(devFp);
     resDev.match = matchingDevices.contains(devUuid);
-
-    QList<WorkspaceLibraryDb::Part> parts;
     if (resDev.match) {
       // List all parts of device.
-      parts = mDb.getDeviceParts(devUuid);  // can throw
+      addParts(resDev, devParts.value(devUuid));
     } else {
       // List only matched parts of device.
-      parts = mDb.findPartsOfDevice(devUuid,
-                                    input);  // can throw
-    }
-    foreach (const WorkspaceLibraryDb::Part& part, parts) {
-      resDev.parts.append(std::make_shared<Part>(
-          SimpleString(part.mpn), SimpleString(part.manufacturer),
-          part.attributes));
+      addParts(resDev,
+               db.findPartsOfDevice(devUuid, input));  // can throw
     }
   }
 
   // Get additional metadata of elements.
-  QMutableHashIterator<FilePath, SearchResultComponent> cmpIt(
-      result.components);
-  while (cmpIt.hasNext()) {
-    cmpIt.next();
-    mDb.getTranslations<Component>(cmpIt.key(), mLocaleOrder,
-                                   &cmpIt.value().name);
-    mDb.getMetadata<Component>(cmpIt.key(), nullptr, nullptr,
-                               &cmpIt.value().deprecated);
-    QMutableHashIterator<FilePath, SearchResultDevice> devIt(
-        cmpIt.value().devices);
-    while (devIt.hasNext()) {
-      devIt.next();
-      mDb.getTranslations<Device>(devIt.key(), mLocaleOrder,
-                                  &devIt.value().name);
-      mDb.getMetadata<Device>(devIt.key(), nullptr, nullptr,
-                              &devIt.value().deprecated);
-      if (devIt.value().pkgFp.isValid()) {
-        mDb.getTranslations<Package>(devIt.value().pkgFp, mLocaleOrder,
-                                     &devIt.value().pkgName);
+  QList<FilePath> resultDevFps;
+  QList<FilePath> resultPkgFps;
+  foreach (const SearchResultComponent& cmp, result.components) {
+    for (auto it = cmp.devices.begin(); it != cmp.devices.end(); it++) {
+      resultDevFps.append(it.key());
+      if (it.value().pkgFp.isValid()) {
+        resultPkgFps.append(it.value().pkgFp);
       }
     }
   }
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> cmpInfos =
+      db.getElementInfos<Component>(result.components.keys(),
+                                    localeOrder);  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> devInfos =
+      db.getElementInfos<Device>(resultDevFps, localeOrder);  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> pkgInfos =
+      db.getElementInfos<Package>(resultPkgFps, localeOrder);  // can throw
+  for (auto cmpIt = result.components.begin();
+       cmpIt != result.components.end(); cmpIt++) {
+    const WorkspaceLibraryDb::ElementInfo cmpInfo = cmpInfos.value(cmpIt.key());
+    cmpIt.value().name = cmpInfo.name;
+    cmpIt.value().deprecated = cmpInfo.deprecated;
+    for (auto devIt = cmpIt.value().devices.begin();
+         devIt != cmpIt.value().devices.end(); devIt++) {
+      const WorkspaceLibraryDb::ElementInfo devInfo =
+          devInfos.value(devIt.key());
+      devIt.value().name = devInfo.name;
+      devIt.value().deprecated = devInfo.deprecated;
+      devIt.value().pkgName = pkgInfos.value(devIt.value().pkgFp).name;
+    }
+  }
 
   // Count number it items.
   foreach (const SearchResultComponent& cmp, result.components) {
@@ -713,65 +777,89 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
 
 void AddComponentDialog::setSelectedCategory(
     const std::optional<Uuid>& categoryUuid) {
+  abortSearch();
   mCurrentSearchTerm.clear();
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
   mSelectedCategoryUuid = categoryUuid;
-  QSet<Uuid> components = mDb.getByCategory<Component>(categoryUuid);
+
+  // Fetch all data with bulk queries, as there might be many elements.
+  const QSet<Uuid> components =
+      mDb.getByCategory<Component>(categoryUuid);  // can throw
+  QHash<Uuid, QSet<Uuid>> componentDevices;
+  QSet<Uuid> allDevices;
+  foreach (const Uuid& cmpUuid, components) {
+    const QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);  // can throw
+    componentDevices.insert(cmpUuid, devices);
+    allDevices |= devices;
+  }
+  const QHash<Uuid, FilePath> cmpFps =
+      mDb.getLatest<Component>(components);  // can throw
+  const QHash<Uuid, FilePath> devFps =
+      mDb.getLatest<Device>(allDevices);  // can throw
+  const QHash<FilePath, std::pair<Uuid, Uuid>> devMetadata =
+      mDb.getDeviceMetadata(devFps.values());  // can throw
+  QSet<Uuid> pkgUuids;
+  foreach (const auto& metadata, devMetadata) {
+    pkgUuids.insert(metadata.second);
+  }
+  const QHash<Uuid, FilePath> pkgFps =
+      mDb.getLatest<Package>(pkgUuids);  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> cmpInfos =
+      mDb.getElementInfos<Component>(cmpFps.values(),
+                                     mLocaleOrder);  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> devInfos =
+      mDb.getElementInfos<Device>(devFps.values(),
+                                  mLocaleOrder);  // can throw
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> pkgInfos =
+      mDb.getElementInfos<Package>(pkgFps.values(),
+                                   mLocaleOrder);  // can throw
+  const QHash<Uuid, QList<WorkspaceLibraryDb::Part>> devParts =
+      mDb.getDeviceParts(allDevices);  // can throw
+
   foreach (const Uuid& cmpUuid, components) {
     // component
-    FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);
+    const FilePath cmpFp = cmpFps.value(cmpUuid);
     if (!cmpFp.isValid()) continue;
-    QString cmpName;
-    mDb.getTranslations<Component>(cmpFp, mLocaleOrder, &cmpName);
-    bool cmpDeprecated = false;
-    mDb.getMetadata<Component>(cmpFp, nullptr, nullptr, &cmpDeprecated);
+    const WorkspaceLibraryDb::ElementInfo cmpInfo = cmpInfos.value(cmpFp);
     QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
     cmpItem->setIcon(0, QIcon(":/img/library/symbol.png"));
-    cmpItem->setText(0, cmpName);
-    cmpItem->setForeground(0, cmpDeprecated ? QBrush(Qt::red) : QBrush());
+    cmpItem->setText(0, cmpInfo.name);
+    cmpItem->setForeground(0,
+                           cmpInfo.deprecated ? QBrush(Qt::red) : QBrush());
     cmpItem->setData(0, Qt::UserRole, cmpFp.toStr());
     // devices
-    QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);
+    const QSet<Uuid> devices = componentDevices.value(cmpUuid);
     foreach (const Uuid& devUuid, devices) {
-      try {
-        FilePath devFp = mDb.getLatest<Device>(devUuid);
-        if (!devFp.isValid()) continue;
-        QString devName;
-        mDb.getTranslations<Device>(devFp, mLocaleOrder, &devName);
-        bool devDeprecated = false;
-        mDb.getMetadata<Device>(devFp, nullptr, nullptr, &devDeprecated);
-        QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
-        devItem->setIcon(0, QIcon(":/img/library/device.png"));
-        devItem->setText(0, devName);
-        devItem->setForeground(0, devDeprecated ? QBrush(Qt::red) : QBrush());
-        devItem->setData(0, Qt::UserRole, devFp.toStr());
-        // package
-        Uuid pkgUuid = Uuid::createRandom();  // only for initialization, will
-                                              // be overwritten
-        mDb.getDeviceMetadata(devFp, nullptr, &pkgUuid);
-        FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);
-        if (pkgFp.isValid()) {
-          QString pkgName;
-          mDb.getTranslations<Package>(pkgFp, mLocaleOrder, &pkgName);
-          devItem->setText(1, pkgName);
-          devItem->setTextAlignment(1, Qt::AlignRight);
-          QFont font = devItem->font(1);
-          font.setItalic(true);
-          devItem->setFont(1, font);
-        }
-        // Parts
-        const QList<WorkspaceLibraryDb::Part> parts =
-            mDb.getDeviceParts(devUuid);
-        foreach (const WorkspaceLibraryDb::Part& partInfo, parts) {
-          std::shared_ptr<Part> part = std::make_shared<Part>(
-              SimpleString(partInfo.mpn), SimpleString(partInfo.manufacturer),
-              partInfo.attributes);
-          addPartItem(part, devItem);
-        }
-      } catch (const Exception& e) {
-        // what could we do here?
+      const FilePath devFp = devFps.value(devUuid);
+      if (!devFp.isValid()) continue;
+      const WorkspaceLibraryDb::ElementInfo devInfo = devInfos.value(devFp);
+      QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
+      devItem->setIcon(0, QIcon(":/img/library/device.png"));
+      devItem->setText(0, devInfo.name);
+      devItem->setForeground(0,
+                             devInfo.deprecated ? QBrush(Qt::red) : QBrush());
+      devItem->setData(0, Qt::UserRole, devFp.toStr());
+      // package
+      auto metadata = devMetadata.find(devFp);
+      const FilePath pkgFp = (metadata != devMetadata.end())
+          ? pkgFps.value(metadata->second)
+          : FilePath();
+      if (pkgFp.isValid()) {
+        devItem->setText(1, pkgInfos.value(pkgFp).name);
+        devItem->setTextAlignment(1, Qt::AlignRight);
+        QFont font = devItem->font(1);
+        font.setItalic(true);
+        devItem->setFont(1, font);
+      }
+      // Parts
+      foreach (const WorkspaceLibraryDb::Part& partInfo,
+               devParts.value(devUuid)) {
+        std::shared_ptr<Part> part = std::make_shared<Part>(
+            SimpleString(partInfo.mpn), SimpleString(partInfo.manufacturer),
+            partInfo.attributes);
+        addPartItem(part, devItem);
       }
     }
     cmpItem->setText(1, QString("[%1]").arg(devices.count()));
@@ -780,6 +868,9 @@ void AddComponentDialog::setSelectedCategory(
 
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
 
+  // Open the components in the background, so selecting them is fast.
+  mDb.getElementCache().prefetch<Component>(cmpFps.values());
+
   // Delay parts information download, but show cached information immediately
   // to avoid flicker.
   updatePartsInformation(1000);
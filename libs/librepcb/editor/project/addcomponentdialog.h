@@ -166,7 +166,15 @@ private:
       const QString& input,
       const std::optional<Uuid>& selectedDevice = std::nullopt,
       bool selectFirstDevice = false);
-  SearchResult search(const QString& input);
+  void searchFinished(const QString& input,
+                      const std::optional<Uuid>& selectedDevice,
+                      bool selectFirstDevice) noexcept;
+  void abortSearch() noexcept;
+  void showSearchResult(const QString& input, const SearchResult& result,
+                        const std::optional<Uuid>& selectedDevice,
+                        bool selectFirstDevice);
+  static SearchResult search(const WorkspaceLibraryDb& db, const QString& input,
+                             const QStringList& localeOrder);
   void setSelectedCategory(const std::optional<Uuid>& categoryUuid);
   void setSelectedComponent(std::shared_ptr<const Component> cmp);
   void setSelectedSymbVar(
@@ -194,6 +202,7 @@ private:
   qint64 mUpdatePartInformationDownloadStart;
   bool mUpdatePartInformationOnExpand;
   QString mCurrentSearchTerm;
+  std::unique_ptr<QFutureWatcher<SearchResult>> mSearchWatcher;
 
   // Attributes
   std::optional<Uuid> mSelectedCategoryUuid;
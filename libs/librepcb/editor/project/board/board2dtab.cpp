@@ -77,6 +77,7 @@
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -2054,14 +2055,35 @@ void Board2dTab::execSpecctraImportDialog() noexcept {
     auto cursorScopeGuard =
         scopeGuard([]() { QApplication::restoreOverrideCursor(); });
 
-    // Perform import.
+    // Parse the session and match it with the board in a worker thread.
+    // The modal progress dialog avoids modifications of the board meanwhile.
     qDebug().nospace() << "Import Specctra SES from " << fp.toNative() << "...";
     logger->debug(tr("Parsing Specctra session '%1'...").arg(fp.toNative()));
-    const QByteArray content = FileUtils::readFile(fp);  // can throw
-    std::unique_ptr<SExpression> root =
-        SExpression::parse(content, fp, SExpression::Mode::Permissive);
-    mProjectEditor.getUndoStack().execCmd(
-        new CmdBoardSpecctraImport(mBoard, *root, logger));  // can throw
+    typedef std::shared_ptr<const CmdBoardSpecctraImport::Result> Result;
+    auto snapshot = CmdBoardSpecctraImport::takeSnapshot(mBoard);
+    QFuture<Result> future = QtConcurrent::run([fp, snapshot, logger]() {
+      QElapsedTimer timer;
+      timer.start();
+      const QByteArray content = FileUtils::readFile(fp);  // can throw
+      std::unique_ptr<SExpression> root =
+          SExpression::parse(content, fp, SExpression::Mode::Permissive);
+      qDebug() << "Read Specctra SES in" << timer.elapsed() << "ms.";
+      return CmdBoardSpecctraImport::prepare(*snapshot, *root, *logger);
+    });
+    QProgressDialog progress(tr("Importing Specctra session..."), QString(), 0,
+                             0, qApp->activeWindow());
+    progress.setWindowModality(Qt::WindowModal);
+    QFutureWatcher<Result> watcher;
+    connect(&watcher, &QFutureWatcher<Result>::finished, &progress,
+            &QProgressDialog::close);
+    watcher.setFuture(future);
+    if (!future.isFinished()) {
+      progress.exec();
+    }
+
+    // Apply the prepared changes with a single undo command.
+    mProjectEditor.getUndoStack().execCmd(new CmdBoardSpecctraImport(
+        mBoard, future.result(), logger));  // can throw
     qDebug() << "Successfully imported Specctra SES.";
   } catch (const Exception& e) {
     logger->critical(e.getMsg());
@@ -441,10 +441,15 @@ void BoardEditor::startOrderPcbUpload(bool openBrowser) noexcept {
 
 void BoardEditor::setDrcResult(
     const BoardDesignRuleCheck::Result& result) noexcept {
+  // Apply the planes rebuilt by the DRC.
+  if (result.applyPlanesToBoard()) {
+    emit planesUpdated();
+  }
+
   // Detect & remove disappeared messages.
-  const QSet<SExpression> approvals =
-      RuleCheckMessage::getAllApprovals(result.messages);
-  if (mBoard.updateDrcMessageApprovals(approvals, result.quick)) {
+  if (mBoard.updateDrcMessageApprovals(
+          RuleCheckMessage::getAllApprovalFingerprints(result.messages),
+          result.quick)) {
     mProjectEditor.setManualModificationsMade();
   }
 
@@ -460,7 +465,8 @@ void BoardEditor::setDrcResult(
     connect(mDrcMessages.get(), &RuleCheckMessagesModel::highlightRequested,
             this, &BoardEditor::drcMessageHighlightRequested);
   }
-  mDrcMessages->setMessages(result.messages, mBoard.getDrcMessageApprovals());
+  mDrcMessages->setMessages(result.messages,
+                            mBoard.getDrcMessageApprovalFingerprints());
   mDrcExecutionError = result.errors.join("\n\n");
   mDrcNotification->dismiss();
   onUiDataChanged.notify();
@@ -63,7 +63,6 @@
 #include "../graphicsitems/bgi_via.h"
 #include "../graphicsitems/bgi_zone.h"
 
-#include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/library/cmp/component.h>
 #include <librepcb/core/library/dev/device.h>
 #include <librepcb/core/library/pkg/package.h>
@@ -83,7 +82,6 @@
 #include <librepcb/core/project/circuit/componentinstance.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/utils/scopeguard.h>
-#include <librepcb/core/utils/tangentpathjoiner.h>
 #include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
@@ -197,27 +195,21 @@ bool BoardEditorState_Select::processImportDxf() noexcept {
       auto cursorScopeGuard =
           scopeGuard([this]() { parentWidget()->unsetCursor(); });
 
-      // Read DXF file.
-      DxfReader import;
-      import.setScaleFactor(dialog.getScaleFactor());
-      import.parse(fp);  // can throw
-
-      // If enabled, join tangent paths.
-      QVector<Path> paths = import.getPolygons().toVector();
-      if (dialog.getJoinTangentPolylines()) {
-        paths = TangentPathJoiner::join(paths, 2000);
-      }
+      // Read DXF file with the chosen filters (and joining tangent paths, if
+      // enabled).
+      const DxfImportDialog::Objects objects =
+          dialog.readFile(fp);  // can throw
 
       // Build board elements to import. ALthough this has nothing to do with
       // the clipboard, we use BoardClipboardData since it works very well :-)
       std::unique_ptr<BoardClipboardData> data(
           new BoardClipboardData(scene->getBoard().getUuid(), Point(0, 0)));
-      foreach (const auto& path, paths) {
+      foreach (const auto& path, objects.polygons) {
         data->getPolygons().append(
             BoardPolygonData(Uuid::createRandom(), dialog.getLayer(),
                              dialog.getLineWidth(), path, false, false, false));
       }
-      for (const auto& circle : import.getCircles()) {
+      for (const auto& circle : objects.circles) {
         if (dialog.getImportCirclesAsDrills()) {
           data->getHoles().append(
               BoardHoleData(Uuid::createRandom(), circle.diameter,
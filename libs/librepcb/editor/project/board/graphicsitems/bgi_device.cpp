@@ -113,6 +113,7 @@ BGI_Device::BGI_Device(BI_Device& device,
   updateBoardSide();
   updateHoleStopMaskOffsets();
 
+  mOnEditedSlot.setBatched(true);
   mDevice.onEdited.attach(mOnEditedSlot);
 }
 
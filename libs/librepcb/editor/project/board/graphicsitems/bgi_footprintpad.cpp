@@ -71,6 +71,7 @@ BGI_FootprintPad::BGI_FootprintPad(BI_FootprintPad& pad,
   updateLayer();
   updateToolTip();
 
+  mOnPadEditedSlot.setBatched(true);
   mPad.onEdited.attach(mOnPadEditedSlot);
   if (auto ptr = mDeviceGraphicsItem.lock()) {
     ptr->onEdited.attach(mOnDeviceEditedSlot);
@@ -49,6 +49,7 @@ BGI_Hole::BGI_Hole(BI_Hole& hole, const GraphicsLayerList& layers) noexcept
 
   updateHole();
 
+  mOnEditedSlot.setBatched(true);
   mHole.onEdited.attach(mOnEditedSlot);
 }
 
@@ -60,6 +60,7 @@ BGI_NetLine::BGI_NetLine(BI_NetLine& netline, const GraphicsLayerList& layers,
   updateNetSignalName();
   updateVisibility();
 
+  mOnNetLineEditedSlot.setBatched(true);
   mNetLine.onEdited.attach(mOnNetLineEditedSlot);
 }
 
@@ -58,6 +58,7 @@ BGI_NetPoint::BGI_NetPoint(BI_NetPoint& netpoint,
   updateDiameter();
   updateNetSignalName();
 
+  mOnEditedSlot.setBatched(true);
   mNetPoint.onEdited.attach(mOnEditedSlot);
 }
 
@@ -64,6 +64,7 @@ BGI_Plane::BGI_Plane(BI_Plane& plane, const GraphicsLayerList& layers,
   updateLayer();
   updateVisibility();
 
+  mOnEditedSlot.setBatched(true);
   mPlane.onEdited.attach(mOnEditedSlot);
 }
 
@@ -53,6 +53,7 @@ BGI_Polygon::BGI_Polygon(BI_Polygon& polygon,
   updateZValue();
   updateEditable();
 
+  mOnEditedSlot.setBatched(true);
   mPolygon.onEdited.attach(mOnEditedSlot);
 }
 
@@ -69,6 +69,7 @@ BGI_StrokeText::BGI_StrokeText(BI_StrokeText& text,
   updateAnchorLayer();
   updateAnchorLine();
 
+  mOnEditedSlot.setBatched(true);
   mText.onEdited.attach(mOnEditedSlot);
   if (auto ptr = deviceItem.lock()) {
     ptr->onEdited.attach(mOnDeviceEditedSlot);
@@ -79,6 +79,7 @@ BGI_Via::BGI_Via(BI_Via& via, const GraphicsLayerList& layers,
   updateToolTip();
   updateText();
 
+  mOnEditedSlot.setBatched(true);
   mVia.onEdited.attach(mOnEditedSlot);
   for (auto layer : {mViaLayer, mTopStopMaskLayer, mBottomStopMaskLayer}) {
     if (layer) {
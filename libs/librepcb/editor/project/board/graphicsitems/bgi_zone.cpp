@@ -55,6 +55,7 @@ BGI_Zone::BGI_Zone(BI_Zone& zone, const GraphicsLayerList& layers) noexcept
   updateZValue();
   updateEditable();
 
+  mOnEditedSlot.setBatched(true);
   mZone.onEdited.attach(mOnEditedSlot);
 }
 
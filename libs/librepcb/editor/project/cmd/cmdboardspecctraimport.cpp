@@ -109,14 +109,226 @@ static double getResolution(const SExpression& node, QString& logStr) {
   return resolution;
 }
 
+/**
+ * @brief Spatial hash to look up points which are fuzzy-equal
+ *
+ * The grid size is the maximum deviation accepted by fuzzyCompare(), thus
+ * all candidates for a point are located in the same or an adjacent cell.
+ * The insertion order is memorized to find the same object as a linear
+ * search through all objects would do.
+ */
+template <typename T>
+class FuzzyPointIndex final {
+public:
+  void insert(const Point& pos, const T& value) noexcept {
+    mCells[getCell(pos)].append(std::make_pair(mCount++, value));
+  }
+
+  /**
+   * @brief Iterate over all values located close to a given position
+   *
+   * @param pos       The position to look up.
+   * @param callback  Called with the insertion index and the value of each
+   *                  candidate, in insertion order within each cell.
+   *                  Returning `false` skips the rest of the current cell.
+   */
+  template <typename TCallback>
+  void forEachCandidate(const Point& pos, TCallback callback) const {
+    const Cell cell = getCell(pos);
+    for (qint64 dx = -1; dx <= 1; ++dx) {
+      for (qint64 dy = -1; dy <= 1; ++dy) {
+        auto it = mCells.constFind(
+            std::make_pair(cell.first + dx, cell.second + dy));
+        if (it != mCells.constEnd()) {
+          for (const auto& item : *it) {
+            if (!callback(item.first, item.second)) {
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Find the first inserted value close to a given position which
+   *        matches a predicate
+   */
+  template <typename TPredicate>
+  std::optional<T> findFirst(const Point& pos, TPredicate predicate) const {
+    int foundIndex = -1;
+    std::optional<T> found;
+    forEachCandidate(pos, [&](int index, const T& value) {
+      if ((foundIndex >= 0) && (foundIndex < index)) {
+        return false;  // Values within a cell are sorted by index.
+      } else if (predicate(value)) {
+        foundIndex = index;
+        found = value;
+        return false;
+      }
+      return true;
+    });
+    return found;
+  }
+
+private:
+  typedef std::pair<qint64, qint64> Cell;
+  static constexpr qint64 sGridSize = 1000;  // See fuzzyCompare().
+
+  static Cell getCell(const Point& pos) noexcept {
+    return std::make_pair(floorDiv(pos.getX().toNm()),
+                          floorDiv(pos.getY().toNm()));
+  }
+
+  static qint64 floorDiv(qint64 value) noexcept {
+    return (value >= 0) ? (value / sGridSize)
+                        : ((value - sGridSize + 1) / sGridSize);
+  }
+
+  int mCount = 0;
+  QHash<Cell, QVector<std::pair<int, T>>> mCells;
+};
+
+/*******************************************************************************
+ *  Struct CmdBoardSpecctraImport::Snapshot
+ ******************************************************************************/
+
+struct CmdBoardSpecctraImport::Snapshot {
+  struct Pad {
+    Point position;
+    bool tht;
+    const Layer* solderLayer;
+    Uuid component;
+    Uuid pad;
+  };
+  struct Net {
+    Uuid uuid;
+    QList<Pad> pads;
+  };
+  struct OldJunction {
+    Uuid uuid;
+    Point pos;
+    const Layer* layer;  // May be nullptr.
+  };
+  struct OldTrace {
+    Uuid uuid;
+    Point start;
+    Point end;
+    const Layer* layer;
+    Length width;
+  };
+  struct OldSegment {
+    Uuid uuid;
+    std::optional<Uuid> net;
+    QList<OldJunction> junctions;
+    QList<OldTrace> traces;
+    QList<Via> vias;
+  };
+
+  QSet<const Layer*> copperLayers;
+  UnsignedLength minViaAnnularRing = UnsignedLength(0);
+  QHash<QString, Net> nets;  ///< Key: Net name
+  QList<OldSegment> segments;
+};
+
+/*******************************************************************************
+ *  Struct CmdBoardSpecctraImport::Result
+ ******************************************************************************/
+
+struct CmdBoardSpecctraImport::Result {
+  struct Segment {
+    Uuid uuid;
+    std::optional<Uuid> net;
+    BoardNetSegmentSplitter::Segment elements;
+  };
+
+  std::optional<QList<ComponentOut>> components;
+  QList<Segment> segments;
+  int newObjects = 0;
+  int reusedObjects = 0;
+};
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
 CmdBoardSpecctraImport::CmdBoardSpecctraImport(
     Board& board, const SExpression& root,
     std::shared_ptr<MessageLogger> logger)
+  : CmdBoardSpecctraImport(board, prepare(*takeSnapshot(board), root, *logger),
+                           logger) {
+}
+
+CmdBoardSpecctraImport::CmdBoardSpecctraImport(
+    Board& board, std::shared_ptr<const Result> result,
+    std::shared_ptr<MessageLogger> logger)
   : UndoCommandGroup(tr("Import From Specctra Session")),
-    mProject(board.getProject()),
-    mCircuit(mProject.getCircuit()),
+    mCircuit(board.getProject().getCircuit()),
     mBoard(board),
-    mLogger(logger) {
+    mLogger(logger),
+    mResult(result) {
+  Q_ASSERT(mResult);
+}
+
+CmdBoardSpecctraImport::~CmdBoardSpecctraImport() noexcept {
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+std::shared_ptr<const CmdBoardSpecctraImport::Snapshot>
+    CmdBoardSpecctraImport::takeSnapshot(const Board& board) {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->copperLayers = board.getCopperLayers();
+  snapshot->minViaAnnularRing =
+      board.getDesignRules().getViaAnnularRing().getMinValue();
+  for (const NetSignal* net :
+       board.getProject().getCircuit().getNetSignals()) {
+    Snapshot::Net data{net->getUuid(), {}};
+    for (const ComponentSignalInstance* cmpSig : net->getComponentSignals()) {
+      for (const BI_FootprintPad* pad : cmpSig->getRegisteredFootprintPads()) {
+        data.pads.append(Snapshot::Pad{
+            pad->getPosition(), pad->getLibPad().isTht(),
+            &pad->getSolderLayer(), pad->getDevice().getComponentInstanceUuid(),
+            pad->getLibPadUuid()});
+      }
+    }
+    snapshot->nets.insert(*net->getName(), data);
+  }
+  foreach (const BI_NetSegment* seg, board.getNetSegments()) {
+    Snapshot::OldSegment oldSeg{
+        seg->getUuid(),
+        seg->getNetSignal() ? std::make_optional(seg->getNetSignal()->getUuid())
+                            : std::nullopt,
+        {},
+        {},
+        {}};
+    foreach (const BI_NetPoint* np, seg->getNetPoints()) {
+      oldSeg.junctions.append(Snapshot::OldJunction{
+          np->getUuid(), np->getPosition(), np->getLayerOfTraces()});
+    }
+    foreach (const BI_NetLine* nl, seg->getNetLines()) {
+      oldSeg.traces.append(Snapshot::OldTrace{
+          nl->getUuid(), nl->getStartPoint().getPosition(),
+          nl->getEndPoint().getPosition(), &nl->getLayer(), *nl->getWidth()});
+    }
+    foreach (const BI_Via* via, seg->getVias()) {
+      oldSeg.vias.append(via->getVia());
+    }
+    snapshot->segments.append(oldSeg);
+  }
+  return snapshot;
+}
+
+std::shared_ptr<const CmdBoardSpecctraImport::Result>
+    CmdBoardSpecctraImport::prepare(const Snapshot& snapshot,
+                                    const SExpression& root,
+                                    MessageLogger& logger) {
+  QElapsedTimer timer;
+  timer.start();
+  auto result = std::make_shared<Result>();
+
   // Check file type.
   if (root.getName() != "session") {
     throw RuntimeError(
@@ -134,11 +346,11 @@ CmdBoardSpecctraImport::CmdBoardSpecctraImport(
     hostVersion = child->getValue();
   }
   if (hostCad.isEmpty()) {
-    mLogger->warning(
+    logger.warning(
         "Specctra session doesn't specify host CAD, compatibility is unknown.");
   } else if ((hostCad != qApp->applicationName()) ||
              (hostVersion != qApp->applicationVersion())) {
-    mLogger->warning(
+    logger.warning(
         QString(
             "Specctra session originates from %1, compatibility is unknown.")
             .arg(hostCad + " " + hostVersion));
@@ -148,8 +360,8 @@ CmdBoardSpecctraImport::CmdBoardSpecctraImport(
   if (const SExpression* child = root.tryGetChild("placement")) {
     QString logRes;
     const double resolution = getResolution(*child, logRes);
-    mLogger->debug("Placement resolution: " % logRes);
-    mComponents = QList<ComponentOut>();
+    logger.debug("Placement resolution: " % logRes);
+    result->components = QList<ComponentOut>();
     for (const SExpression* cmpNode : child->getChildren("component")) {
       QList<const SExpression*> childs = cmpNode->getChildren("place");
       if (childs.count() != 1) {
@@ -162,23 +374,24 @@ CmdBoardSpecctraImport::CmdBoardSpecctraImport(
                 parseLength(node->getChild("@2"), resolution));
       Side side = parseSide(node->getChild("@3"));
       Angle rot = parseAngle(node->getChild("@4"));
-      mComponents->append(ComponentOut{name, pos, side, rot});
+      result->components->append(ComponentOut{name, pos, side, rot});
     }
   } else {
-    mLogger->warning(
+    logger.warning(
         "Specctra session doesn't contain component placement data.");
   }
 
   const SExpression& routesNode = root.getChild("routes");
   QString logRes;
   const double resolution = getResolution(routesNode, logRes);
-  mLogger->debug("Routing resolution: " % logRes);
+  logger.debug("Routing resolution: " % logRes);
 
   // Parse pad stacks.
+  QHash<QString, PadStackOut> padStacks;
   for (const SExpression* padStackNode :
        routesNode.getChild("library_out").getChildren("padstack")) {
     QString name = padStackNode->getChild("@0").getValue();
-    if (mPadStacks.contains(name)) {
+    if (padStacks.contains(name)) {
       throw RuntimeError(
           __FILE__, __LINE__,
           QString("Pad stack '%1' defined multiple times.").arg(name));
@@ -207,24 +420,26 @@ CmdBoardSpecctraImport::CmdBoardSpecctraImport(
     std::sort(layers.begin(), layers.end(), [](const Layer* a, const Layer* b) {
       return a->getCopperNumber() < b->getCopperNumber();
     });
-    for (const Layer* layer : mBoard.getCopperLayers()) {
+    for (const Layer* layer : snapshot.copperLayers) {
       if ((layer->getCopperNumber() > layers.first()->getCopperNumber()) &&
           (layer->getCopperNumber() < layers.last()->getCopperNumber()) &&
           (!layers.contains(layer))) {
         throw RuntimeError(__FILE__, __LINE__, "Missing layers in pad stack.");
       }
     }
-    mPadStacks[name] =
+    padStacks[name] =
         PadStackOut{layers.first(), layers.last(), *diameters.begin()};
   }
 
   // Parse networks.
+  QList<NetOut> nets;
+  int wireCount = 0;
   for (const SExpression* netNode :
        routesNode.getChild("network_out").getChildren("net")) {
     NetOut net{netNode->getChild("@0").getValue(), {}, {}};
     for (const SExpression* viaNode : netNode->getChildren("via")) {
       QString padStackId = viaNode->getChild("@0").getValue();
-      if (!mPadStacks.contains(padStackId)) {
+      if (!padStacks.contains(padStackId)) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString("Pad stack '%1' not found.").arg(padStackId));
@@ -245,7 +460,7 @@ CmdBoardSpecctraImport::CmdBoardSpecctraImport(
                      parseLength(*childs.at(1), resolution),
                      {}};
         if (wire.width <= 0) {
-          mLogger->warning("Skippted wire with zero width.");
+          logger.warning("Skippted wire with zero width.");
           continue;
         }
         for (int i = 3; i < childs.count(); i += 2) {
@@ -258,106 +473,89 @@ CmdBoardSpecctraImport::CmdBoardSpecctraImport(
                              "Path contains too few vertices.");
         }
         net.wires.append(wire);
+        wireCount += wire.path.getVertices().count() - 1;
       }
     }
-    mNets.append(net);
+    nets.append(net);
   }
 
-  mLogger->debug(tr("Specctra session file parsed successfully."));
-}
-
-CmdBoardSpecctraImport::~CmdBoardSpecctraImport() noexcept {
-}
-
-/*******************************************************************************
- *  Inherited from UndoCommand
- ******************************************************************************/
-
-bool CmdBoardSpecctraImport::performExecute() {
-  // if an error occurs, undo all already executed child commands
-  auto undoScopeGuard = scopeGuard([&]() { performUndo(); });
-
-  // Memorize current board to allow reusing their properties.
-  struct OldJunction {
-    Uuid uuid;
-    Point pos;
-    const Layer* layer;  // May be nullptr.
-  };
-  struct OldTrace {
-    Uuid uuid;
-    Point start;
-    Point end;
-    const Layer* layer;
-    Length width;
-  };
-
-  struct OldSegment {
-    Uuid uuid;
-    QPointer<NetSignal> net;
-    QList<OldJunction> junctions;
-    QList<OldTrace> traces;
-    QList<Via> vias;
-  };
-  QList<OldSegment> oldSegments;
-  foreach (const BI_NetSegment* seg, mBoard.getNetSegments()) {
-    OldSegment oldSeg{seg->getUuid(), seg->getNetSignal(), {}, {}, {}};
-    foreach (const BI_NetPoint* np, seg->getNetPoints()) {
-      oldSeg.junctions.append(OldJunction{np->getUuid(), np->getPosition(),
-                                          np->getLayerOfTraces()});
+  logger.debug(tr("Specctra session file parsed successfully."));
+  qDebug() << "Parsed Specctra session with" << nets.count() << "nets and"
+           << wireCount << "wire segments in" << timer.elapsed() << "ms.";
+  timer.start();
+
+  // Index the existing board objects by net and position to quickly find
+  // the corresponding old objects for new objects.
+  typedef Snapshot::OldJunction OldJunction;
+  typedef Snapshot::OldTrace OldTrace;
+  typedef Snapshot::OldSegment OldSegment;
+  QHash<std::optional<Uuid>, FuzzyPointIndex<const OldJunction*>>
+      oldJunctions;
+  QHash<std::optional<Uuid>, FuzzyPointIndex<const OldTrace*>> oldTraces;
+  QHash<std::optional<Uuid>, FuzzyPointIndex<const Via*>> oldVias;
+  QHash<Uuid, int> oldSegmentIndices;  // Key: UUID of any segment object.
+  for (int i = 0; i < snapshot.segments.count(); ++i) {
+    const OldSegment& seg = snapshot.segments.at(i);
+    for (const OldJunction& np : seg.junctions) {
+      oldJunctions[seg.net].insert(np.pos, &np);
+      oldSegmentIndices.insert(np.uuid, i);
     }
-    foreach (const BI_NetLine* nl, seg->getNetLines()) {
-      oldSeg.traces.append(OldTrace{
-          nl->getUuid(), nl->getStartPoint().getPosition(),
-          nl->getEndPoint().getPosition(), &nl->getLayer(), *nl->getWidth()});
+    for (const OldTrace& nl : seg.traces) {
+      oldTraces[seg.net].insert(std::min(nl.start, nl.end), &nl);
+      oldSegmentIndices.insert(nl.uuid, i);
     }
-    foreach (const BI_Via* via, seg->getVias()) {
-      oldSeg.vias.append(via->getVia());
+    for (const Via& via : seg.vias) {
+      oldVias[seg.net].insert(via.getPosition(), &via);
+      oldSegmentIndices.insert(via.getUuid(), i);
     }
-    oldSegments.append(oldSeg);
   }
 
   // Helper functions to find corresponding old objects for new objects.
   QSet<Uuid> reusedUuids;
   int newUuids = 0;
-  auto findNetPoint = [&](const NetSignal* net, const Point& pos,
+  auto findNetPoint = [&](const std::optional<Uuid>& net, const Point& pos,
                           const Layer* layer) {
-    for (const OldSegment& seg : oldSegments) {
-      if (seg.net == net) {
-        for (const OldJunction& np : seg.junctions) {
-          if (fuzzyCompare(np.pos, pos) && (np.layer == layer) &&
-              (!reusedUuids.contains(np.uuid))) {
-            reusedUuids.insert(np.uuid);
-            return std::make_optional(np);
-          }
-        }
-      }
+    std::optional<const OldJunction*> np;
+    auto it = oldJunctions.constFind(net);
+    if (it != oldJunctions.constEnd()) {
+      np = it->findFirst(pos, [&](const OldJunction* candidate) {
+        return fuzzyCompare(candidate->pos, pos) &&
+            (candidate->layer == layer) &&
+            (!reusedUuids.contains(candidate->uuid));
+      });
+    }
+    if (np) {
+      reusedUuids.insert((*np)->uuid);
+      return std::make_optional(**np);
     }
     ++newUuids;
     return std::optional<OldJunction>();
   };
-  auto findNetLineImpl = [&](const NetSignal* net, Point start, Point end,
-                             const Layer& layer,
+  auto findNetLineImpl = [&](const std::optional<Uuid>& net, Point start,
+                             Point end, const Layer& layer,
                              const std::optional<Length>& width) {
     if (start > end) std::swap(start, end);
-    for (const OldSegment& seg : oldSegments) {
-      if (seg.net == net) {
-        for (const OldTrace& nl : seg.traces) {
-          Point nlStart = nl.start;
-          Point nlEnd = nl.end;
-          if (nlStart > nlEnd) std::swap(nlStart, nlEnd);
-          if (fuzzyCompare(nlStart, start) && fuzzyCompare(nlEnd, end) &&
-              (nl.layer == &layer) && ((!width) || (nl.width == *width)) &&
-              (!reusedUuids.contains(nl.uuid))) {
-            reusedUuids.insert(nl.uuid);
-            return std::make_optional(nl);
-          }
-        }
-      }
+    std::optional<const OldTrace*> nl;
+    auto it = oldTraces.constFind(net);
+    if (it != oldTraces.constEnd()) {
+      nl = it->findFirst(start, [&](const OldTrace* candidate) {
+        Point nlStart = candidate->start;
+        Point nlEnd = candidate->end;
+        if (nlStart > nlEnd) std::swap(nlStart, nlEnd);
+        return fuzzyCompare(nlStart, start) && fuzzyCompare(nlEnd, end) &&
+            (candidate->layer == &layer) &&
+            ((!width) || (candidate->width == *width)) &&
+            (!reusedUuids.contains(candidate->uuid));
+      });
+    }
+    if (nl) {
+      reusedUuids.insert((*nl)->uuid);
+      return std::make_optional(**nl);
     }
     return std::optional<OldTrace>();
   };
-  auto findNetLine = [&](const NetSignal* net, Point start, Point end,
-                         const Layer& layer, const Length& width) {
+  auto findNetLine = [&](const std::optional<Uuid>& net, Point start,
+                         Point end, const Layer& layer, const Length& width) {
     // First try to match including trace width, then ignore it because it
     // might have been changed during the DSN -> SES roundtrip.
     if (auto nl = findNetLineImpl(net, start, end, layer, width)) {
@@ -370,135 +568,72 @@ bool CmdBoardSpecctraImport::performExecute() {
       return std::optional<OldTrace>();
     }
   };
-  auto findVia = [&](const NetSignal* net, const Point& pos, const Layer& start,
-                     const Layer& end) {
-    for (const OldSegment& seg : oldSegments) {
-      if (seg.net == net) {
-        for (const Via& via : seg.vias) {
-          if (fuzzyCompare(via.getPosition(), pos) &&
-              (via.getStartLayer() == start) && (via.getEndLayer() == end) &&
-              (!reusedUuids.contains(via.getUuid()))) {
-            reusedUuids.insert(via.getUuid());
-            return std::make_optional(via);
-          }
-        }
-      }
+  auto findVia = [&](const std::optional<Uuid>& net, const Point& pos,
+                     const Layer& start, const Layer& end) {
+    std::optional<const Via*> via;
+    auto it = oldVias.constFind(net);
+    if (it != oldVias.constEnd()) {
+      via = it->findFirst(pos, [&](const Via* candidate) {
+        return fuzzyCompare(candidate->getPosition(), pos) &&
+            (candidate->getStartLayer() == start) &&
+            (candidate->getEndLayer() == end) &&
+            (!reusedUuids.contains(candidate->getUuid()));
+      });
+    }
+    if (via) {
+      reusedUuids.insert((*via)->getUuid());
+      return std::make_optional(**via);
     }
     ++newUuids;
     return std::optional<Via>();
   };
-  auto anyRefInSegment = [](const OldSegment& seg, const QSet<Uuid>& refs) {
-    foreach (const OldJunction& np, seg.junctions) {
-      if (refs.contains(np.uuid)) {
-        return true;
-      }
-    }
-    foreach (const OldTrace& nl, seg.traces) {
-      if (refs.contains(nl.uuid)) {
-        return true;
-      }
-    }
-    foreach (const Via& via, seg.vias) {
-      if (refs.contains(via.getUuid())) {
-        return true;
-      }
-    }
-    return false;
-  };
-  auto findNetSegment = [&](const NetSignal* net, const QSet<Uuid>& refs) {
-    for (const OldSegment& seg : oldSegments) {
-      if (seg.net == net) {
-        if (anyRefInSegment(seg, refs) && (!reusedUuids.contains(seg.uuid))) {
-          reusedUuids.insert(seg.uuid);
-          return std::make_optional(seg);
+  auto findNetSegment = [&](const std::optional<Uuid>& net,
+                            const QSet<Uuid>& refs) {
+    int index = -1;
+    for (const Uuid& ref : refs) {
+      const int i = oldSegmentIndices.value(ref, -1);
+      if ((i >= 0) && ((index < 0) || (i < index))) {
+        const OldSegment& seg = snapshot.segments.at(i);
+        if ((seg.net == net) && (!reusedUuids.contains(seg.uuid))) {
+          index = i;
         }
       }
     }
+    if (index >= 0) {
+      const Uuid uuid = snapshot.segments.at(index).uuid;
+      reusedUuids.insert(uuid);
+      return std::make_optional(uuid);
+    }
     ++newUuids;
-    return std::optional<OldSegment>();
+    return std::optional<Uuid>();
   };
 
-  //////////////////////////////////////////////////////////////////////////////
-
-  // Delete all net segments, they will be re-created from scratch below.
-  foreach (auto seg, mBoard.getNetSegments()) {
-    execNewChildCmd(new CmdBoardNetSegmentRemove(*seg));  // can throw
-  }
-
-  // Update devices placement.
-  QSet<QString> importedComponents;
-  QSet<Uuid> updatedComponents;
-  if (mComponents) {
-    for (const auto& item : *mComponents) {
-      importedComponents.insert(item.name);
-      ComponentInstance* cmp = mCircuit.getComponentInstanceByName(item.name);
-      BI_Device* dev = cmp
-          ? mBoard.getDeviceInstanceByComponentUuid(cmp->getUuid())
-          : nullptr;
-      if ((!cmp) || (!dev)) {
-        mLogger->warning(
-            tr("Component '%1' from Specctra session does not exist "
-               "in this board.")
-                .arg(item.name));
-        continue;
-      }
-      if (((item.side == Side::Front) && (dev->getMirrored())) ||
-          ((item.side == Side::Back) && (!dev->getMirrored()))) {
-        mLogger->warning(
-            tr("Component '%1' has been flipped, which is not supported yet.")
-                .arg(item.name));
-        continue;
-      }
-      std::unique_ptr<CmdDeviceInstanceEditAll> cmd(
-          new CmdDeviceInstanceEditAll(*dev));
-      if (!fuzzyCompare(dev->getPosition(), item.pos)) {
-        cmd->setPosition(item.pos, false);
-        updatedComponents.insert(cmp->getUuid());
-      }
-      if (!fuzzyCompare(dev->getRotation(), item.rot)) {
-        cmd->setRotation(item.rot, false);
-        updatedComponents.insert(cmp->getUuid());
-      }
-      execNewChildCmd(cmd.release());
-    }
-
-    // Warn about missing components.
-    for (const auto dev : mBoard.getDeviceInstances()) {
-      const QString name = *dev->getComponentInstance().getName();
-      // Footprints without pads are discarded by Freerouting as they are not
-      // relevant, thus ignore them.
-      if ((!importedComponents.contains(name)) && (!dev->getPads().isEmpty())) {
-        mLogger->warning(
-            tr("The component '%1' does not exist in the Specctra session.")
-                .arg(name));
-      }
-    }
-  }
-
-  // Import nets.
-  for (const auto& net : mNets) {
-    NetSignal* netSignal = mCircuit.getNetSignalByName(net.netName);
+  // Match nets.
+  for (const auto& net : nets) {
+    auto netIt = snapshot.nets.constFind(net.netName);
+    const Snapshot::Net* netSignal =
+        (netIt != snapshot.nets.constEnd()) ? &netIt.value() : nullptr;
+    const std::optional<Uuid> netUuid =
+        netSignal ? std::make_optional(netSignal->uuid) : std::nullopt;
     // ATTENTION: The ~anonymous~ comes from our own Specctra export!
     if ((!netSignal) && (!net.netName.startsWith("~anonymous~"))) {
-      mLogger->warning(tr("The net '%1' from Specctra session does not exist "
-                          "in this project, skipping it.")
-                           .arg(net.netName));
+      logger.warning(tr("The net '%1' from Specctra session does not exist "
+                        "in this project, skipping it.")
+                         .arg(net.netName));
       continue;
     }
 
     // Helper data to memorize anchors.
     struct AnchorData {
-      Point pos;
       const Layer* startLayer;
       const Layer* endLayer;
       TraceAnchor anchor;
     };
-    QList<AnchorData> anchors;
+    QHash<Point, QList<AnchorData>> anchors;
     auto findAnchor = [&anchors](const Point& pos, const Layer* layer) {
       const int layerNumber = layer->getCopperNumber();
-      for (auto& anchor : anchors) {
-        if ((anchor.pos == pos) &&
-            (layerNumber >= anchor.startLayer->getCopperNumber()) &&
+      for (const auto& anchor : anchors.value(pos)) {
+        if ((layerNumber >= anchor.startLayer->getCopperNumber()) &&
             (layerNumber <= anchor.endLayer->getCopperNumber())) {
           return std::make_optional(anchor.anchor);
         }
@@ -507,55 +642,50 @@ bool CmdBoardSpecctraImport::performExecute() {
     };
 
     // Add anchors for each pad corresponding to imported wire coordinates.
-    QList<Point> wireCoordinates;
-    QHash<const Layer*, QList<Point>> wireCoordinatesPerLayer;
+    FuzzyPointIndex<Point> wireCoordinates;
+    QHash<const Layer*, FuzzyPointIndex<Point>> wireCoordinatesPerLayer;
     for (const auto& wire : net.wires) {
       for (const auto& vertex : wire.path.getVertices()) {
-        wireCoordinates.append(vertex.getPos());
-        wireCoordinatesPerLayer[wire.layer].append(vertex.getPos());
+        wireCoordinates.insert(vertex.getPos(), vertex.getPos());
+        wireCoordinatesPerLayer[wire.layer].insert(vertex.getPos(),
+                                                   vertex.getPos());
       }
     }
-    for (const ComponentSignalInstance* cmpSig :
-         (netSignal ? netSignal->getComponentSignals()
-                    : QList<ComponentSignalInstance*>{})) {
-      for (const BI_FootprintPad* pad : cmpSig->getRegisteredFootprintPads()) {
-        Point pos = pad->getPosition();
-        QList<Point>& coordinates = pad->getLibPad().isTht()
-            ? wireCoordinates
-            : wireCoordinatesPerLayer[&pad->getSolderLayer()];
-        if (!coordinates.contains(pos)) {
-          // Find another coordinate which is very close (rounding errors).
-          // In some tests, errors were up to 70 nm!
-          std::sort(coordinates.begin(), coordinates.end(),
-                    [&pos](const Point& a, const Point& b) {
-                      return (a - pos).getLength() < (b - pos).getLength();
-                    });
-          if ((!coordinates.isEmpty()) &&
-              fuzzyCompare(pos, coordinates.first())) {
-            pos = coordinates.first();
-          } else {
-            continue;
-          }
+    for (const Snapshot::Pad& pad :
+         (netSignal ? netSignal->pads : QList<Snapshot::Pad>{})) {
+      // Find the closest coordinate since there might be small deviations
+      // (rounding errors). In some tests, errors were up to 70 nm!
+      Point pos = pad.position;
+      const FuzzyPointIndex<Point>& coordinates = pad.tht
+          ? wireCoordinates
+          : wireCoordinatesPerLayer[pad.solderLayer];
+      std::optional<Point> closest;
+      coordinates.forEachCandidate(pos, [&](int index, const Point& p) {
+        Q_UNUSED(index);
+        if ((!closest) ||
+            ((p - pos).getLength() < (*closest - pos).getLength())) {
+          closest = p;
         }
-        const Layer* startLayer = pad->getLibPad().isTht()
-            ? &Layer::topCopper()
-            : &pad->getSolderLayer();
-        const Layer* endLayer = pad->getLibPad().isTht()
-            ? &Layer::botCopper()
-            : &pad->getSolderLayer();
-        anchors.append(AnchorData{
-            pos, startLayer, endLayer,
-            TraceAnchor::pad(pad->getDevice().getComponentInstanceUuid(),
-                             pad->getLibPadUuid())});
+        return true;
+      });
+      if (closest && fuzzyCompare(pos, *closest)) {
+        pos = *closest;
+      } else {
+        continue;
       }
+      const Layer* startLayer =
+          pad.tht ? &Layer::topCopper() : pad.solderLayer;
+      const Layer* endLayer = pad.tht ? &Layer::botCopper() : pad.solderLayer;
+      anchors[pos].append(AnchorData{startLayer, endLayer,
+                                     TraceAnchor::pad(pad.component, pad.pad)});
     }
 
     // Define net segments with BoardNetSegmentSplitter.
     BoardNetSegmentSplitter splitter;
     for (const auto& via : net.vias) {
-      const PadStackOut& padStack = mPadStacks.value(via.padStackId);
+      const PadStackOut& padStack = padStacks.value(via.padStackId);
       const std::optional<Via> oldVia =
-          findVia(netSignal, via.pos, *padStack.startLayer, *padStack.endLayer);
+          findVia(netUuid, via.pos, *padStack.startLayer, *padStack.endLayer);
       const Uuid uuid = oldVia ? oldVia->getUuid() : Uuid::createRandom();
       // Note: How can we know the drill diameter??? Use this logic for now:
       //  - If position & size not modified, keep original drill diameter too
@@ -567,9 +697,8 @@ bool CmdBoardSpecctraImport::performExecute() {
       } else if (auto dia = extractViaDrillDiameter(via.padStackId)) {
         drillDiameter = *dia;
       } else {
-        const UnsignedLength annularWidth =
-            mBoard.getDesignRules().getViaAnnularRing().getMinValue();
-        drillDiameter = PositiveLength(padStack.diameter - annularWidth * 2);
+        drillDiameter = PositiveLength(padStack.diameter -
+                                       snapshot.minViaAnnularRing * 2);
       }
       // For the exposure config, use a similar mechanism.
       MaskConfig exposureConfig = MaskConfig::automatic();
@@ -583,8 +712,8 @@ bool CmdBoardSpecctraImport::performExecute() {
                           PositiveLength(padStack.diameter), *drillDiameter,
                           exposureConfig),
                       false);
-      anchors.append(AnchorData{via.pos, padStack.startLayer, padStack.endLayer,
-                                TraceAnchor::via(uuid)});
+      anchors[via.pos].append(AnchorData{
+          padStack.startLayer, padStack.endLayer, TraceAnchor::via(uuid)});
     }
     auto getOrCreateAnchor = [&](const Point& pos, const Layer* layer) {
       if (auto anchor = findAnchor(pos, layer)) {
@@ -592,11 +721,11 @@ bool CmdBoardSpecctraImport::performExecute() {
       } else {
         // Create new junction.
         const std::optional<OldJunction> oldNp =
-            findNetPoint(netSignal, pos, layer);
+            findNetPoint(netUuid, pos, layer);
         const Uuid uuid = oldNp ? oldNp->uuid : Uuid::createRandom();
         splitter.addJunction(Junction(uuid, oldNp ? oldNp->pos : pos));
         const TraceAnchor a = TraceAnchor::junction(uuid);
-        anchors.append(AnchorData{pos, layer, layer, a});
+        anchors[pos].append(AnchorData{layer, layer, a});
         return a;
       }
     };
@@ -605,7 +734,7 @@ bool CmdBoardSpecctraImport::performExecute() {
         Point p0 = wire.path.getVertices().at(i - 1).getPos();
         Point p1 = wire.path.getVertices().at(i).getPos();
         const std::optional<OldTrace> oldNl =
-            findNetLine(netSignal, p0, p1, *wire.layer, wire.width);
+            findNetLine(netUuid, p0, p1, *wire.layer, wire.width);
         if (oldNl && (!fuzzyCompare(oldNl->start, p0))) {
           std::swap(p0, p1);  // Avoid change in file format.
         }
@@ -616,10 +745,9 @@ bool CmdBoardSpecctraImport::performExecute() {
       }
     }
 
-    // Add netpoints, vias and traces for each segment.
+    // Determine the UUID of each segment.
     foreach (const BoardNetSegmentSplitter::Segment& segment,
              splitter.split()) {
-      // Find old segment.
       QSet<Uuid> nsRefs;
       for (const Junction& junction : segment.junctions) {
         nsRefs.insert(junction.getUuid());
@@ -630,81 +758,170 @@ bool CmdBoardSpecctraImport::performExecute() {
       for (const Via& via : segment.vias) {
         nsRefs.insert(via.getUuid());
       }
-      const std::optional<OldSegment> oldNs = findNetSegment(netSignal, nsRefs);
-
-      // Add new segment
-      BI_NetSegment* copy = new BI_NetSegment(
-          mBoard, oldNs ? oldNs->uuid : Uuid::createRandom(), netSignal);
-      execNewChildCmd(new CmdBoardNetSegmentAdd(*copy));
-
-      // Add vias, netpoints and netlines
-      std::unique_ptr<CmdBoardNetSegmentAddElements> cmdAddElements(
-          new CmdBoardNetSegmentAddElements(*copy));
-      QHash<Uuid, BI_Via*> viaMap;
-      for (const Via& v : segment.vias) {
-        BI_Via* via = cmdAddElements->addVia(Via(
-            v.getUuid(), v.getStartLayer(), v.getEndLayer(), v.getPosition(),
-            v.getSize(), v.getDrillDiameter(), v.getExposureConfig()));
-        viaMap.insert(v.getUuid(), via);
+      const std::optional<Uuid> oldNs = findNetSegment(netUuid, nsRefs);
+      result->segments.append(Result::Segment{
+          oldNs ? *oldNs : Uuid::createRandom(), netUuid, segment});
+    }
+  }
+  result->newObjects = newUuids;
+  result->reusedObjects = reusedUuids.count();
+
+  qDebug() << "Matched Specctra session with board in" << timer.elapsed()
+           << "ms.";
+  return result;
+}
+
+/*******************************************************************************
+ *  Inherited from UndoCommand
+ ******************************************************************************/
+
+bool CmdBoardSpecctraImport::performExecute() {
+  // if an error occurs, undo all already executed child commands
+  auto undoScopeGuard = scopeGuard([&]() { performUndo(); });
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // Delete all net segments, they will be re-created from scratch below.
+  foreach (auto seg, mBoard.getNetSegments()) {
+    execNewChildCmd(new CmdBoardNetSegmentRemove(*seg));  // can throw
+  }
+
+  // Update devices placement.
+  QSet<QString> importedComponents;
+  QSet<Uuid> updatedComponents;
+  if (mResult->components) {
+    for (const auto& item : *mResult->components) {
+      importedComponents.insert(item.name);
+      ComponentInstance* cmp = mCircuit.getComponentInstanceByName(item.name);
+      BI_Device* dev = cmp
+          ? mBoard.getDeviceInstanceByComponentUuid(cmp->getUuid())
+          : nullptr;
+      if ((!cmp) || (!dev)) {
+        mLogger->warning(
+            tr("Component '%1' from Specctra session does not exist "
+               "in this board.")
+                .arg(item.name));
+        continue;
+      }
+      if (((item.side == Side::Front) && (dev->getMirrored())) ||
+          ((item.side == Side::Back) && (!dev->getMirrored()))) {
+        mLogger->warning(
+            tr("Component '%1' has been flipped, which is not supported yet.")
+                .arg(item.name));
+        continue;
       }
-      QHash<Uuid, BI_NetPoint*> netPointMap;
-      for (const Junction& junction : segment.junctions) {
-        BI_NetPoint* netpoint =
-            new BI_NetPoint(*copy, junction.getUuid(), junction.getPosition());
-        cmdAddElements->addNetPoint(*netpoint);
-        netPointMap.insert(junction.getUuid(), netpoint);
+      std::unique_ptr<CmdDeviceInstanceEditAll> cmd(
+          new CmdDeviceInstanceEditAll(*dev));
+      if (!fuzzyCompare(dev->getPosition(), item.pos)) {
+        cmd->setPosition(item.pos, false);
+        updatedComponents.insert(cmp->getUuid());
       }
-      for (const Trace& trace : segment.traces) {
-        BI_NetLineAnchor* start = nullptr;
-        if (std::optional<Uuid> anchor =
-                trace.getStartPoint().tryGetJunction()) {
-          start = netPointMap[*anchor];
-        } else if (std::optional<Uuid> anchor =
-                       trace.getStartPoint().tryGetVia()) {
-          start = viaMap[*anchor];
-        } else if (std::optional<TraceAnchor::PadAnchor> anchor =
-                       trace.getStartPoint().tryGetPad()) {
-          BI_Device* device =
-              mBoard.getDeviceInstanceByComponentUuid(anchor->device);
-          start = device ? device->getPad(anchor->pad) : nullptr;
-        }
-        BI_NetLineAnchor* end = nullptr;
-        if (std::optional<Uuid> anchor = trace.getEndPoint().tryGetJunction()) {
-          end = netPointMap[*anchor];
-        } else if (std::optional<Uuid> anchor =
-                       trace.getEndPoint().tryGetVia()) {
-          end = viaMap[*anchor];
-        } else if (std::optional<TraceAnchor::PadAnchor> anchor =
-                       trace.getEndPoint().tryGetPad()) {
-          BI_Device* device =
-              mBoard.getDeviceInstanceByComponentUuid(anchor->device);
-          end = device ? device->getPad(anchor->pad) : nullptr;
-        }
-        if ((!start) || (!end)) {
-          throw LogicError(__FILE__, __LINE__);
-        }
-        BI_NetLine* netline =
-            new BI_NetLine(*copy, trace.getUuid(), *start, *end,
-                           trace.getLayer(), trace.getWidth());
-        cmdAddElements->addNetLine(*netline);
+      if (!fuzzyCompare(dev->getRotation(), item.rot)) {
+        cmd->setRotation(item.rot, false);
+        updatedComponents.insert(cmp->getUuid());
+      }
+      execNewChildCmd(cmd.release());
+    }
+
+    // Warn about missing components.
+    for (const auto dev : mBoard.getDeviceInstances()) {
+      const QString name = *dev->getComponentInstance().getName();
+      // Footprints without pads are discarded by Freerouting as they are not
+      // relevant, thus ignore them.
+      if ((!importedComponents.contains(name)) && (!dev->getPads().isEmpty())) {
+        mLogger->warning(
+            tr("The component '%1' does not exist in the Specctra session.")
+                .arg(name));
       }
-      execNewChildCmd(cmdAddElements.release());
     }
   }
 
+  // Add the prepared net segments.
+  for (const Result::Segment& segment : mResult->segments) {
+    NetSignal* netSignal = nullptr;
+    if (segment.net) {
+      netSignal = mCircuit.getNetSignals().value(*segment.net);
+      if (!netSignal) {
+        throw LogicError(__FILE__, __LINE__, "Net signal does not exist.");
+      }
+    }
+
+    // Add new segment
+    BI_NetSegment* copy = new BI_NetSegment(mBoard, segment.uuid, netSignal);
+    execNewChildCmd(new CmdBoardNetSegmentAdd(*copy));
+
+    // Add vias, netpoints and netlines
+    std::unique_ptr<CmdBoardNetSegmentAddElements> cmdAddElements(
+        new CmdBoardNetSegmentAddElements(*copy));
+    QHash<Uuid, BI_Via*> viaMap;
+    for (const Via& v : segment.elements.vias) {
+      BI_Via* via = cmdAddElements->addVia(Via(
+          v.getUuid(), v.getStartLayer(), v.getEndLayer(), v.getPosition(),
+          v.getSize(), v.getDrillDiameter(), v.getExposureConfig()));
+      viaMap.insert(v.getUuid(), via);
+    }
+    QHash<Uuid, BI_NetPoint*> netPointMap;
+    for (const Junction& junction : segment.elements.junctions) {
+      BI_NetPoint* netpoint =
+          new BI_NetPoint(*copy, junction.getUuid(), junction.getPosition());
+      cmdAddElements->addNetPoint(*netpoint);
+      netPointMap.insert(junction.getUuid(), netpoint);
+    }
+    for (const Trace& trace : segment.elements.traces) {
+      BI_NetLineAnchor* start = nullptr;
+      if (std::optional<Uuid> anchor = trace.getStartPoint().tryGetJunction()) {
+        start = netPointMap[*anchor];
+      } else if (std::optional<Uuid> anchor =
+                     trace.getStartPoint().tryGetVia()) {
+        start = viaMap[*anchor];
+      } else if (std::optional<TraceAnchor::PadAnchor> anchor =
+                     trace.getStartPoint().tryGetPad()) {
+        BI_Device* device =
+            mBoard.getDeviceInstanceByComponentUuid(anchor->device);
+        start = device ? device->getPad(anchor->pad) : nullptr;
+      }
+      BI_NetLineAnchor* end = nullptr;
+      if (std::optional<Uuid> anchor = trace.getEndPoint().tryGetJunction()) {
+        end = netPointMap[*anchor];
+      } else if (std::optional<Uuid> anchor = trace.getEndPoint().tryGetVia()) {
+        end = viaMap[*anchor];
+      } else if (std::optional<TraceAnchor::PadAnchor> anchor =
+                     trace.getEndPoint().tryGetPad()) {
+        BI_Device* device =
+            mBoard.getDeviceInstanceByComponentUuid(anchor->device);
+        end = device ? device->getPad(anchor->pad) : nullptr;
+      }
+      if ((!start) || (!end)) {
+        throw LogicError(__FILE__, __LINE__);
+      }
+      BI_NetLine* netline =
+          new BI_NetLine(*copy, trace.getUuid(), *start, *end,
+                         trace.getLayer(), trace.getWidth());
+      cmdAddElements->addNetLine(*netline);
+    }
+    execNewChildCmd(cmdAddElements.release());
+  }
+
   // Print some statistics.
   mLogger->info(
       tr("Updated %1 components (%2 unmodified components skipped).")
           .arg(updatedComponents.count())
           .arg(importedComponents.count() - updatedComponents.count()));
   mLogger->info(tr("Updated %1 net objects (%2 unmodified objects skipped).")
-                    .arg(newUuids)
-                    .arg(reusedUuids.count()));
+                    .arg(mResult->newObjects)
+                    .arg(mResult->reusedObjects));
+  qDebug() << "Applied Specctra session to board in" << timer.elapsed()
+           << "ms.";
 
   undoScopeGuard.dismiss();  // no undo required
   return getChildCount() > 0;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
 std::optional<PositiveLength> CmdBoardSpecctraImport::extractViaDrillDiameter(
     const QString& padStackId) noexcept {
   // Note: Keep in sync with BoardSpecctraExport::getWiringPadStackId().
@@ -44,7 +44,6 @@ class Board;
 class Circuit;
 class Layer;
 class MessageLogger;
-class Project;
 class SExpression;
 
 namespace editor {
@@ -91,11 +90,58 @@ public:
     QList<WireOut> wires;
   };
 
+  /**
+   * @brief Copy of the board data needed by #prepare()
+   *
+   * Created in the GUI thread with #takeSnapshot() to allow preparing the
+   * import in a worker thread.
+   */
+  struct Snapshot;
+
+  /**
+   * @brief The prepared changes, created by #prepare()
+   */
+  struct Result;
+
   // Constructors / Destructor
   explicit CmdBoardSpecctraImport(Board& board, const SExpression& root,
                                   std::shared_ptr<MessageLogger> logger);
+  explicit CmdBoardSpecctraImport(Board& board,
+                                  std::shared_ptr<const Result> result,
+                                  std::shared_ptr<MessageLogger> logger);
   ~CmdBoardSpecctraImport() noexcept;
 
+  // Static Methods
+
+  /**
+   * @brief Copy all board data needed to prepare the import
+   *
+   * @param board   The board to import the session into.
+   *
+   * @return The snapshot to be passed to #prepare().
+   */
+  static std::shared_ptr<const Snapshot> takeSnapshot(const Board& board);
+
+  /**
+   * @brief Parse a session and match it against the board
+   *
+   * Determines all net segments to be created, reusing the UUIDs of
+   * the existing board objects where possible. This is thread-safe, thus
+   * it can (and should) be called in a worker thread since it might take
+   * some time for large boards.
+   *
+   * @param snapshot  The board data from #takeSnapshot().
+   * @param root      The parsed Specctra session.
+   * @param logger    Logger for warnings and debug messages.
+   *
+   * @return The prepared changes to be applied with the undo command.
+   *
+   * @throws Exception if the session is invalid.
+   */
+  static std::shared_ptr<const Result> prepare(const Snapshot& snapshot,
+                                               const SExpression& root,
+                                               MessageLogger& logger);
+
 private:  // Methods
   /// @copydoc ::librepcb::editor::UndoCommand::performExecute()
   bool performExecute() override;
@@ -105,13 +151,10 @@ private:  // Methods
   static std::optional<MaskConfig> extractViaExposureConfig(
       const QString& padStackId) noexcept;
 
-  Project& mProject;
   Circuit& mCircuit;
   Board& mBoard;
   std::shared_ptr<MessageLogger> mLogger;
-  std::optional<QList<ComponentOut>> mComponents;
-  QHash<QString, PadStackOut> mPadStacks;
-  QList<NetOut> mNets;
+  std::shared_ptr<const Result> mResult;
 };
 
 /*******************************************************************************
@@ -45,6 +45,7 @@
 #include <librepcb/core/project/board/items/bi_via.h>
 #include <librepcb/core/project/board/items/bi_zone.h>
 #include <librepcb/core/project/project.h>
+#include <librepcb/core/utils/signalslot.h>
 
 #include <QtCore>
 
@@ -200,6 +201,7 @@ UnsignedLength CmdDragSelectedBoardItems::getMedianLineWidth() const noexcept {
  ******************************************************************************/
 
 void CmdDragSelectedBoardItems::snapToGrid() noexcept {
+  SignalBatch batch;  // Update each graphics item only once.
   PositiveLength grid = mScene.getBoard().getGridInterval();
   foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
     cmd->snapToGrid(grid, true);
@@ -282,6 +284,10 @@ void CmdDragSelectedBoardItems::setCurrentPosition(
   }
 
   if (delta != mDeltaPos) {
+    // Moving many elements must not update each graphics item several times
+    // (e.g. traces connected to two moved vias), thus batch all updates.
+    SignalBatch batch;
+
     // move selected elements
     foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
       cmd->translate(delta - mDeltaPos, true);
@@ -317,6 +323,7 @@ void CmdDragSelectedBoardItems::setCurrentPosition(
 
 void CmdDragSelectedBoardItems::rotate(const Angle& angle,
                                        bool aroundCurrentPosition) noexcept {
+  SignalBatch batch;  // Update each graphics item only once.
   const Point center = (aroundCurrentPosition && (mItemCount > 1))
       ? (mStartPos + mDeltaPos)
             .mappedToGrid(mScene.getBoard().getGridInterval())
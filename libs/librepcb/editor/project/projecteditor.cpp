@@ -47,12 +47,14 @@
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/erc/electricalrulecheckdatatracker.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/schematic/schematic.h>
 #include <librepcb/core/utils/scopeguard.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -83,8 +85,11 @@ ProjectEditor::ProjectEditor(
     mUndoStack(new UndoStack()),
     mHighlightedNetSignals(new QSet<const NetSignal*>()),
     mActiveSchematicTabs(),
+    mErcDataTracker(new ElectricalRuleCheckDataTracker(*mProject)),
+    mErc(new ElectricalRuleCheck()),
+    mErcWatcher(),
+    mErcRerunRequested(false),
     mErcMessages(),
-    mErcExecutionError(),
     mManualModificationsMade(false),
     mLastAutosaveStateId(mUndoStack->getUniqueStateId()),
     mAutoSaveTimer() {
@@ -210,6 +215,9 @@ ProjectEditor::~ProjectEditor() noexcept {
   mAutoSaveTimer.stop();
   mErcTimer.stop();
 
+  // A running ERC does not access the project, so no need to wait for it.
+  mErcWatcher.reset();
+
   // Delete all command objects in the undo stack. This mmust be done before
   // other important objects are deleted, as undo command objects can hold
   // pointers/references to them!
@@ -222,6 +230,7 @@ ProjectEditor::~ProjectEditor() noexcept {
     mErcMessages->clear();
     mErcMessages.reset();
   }
+  mErcDataTracker.reset();
   mProject.reset();  // This also closes schematic- & board editors.
   Q_ASSERT(mSchematics->isEmpty());
   Q_ASSERT(mBoards->isEmpty());
@@ -259,7 +268,7 @@ ui::ProjectData ProjectEditor::getUiData() const noexcept {
                        : ui::RuleCheckState::NotRunYet,  // State
           mErcMessages,  // Messages
           mErcMessages ? mErcMessages->getUnapprovedCount() : 0,  // Unapproved
-          q2s(mErcExecutionError),  // Execution error
+          slint::SharedString(),  // Execution error
       },
   };
 }
@@ -717,39 +726,73 @@ void ProjectEditor::scheduleErcRun() noexcept {
 }
 
 void ProjectEditor::runErc() noexcept {
-  try {
-    QElapsedTimer timer;
-    timer.start();
-    ElectricalRuleCheck erc(*mProject);
-    const auto messages = erc.runChecks();
-
-    // Detect disappeared messages & remove their approvals.
-    QSet<SExpression> approvals = RuleCheckMessage::getAllApprovals(messages);
-    mSupportedErcApprovals |= approvals;
-    mDisappearedErcApprovals = mSupportedErcApprovals - approvals;
-    approvals = mProject->getErcMessageApprovals() - mDisappearedErcApprovals;
+  // The ERC object keeps the results of the previous run to check only
+  // modified objects, thus it must not run concurrently. If the project was
+  // modified while the ERC is running, it will be run again when finished.
+  if (mErcWatcher && mErcWatcher->isRunning()) {
+    mErcRerunRequested = true;
+    return;
+  }
+  mErcRerunRequested = false;
+
+  // Copy the modified project data in the main thread, then run the checks in
+  // a worker thread.
+  QElapsedTimer timer;
+  timer.start();
+  auto data = std::make_shared<const ElectricalRuleCheckData>(
+      mErcDataTracker->takeSnapshot());
+  auto erc = mErc;
+  mErcWatcher.reset(new QFutureWatcher<RuleCheckMessageList>());
+  connect(mErcWatcher.get(), &QFutureWatcher<RuleCheckMessageList>::finished,
+          this, [this, timer]() { ercFinished(timer.elapsed()); });
+  mErcWatcher->setFuture(
+      QtConcurrent::run([erc, data]() { return erc->runChecks(*data); }));
+}
+
+void ProjectEditor::ercFinished(qint64 elapsedMs) noexcept {
+  const RuleCheckMessageList messages = mErcWatcher->result();
+
+  // Detect disappeared messages & remove their approvals. The approvals are
+  // compared by their fingerprints, which are cached by the messages and the
+  // project, so only the approvals to be removed need to be hashed again.
+  const QSet<RuleCheckMessage::Fingerprint> fingerprints =
+      RuleCheckMessage::getAllApprovalFingerprints(messages);
+  mSupportedErcApprovals |= fingerprints;
+  const QSet<RuleCheckMessage::Fingerprint> disappeared =
+      mSupportedErcApprovals - fingerprints;
+  if (mProject->getErcMessageApprovalFingerprints().intersects(disappeared)) {
+    QSet<SExpression> approvals = mProject->getErcMessageApprovals();
+    for (auto it = approvals.begin(); it != approvals.end();) {
+      if (disappeared.contains(RuleCheckMessage::calcFingerprint(*it))) {
+        it = approvals.erase(it);
+      } else {
+        ++it;
+      }
+    }
     if (mProject->setErcMessageApprovals(approvals)) {
       setManualModificationsMade();
     }
-
-    // Update UI.
-    if (!mErcMessages) {
-      mErcMessages.reset(new RuleCheckMessagesModel());
-      connect(mErcMessages.get(), &RuleCheckMessagesModel::approvalChanged,
-              mProject.get(), &Project::setErcMessageApproved);
-      connect(mErcMessages.get(), &RuleCheckMessagesModel::approvalChanged,
-              this, &ProjectEditor::setManualModificationsMade);
-    }
-    mErcMessages->setMessages(messages, approvals);
-    mErcExecutionError.clear();
-
-    qDebug() << "ERC succeeded after" << timer.elapsed() << "ms.";
-  } catch (const Exception& e) {
-    mErcExecutionError = e.getMsg();
-    qCritical() << "ERC failed:" << e.getMsg();
   }
 
+  // Update UI.
+  if (!mErcMessages) {
+    mErcMessages.reset(new RuleCheckMessagesModel());
+    connect(mErcMessages.get(), &RuleCheckMessagesModel::approvalChanged,
+            mProject.get(), &Project::setErcMessageApproved);
+    connect(mErcMessages.get(), &RuleCheckMessagesModel::approvalChanged, this,
+            &ProjectEditor::setManualModificationsMade);
+  }
+  mErcMessages->setMessages(messages,
+                            mProject->getErcMessageApprovalFingerprints());
   onUiDataChanged.notify();
+
+  qDebug() << "ERC succeeded after" << elapsedMs << "ms,"
+           << mErcDataTracker->getUpdatedObjectsCount() << "objects copied,"
+           << mErc->getCheckedObjectsCount() << "objects checked.";
+
+  if (mErcRerunRequested) {
+    scheduleErcRun();
+  }
 }
 
 void ProjectEditor::projectSettingsChanged() noexcept {
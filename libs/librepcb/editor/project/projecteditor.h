@@ -26,6 +26,7 @@
 #include "../utils/uiobjectlist.h"
 #include "appwindow.h"
 
+#include <librepcb/core/rulecheck/rulecheckmessage.h>
 #include <librepcb/core/serialization/fileformatmigration.h>
 #include <librepcb/core/serialization/sexpression.h>
 #include <librepcb/core/utils/signalslot.h>
@@ -40,6 +41,8 @@
 namespace librepcb {
 
 class Board;
+class ElectricalRuleCheck;
+class ElectricalRuleCheckDataTracker;
 class NetSignal;
 class Project;
 class Workspace;
@@ -196,6 +199,7 @@ private:
   void showUpgradeMessages() noexcept;
   void scheduleErcRun() noexcept;
   void runErc() noexcept;
+  void ercFinished(qint64 elapsedMs) noexcept;
   void projectSettingsChanged() noexcept;
 
 private:
@@ -213,10 +217,12 @@ private:
   QVector<QPointer<SchematicTab>> mActiveSchematicTabs;
 
   // ERC
+  std::unique_ptr<ElectricalRuleCheckDataTracker> mErcDataTracker;
+  std::shared_ptr<ElectricalRuleCheck> mErc;  // Used from worker thread!
+  std::unique_ptr<QFutureWatcher<RuleCheckMessageList>> mErcWatcher;
+  bool mErcRerunRequested;  // Project modified while ERC was running
   std::shared_ptr<RuleCheckMessagesModel> mErcMessages;  // Lazy initialized
-  QSet<SExpression> mSupportedErcApprovals;
-  QSet<SExpression> mDisappearedErcApprovals;
-  QString mErcExecutionError;
+  QSet<RuleCheckMessage::Fingerprint> mSupportedErcApprovals;
   QTimer mErcTimer;
 
   /// Modifications bypassing the undo stack
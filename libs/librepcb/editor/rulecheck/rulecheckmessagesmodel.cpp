@@ -57,10 +57,63 @@ void RuleCheckMessagesModel::clear() noexcept {
 
 void RuleCheckMessagesModel::setMessages(
     const RuleCheckMessageList& messages,
-    const QSet<SExpression>& approvals) noexcept {
-  mMessages = messages;
+    const QSet<RuleCheckMessage::Fingerprint>& approvals) noexcept {
+  // Instead of resetting the whole model, apply only the differences between
+  // the old and new messages to avoid rebuilding all rows in the UI. Messages
+  // are identified by their approval fingerprint. The message list is updated
+  // step by step to keep it consistent with the emitted notifications.
+  using Fingerprint = RuleCheckMessage::Fingerprint;
+  const QSet<Fingerprint> oldApprovals = mApprovals;
   mApprovals = approvals;
-  notify_reset();
+  QHash<Fingerprint, int> remainingOld;
+  for (const auto& msg : mMessages) {
+    ++remainingOld[msg->getApprovalFingerprint()];
+  }
+  QHash<Fingerprint, int> remainingNew;
+  for (const auto& msg : messages) {
+    ++remainingNew[msg->getApprovalFingerprint()];
+  }
+  auto removeSurplusRows = [&](int row, const Fingerprint& next) {
+    int count = 0;
+    while ((row + count) < mMessages.count()) {
+      const auto& msg = mMessages.at(row + count);
+      const Fingerprint& fp = msg->getApprovalFingerprint();
+      if ((fp == next) || (remainingOld[fp] <= remainingNew[fp])) {
+        break;
+      }
+      --remainingOld[fp];
+      ++count;
+    }
+    if (count > 0) {
+      mMessages.remove(row, count);
+      notify_row_removed(row, count);
+    }
+  };
+  for (int row = 0; row < messages.count(); ++row) {
+    const auto& msg = messages.at(row);
+    const Fingerprint& fp = msg->getApprovalFingerprint();
+    removeSurplusRows(row, fp);
+    if ((row < mMessages.count()) &&
+        (mMessages.at(row)->getApprovalFingerprint() == fp)) {
+      const auto oldMsg = mMessages.at(row);
+      mMessages[row] = msg;
+      if (((oldMsg != msg) && ((*oldMsg) != (*msg))) ||
+          (oldApprovals.contains(fp) != mApprovals.contains(fp))) {
+        notify_row_changed(row);
+      }
+      --remainingOld[fp];
+    } else {
+      mMessages.insert(row, msg);
+      notify_row_added(row, 1);
+    }
+    --remainingNew[fp];
+  }
+  if (mMessages.count() > messages.count()) {
+    const int count = mMessages.count() - messages.count();
+    mMessages.remove(messages.count(), count);
+    notify_row_removed(messages.count(), count);
+  }
+  Q_ASSERT(mMessages == messages);
   updateUnapprovedCount();
 }
 
@@ -79,7 +132,7 @@ std::optional<ui::RuleCheckMessageData> RuleCheckMessagesModel::row_data(
         l2s(msg->getSeverity()),  // Severity
         q2s(msg->getMessage()),  // Message
         q2s(msg->getDescription()),  // Description
-        mApprovals.contains(msg->getApproval()),  // Approved
+        isApproved(*msg),  // Approved
         false,  // Supports autofix
         ui::RuleCheckMessageAction::None,  // Action
     };
@@ -91,13 +144,13 @@ std::optional<ui::RuleCheckMessageData> RuleCheckMessagesModel::row_data(
 void RuleCheckMessagesModel::set_row_data(
     std::size_t i, const ui::RuleCheckMessageData& data) noexcept {
   if (auto msg = mMessages.value(i)) {
-    if (data.approved && (!mApprovals.contains(msg->getApproval()))) {
-      mApprovals.insert(msg->getApproval());
+    if (data.approved && (!isApproved(*msg))) {
+      mApprovals.insert(msg->getApprovalFingerprint());
       emit approvalChanged(msg->getApproval(), true);
       notify_row_changed(i);
       updateUnapprovedCount();
-    } else if ((!data.approved) && mApprovals.contains(msg->getApproval())) {
-      mApprovals.remove(msg->getApproval());
+    } else if ((!data.approved) && isApproved(*msg)) {
+      mApprovals.remove(msg->getApprovalFingerprint());
       emit approvalChanged(msg->getApproval(), false);
       notify_row_changed(i);
       updateUnapprovedCount();
@@ -121,7 +174,7 @@ void RuleCheckMessagesModel::set_row_data(
 void RuleCheckMessagesModel::updateUnapprovedCount() noexcept {
   int count = 0;
   for (auto msg : mMessages) {
-    if (!mApprovals.contains(msg->getApproval())) {
+    if (!isApproved(*msg)) {
       ++count;
     }
   }
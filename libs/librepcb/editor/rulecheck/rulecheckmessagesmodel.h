@@ -54,8 +54,9 @@ public:
 
   // General Methods
   void clear() noexcept;
-  void setMessages(const RuleCheckMessageList& messages,
-                   const QSet<SExpression>& approvals) noexcept;
+  void setMessages(
+      const RuleCheckMessageList& messages,
+      const QSet<RuleCheckMessage::Fingerprint>& approvals) noexcept;
   int getUnapprovedCount() const noexcept { return mUnapprovedCount; }
 
   // Implementations
@@ -76,10 +77,13 @@ signals:
   void autofixRequested(std::shared_ptr<const RuleCheckMessage> msg);
 
 private:
+  bool isApproved(const RuleCheckMessage& msg) const noexcept {
+    return mApprovals.contains(msg.getApprovalFingerprint());
+  }
   void updateUnapprovedCount() noexcept;
 
   RuleCheckMessageList mMessages;
-  QSet<SExpression> mApprovals;
+  QSet<RuleCheckMessage::Fingerprint> mApprovals;
   int mUnapprovedCount;
 };
 
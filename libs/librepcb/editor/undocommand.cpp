@@ -23,6 +23,7 @@
 #include "undocommand.h"
 
 #include <librepcb/core/exceptions.h>
+#include <librepcb/core/utils/signalslot.h>
 
 #include <QtCore>
 
@@ -53,6 +54,10 @@ bool UndoCommand::execute() {
     throw LogicError(__FILE__, __LINE__);
   }
 
+  // Defer expensive updates (e.g. of graphics items) until the whole command
+  // is executed, to avoid updating them once per modification.
+  SignalBatch batch;
+
   mIsExecuted = true;  // set this flag BEFORE performing the execution!
   bool retval = performExecute();  // can throw
   mRedoCount++;
@@ -65,6 +70,7 @@ void UndoCommand::undo() {
     throw LogicError(__FILE__, __LINE__);
   }
 
+  SignalBatch batch;  // See execute().
   performUndo();  // can throw
   mUndoCount++;
 }
@@ -74,6 +80,7 @@ void UndoCommand::redo() {
     throw LogicError(__FILE__, __LINE__);
   }
 
+  SignalBatch batch;  // See execute().
   performRedo();  // can throw
   mRedoCount++;
 }
@@ -173,21 +173,30 @@ QVector<std::shared_ptr<CategoryTreeModel::Item>> CategoryTreeModel::getChilds(
           new Item{parent, uuid, QString(), QString(), {}});
       child->childs = getChilds(child);
       if (!child->childs.isEmpty() || listAll() || containsItems(uuid)) {
-        FilePath fp = listPackageCategories()
-            ? mLibrary.getLatest<PackageCategory>(uuid)
-            : mLibrary.getLatest<ComponentCategory>(uuid);
-        if (fp.isValid()) {
-          if (listPackageCategories()) {
-            mLibrary.getTranslations<PackageCategory>(
-                fp, mLocaleOrder, &child->text, &child->tooltip);
-          } else {
-            mLibrary.getTranslations<ComponentCategory>(
-                fp, mLocaleOrder, &child->text, &child->tooltip);
-          }
-        }
         childs.append(child);
       }
     }
+
+    // Fetch the texts of all children at once since there might be many.
+    QSet<Uuid> childUuids;
+    foreach (const auto& child, childs) {
+      childUuids.insert(*child->uuid);
+    }
+    const QHash<Uuid, FilePath> fps = listPackageCategories()
+        ? mLibrary.getLatest<PackageCategory>(childUuids)
+        : mLibrary.getLatest<ComponentCategory>(childUuids);
+    const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> infos =
+        listPackageCategories()
+        ? mLibrary.getElementInfos<PackageCategory>(fps.values(), mLocaleOrder)
+        : mLibrary.getElementInfos<ComponentCategory>(fps.values(),
+                                                      mLocaleOrder);
+    foreach (const auto& child, childs) {
+      auto it = infos.find(fps.value(*child->uuid));
+      if (it != infos.end()) {
+        child->text = it->name;
+        child->tooltip = it->description;
+      }
+    }
   } catch (const Exception& e) {
     qCritical() << "Failed to update category tree model items:" << e.getMsg();
   }
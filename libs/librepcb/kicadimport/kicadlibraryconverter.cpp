@@ -124,14 +124,10 @@ std::unique_ptr<Package> KiCadLibraryConverter::createPackage(
     tryOrLogError([&]() { lines.append(C::convertFootprintArc(arc)); }, log);
   }
   const QList<C::LineGroup> lineGroups = C::groupLinesByLayerAndWidth(lines);
-  bool timedOut = false;
   for (const C::LineGroup& group : lineGroups) {
     tryOrLogError(
         [&]() {
-          const qint64 timeout =
-              generatedBy.contains("TerminalBlock_WAGO") ? 500 : 5000;
-          foreach (const Path& path,
-                   TangentPathJoiner::join(group.paths, timeout, &timedOut)) {
+          foreach (const Path& path, TangentPathJoiner::join(group.paths)) {
             footprint->getPolygons().append(
                 std::make_shared<Polygon>(Uuid::createRandom(), *group.layer,
                                           group.width, false, false, path));
@@ -139,11 +135,6 @@ std::unique_ptr<Package> KiCadLibraryConverter::createPackage(
         },
         log);
   }
-  if (timedOut) {
-    log.info(
-        "Aborted joining tangent line segments to polygons due to timeout, "
-        "keeping them separate.");
-  }
   for (const KiCadFootprintCircle& circle : kiFpt.circles) {
     tryOrLogError(
         [&]() {
@@ -27,10 +27,9 @@
 #include "kicadtypes.h"
 
 #include <librepcb/core/fileio/fileutils.h>
-#include <librepcb/core/fileio/transactionaldirectory.h>
-#include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/cmp/component.h>
 #include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/libraryelementwriter.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/utils/messagelogger.h>
@@ -39,6 +38,8 @@
 #include <QtConcurrent>
 #include <QtCore>
 
+#include <atomic>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -537,12 +538,23 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
   log->info(tr("Parsing libraries..."));
   emit progressPercent(5);
 
-  // Load symbols.
-  int i = 0;
-  int symbolCount = 0;
-  for (SymbolLibrary& lib : result->symbolLibs) {
+  // Load the "generated_by" identifiers of all existing elements at once
+  // instead of querying the database for each parsed element.
+  const QSet<QString> importedSymbols = getAlreadyImported<librepcb::Symbol>();
+  const QSet<QString> importedPackages =
+      getAlreadyImported<librepcb::Package>();
+  const QSet<QString> importedComponents =
+      getAlreadyImported<librepcb::Component>();
+  const QSet<QString> importedDevices = getAlreadyImported<librepcb::Device>();
+
+  // Load symbols. Each library is parsed in its own job of the thread pool.
+  // Since every job only writes to its own library, the result order is the
+  // same as with sequential parsing.
+  std::atomic<int> symbolCount = 0;
+  std::atomic<int> symbolLibsParsed = 0;
+  auto parseSymbolLibrary = [&](SymbolLibrary& lib) {
     lib.symbols.clear();  // Might be a leftover from previous run.
-    if (mAbort) break;
+    if (mAbort) return;
 
     MessageLogger symLog(log.get(), lib.file.getCompleteBasename());
     try {
@@ -581,8 +593,8 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
             devGeneratedBy,
             pkgGeneratedBy,
             true,  // Might be set to false below.
-            isAlreadyImported<librepcb::Component>(cmpGeneratedBy),
-            isAlreadyImported<librepcb::Device>(devGeneratedBy),
+            importedComponents.contains(cmpGeneratedBy),
+            importedDevices.contains(devGeneratedBy),
             kiSymbol.extends,
             {},
             Qt::Checked,
@@ -594,8 +606,7 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
           const QString genBy =
               generatedBy(lib.file.getCompleteBasename(),
                           {kiSymbol.name, QString::number(gate.index)});
-          const bool alreadyImported =
-              isAlreadyImported<librepcb::Symbol>(genBy);
+          const bool alreadyImported = importedSymbols.contains(genBy);
           if (!alreadyImported) {
             sym.symAlreadyImported = false;
           }
@@ -613,42 +624,64 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
                           .arg(lib.file.getFilename()) %
                       " " % e.getMsg());
     }
-    emit progressPercent(5 + (45 * (++i) / result->symbolLibs.count()));
+    emit progressPercent(
+        5 + (45 * (++symbolLibsParsed) / result->symbolLibs.count()));
+  };
+  QtConcurrent::blockingMap(result->symbolLibs, parseSymbolLibrary);
+
+  // Load footprints. Each footprint file is parsed in its own job of the
+  // thread pool, the results are collected afterwards in the original order.
+  QVector<QVector<std::optional<Footprint>>> footprints;
+  QVector<std::pair<int, int>> footprintJobs;  // Library & file index.
+  for (int i = 0; i < result->footprintLibs.count(); ++i) {
+    const int fileCount = result->footprintLibs.at(i).files.count();
+    footprints.append(QVector<std::optional<Footprint>>(fileCount));
+    for (int k = 0; k < fileCount; ++k) {
+      footprintJobs.append(std::make_pair(i, k));
+    }
   }
-
-  // Load footprints.
-  i = 0;
+  std::atomic<int> footprintsParsed = 0;
+  auto parseFootprint = [&](const std::pair<int, int>& job) {
+    if (mAbort) return;
+
+    const FootprintLibrary& lib = result->footprintLibs.at(job.first);
+    const FilePath& fptFp = lib.files.at(job.second);
+    MessageLogger fptLog(
+        log.get(),
+        lib.dir.getCompleteBasename() + ":" + fptFp.getCompleteBasename());
+    try {
+      std::unique_ptr<SExpression> root = SExpression::parse(
+          FileUtils::readFile(fptFp), fptFp, SExpression::Mode::Permissive);
+      KiCadFootprint kiFpt = KiCadFootprint::parse(*root, fptLog);
+      const QString pkgGeneratedBy = generatedBy(lib.dir.getCompleteBasename(),
+                                                 {fptFp.getCompleteBasename()});
+      footprints[job.first][job.second] = Footprint{
+          fptFp,
+          kiFpt.name,
+          pkgGeneratedBy,
+          importedPackages.contains(pkgGeneratedBy),
+          Qt::Checked,
+      };
+    } catch (const Exception& e) {
+      fptLog.critical(
+          QString("Failed to parse footprint '%1':")
+              .arg(lib.dir.getFilename() + ":" + fptFp.getFilename()) %
+          " " % e.getMsg());
+    }
+    emit progressPercent(50 +
+                         (45 * (++footprintsParsed) / footprintJobs.count()));
+  };
+  QtConcurrent::blockingMap(footprintJobs, parseFootprint);
   int footprintCount = 0;
-  for (FootprintLibrary& lib : result->footprintLibs) {
+  for (int i = 0; i < result->footprintLibs.count(); ++i) {
+    FootprintLibrary& lib = result->footprintLibs[i];
     lib.footprints.clear();  // Might be a leftover from previous run.
-    for (const FilePath& fptFp : lib.files) {
-      if (mAbort) break;
-
-      MessageLogger fptLog(
-          log.get(),
-          lib.dir.getCompleteBasename() + ":" + fptFp.getCompleteBasename());
-      try {
-        std::unique_ptr<SExpression> root = SExpression::parse(
-            FileUtils::readFile(fptFp), fptFp, SExpression::Mode::Permissive);
-        KiCadFootprint kiFpt = KiCadFootprint::parse(*root, fptLog);
-        const QString pkgGeneratedBy = generatedBy(
-            lib.dir.getCompleteBasename(), {fptFp.getCompleteBasename()});
-        lib.footprints.append(Footprint{
-            fptFp,
-            kiFpt.name,
-            pkgGeneratedBy,
-            isAlreadyImported<librepcb::Package>(pkgGeneratedBy),
-            Qt::Checked,
-        });
+    for (const std::optional<Footprint>& fpt : footprints.at(i)) {
+      if (fpt) {
+        lib.footprints.append(*fpt);
         ++footprintCount;
-      } catch (const Exception& e) {
-        fptLog.critical(
-            QString("Failed to parse footprint '%1':")
-                .arg(lib.dir.getFilename() + ":" + fptFp.getFilename()) %
-            " " % e.getMsg());
       }
     }
-    emit progressPercent(50 + (45 * (++i) / result->footprintLibs.count()));
   }
 
   qDebug() << "Parsed all KiCad libraries in" << timer.elapsed() << "ms.";
@@ -658,7 +691,7 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
     mState = State::Scanned;
   } else {
     log->info(tr("Found %1 symbols and %2 footprints.")
-                  .arg(symbolCount)
+                  .arg(symbolCount.load())
                   .arg(footprintCount));
     if (symbolCount + footprintCount > 1000) {
       log->warning(
@@ -685,10 +718,21 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
   log->info(tr("Importing libraries..."));
   emit progressPercent(5);
 
+  // The conversion is done sequentially in the order of the dependencies
+  // between the elements since the converter builds up the UUID mappings
+  // needed by the dependent elements (e.g. symbol pins for components).
+  // Serializing and writing the converted elements to disk is done in
+  // parallel by the writer.
   KiCadLibraryConverter converter(mLibraryDb, *mSettings);
+  LibraryElementWriter writer(mDestinationLibraryFp);
+  auto writeError = [log](const QString& group, const QString& msg) {
+    // Called from a worker thread, so don't capture any local logger.
+    return [log, group, msg](const QString& error) {
+      MessageLogger(log.get(), group).critical(msg.arg(error));
+    };
+  };
   int totalCount = 0;
   int processedCount = 0;
-  int importedCount = 0;
 
   // Calculate total count.
   for (const FootprintLibrary& lib : result->footprintLibs) {
@@ -772,13 +816,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
         auto package =
             converter.createPackage(lib.dir, kiFpt, fpt.generatedBy, models,
                                     fptLog);  // can throw
-        TransactionalDirectory dir(TransactionalFileSystem::openRW(
-            mDestinationLibraryFp
-                .getPathTo(librepcb::Package::getShortElementName())
-                .getPathTo(package->getUuid().toStr())));
-        package->saveTo(dir);
-        dir.getFileSystem()->save();
-        ++importedCount;
+        writer.write(std::move(package),
+                     writeError(lib.dir.getCompleteBasename() % ":" %
+                                    fpt.file.getCompleteBasename(),
+                                tr("Skipped footprint due to error: %1")));
       } catch (const Exception& e) {
         fptLog.critical(
             tr("Skipped footprint due to error: %1").arg(e.getMsg()));
@@ -827,13 +868,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
             auto symbol = converter.createSymbol(lib.file, kiSym, kiGate,
                                                  gate.symGeneratedBy,
                                                  gateLog);  // can throw
-            TransactionalDirectory dir(TransactionalFileSystem::openRW(
-                mDestinationLibraryFp
-                    .getPathTo(librepcb::Symbol::getShortElementName())
-                    .getPathTo(symbol->getUuid().toStr())));
-            symbol->saveTo(dir);
-            dir.getFileSystem()->save();
-            ++importedCount;
+            writer.write(std::move(symbol),
+                         writeError(lib.file.getCompleteBasename() % ":" %
+                                        kiGate.name,
+                                    tr("Skipped symbol due to error: %1")));
           } catch (const Exception& e) {
             gateLog.critical(
                 tr("Skipped symbol due to error: %1").arg(e.getMsg()));
@@ -859,13 +897,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
             auto component = converter.createComponent(
                 lib.file, kiSym, kiGates, sym.cmpGeneratedBy, symGeneratedBy,
                 symLog);  // can throw
-            TransactionalDirectory dir(TransactionalFileSystem::openRW(
-                mDestinationLibraryFp
-                    .getPathTo(librepcb::Component::getShortElementName())
-                    .getPathTo(component->getUuid().toStr())));
-            component->saveTo(dir);
-            dir.getFileSystem()->save();
-            ++importedCount;
+            writer.write(
+                std::move(component),
+                writeError(lib.file.getCompleteBasename() % ":" % kiSym.name,
+                           tr("Skipped component due to error: %1")));
           } catch (const Exception& e) {
             symLog.critical(
                 tr("Skipped component due to error: %1").arg(e.getMsg()));
@@ -902,13 +937,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
                 lib.file, kiSym, kiGates, sym.devGeneratedBy,
                 sym.cmpGeneratedBy, sym.pkgGeneratedBy,
                 symLog);  // can throw
-            TransactionalDirectory dir(TransactionalFileSystem::openRW(
-                mDestinationLibraryFp
-                    .getPathTo(librepcb::Device::getShortElementName())
-                    .getPathTo(device->getUuid().toStr())));
-            device->saveTo(dir);
-            dir.getFileSystem()->save();
-            ++importedCount;
+            writer.write(
+                std::move(device),
+                writeError(lib.file.getCompleteBasename() % ":" % kiSym.name,
+                           tr("Skipped device due to error: %1")));
           } catch (const Exception& e) {
             symLog.critical(
                 tr("Skipped device due to error: %1").arg(e.getMsg()));
@@ -924,6 +956,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
     }
   }
 
+  // Wait until all elements are written.
+  writer.waitForFinished();
+  const int importedCount = writer.getWrittenCount();
+
   // Warn about missing 3D shape libraries.
   foreach (const QString& libName, Toolbox::sortedQSet(missing3dShapeLibs)) {
     log->info(QString("3D model library not found: '%1'").arg(libName));
@@ -954,15 +990,13 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
 }
 
 template <typename T>
-bool KiCadLibraryImport::isAlreadyImported(
-    const QString& generatedBy) const noexcept {
+QSet<QString> KiCadLibraryImport::getAlreadyImported() const noexcept {
   try {
-    const QSet<Uuid> uuids = mLibraryDb.getGenerated<T>(generatedBy);
-    return !uuids.isEmpty();
+    return mLibraryDb.getAllGeneratedBy<T>();
   } catch (const Exception& e) {
-    qCritical() << "Failed to get imported filepath:" << e.getMsg();
+    qCritical() << "Failed to get imported elements:" << e.getMsg();
   }
-  return false;
+  return QSet<QString>();
 }
 
 static bool setDependent(bool dependent, Qt::CheckState& checkState) noexcept {
@@ -28,6 +28,7 @@
 
 #include <QtCore>
 
+#include <atomic>
 #include <memory>
 
 /*******************************************************************************
@@ -125,6 +126,9 @@ public:
 
   // Getters
   State getState() const noexcept { return mState; }
+  const FilePath& getDestinationLibraryPath() const noexcept {
+    return mDestinationLibraryFp;
+  }
   const FilePath& getLoadedLibsPath() const noexcept { return mLoadedLibsFp; }
   const FilePath& getLoadedShapes3dPath() const noexcept {
     return mLoadedShapes3dFp;
@@ -182,7 +186,7 @@ private:
   std::shared_ptr<Result> import(std::shared_ptr<Result> result,
                                  std::shared_ptr<MessageLogger> log) noexcept;
   template <typename T>
-  bool isAlreadyImported(const QString& generatedBy) const noexcept;
+  QSet<QString> getAlreadyImported() const noexcept;
   void updateDependencies(std::shared_ptr<Result> result) noexcept;
 
   const FilePath mDestinationLibraryFp;
@@ -192,7 +196,7 @@ private:
   FilePath mLoadedShapes3dFp;
   QFuture<std::shared_ptr<Result>> mFuture;
   State mState;
-  bool mAbort;
+  std::atomic<bool> mAbort;
 };
 
 /*******************************************************************************
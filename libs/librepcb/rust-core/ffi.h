@@ -277,6 +277,76 @@ struct InteractiveHtmlBomRefMap {
   size_t id;
 };
 
+/**
+ * Wrapper for [Track], used to add many tracks at once
+ */
+struct InteractiveHtmlBomTrack {
+  /**
+   * Start position X
+   */
+  float start_x;
+  /**
+   * Start position Y
+   */
+  float start_y;
+  /**
+   * End position X
+   */
+  float end_x;
+  /**
+   * End position Y
+   */
+  float end_y;
+  /**
+   * Width
+   */
+  float width;
+};
+
+/**
+ * Wrapper for [Via], used to add many vias at once
+ */
+struct InteractiveHtmlBomVia {
+  /**
+   * Exists on front side
+   */
+  bool front;
+  /**
+   * Exists on back side
+   */
+  bool back;
+  /**
+   * Position X
+   */
+  float pos_x;
+  /**
+   * Position Y
+   */
+  float pos_y;
+  /**
+   * Outer diameter
+   */
+  float diameter;
+  /**
+   * Drill diameter
+   */
+  float drill_diameter;
+};
+
+/**
+ * Vertex of a zone outline
+ */
+struct InteractiveHtmlBomPoint {
+  /**
+   * Position X in nanometers
+   */
+  int64_t x;
+  /**
+   * Position Y in nanometers
+   */
+  int64_t y;
+};
+
 extern "C" {
 
 extern size_t ffi_qbytearray_len(const QByteArray * NONNULL obj);
@@ -398,28 +468,22 @@ void ffi_ibom_add_bom_line(InteractiveHtmlBom * NONNULL obj,
                            size_t parts_size);
 
 /**
- * Wrapper for adding a track to [InteractiveHtmlBom::tracks]
+ * Wrapper for adding tracks of the same layer and net to
+ * [InteractiveHtmlBom::tracks]
  */
-void ffi_ibom_add_track(InteractiveHtmlBom * NONNULL obj,
-                        InteractiveHtmlBomLayer layer,
-                        float start_x,
-                        float start_y,
-                        float end_x,
-                        float end_y,
-                        float width,
-                        const QString *net_name);
+void ffi_ibom_add_tracks(InteractiveHtmlBom * NONNULL obj,
+                         InteractiveHtmlBomLayer layer,
+                         const InteractiveHtmlBomTrack *tracks_array,
+                         size_t tracks_size,
+                         const QString *net_name);
 
 /**
- * Wrapper for adding a via to [InteractiveHtmlBom::vias]
+ * Wrapper for adding vias of the same net to [InteractiveHtmlBom::vias]
  */
-void ffi_ibom_add_via(InteractiveHtmlBom * NONNULL obj,
-                      const InteractiveHtmlBomLayer *layers_array,
-                      size_t layers_size,
-                      float pos_x,
-                      float pos_y,
-                      float diameter,
-                      float drill_diameter,
-                      const QString *net_name);
+void ffi_ibom_add_vias(InteractiveHtmlBom * NONNULL obj,
+                       const InteractiveHtmlBomVia *vias_array,
+                       size_t vias_size,
+                       const QString *net_name);
 
 /**
  * Wrapper for adding a zone to [InteractiveHtmlBom::zones]
@@ -429,6 +493,22 @@ void ffi_ibom_add_zone(InteractiveHtmlBom * NONNULL obj,
                        const QString * NONNULL svgpath,
                        const QString *net_name);
 
+/**
+ * Wrapper for adding zones of the same layer and net to
+ * [InteractiveHtmlBom::zones]
+ *
+ * The vertices of all zones are passed in a single array, `sizes_array`
+ * contains the number of vertices of each zone. The outlines must not
+ * contain arcs.
+ */
+void ffi_ibom_add_zones(InteractiveHtmlBom * NONNULL obj,
+                        InteractiveHtmlBomLayer layer,
+                        const InteractiveHtmlBomPoint *points_array,
+                        size_t points_size,
+                        const size_t *sizes_array,
+                        size_t sizes_size,
+                        const QString *net_name);
+
 /**
  * Wrapper for [InteractiveHtmlBom::generate_html]
  */
@@ -436,6 +516,18 @@ bool ffi_ibom_generate_html(const InteractiveHtmlBom * NONNULL obj,
                             QString * NONNULL out,
                             QString * NONNULL err);
 
+/**
+ * Wrapper for [InteractiveHtmlBom::generate_html], writing the HTML
+ * directly to a file
+ *
+ * Avoids passing the whole HTML as `QString` back to C++. The file is
+ * written to a temporary file first, which is then renamed to the target
+ * file to not leave a half-written file behind on errors.
+ */
+bool ffi_ibom_write_html(const InteractiveHtmlBom * NONNULL obj,
+                         const QString * NONNULL path,
+                         QString * NONNULL err);
+
 /**
  * Wrapper for [increment_number_in_string]
  */
@@ -503,6 +595,9 @@ void ffi_zipwriter_delete(ZipWriter *obj);
 
 /**
  * Write a file to [ZipWriter]
+ *
+ * The file is compressed asynchronously, thus errors might also be reported
+ * by subsequent calls or by [ffi_zipwriter_finish].
  */
 bool ffi_zipwriter_write_file(ZipWriter * NONNULL obj,
                               const QString * NONNULL name,
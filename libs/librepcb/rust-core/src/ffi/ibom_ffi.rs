@@ -2,8 +2,11 @@
 //! [`interactive-html-bom::InteractiveHtmlBom`](https://docs.rs/interactive-html-bom/latest/struct.interactiveHtmlBom.html)
 
 use super::cpp_ffi::*;
+use crate::toolbox::svg_path_from_polyline;
 use interactive_html_bom::*;
 use std::convert::From;
+use std::fs;
+use std::io::Write;
 
 /// Wrapper for [ViewMode]
 #[repr(C)]
@@ -183,6 +186,69 @@ struct InteractiveHtmlBomRefMap {
   id: usize,
 }
 
+/// Wrapper for [Track], used to add many tracks at once
+#[repr(C)]
+struct InteractiveHtmlBomTrack {
+  /// Start position X
+  start_x: f32,
+  /// Start position Y
+  start_y: f32,
+  /// End position X
+  end_x: f32,
+  /// End position Y
+  end_y: f32,
+  /// Width
+  width: f32,
+}
+
+/// Wrapper for [Via], used to add many vias at once
+#[repr(C)]
+struct InteractiveHtmlBomVia {
+  /// Exists on front side
+  front: bool,
+  /// Exists on back side
+  back: bool,
+  /// Position X
+  pos_x: f32,
+  /// Position Y
+  pos_y: f32,
+  /// Outer diameter
+  diameter: f32,
+  /// Drill diameter
+  drill_diameter: f32,
+}
+
+/// Vertex of a zone outline
+#[repr(C)]
+struct InteractiveHtmlBomPoint {
+  /// Position X in nanometers
+  x: i64,
+  /// Position Y in nanometers
+  y: i64,
+}
+
+/// Convert an optional `QString` pointer to an optional [String]
+fn from_qstring_ptr(s: *const QString) -> Option<String> {
+  if s.is_null() {
+    None
+  } else {
+    unsafe { Some(from_qstring(&*s)) }
+  }
+}
+
+/// Convert a C array pointer and its size to a slice
+///
+/// Empty C++ containers may return a null pointer as data, which must not
+/// be passed to [std::slice::from_raw_parts], so this is mapped to an
+/// empty slice.
+unsafe fn from_array_ptr<'a, T>(data: *const T, size: usize) -> &'a [T] {
+  if data.is_null() || (size == 0) {
+    &[]
+  } else {
+    std::slice::from_raw_parts(data, size)
+  }
+}
+
 /// Create a new [InteractiveHtmlBom] object
 #[no_mangle]
 extern "C" fn ffi_ibom_new(
@@ -319,7 +385,7 @@ extern "C" fn ffi_ibom_add_footprint(
 ) -> usize {
   let mut pads = Vec::new();
   unsafe {
-    for pad in std::slice::from_raw_parts(pads_array, pads_size) {
+    for pad in from_array_ptr(pads_array, pads_size) {
       let mut layers = Vec::new();
       if pad.front {
         layers.push(Layer::Front);
@@ -371,7 +437,7 @@ extern "C" fn ffi_ibom_add_bom_line(
 ) {
   let mut vec = Vec::new();
   unsafe {
-    for map in std::slice::from_raw_parts(parts_array, parts_size) {
+    for map in from_array_ptr(parts_array, parts_size) {
       vec.push(RefMap::new(&from_qstring(&*map.reference), map.id));
     }
   }
@@ -383,59 +449,54 @@ extern "C" fn ffi_ibom_add_bom_line(
   }
 }
 
-/// Wrapper for adding a track to [InteractiveHtmlBom::tracks]
+/// Wrapper for adding tracks of the same layer and net to
+/// [InteractiveHtmlBom::tracks]
 #[no_mangle]
-extern "C" fn ffi_ibom_add_track(
+extern "C" fn ffi_ibom_add_tracks(
   obj: &mut InteractiveHtmlBom,
   layer: InteractiveHtmlBomLayer,
-  start_x: f32,
-  start_y: f32,
-  end_x: f32,
-  end_y: f32,
-  width: f32,
+  tracks_array: *const InteractiveHtmlBomTrack,
+  tracks_size: usize,
   net_name: *const QString,
 ) {
-  let net = if net_name.is_null() {
-    None
-  } else {
-    unsafe { Some(from_qstring(&*net_name)) }
-  };
-  obj.tracks.push(Track::new(
-    layer.into(),
-    (start_x, start_y),
-    (end_x, end_y),
-    width,
-    net.as_deref(),
-  ));
+  let net = from_qstring_ptr(net_name);
+  let tracks = unsafe { from_array_ptr(tracks_array, tracks_size) };
+  obj.tracks.reserve(tracks.len());
+  for track in tracks {
+    obj.tracks.push(Track::new(
+      layer.into(),
+      (track.start_x, track.start_y),
+      (track.end_x, track.end_y),
+      track.width,
+      net.as_deref(),
+    ));
+  }
 }
 
-/// Wrapper for adding a via to [InteractiveHtmlBom::vias]
+/// Wrapper for adding vias of the same net to [InteractiveHtmlBom::vias]
 #[no_mangle]
-extern "C" fn ffi_ibom_add_via(
+extern "C" fn ffi_ibom_add_vias(
   obj: &mut InteractiveHtmlBom,
-  layers_array: *const InteractiveHtmlBomLayer,
-  layers_size: usize,
-  pos_x: f32,
-  pos_y: f32,
-  diameter: f32,
-  drill_diameter: f32,
+  vias_array: *const InteractiveHtmlBomVia,
+  vias_size: usize,
   net_name: *const QString,
 ) {
-  unsafe {
-    let layers = std::slice::from_raw_parts(layers_array, layers_size)
-      .iter()
-      .map(|x| (*x).into())
-      .collect::<Vec<_>>();
-    let net = if net_name.is_null() {
-      None
-    } else {
-      Some(from_qstring(&*net_name))
-    };
+  let net = from_qstring_ptr(net_name);
+  let vias = unsafe { from_array_ptr(vias_array, vias_size) };
+  obj.vias.reserve(vias.len());
+  for via in vias {
+    let mut layers = Vec::new();
+    if via.front {
+      layers.push(Layer::Front);
+    }
+    if via.back {
+      layers.push(Layer::Back);
+    }
     obj.vias.push(Via::new(
       &layers,
-      (pos_x, pos_y),
-      diameter,
-      drill_diameter,
+      (via.pos_x, via.pos_y),
+      via.diameter,
+      via.drill_diameter,
       net.as_deref(),
     ));
   }
@@ -449,11 +510,7 @@ extern "C" fn ffi_ibom_add_zone(
   svgpath: &QString,
   net_name: *const QString,
 ) {
-  let net = if net_name.is_null() {
-    None
-  } else {
-    unsafe { Some(from_qstring(&*net_name)) }
-  };
+  let net = from_qstring_ptr(net_name);
   obj.zones.push(Zone::new(
     layer.into(),
     &from_qstring(svgpath),
@@ -461,6 +518,37 @@ extern "C" fn ffi_ibom_add_zone(
   ));
 }
 
+/// Wrapper for adding zones of the same layer and net to
+/// [InteractiveHtmlBom::zones]
+///
+/// The vertices of all zones are passed in a single array, `sizes_array`
+/// contains the number of vertices of each zone. The outlines must not
+/// contain arcs.
+#[no_mangle]
+extern "C" fn ffi_ibom_add_zones(
+  obj: &mut InteractiveHtmlBom,
+  layer: InteractiveHtmlBomLayer,
+  points_array: *const InteractiveHtmlBomPoint,
+  points_size: usize,
+  sizes_array: *const usize,
+  sizes_size: usize,
+  net_name: *const QString,
+) {
+  let net = from_qstring_ptr(net_name);
+  let points = unsafe { from_array_ptr(points_array, points_size) };
+  let sizes = unsafe { from_array_ptr(sizes_array, sizes_size) };
+  obj.zones.reserve(sizes.len());
+  let mut offset = 0;
+  for size in sizes {
+    let outline = &points[offset..(offset + size)];
+    offset += size;
+    let svgpath = svg_path_from_polyline(outline.iter().map(|p| (p.x, p.y)));
+    obj
+      .zones
+      .push(Zone::new(layer.into(), &svgpath, net.as_deref()));
+  }
+}
+
 /// Wrapper for [InteractiveHtmlBom::generate_html]
 #[no_mangle]
 extern "C" fn ffi_ibom_generate_html(
@@ -479,3 +567,46 @@ extern "C" fn ffi_ibom_generate_html(
     }
   }
 }
+
+/// Wrapper for [InteractiveHtmlBom::generate_html], writing the HTML
+/// directly to a file
+///
+/// Avoids passing the whole HTML as `QString` back to C++. The file is
+/// written to a temporary file first, which is then renamed to the target
+/// file to not leave a half-written file behind on errors.
+#[no_mangle]
+extern "C" fn ffi_ibom_write_html(
+  obj: &InteractiveHtmlBom,
+  path: &QString,
+  err: &mut QString,
+) -> bool {
+  let path_str = from_qstring(path);
+  let fp = std::path::Path::new(&path_str);
+  let tmp_fp = fp.with_file_name(format!(
+    "{}.tmp",
+    fp.file_name().unwrap_or_default().to_string_lossy()
+  ));
+  let res = obj.generate_html().and_then(|html| {
+    let write = || -> std::io::Result<()> {
+      if let Some(parent) = fp.parent() {
+        fs::create_dir_all(parent)?;
+      }
+      let mut file = fs::File::create(&tmp_fp)?;
+      file.write_all(html.as_bytes())?;
+      file.sync_all()?;
+      drop(file);
+      fs::rename(&tmp_fp, fp)
+    };
+    write().map_err(|e| {
+      _ = fs::remove_file(&tmp_fp);
+      e.to_string()
+    })
+  });
+  match res {
+    Ok(()) => true,
+    Err(msg) => {
+      qstring_set(err, &msg);
+      false
+    }
+  }
+}
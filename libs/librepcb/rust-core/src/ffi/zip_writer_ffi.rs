@@ -2,9 +2,21 @@
 //! [`zip::ZipWriter`](https://docs.rs/zip/0.6.6/zip/write/struct.ZipWriter.html)
 
 use super::cpp_ffi::*;
+use std::collections::VecDeque;
 use std::fs;
 use std::fs::File;
-use std::io::Write;
+use std::io::{Cursor, Seek, Write};
+use std::sync::mpsc::{channel, Receiver, Sender};
+use std::sync::{Arc, Mutex};
+use std::thread::JoinHandle;
+use zip::result::ZipResult;
+use zip::write::FileOptions;
+use zip::CompressionMethod;
+
+/// Files smaller than this (in bytes) are stored without compression
+///
+/// For such small files, the compression overhead is larger than the gain.
+const MIN_DEFLATE_SIZE: usize = 64;
 
 /// Proxy type for in-memory and file-based
 /// [`zip::ZipWriter`](https://docs.rs/zip/0.6.6/zip/write/struct.ZipWriter.html)
@@ -15,8 +27,213 @@ enum Writer {
   Mem(zip::ZipWriter<QByteArrayWriter>),
 }
 
+/// A job to be executed by the [WorkerPool]
+type Job = Box<dyn FnOnce() + Send>;
+
+/// A fixed-size pool of worker threads
+///
+/// The threads are spawned lazily, i.e. only as many threads as needed (but
+/// at most `max_workers`) are created. They are reused for all jobs and
+/// joined when the pool is dropped.
+struct WorkerPool {
+  /// Queue of jobs, shared by all workers
+  receiver: Arc<Mutex<Receiver<Job>>>,
+  /// Sender of the queue, [None] only while dropping
+  sender: Option<Sender<Job>>,
+  /// All spawned worker threads
+  workers: Vec<JoinHandle<()>>,
+  /// Maximum number of worker threads
+  max_workers: usize,
+}
+
+impl WorkerPool {
+  fn new(max_workers: usize) -> Self {
+    let (sender, receiver) = channel::<Job>();
+    WorkerPool {
+      receiver: Arc::new(Mutex::new(receiver)),
+      sender: Some(sender),
+      workers: Vec::new(),
+      max_workers: max_workers.max(1),
+    }
+  }
+
+  /// Queue a job, spawning a new worker thread if the limit is not reached
+  fn execute<F: FnOnce() + Send + 'static>(&mut self, job: F) {
+    if self.workers.len() < self.max_workers {
+      let receiver = self.receiver.clone();
+      self.workers.push(std::thread::spawn(move || loop {
+        // Note: The lock is released before the job gets executed.
+        let job = receiver.lock().unwrap().recv();
+        match job {
+          // A panicking job must not kill the worker.
+          Ok(job) => {
+            _ = std::panic::catch_unwind(std::panic::AssertUnwindSafe(job))
+          }
+          Err(_) => break, // Pool dropped.
+        }
+      }));
+    }
+    if let Some(sender) = &self.sender {
+      _ = sender.send(Box::new(job));
+    }
+  }
+}
+
+impl Drop for WorkerPool {
+  fn drop(&mut self) {
+    drop(self.sender.take()); // Let the workers leave their loop.
+    for worker in self.workers.drain(..) {
+      _ = worker.join();
+    }
+  }
+}
+
+/// A file being compressed, or already compressed, for the [ZipWriter]
+///
+/// The compressed file is a complete in-memory Zip archive containing only
+/// this single file. It gets raw-copied into the output archive, i.e. without
+/// decompressing and compressing it again.
+enum PendingFile {
+  /// File not compressed in a worker thread (e.g. because it is tiny)
+  Ready(ZipResult<Vec<u8>>),
+  /// File being compressed in the [WorkerPool]
+  Running(Receiver<ZipResult<Vec<u8>>>),
+}
+
 /// Wrapper type for [Writer]
-struct ZipWriter(Writer);
+///
+/// Files are compressed in parallel in a [WorkerPool], but are written to
+/// the archive strictly in the order they were added. Since each file is
+/// compressed independently, the resulting archive does not depend on the
+/// thread scheduling, i.e. it is byte-identical to a serially written one.
+struct ZipWriter {
+  /// The output archive
+  writer: Writer,
+  /// Options used for all files, determines the modification time
+  options: FileOptions,
+  /// Files not written to the archive yet, in the order they were added
+  pending: VecDeque<PendingFile>,
+  /// Maximum number of files being compressed at the same time
+  max_pending: usize,
+  /// Worker threads used for compressing files
+  pool: WorkerPool,
+}
+
+impl ZipWriter {
+  fn new(writer: Writer) -> Self {
+    Self::with_options(writer, FileOptions::default())
+  }
+
+  fn with_options(writer: Writer, options: FileOptions) -> Self {
+    let max_pending =
+      std::thread::available_parallelism().map_or(1, |n| n.get());
+    ZipWriter {
+      writer,
+      options,
+      pending: VecDeque::new(),
+      max_pending,
+      pool: WorkerPool::new(max_pending),
+    }
+  }
+
+  /// Add a file, blocking only if too many files are pending
+  fn add_file(
+    &mut self,
+    name: String,
+    data: Vec<u8>,
+    mode: u32,
+  ) -> ZipResult<()> {
+    let options = self.options.unix_permissions(mode);
+    let file = if data.len() < MIN_DEFLATE_SIZE {
+      PendingFile::Ready(compress_file(&name, &data, options))
+    } else {
+      let (sender, receiver) = channel();
+      self.pool.execute(move || {
+        _ = sender.send(compress_file(&name, &data, options));
+      });
+      PendingFile::Running(receiver)
+    };
+    self.pending.push_back(file);
+    while self.pending.len() > self.max_pending {
+      self.write_next_pending()?;
+    }
+    Ok(())
+  }
+
+  /// Write all pending files and finish the archive
+  fn finish(&mut self) -> ZipResult<()> {
+    while !self.pending.is_empty() {
+      self.write_next_pending()?;
+    }
+    match &mut self.writer {
+      Writer::File(zip) => zip.finish().map(|_| ()),
+      Writer::Mem(zip) => zip.finish().map(|_| ()),
+    }
+  }
+
+  /// Wait for the oldest pending file and write it to the archive
+  fn write_next_pending(&mut self) -> ZipResult<()> {
+    let compressed = match self.pending.pop_front() {
+      Some(PendingFile::Ready(res)) => res?,
+      Some(PendingFile::Running(receiver)) => match receiver.recv() {
+        Ok(res) => res?,
+        Err(_) => {
+          return Err(
+            std::io::Error::other("Zip compression thread panicked").into(),
+          )
+        }
+      },
+      None => return Ok(()),
+    };
+    match &mut self.writer {
+      Writer::File(zip) => raw_copy_file(zip, compressed),
+      Writer::Mem(zip) => raw_copy_file(zip, compressed),
+    }
+  }
+}
+
+/// Compress a file into a single-file in-memory Zip archive
+///
+/// Tiny files and files which don't get smaller by compression (e.g. images
+/// or already compressed archives) are stored uncompressed.
+fn compress_file(
+  name: &str,
+  data: &[u8],
+  options: FileOptions,
+) -> ZipResult<Vec<u8>> {
+  if data.len() >= MIN_DEFLATE_SIZE {
+    let compressed =
+      write_single_file(name, data, options, CompressionMethod::Deflated)?;
+    let mut archive = zip::ZipArchive::new(Cursor::new(&compressed))?;
+    if archive.by_index_raw(0)?.compressed_size() < data.len() as u64 {
+      return Ok(compressed);
+    }
+  }
+  write_single_file(name, data, options, CompressionMethod::Stored)
+}
+
+/// Write a file into a new in-memory Zip archive
+fn write_single_file(
+  name: &str,
+  data: &[u8],
+  options: FileOptions,
+  method: CompressionMethod,
+) -> ZipResult<Vec<u8>> {
+  let mut zip = zip::ZipWriter::new(Cursor::new(Vec::new()));
+  zip.start_file(name, options.compression_method(method))?;
+  zip.write_all(data)?;
+  Ok(zip.finish()?.into_inner())
+}
+
+/// Copy the file of a single-file in-memory Zip archive into another archive
+fn raw_copy_file<W: Write + Seek>(
+  zip: &mut zip::ZipWriter<W>,
+  compressed: Vec<u8>,
+) -> ZipResult<()> {
+  let mut archive = zip::ZipArchive::new(Cursor::new(compressed))?;
+  let file = archive.by_index_raw(0)?;
+  zip.raw_copy_file(file)
+}
 
 /// Create a new [ZipWriter] object writing to a file
 #[no_mangle]
@@ -39,7 +256,7 @@ extern "C" fn ffi_zipwriter_new_to_file(
     }
   };
   let zip = zip::ZipWriter::new(file);
-  Box::into_raw(Box::new(ZipWriter(Writer::File(zip))))
+  Box::into_raw(Box::new(ZipWriter::new(Writer::File(zip))))
 }
 
 /// Create a new [ZipWriter] object writing to memory
@@ -49,7 +266,7 @@ extern "C" fn ffi_zipwriter_new_to_mem(
 ) -> *mut ZipWriter {
   let writer = QByteArrayWriter::new(data);
   let zip = zip::ZipWriter::new(writer);
-  Box::into_raw(Box::new(ZipWriter(Writer::Mem(zip))))
+  Box::into_raw(Box::new(ZipWriter::new(Writer::Mem(zip))))
 }
 
 /// Delete [ZipWriter] object
@@ -60,6 +277,9 @@ extern "C" fn ffi_zipwriter_delete(obj: *mut ZipWriter) {
 }
 
 /// Write a file to [ZipWriter]
+///
+/// The file is compressed asynchronously, thus errors might also be reported
+/// by subsequent calls or by [ffi_zipwriter_finish].
 #[no_mangle]
 extern "C" fn ffi_zipwriter_write_file(
   obj: &mut ZipWriter,
@@ -68,22 +288,8 @@ extern "C" fn ffi_zipwriter_write_file(
   mode: u32,
   err: &mut QString,
 ) -> bool {
-  let options = zip::write::FileOptions::default()
-    .compression_method(zip::CompressionMethod::Deflated)
-    .unix_permissions(mode);
-  let start_res = match &mut obj.0 {
-    Writer::File(zip) => zip.start_file(from_qstring(name), options),
-    Writer::Mem(zip) => zip.start_file(from_qstring(name), options),
-  };
-  if let Err(e) = start_res {
-    qstring_set(err, e.to_string().as_str());
-    return false;
-  }
-  let write_res = match &mut obj.0 {
-    Writer::File(zip) => zip.write_all(qbytearray_to_slice(data)),
-    Writer::Mem(zip) => zip.write_all(qbytearray_to_slice(data)),
-  };
-  if let Err(e) = write_res {
+  let data = qbytearray_to_slice(data).to_vec();
+  if let Err(e) = obj.add_file(from_qstring(name), data, mode) {
     qstring_set(err, e.to_string().as_str());
     return false;
   }
@@ -96,13 +302,45 @@ extern "C" fn ffi_zipwriter_finish(
   obj: &mut ZipWriter,
   err: &mut QString,
 ) -> bool {
-  let res = match &mut obj.0 {
-    Writer::File(zip) => zip.finish().err(),
-    Writer::Mem(zip) => zip.finish().err(),
-  };
-  if let Some(e) = res {
+  if let Err(e) = obj.finish() {
     qstring_set(err, e.to_string().as_str());
     return false;
   }
   true
 }
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn write_archive(fp: &std::path::Path) -> Vec<u8> {
+    // Fixed timestamp to make the output reproducible.
+    let options =
+      FileOptions::default().last_modified_time(zip::DateTime::default());
+    let zip = zip::ZipWriter::new(File::create(fp).unwrap());
+    let mut writer = ZipWriter::with_options(Writer::File(zip), options);
+    for i in 0..100 {
+      let data = match i % 3 {
+        0 => i.to_string().into_bytes(),
+        1 => vec![b'x'; 10000 + i],
+        _ => (0..(10000 + i)).map(|j| (j * 7919 % 251) as u8).collect(),
+      };
+      writer.add_file(format!("file {}", i), data, 0o644).unwrap();
+    }
+    writer.finish().unwrap();
+    drop(writer);
+    fs::read(fp).unwrap()
+  }
+
+  #[test]
+  fn test_output_is_reproducible() {
+    let dir = std::env::temp_dir()
+      .join(format!("librepcb-zip-writer-test-{}", std::process::id()));
+    fs::create_dir_all(&dir).unwrap();
+    let first = write_archive(&dir.join("1.zip"));
+    let second = write_archive(&dir.join("2.zip"));
+    _ = fs::remove_dir_all(&dir);
+    assert!(!first.is_empty());
+    assert!(first == second);
+  }
+}
@@ -34,6 +34,63 @@ pub fn increment_number_in_string(s: &str) -> String {
   ret + "1"
 }
 
+/// Format a length in nanometers as a string in millimeters
+///
+/// Same format as `Length::toMmString()` in C++, except that integers are
+/// formatted without decimal places (e.g. "1" instead of "1.0"), as done
+/// for SVG paths.
+///
+/// # Arguments
+///
+/// * `nm` - The length in nanometers.
+///
+/// # Returns
+///
+/// Returns the formatted length.
+pub fn format_nm_as_mm(nm: i64) -> String {
+  let abs = nm.unsigned_abs();
+  let mut s = String::new();
+  if nm < 0 {
+    s.push('-');
+  }
+  s.push_str(&(abs / 1_000_000).to_string());
+  let frac = abs % 1_000_000;
+  if frac != 0 {
+    s.push('.');
+    s.push_str(format!("{:06}", frac).trim_end_matches('0'));
+  }
+  s
+}
+
+/// Build an SVG path from a polyline
+///
+/// Same format as `Path::toSvgPathMm()` in C++ for paths without arcs,
+/// but without converting the coordinates to a string in C++ first.
+///
+/// # Arguments
+///
+/// * `points` - The vertices with X/Y coordinates in nanometers.
+///
+/// # Returns
+///
+/// Returns the SVG path with coordinates in millimeters.
+pub fn svg_path_from_polyline<I>(points: I) -> String
+where
+  I: IntoIterator<Item = (i64, i64)>,
+{
+  let mut s = String::new();
+  for (i, (x, y)) in points.into_iter().enumerate() {
+    if i > 0 {
+      s.push(' ');
+    }
+    s.push_str(if i == 0 { "M " } else { "L " });
+    s.push_str(&format_nm_as_mm(x));
+    s.push(' ');
+    s.push_str(&format_nm_as_mm(y));
+  }
+  s
+}
+
 #[cfg(test)]
 mod tests {
   use super::*;
@@ -55,4 +112,28 @@ mod tests {
     d11: ("12 foo 34 bar 56 ",       "12 foo 34 bar 57 "),
     d12: ("99A",                     "100A"),
   }
+
+  #[test]
+  fn test_format_nm_as_mm() {
+    assert_eq!(format_nm_as_mm(0), "0");
+    assert_eq!(format_nm_as_mm(1), "0.000001");
+    assert_eq!(format_nm_as_mm(-1), "-0.000001");
+    assert_eq!(format_nm_as_mm(1_000_000), "1");
+    assert_eq!(format_nm_as_mm(-2_500_000), "-2.5");
+    assert_eq!(format_nm_as_mm(123_456_789), "123.456789");
+    assert_eq!(format_nm_as_mm(i64::MIN), "-9223372036854.775808");
+  }
+
+  #[test]
+  fn test_svg_path_from_polyline() {
+    assert_eq!(svg_path_from_polyline(vec![]), "");
+    assert_eq!(
+      svg_path_from_polyline(vec![(1_000_000, -500_000)]),
+      "M 1 -0.5"
+    );
+    assert_eq!(
+      svg_path_from_polyline(vec![(0, 0), (1_000_000, 0), (0, 2_250_000)]),
+      "M 0 0 L 1 0 L 0 2.25"
+    );
+  }
 }
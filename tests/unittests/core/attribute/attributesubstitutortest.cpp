@@ -72,6 +72,37 @@ TEST_P(AttributeSubstitutorTest, testData) {
       << "Actual value: '" << qPrintable(output) << "'";
 }
 
+TEST(AttributeSubstitutorDependenciesTest, testLiteral) {
+  AttributeSubstitutor::Dependencies deps = {{"FOO", "bar"}};
+  EXPECT_FALSE(AttributeSubstitutor::containsVariables("Hello { World! }}"));
+  EXPECT_EQ("Hello { World! }}",
+            AttributeSubstitutor::substitute("Hello { World! }}", &lookup,
+                                             nullptr, &deps));
+  EXPECT_TRUE(deps.isEmpty());
+  EXPECT_FALSE(AttributeSubstitutor::dependenciesChanged(deps, &lookup));
+}
+
+TEST(AttributeSubstitutorDependenciesTest, testNestedKeys) {
+  AttributeSubstitutor::Dependencies deps;
+  EXPECT_TRUE(AttributeSubstitutor::containsVariables("{{FOO or KEY_5}}"));
+  EXPECT_EQ("Recursive Recursive Normal value value value",
+            AttributeSubstitutor::substitute("{{FOO or KEY_5}}", &lookup,
+                                             nullptr, &deps));
+  AttributeSubstitutor::Dependencies expected = {
+      {"FOO", ""},
+      {"KEY_5", "Recursive {{KEY_4}} value"},
+      {"KEY_4", "Recursive {{KEY_1}} value"},
+      {"KEY_1", "Normal value"},
+  };
+  EXPECT_EQ(expected, deps);
+  EXPECT_FALSE(AttributeSubstitutor::dependenciesChanged(deps, &lookup));
+
+  auto modifiedLookup = [](const QString& key) {
+    return (key == "KEY_1") ? QString("Modified") : lookup(key);
+  };
+  EXPECT_TRUE(AttributeSubstitutor::dependenciesChanged(deps, modifiedLookup));
+}
+
 /*******************************************************************************
  *  Test Data
  ******************************************************************************/
@@ -23,6 +23,7 @@
 
 #include <gtest/gtest.h>
 #include <librepcb/core/export/interactivehtmlbom.h>
+#include <librepcb/core/fileio/fileutils.h>
 
 #include <QtCore>
 
@@ -98,25 +99,50 @@ TEST_F(InteractiveHtmlBomTest, testGenerateHtml) {
       Path::centeredRect(PositiveLength(100000), PositiveLength(100000)),
       UnsignedLength(0), true);
 
-  ibom.addTrack(InteractiveHtmlBom::Layer::Top, Point(0, 0),
-                Point(100000, 100000), PositiveLength(100000), std::nullopt);
-  ibom.addTrack(InteractiveHtmlBom::Layer::Bottom, Point(0, 0),
-                Point(100000, 100000), PositiveLength(100000), QString("net"));
-
-  ibom.addVia({InteractiveHtmlBom::Layer::Top}, Point(0, 0),
-              PositiveLength(2000000), PositiveLength(1000000), std::nullopt);
-  ibom.addVia(
-      {InteractiveHtmlBom::Layer::Top, InteractiveHtmlBom::Layer::Bottom},
-      Point(100, 200), PositiveLength(2000000), PositiveLength(1000000),
+  ibom.addTracks(InteractiveHtmlBom::Layer::Top,
+                 {
+                     InteractiveHtmlBom::Track{Point(0, 0),
+                                               Point(100000, 100000),
+                                               PositiveLength(100000)},
+                 },
+                 std::nullopt);
+  ibom.addTracks(InteractiveHtmlBom::Layer::Bottom,
+                 {
+                     InteractiveHtmlBom::Track{Point(0, 0),
+                                               Point(100000, 100000),
+                                               PositiveLength(100000)},
+                     InteractiveHtmlBom::Track{Point(100000, 100000),
+                                               Point(200000, 0),
+                                               PositiveLength(200000)},
+                 },
+                 QString("net"));
+  ibom.addTracks(InteractiveHtmlBom::Layer::Top, {}, std::nullopt);
+
+  ibom.addVias(
+      {
+          InteractiveHtmlBom::Via{true, false, Point(0, 0),
+                                  PositiveLength(2000000),
+                                  PositiveLength(1000000)},
+      },
+      std::nullopt);
+  ibom.addVias(
+      {
+          InteractiveHtmlBom::Via{true, true, Point(100, 200),
+                                  PositiveLength(2000000),
+                                  PositiveLength(1000000)},
+      },
       QString("net"));
 
-  ibom.addPlaneFragment(
+  ibom.addPlaneFragments(
       InteractiveHtmlBom::Layer::Top,
-      Path::centeredRect(PositiveLength(100000), PositiveLength(100000)),
+      {Path::centeredRect(PositiveLength(100000), PositiveLength(100000))},
       std::nullopt);
-  ibom.addPlaneFragment(
+  ibom.addPlaneFragments(
       InteractiveHtmlBom::Layer::Bottom,
-      Path::centeredRect(PositiveLength(100000), PositiveLength(100000)),
+      {
+          Path::centeredRect(PositiveLength(100000), PositiveLength(100000)),
+          Path::circle(PositiveLength(100000)),
+      },
       QString("net"));
 
   const std::size_t id0 = ibom.addFootprint(
@@ -142,6 +168,28 @@ TEST_F(InteractiveHtmlBomTest, testGenerateHtml) {
   EXPECT_TRUE(html.contains("<html"));
 }
 
+TEST_F(InteractiveHtmlBomTest, testWriteHtml) {
+  InteractiveHtmlBom ibom("title", "company", "rev", "date", Point(0, 0),
+                          Point(100000, 100000));
+  ibom.addTracks(InteractiveHtmlBom::Layer::Top,
+                 {
+                     InteractiveHtmlBom::Track{Point(0, 0),
+                                               Point(100000, 100000),
+                                               PositiveLength(100000)},
+                 },
+                 QString("net"));
+
+  const FilePath dir = FilePath::getRandomTempPath();
+  const FilePath fp = dir.getPathTo("sub dir/ibom.html");
+  ibom.writeHtml(fp);
+  const QByteArray content = FileUtils::readFile(fp);
+  const bool tmpFileExists =
+      fp.getParentDir().getPathTo("ibom.html.tmp").isExistingFile();
+  FileUtils::removeDirRecursively(dir);
+  EXPECT_EQ(ibom.generateHtml().toUtf8(), content);
+  EXPECT_FALSE(tmpFileExists);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
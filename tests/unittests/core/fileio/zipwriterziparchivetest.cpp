@@ -113,6 +113,38 @@ TEST_F(ZipWriterZipArchiveTest, testWriteReadLargeFile) {
   EXPECT_EQ(arr, readback);
 }
 
+TEST_F(ZipWriterZipArchiveTest, testWriteReadManyFiles) {
+  // Mix of tiny, compressible and incompressible files, more than there are
+  // worker threads to make sure the order is kept.
+  QRandomGenerator rng(42);
+  QList<QByteArray> files;
+  for (int i = 0; i < 100; ++i) {
+    QByteArray data;
+    if (i % 3 == 0) {
+      data = QByteArray::number(i);
+    } else if (i % 3 == 1) {
+      data = QByteArray(10000 + i, 'x');
+    } else {
+      data.resize(10000 + i);
+      rng.fillRange(reinterpret_cast<quint32*>(data.data()), data.size() / 4);
+    }
+    files.append(data);
+  }
+
+  ZipWriter w(mZipFilePath);
+  for (int i = 0; i < files.count(); ++i) {
+    w.writeFile(QString("file %1").arg(i), files.at(i), 0644);
+  }
+  w.finish();
+
+  ZipArchive a(mZipFilePath);
+  ASSERT_EQ(static_cast<std::size_t>(files.count()), a.getEntriesCount());
+  for (std::size_t i = 0; i < a.getEntriesCount(); ++i) {
+    EXPECT_EQ(QString("file %1").arg(i), a.getFileName(i));
+    EXPECT_EQ(files.at(i), a.readFile(i));
+  }
+}
+
 TEST_F(ZipWriterZipArchiveTest, testExtractTo) {
   ZipWriter w(mZipFilePath);
   w.writeFile("test dir/file 1", "a", 0644);
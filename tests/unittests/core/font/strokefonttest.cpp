@@ -0,0 +1,150 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/font/strokefont.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+#include <chrono>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontTest : public ::testing::Test {
+protected:
+  static std::unique_ptr<StrokeFont> loadFont() {
+    const FilePath fp = Application::getResourcesDir().getPathTo(
+        "fontobene/" % Application::getDefaultStrokeFontName());
+    return std::make_unique<StrokeFont>(fp, FileUtils::readFile(fp));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontTest, testCachedGlyphsAreEqual) {
+  const QString text = "R1 C42\nU1001 µΩ";
+  const PositiveLength h1(1000000);
+  const PositiveLength h2(1500000);
+
+  // Stroke with a fresh font (nothing cached yet).
+  Point bottomLeft1, topRight1;
+  const QVector<Path> paths1 =
+      loadFont()->stroke(text, h1, Length(100000), Length(1500000),
+                         Alignment(), bottomLeft1, topRight1);
+  EXPECT_FALSE(paths1.isEmpty());
+
+  // Stroke with another height in between, then again with the first height.
+  std::unique_ptr<StrokeFont> font = loadFont();
+  Point bottomLeft, topRight;
+  for (const PositiveLength& h : {h1, h2, h1}) {
+    font->stroke(text, h, Length(100000), Length(1500000), Alignment(),
+                 bottomLeft, topRight);
+  }
+  EXPECT_EQ(paths1, font->stroke(text, h1, Length(100000), Length(1500000),
+                                 Alignment(), bottomLeft, topRight));
+  EXPECT_EQ(bottomLeft1, bottomLeft);
+  EXPECT_EQ(topRight1, topRight);
+}
+
+TEST_F(StrokeFontTest, testConcurrentStroking) {
+  std::unique_ptr<StrokeFont> font = loadFont();
+  Length width;
+  const QVector<Path> expected =
+      font->strokeLine("ABCDEFGHIJ", PositiveLength(800000), Length(0), width);
+
+  QList<QFuture<QVector<Path>>> futures;
+  for (int i = 0; i < 8; ++i) {
+    futures.append(QtConcurrent::run([&font]() {
+      Length w;
+      return font->strokeLine("ABCDEFGHIJ", PositiveLength(800000), Length(0),
+                              w);
+    }));
+  }
+  for (QFuture<QVector<Path>>& future : futures) {
+    EXPECT_EQ(expected, future.result());
+  }
+}
+
+TEST_F(StrokeFontTest, testEvictedGlyphsAreEqual) {
+  const QString text = "0123456789";
+  const PositiveLength h1(1000000);
+  std::unique_ptr<StrokeFont> font = loadFont();
+  Length width;
+  const QVector<Path> expected = font->strokeLine(text, h1, Length(0), width);
+
+  // Stroke with so many different heights that the cache limit is exceeded
+  // and the glyphs of the first height get evicted.
+  for (int i = 1; i <= 2000; ++i) {
+    Length w;
+    font->strokeLine(text, PositiveLength(h1->toNm() + i), Length(0), w);
+  }
+  Length width2;
+  EXPECT_EQ(expected, font->strokeLine(text, h1, Length(0), width2));
+  EXPECT_EQ(width, width2);
+}
+
+// For testing performance of stroking cached glyphs.
+TEST_F(StrokeFontTest, testStrokingPerformance) {
+  QString text;
+  for (int i = 0; i < 100; ++i) {
+    text += QString("R%1 C%2 U%3\n").arg(i).arg(i * 7).arg(i * 13);
+  }
+  std::unique_ptr<StrokeFont> font = loadFont();
+  auto stroke = [&font, &text]() {
+    Point bottomLeft, topRight;
+    const std::chrono::time_point<std::chrono::high_resolution_clock> start =
+        std::chrono::high_resolution_clock::now();
+    const QVector<Path> paths =
+        font->stroke(text, PositiveLength(1000000), Length(100000),
+                     Length(1500000), Alignment(), bottomLeft, topRight);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+    return std::make_pair(paths, elapsed.count() * 1000);
+  };
+  const auto uncached = stroke();
+  const auto cached = stroke();
+  std::cout << "Stroked " << text.length() << " characters in "
+            << uncached.second << " ms (uncached) resp. " << cached.second
+            << " ms (cached)\n";
+  EXPECT_FALSE(uncached.first.isEmpty());
+  EXPECT_EQ(uncached.first, cached.first);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -415,6 +415,35 @@ TEST_F(PathTest, testOperatorCompareLess) {
               Path({Vertex(Point(0, 0), Angle::deg90())}));
 }
 
+TEST_F(PathTest, testToQPainterPathPx) {
+  Path path({
+      Vertex(Point(0, 0), Angle::deg0()),
+      Vertex(Point(1000000, 0), Angle::deg90()),
+      Vertex(Point(1000000, 1000000), Angle::deg0()),
+  });
+  const QPainterPath& pathPx = path.toQPainterPathPx();
+  EXPECT_GT(pathPx.elementCount(), 3);  // Arc consists of multiple curves.
+  EXPECT_EQ(path.toQPainterPathPx(), Path(path).toQPainterPathPx());
+  const QPainterPath unitedPx = Path::toQPainterPathPx({path}, false);
+  EXPECT_EQ(pathPx.elementCount(), unitedPx.elementCount());
+  EXPECT_EQ(pathPx.boundingRect(), unitedPx.boundingRect());
+}
+
+TEST_F(PathTest, testToQPainterPathPxAfterModification) {
+  Path path({Vertex(Point(0, 0)), Vertex(Point(1000000, 0))});
+  const QPainterPath before = path.toQPainterPathPx();
+  path.addVertex(Point(1000000, 1000000));
+  const QPainterPath after = path.toQPainterPathPx();
+  EXPECT_EQ(2, before.elementCount());
+  EXPECT_EQ(3, after.elementCount());
+  EXPECT_EQ(3, Path::toQPainterPathPx({path}, false).elementCount());
+
+  Path copy({Vertex(Point(5, 5)), Vertex(Point(6, 6))});
+  EXPECT_EQ(2, copy.toQPainterPathPx().elementCount());
+  copy = path;
+  EXPECT_EQ(after, copy.toQPainterPathPx());
+}
+
 TEST_F(PathTest, testLine) {
   Point p1(Length(12), Length(34));
   Point p2(Length(56), Length(78));
@@ -49,6 +49,31 @@ protected:
     FileUtils::removeFile(fp);
   }
 
+  /**
+   * @brief Helper to call reader.parse() in streaming mode
+   */
+  void parse(const QByteArray& dxf, const DxfReader::Callbacks& callbacks) {
+    FilePath fp = FilePath::getRandomTempPath();
+    FileUtils::writeFile(fp, dxf);
+    reader.parse(fp, callbacks);
+    FileUtils::removeFile(fp);
+  }
+
+  /**
+   * @brief Some lines on different layers, 3 of them forming a triangle
+   */
+  static QByteArray linesOnLayers() {
+    return "0\nSECTION\n"
+           "2\nENTITIES\n"
+           "0\nLINE\n8\nA\n10\n0.0\n20\n0.0\n11\n1.0\n21\n0.0\n"
+           "0\nLINE\n8\nB\n10\n5.0\n20\n5.0\n11\n6.0\n21\n6.0\n"
+           "0\nLINE\n8\nA\n10\n0.0\n20\n1.0\n11\n0.0\n21\n0.0\n"
+           "0\nLINE\n8\nA\n10\n0.0\n20\n1.0\n11\n1.0\n21\n0.0\n"
+           "0\nCIRCLE\n8\nB\n10\n5.0\n20\n5.0\n40\n1.0\n"
+           "0\nENDSEC\n"
+           "0\nEOF\n";
+  }
+
   /**
    * @brief Helper to easily compare objects as strings for easier debugging
    */
@@ -524,6 +549,57 @@ TEST_F(DxfReaderTest, testLwPolylineClosed) {
   EXPECT_EQ(str(expected), str(reader.getPolygons().first()));
 }
 
+TEST_F(DxfReaderTest, testStreamingDoesNotStoreObjects) {
+  int polygons = 0;
+  int circles = 0;
+  int lastProgress = -1;
+  DxfReader::Callbacks callbacks;
+  callbacks.polygon = [&](const Path&) { ++polygons; };
+  callbacks.circle = [&](const DxfReader::Circle&) { ++circles; };
+  callbacks.progress = [&](int percent) { lastProgress = percent; };
+  parse(linesOnLayers(), callbacks);
+  EXPECT_EQ(4, polygons);
+  EXPECT_EQ(1, circles);
+  EXPECT_EQ(100, lastProgress);
+  EXPECT_EQ(0, reader.getPolygons().count());
+  EXPECT_EQ(0, reader.getCircles().count());
+}
+
+TEST_F(DxfReaderTest, testLayerFilter) {
+  reader.setLayerFilter({"B"});
+  parse(linesOnLayers());
+  ASSERT_EQ(1, reader.getPolygons().count());
+  ASSERT_EQ(1, reader.getCircles().count());
+  EXPECT_EQ(str(Path::line(Point(5000000, 5000000), Point(6000000, 6000000))),
+            str(reader.getPolygons().first()));
+}
+
+TEST_F(DxfReaderTest, testBoundingBoxFilter) {
+  reader.setBoundingBoxFilter(
+      std::make_pair(Point(-100, -100), Point(2000000, 500000)));
+  parse(linesOnLayers());
+  EXPECT_EQ(3, reader.getPolygons().count());  // Line on layer B is outside.
+  EXPECT_EQ(0, reader.getCircles().count());
+}
+
+TEST_F(DxfReaderTest, testJoinPaths) {
+  reader.setJoinPaths(true);
+  parse(linesOnLayers());
+  ASSERT_EQ(2, reader.getPolygons().count());
+  ASSERT_EQ(1, reader.getCircles().count());
+
+  // Closed triangle is emitted first, the remaining open line at the end.
+  Path expected({
+      Vertex(Point(0, 1000000), Angle(0)),
+      Vertex(Point(1000000, 0), Angle(0)),
+      Vertex(Point(0, 0), Angle(0)),
+      Vertex(Point(0, 1000000), Angle(0)),
+  });
+  EXPECT_EQ(str(expected), str(reader.getPolygons().at(0)));
+  EXPECT_EQ(str(Path::line(Point(5000000, 5000000), Point(6000000, 6000000))),
+            str(reader.getPolygons().at(1)));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
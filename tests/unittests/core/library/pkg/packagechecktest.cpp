@@ -0,0 +1,186 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/library/pkg/packagecheck.h>
+#include <librepcb/core/library/pkg/packagecheckmessages.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+#include <chrono>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PackageCheckTest : public ::testing::Test {
+protected:
+  static std::shared_ptr<Footprint> loadFootprint(const QString& fileName) {
+    const FilePath fp = FilePath(UNITTESTS_SOURCE_DIR "/core/library/pkg")
+                            .getPathTo(fileName);
+    const std::unique_ptr<const SExpression> root =
+        SExpression::parse(FileUtils::readFile(fp), fp);
+    return std::make_shared<Footprint>(*root);
+  }
+
+  static std::shared_ptr<const FootprintPad> getPadAt(
+      const Footprint& footprint, const Point& pos) {
+    for (const auto& pad : footprint.getPads()) {
+      if (pad.getPosition() == pos) {
+        return footprint.getPads().find(pad.getUuid());
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename T>
+  static QList<std::shared_ptr<const T>> getMessages(
+      const RuleCheckMessageList& msgs) {
+    QList<std::shared_ptr<const T>> result;
+    for (const auto& msg : msgs) {
+      if (auto m = std::dynamic_pointer_cast<const T>(msg)) {
+        result.append(m);
+      }
+    }
+    return result;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PackageCheckTest, testPadClearancesOfLargeGrid) {
+  Package pkg(Uuid::createRandom(), Version::fromString("0.1"), "",
+              ElementName("BGA"), "", "", Package::AssemblyType::Smt);
+
+  // A BGA with 50x50 pads (1mm pitch, 0.5mm diameter) without violations,
+  // plus a pad overlapping with one pad of the grid, a pad between 4 grid
+  // pads violating the clearance to each of them, and a legend line touching
+  // only one pad of the grid.
+  std::shared_ptr<Footprint> footprint =
+      loadFootprint("packagechecktest_bga2502.lp");
+  ASSERT_EQ(2502, footprint->getPads().count());
+  pkg.getFootprints().append(footprint);
+  auto grid = [&footprint](int x, int y) {
+    return getPadAt(*footprint, Point(x * 1000000, y * 1000000));
+  };
+  const auto overlappingPad = getPadAt(*footprint, Point(10200000, 10000000));
+  const auto clearancePad = getPadAt(*footprint, Point(20500000, 20500000));
+
+  const std::chrono::time_point<std::chrono::high_resolution_clock> start =
+      std::chrono::high_resolution_clock::now();
+  const RuleCheckMessageList msgs = pkg.runChecks();
+  const std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  std::cout << "Checked " << footprint->getPads().count() << " pads in "
+            << (elapsed.count() * 1000) << " ms\n";
+
+  const auto overlaps = getMessages<MsgOverlappingPads>(msgs);
+  ASSERT_EQ(1, overlaps.count());
+  EXPECT_EQ(grid(10, 10), overlaps.at(0)->getPad1());
+  EXPECT_EQ(overlappingPad, overlaps.at(0)->getPad2());
+
+  const auto clearances = getMessages<MsgPadClearanceViolation>(msgs);
+  ASSERT_EQ(4, clearances.count());
+  EXPECT_EQ(grid(20, 20), clearances.at(0)->getPad1());
+  EXPECT_EQ(grid(21, 20), clearances.at(1)->getPad1());
+  EXPECT_EQ(grid(20, 21), clearances.at(2)->getPad1());
+  EXPECT_EQ(grid(21, 21), clearances.at(3)->getPad1());
+  for (const auto& msg : clearances) {
+    EXPECT_EQ(clearancePad, msg->getPad2());
+  }
+
+  const auto legend = getMessages<MsgPadOverlapsWithLegend>(msgs);
+  ASSERT_EQ(1, legend.count());
+  EXPECT_EQ(grid(40, 40), legend.at(0)->getPad());
+}
+
+TEST_F(PackageCheckTest, testAbort) {
+  Package pkg(Uuid::createRandom(), Version::fromString("0.1"), "",
+              ElementName("BGA"), "", "", Package::AssemblyType::Smt);
+  pkg.getFootprints().append(loadFootprint("packagechecktest_bga2502.lp"));
+
+  std::atomic_bool abort(true);
+  PackageCheck check(pkg);
+  check.setAbortFlag(&abort);
+  EXPECT_THROW(check.runChecks(), UserCanceled);
+
+  abort = false;
+  EXPECT_EQ(pkg.runChecks().count(), check.runChecks().count());
+}
+
+TEST_F(PackageCheckTest, testPadOutlineCache) {
+  Package pkg(Uuid::createRandom(), Version::fromString("0.1"), "",
+              ElementName("BGA"), "", "", Package::AssemblyType::Smt);
+  std::shared_ptr<Footprint> footprint =
+      loadFootprint("packagechecktest_bga2502.lp");
+  pkg.getFootprints().append(footprint);
+  auto cache = std::make_shared<PackageCheck::PadOutlineCache>();
+  auto runChecks = [&]() {
+    PackageCheck check(pkg);
+    check.setPadOutlineCache(cache);
+    return check.runChecks();
+  };
+
+  // First run fills the cache.
+  const RuleCheckMessageList msgs = runChecks();
+  ASSERT_EQ(1, getMessages<MsgOverlappingPads>(msgs).count());
+  ASSERT_EQ(1, cache->count());
+  EXPECT_EQ(2502, (*cache)[footprint->getUuid()].outlines.count());
+
+  // Unmodified footprints use the cached outlines. Clear them to prove it.
+  for (auto& outline : (*cache)[footprint->getUuid()].outlines) {
+    outline = PackageCheck::PadOutlines();
+  }
+  EXPECT_EQ(0, getMessages<MsgOverlappingPads>(runChecks()).count());
+  EXPECT_EQ(0, getMessages<MsgPadClearanceViolation>(runChecks()).count());
+  EXPECT_EQ(0, getMessages<MsgPadOverlapsWithLegend>(runChecks()).count());
+
+  // Modifying a pad invalidates the cached outlines of its footprint.
+  footprint->getPads().first()->setCopperClearance(UnsignedLength(1));
+  EXPECT_EQ(1, getMessages<MsgOverlappingPads>(runChecks()).count());
+  EXPECT_EQ(4, getMessages<MsgPadClearanceViolation>(runChecks()).count());
+  EXPECT_EQ(1, getMessages<MsgPadOverlapsWithLegend>(runChecks()).count());
+
+  // Outlines of removed footprints are removed from the cache.
+  pkg.getFootprints().clear();
+  runChecks();
+  EXPECT_EQ(0, cache->count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -86,6 +86,31 @@ TEST_F(PackageTest, testUpgradeV01) {
   { std::unique_ptr<Package> obj = Package::open(createDir()); }
 }
 
+TEST_F(PackageTest, testClone) {
+  // Copy into temporary directory.
+  const FilePath src =
+      FilePath(TEST_DATA_DIR "/libraries/v0.1.lplib/pkg").getPathTo(sUuid);
+  FileUtils::copyDirRecursively(src, mTmpDir);
+
+  // Open/upgrade and clone.
+  std::unique_ptr<Package> obj = Package::open(createDir());
+  std::unique_ptr<Package> copy = obj->clone();
+  ASSERT_NE(0, copy->getFootprints().count());
+  EXPECT_NE(obj->getFootprints().first().get(),
+            copy->getFootprints().first().get());
+
+  // Both must serialize to exactly the same content.
+  const FilePath copyDir = FilePath::getRandomTempPath().getPathTo(sUuid);
+  TransactionalDirectory dest(TransactionalFileSystem::open(copyDir, true));
+  copy->saveTo(dest);
+  dest.getFileSystem()->save();
+  obj->save();
+  obj->getDirectory().getFileSystem()->save();
+  EXPECT_EQ(FileUtils::readFile(mTmpDir.getPathTo("package.lp")).toStdString(),
+            FileUtils::readFile(copyDir.getPathTo("package.lp")).toStdString());
+  QDir(copyDir.getParentDir().toStr()).removeRecursively();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -109,6 +109,67 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testCache) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+
+  // Calculate planes without cache as reference.
+  const QHash<Uuid, QVector<Path>> expected =
+      BoardPlaneFragmentsBuilder().runAndApply(*board);  // can throw
+
+  // First run populates the cache, second run restores from the cache.
+  const FilePath cacheDir = FilePath::getRandomTempPath();
+  auto cacheFiles = [&cacheDir]() {
+    return FileUtils::getFilesInDirectory(cacheDir, {"*.lp"}).count();
+  };
+  BoardPlaneFragmentsBuilder builder;
+  builder.setCacheDirectory(cacheDir);
+  EXPECT_TRUE(expected == builder.runAndApply(*board));  // can throw
+  const int fileCount = cacheFiles();
+  EXPECT_GT(fileCount, 0);
+  EXPECT_TRUE(expected == builder.runAndApply(*board));  // can throw
+  EXPECT_EQ(fileCount, cacheFiles());
+
+  // Cache hits must skip the calculation. Prove it by replacing the cache
+  // entries with empty fragments, which must then be returned.
+  for (const FilePath& fp :
+       FileUtils::getFilesInDirectory(cacheDir, {"*.lp"})) {
+    FileUtils::writeFile(fp, "(librepcb_plane_fragments)\n");  // can throw
+  }
+  EXPECT_TRUE(builder.runAndApply(*board).isEmpty());  // can throw
+  EXPECT_EQ(fileCount, cacheFiles());
+
+  // Modifying an input must invalidate the cache entry.
+  BI_Plane* plane = board->getPlanes().first();
+  plane->setMinClearance(UnsignedLength(*plane->getMinClearance() + 100000));
+  const QHash<Uuid, QVector<Path>> modified =
+      builder.runAndApply(*board);  // can throw
+  EXPECT_FALSE(expected == modified);
+  EXPECT_EQ(fileCount + 1, cacheFiles());
+
+  // Quick rebuilds must not write new cache entries.
+  plane->setMinClearance(UnsignedLength(*plane->getMinClearance() + 100000));
+  const QSet<const Layer*> layers = {&plane->getLayer()};
+  builder.runAndApply(*board, &layers);  // can throw
+  EXPECT_EQ(fileCount + 1, cacheFiles());
+
+  // Exceeding the size limit must remove old entries.
+  builder.setCacheMaxSize(0);
+  plane->setMinClearance(UnsignedLength(*plane->getMinClearance() + 100000));
+  EXPECT_FALSE(builder.runAndApply(*board).isEmpty());  // can throw
+  EXPECT_EQ(0, cacheFiles());
+
+  FileUtils::removeDirRecursively(cacheDir);
+}
+
 TEST(BoardPlaneFragmentsBuilderTest, testManyThreads) {
   // open project from test data directory
   FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
@@ -0,0 +1,191 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/componentinstance.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/erc/electricalrulecheckdatatracker.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/project/schematic/items/si_netsegment.h>
+#include <librepcb/core/project/schematic/schematic.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ElectricalRuleCheckTest : public ::testing::Test {
+protected:
+  static std::unique_ptr<Project> openProject(const QString& name) {
+    const FilePath fp(TEST_DATA_DIR "/projects/" % name % "/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRO(fp.getParentDir());
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(fs)),
+                       fp.getFilename());  // can throw
+  }
+
+  static std::string str(const RuleCheckMessageList& messages) {
+    QStringList lines;
+    for (const auto& msg : messages) {
+      lines.append(msg->getMessage());
+      lines.append(QString::fromUtf8(msg->getApproval().toByteArray()));
+    }
+    return lines.join("\n").toStdString();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalRunEqualsFullRun) {
+  // Use the same ERC object for all projects to also test the transition
+  // from one project to a completely different one.
+  ElectricalRuleCheck incrementalErc;
+  for (const QString& name : {"Gerber Test", "DRC", "Nested Planes"}) {
+    std::cout << "- Run ERC for project '" << name.toStdString() << "'\n";
+    std::unique_ptr<Project> project = openProject(name);
+    const ElectricalRuleCheckData data(*project);
+    const RuleCheckMessageList expected = ElectricalRuleCheck().runChecks(data);
+
+    // First run with different data -> same result.
+    EXPECT_EQ(str(expected), str(incrementalErc.runChecks(data)));
+
+    // Second run with unmodified data -> nothing checked, same result.
+    EXPECT_EQ(str(expected), str(incrementalErc.runChecks(data)));
+    EXPECT_EQ(0, incrementalErc.getCheckedObjectsCount());
+  }
+}
+
+TEST_F(ElectricalRuleCheckTest, testOnlyModifiedObjectsAreChecked) {
+  std::unique_ptr<Project> project = openProject("Gerber Test");
+  ElectricalRuleCheckData data(*project);
+  ASSERT_GE(data.components.count(), 1);
+  ASSERT_GE(data.netSignals.count(), 1);
+  ElectricalRuleCheck erc;
+  erc.runChecks(data);
+
+  // Unconnect a component signal, i.e. modify a single component.
+  ElectricalRuleCheckData::Component& cmp = data.components.first();
+  ASSERT_GE(cmp.componentSignals.count(), 1);
+  cmp.componentSignals.first().required = true;
+  cmp.componentSignals.first().netName = std::nullopt;
+  const RuleCheckMessageList messages = erc.runChecks(data);
+  EXPECT_EQ(1, erc.getCheckedObjectsCount());
+  EXPECT_EQ(str(ElectricalRuleCheck().runChecks(data)), str(messages));
+
+  // Open a net, which also affects the check of its net segments.
+  const Uuid netUuid = data.netSignals.first().uuid;
+  data.netSignals.first().realComponentSignals = 0;
+  int segmentCount = 0;
+  for (const auto& schematic : data.schematics) {
+    for (const auto& segment : schematic.netSegments) {
+      if (segment.net == netUuid) {
+        ++segmentCount;
+      }
+    }
+  }
+  const RuleCheckMessageList messages2 = erc.runChecks(data);
+  EXPECT_LE(erc.getCheckedObjectsCount(), 1 + segmentCount);
+  EXPECT_EQ(str(ElectricalRuleCheck().runChecks(data)), str(messages2));
+
+  // Removed objects are not reported anymore.
+  data.components.erase(data.components.begin());
+  const RuleCheckMessageList messages3 = erc.runChecks(data);
+  EXPECT_EQ(0, erc.getCheckedObjectsCount());
+  EXPECT_EQ(str(ElectricalRuleCheck().runChecks(data)), str(messages3));
+}
+
+TEST_F(ElectricalRuleCheckTest, testTrackedSnapshotEqualsFullSnapshot) {
+  std::unique_ptr<Project> project = openProject("Gerber Test");
+  ElectricalRuleCheckDataTracker tracker(*project);
+  ElectricalRuleCheck erc;
+
+  // Compare the ERC of the tracked snapshot with a complete snapshot, which
+  // walks through the whole project like the ERC did before it was made
+  // incremental.
+  auto checkEqual = [&]() {
+    const RuleCheckMessageList actual = erc.runChecks(tracker.takeSnapshot());
+    const RuleCheckMessageList expected =
+        ElectricalRuleCheck().runChecks(ElectricalRuleCheckData(*project));
+    EXPECT_EQ(str(expected), str(actual));
+  };
+
+  // Initial snapshot.
+  checkEqual();
+  const int totalCount = tracker.getUpdatedObjectsCount();
+  EXPECT_GT(totalCount, 0);
+
+  // Unmodified project -> nothing copied.
+  checkEqual();
+  EXPECT_EQ(0, tracker.getUpdatedObjectsCount());
+
+  // Rename a net, affecting its components, symbols and net segments.
+  const Circuit& circuit = project->getCircuit();
+  ASSERT_GE(circuit.getNetSignals().count(), 1);
+  NetSignal* net = circuit.getNetSignals().first();
+  net->setName(CircuitIdentifier("RENAMED_NET"), false);
+  checkEqual();
+  EXPECT_GE(tracker.getUpdatedObjectsCount(), 1);
+  EXPECT_LT(tracker.getUpdatedObjectsCount(), totalCount);
+
+  // Rename a component, affecting only the component and its symbols.
+  ASSERT_GE(circuit.getComponentInstances().count(), 1);
+  ComponentInstance* cmp = circuit.getComponentInstances().first();
+  cmp->setName(CircuitIdentifier("RENAMED_CMP"));
+  checkEqual();
+  EXPECT_EQ(1 + cmp->getSymbols().count(), tracker.getUpdatedObjectsCount());
+
+  // Remove a net segment, which unconnects symbol pins and may open nets.
+  ASSERT_GE(project->getSchematics().count(), 1);
+  Schematic* schematic = project->getSchematics().first();
+  ASSERT_GE(schematic->getNetSegments().count(), 1);
+  SI_NetSegment* segment = schematic->getNetSegments().first();
+  schematic->removeNetSegment(*segment);
+  checkEqual();
+  EXPECT_LT(tracker.getUpdatedObjectsCount(), totalCount);
+
+  // Add it again, which also gives the ownership back to the schematic.
+  schematic->addNetSegment(*segment);
+  checkEqual();
+  EXPECT_LT(tracker.getUpdatedObjectsCount(), totalCount);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
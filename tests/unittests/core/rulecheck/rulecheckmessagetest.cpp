@@ -0,0 +1,147 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/rulecheck/rulecheckmessage.h>
+#include <librepcb/core/types/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class RuleCheckMessageTest : public ::testing::Test {
+protected:
+  class Message final : public RuleCheckMessage {
+  public:
+    Message(const QString& name, const Uuid& uuid) noexcept
+      : RuleCheckMessage(Severity::Warning, "Message", "Description", name) {
+      mApproval->ensureLineBreak();
+      mApproval->appendChild("uuid", uuid);
+      mApproval->ensureLineBreak();
+    }
+  };
+
+  static SExpression parse(const QString& str) {
+    return *SExpression::parse(str.toUtf8(), FilePath());
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(RuleCheckMessageTest, testFingerprintOfEqualApprovals) {
+  const SExpression a = parse("(approved foo (uuid \"bar\") 42)");
+  const SExpression b = parse("(approved foo (uuid \"bar\") 42)");
+  EXPECT_TRUE(RuleCheckMessage::calcFingerprint(a) ==
+              RuleCheckMessage::calcFingerprint(b));
+  EXPECT_EQ(qHash(RuleCheckMessage::calcFingerprint(a)),
+            qHash(RuleCheckMessage::calcFingerprint(b)));
+}
+
+TEST_F(RuleCheckMessageTest, testFingerprintOfDifferentApprovals) {
+  const QStringList approvals = {
+      "(approved foo)",
+      "(approved fo)",
+      "(approved \"foo\")",
+      "(approved foo bar)",
+      "(approved foob ar)",
+      "(approved foo (bar))",
+      "(approved foo (bar) (baz))",
+      "(approved (foo bar))",
+      "(approve foo)",
+  };
+  QSet<RuleCheckMessage::Fingerprint> fingerprints;
+  for (const QString& approval : approvals) {
+    fingerprints.insert(RuleCheckMessage::calcFingerprint(parse(approval)));
+  }
+  EXPECT_EQ(approvals.count(), fingerprints.count());
+}
+
+TEST_F(RuleCheckMessageTest, testFingerprintConsidersLineBreaks) {
+  // Same semantics as SExpression::operator==().
+  const SExpression a = parse("(approved foo (uuid bar))");
+  const SExpression b = parse("(approved foo\n (uuid bar)\n)");
+  EXPECT_EQ(a == b,
+            RuleCheckMessage::calcFingerprint(a) ==
+                RuleCheckMessage::calcFingerprint(b));
+}
+
+TEST_F(RuleCheckMessageTest, testApprovalFingerprint) {
+  const Uuid uuid = Uuid::createRandom();
+  const Message msg1("foo", uuid);
+  const Message msg2("foo", uuid);
+  const Message msg3("foo", Uuid::createRandom());
+  const Message msg4(msg1);
+  EXPECT_TRUE(msg1.getApprovalFingerprint() ==
+              RuleCheckMessage::calcFingerprint(msg1.getApproval()));
+  EXPECT_TRUE(msg1.getApprovalFingerprint() == msg2.getApprovalFingerprint());
+  EXPECT_FALSE(msg1.getApprovalFingerprint() == msg3.getApprovalFingerprint());
+  EXPECT_TRUE(msg1.getApprovalFingerprint() == msg4.getApprovalFingerprint());
+}
+
+TEST_F(RuleCheckMessageTest, testCalcFingerprints) {
+  const QSet<SExpression> approvals = {
+      parse("(approved foo)"),
+      parse("(approved bar)"),
+  };
+  const QSet<RuleCheckMessage::Fingerprint> fingerprints =
+      RuleCheckMessage::calcFingerprints(approvals);
+  EXPECT_EQ(2, fingerprints.count());
+  EXPECT_TRUE(fingerprints.contains(
+      RuleCheckMessage::calcFingerprint(parse("(approved foo)"))));
+  EXPECT_TRUE(fingerprints.contains(
+      RuleCheckMessage::calcFingerprint(parse("(approved bar)"))));
+  EXPECT_FALSE(fingerprints.contains(
+      RuleCheckMessage::calcFingerprint(parse("(approved baz)"))));
+}
+
+TEST_F(RuleCheckMessageTest, testGetAllApprovalFingerprints) {
+  const Uuid uuid = Uuid::createRandom();
+  const RuleCheckMessageList messages = {
+      std::make_shared<Message>("foo", uuid),
+      std::make_shared<Message>("foo", uuid),
+      std::make_shared<Message>("bar", uuid),
+  };
+  const QSet<RuleCheckMessage::Fingerprint> fingerprints =
+      RuleCheckMessage::getAllApprovalFingerprints(messages);
+  EXPECT_TRUE(fingerprints == RuleCheckMessage::calcFingerprints(
+                                  RuleCheckMessage::getAllApprovals(messages)));
+  EXPECT_EQ(2, fingerprints.count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <chrono>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -158,6 +160,115 @@ TEST_F(SerializableObjectListTest, testIndexOfUuid) {
   EXPECT_EQ(1, l.indexOf(mMocks[1]->mUuid));
 }
 
+TEST_F(SerializableObjectListTest, testIndexOfUuidInLargeList) {
+  // Large enough to use the UUID index.
+  QList<std::shared_ptr<Mock>> mocks;
+  List l;
+  for (int i = 0; i < 100; ++i) {
+    mocks.append(std::make_shared<Mock>(Uuid::createRandom(), QString()));
+    l.append(mocks.last());
+  }
+  auto checkAll = [&]() {
+    EXPECT_EQ(mocks.count(), l.count());
+    for (int i = 0; i < mocks.count(); ++i) {
+      EXPECT_EQ(i, l.indexOf(mocks[i]->mUuid));
+    }
+  };
+  checkAll();
+
+  // Append.
+  mocks.append(std::make_shared<Mock>(Uuid::createRandom(), QString()));
+  l.append(mocks.last());
+  checkAll();
+
+  // Insert.
+  mocks.insert(10, std::make_shared<Mock>(Uuid::createRandom(), QString()));
+  l.insert(10, mocks[10]);
+  checkAll();
+
+  // Remove.
+  const Uuid removedUuid = mocks[20]->mUuid;
+  mocks.removeAt(20);
+  l.remove(20);
+  checkAll();
+  EXPECT_EQ(-1, l.indexOf(removedUuid));
+  EXPECT_FALSE(l.contains(removedUuid));
+
+  // Swap.
+  std::swap(mocks[5], mocks[50]);
+  l.swap(5, 50);
+  checkAll();
+
+  // Modify UUID of an element.
+  const Uuid oldUuid = mocks[30]->mUuid;
+  mocks[30]->mUuid = Uuid::createRandom();
+  mocks[30]->onEdited.notify();
+  checkAll();
+  EXPECT_EQ(-1, l.indexOf(oldUuid));
+
+  // Duplicate UUIDs shall return the first element.
+  l.append(std::make_shared<Mock>(mocks[40]->mUuid, QString()));
+  EXPECT_EQ(40, l.indexOf(mocks[40]->mUuid));
+  l.insert(0, std::make_shared<Mock>(mocks[40]->mUuid, QString()));
+  EXPECT_EQ(0, l.indexOf(mocks[40]->mUuid));
+
+  // Clear.
+  l.clear();
+  EXPECT_EQ(-1, l.indexOf(mocks[0]->mUuid));
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfUuidPerformance) {
+  // Roughly the size of a big BGA package.
+  const int count = 5000;
+  List l;
+  for (int i = 0; i < count; ++i) {
+    l.append(std::make_shared<Mock>(Uuid::createRandom(), QString()));
+  }
+  const std::vector<Uuid> uuids = l.getUuids();
+
+  // Look up every element once, like it is done e.g. when loading a project.
+  std::chrono::time_point<std::chrono::high_resolution_clock> start =
+      std::chrono::high_resolution_clock::now();
+  int sum = 0;
+  for (const Uuid& uuid : uuids) {
+    sum += l.indexOf(uuid);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  EXPECT_EQ((count * (count - 1)) / 2, sum);
+  std::cout << "Looked up " << count << " UUIDs in " << (elapsed.count() * 1000)
+            << " ms\n";
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfUuidWithEditsPerformance) {
+  // Roughly the size of a big BGA package.
+  const int count = 5000;
+  List l;
+  for (int i = 0; i < count; ++i) {
+    l.append(std::make_shared<Mock>(Uuid::createRandom(), QString()));
+  }
+  const std::vector<Uuid> uuids = l.getUuids();
+
+  // Look up every element and modify it, like it is done e.g. by undo
+  // commands or fix-ups over all pads of a footprint.
+  std::chrono::time_point<std::chrono::high_resolution_clock> start =
+      std::chrono::high_resolution_clock::now();
+  int sum = 0;
+  for (const Uuid& uuid : uuids) {
+    const int index = l.indexOf(uuid);
+    std::shared_ptr<Mock> obj = l.value(index);
+    obj->mName = "modified";
+    obj->onEdited.notify();
+    sum += index;
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  EXPECT_EQ((count * (count - 1)) / 2, sum);
+  EXPECT_EQ(uuids, l.getUuids());
+  std::cout << "Looked up and edited " << count << " elements in "
+            << (elapsed.count() * 1000) << " ms\n";
+}
+
 TEST_F(SerializableObjectListTest, testIndexOfNameCaseSensitive) {
   List l{mMocks[0], mMocks[1], mMocks[2]};
   EXPECT_EQ(2, l.indexOf("pcb"));
@@ -85,6 +85,28 @@ TEST_F(SQLiteDatabaseTest, testPreparedQuery) {
   db.exec(query);
 }
 
+TEST_F(SQLiteDatabaseTest, testCachedQuery) {
+  SQLiteDatabase db(mTempDbFilePath);
+  db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+  db.exec("INSERT INTO test (name) VALUES ('hello')");
+
+  QSqlQuery& query1 = db.prepareCachedQuery("SELECT COUNT(*) FROM %table",
+                                            {{"%table", "test"}});
+  db.exec(query1);
+  ASSERT_TRUE(query1.first());
+  EXPECT_EQ(1, query1.value(0).toInt());
+
+  // Modifications must be visible even if the query was not finished.
+  SQLiteDatabase db2(mTempDbFilePath);
+  db2.exec("INSERT INTO test (name) VALUES ('world')");
+
+  QSqlQuery& query2 = db.prepareCachedQuery("SELECT COUNT(*) FROM test");
+  EXPECT_EQ(&query1, &query2);
+  db.exec(query2);
+  ASSERT_TRUE(query2.first());
+  EXPECT_EQ(2, query2.value(0).toInt());
+}
+
 TEST_F(SQLiteDatabaseTest, testInsert) {
   SQLiteDatabase db(mTempDbFilePath);
   db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
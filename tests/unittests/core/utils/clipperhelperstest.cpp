@@ -59,6 +59,33 @@ TEST_F(ClipperHelpersTest, testConvertPathWithApproximate) {
       outputStr.toStdString());
 }
 
+TEST_F(ClipperHelpersTest, testConvertPathsMemoryUsage) {
+  // Simulate the fragments of a board with big pours.
+  ClipperLib::Paths input;
+  for (int i = 0; i < 1000; ++i) {
+    ClipperLib::Path path;
+    for (int k = 0; k < 500; ++k) {
+      const qreal angle = 2 * M_PI * k / 500;
+      path.push_back(
+          ClipperLib::IntPoint(i * 1000000 + qRound64(400000 * std::cos(angle)),
+                               qRound64(400000 * std::sin(angle))));
+    }
+    input.push_back(path);
+  }
+
+  const QVector<Path> output = ClipperHelpers::convert(input);
+  qint64 usedBytes = 0;
+  qint64 allocatedBytes = 0;
+  for (const Path& path : output) {
+    EXPECT_TRUE(path.isClosed());
+    usedBytes += path.getVertices().count() * qint64(sizeof(Vertex));
+    allocatedBytes += path.getVertices().capacity() * qint64(sizeof(Vertex));
+  }
+  std::cout << "Vertices memory: " << (usedBytes / 1024) << " KiB used, "
+            << (allocatedBytes / 1024) << " KiB allocated" << std::endl;
+  EXPECT_EQ(usedBytes, allocatedBytes);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
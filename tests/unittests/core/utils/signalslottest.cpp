@@ -100,6 +100,65 @@ TEST(SignalSlotTest, testDuringCallbackDetachedSlotsAreNotCalled) {
   EXPECT_EQ(1, callbackCounter);
 }
 
+TEST(SignalSlotTest, testBatchedNotificationsAreCoalesced) {
+  Sender sender;
+  QList<int> received;
+  Slot<Sender, int> slot(
+      [&](const Sender&, int value) { received.append(value); });
+  slot.setBatched(true);
+  sender.signal.attach(slot);
+
+  {
+    SignalBatch batch;
+    sender.signal.notify(1);
+    sender.signal.notify(2);
+    sender.signal.notify(1);
+    {
+      SignalBatch nestedBatch;
+      sender.signal.notify(2);
+    }
+    EXPECT_EQ(QList<int>{}, received);
+  }
+  EXPECT_EQ((QList<int>{1, 2}), received);
+
+  // Without batch, the slot is called immediately.
+  sender.signal.notify(1);
+  EXPECT_EQ((QList<int>{1, 2, 1}), received);
+}
+
+TEST(SignalSlotTest, testUnbatchedSlotsAreCalledImmediately) {
+  Sender sender;
+  Receiver receiver;
+  sender.signal.attach(receiver.slot);
+
+  SignalBatch batch;
+  EXPECT_CALL(receiver, callback(testing::_, 42)).Times(2);
+  sender.signal.notify(42);
+  sender.signal.notify(42);
+  testing::Mock::VerifyAndClearExpectations(&receiver);
+}
+
+TEST(SignalSlotTest, testBatchedNotificationsOfDestroyedObjectsAreDiscarded) {
+  std::unique_ptr<Sender> sender1(new Sender());
+  Sender sender2;
+  std::unique_ptr<Receiver> receiver1(new Receiver());
+  Receiver receiver2;
+  receiver1->slot.setBatched(true);
+  receiver2.slot.setBatched(true);
+  sender1->signal.attach(receiver1->slot);
+  sender1->signal.attach(receiver2.slot);
+  sender2.signal.attach(receiver2.slot);
+
+  EXPECT_CALL(receiver2, callback(testing::Ref(sender2), 2)).Times(1);
+  {
+    SignalBatch batch;
+    sender1->signal.notify(1);
+    sender2.signal.notify(2);
+    receiver1.reset();
+    sender1.reset();
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
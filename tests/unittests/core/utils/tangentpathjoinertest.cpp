@@ -26,6 +26,8 @@
 #include <librepcb/core/serialization/sexpression.h>
 #include <librepcb/core/utils/tangentpathjoiner.h>
 
+#include <chrono>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -351,6 +353,87 @@ TEST_F(TangentPathJoinerTest, testManyTangentPaths) {
   EXPECT_EQ(str(expected), str(output)) << debug(expected, output);
 }
 
+// For testing performance with a huge, shuffled outline.
+TEST_F(TangentPathJoinerTest, testHugeShuffledOutline) {
+  const int sideLength = 2500;
+  QVector<Point> corners;
+  for (int i = 0; i < sideLength; ++i) {
+    corners.append(Point(i, 0));
+  }
+  for (int i = 0; i < sideLength; ++i) {
+    corners.append(Point(sideLength, i));
+  }
+  for (int i = 0; i < sideLength; ++i) {
+    corners.append(Point(sideLength - i, sideLength));
+  }
+  for (int i = 0; i < sideLength; ++i) {
+    corners.append(Point(0, sideLength - i));
+  }
+  for (Point& p : corners) {
+    p *= 100000;  // 0.1mm grid
+  }
+  QVector<Path> input;
+  const int count = corners.count();
+  for (int i = 0; i < count; ++i) {
+    const int k = (i * 7919) % count;
+    Path path = Path::line(corners.at(k), corners.at((k + 1) % count));
+    if (i % 2) {
+      path.reverse();
+    }
+    input.append(path);
+  }
+
+  std::chrono::time_point<std::chrono::high_resolution_clock> start =
+      std::chrono::high_resolution_clock::now();
+  QVector<Path> output = TangentPathJoiner::join(input);
+  std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  std::cout << "Joined " << input.count() << " segments in "
+            << (elapsed.count() * 1000) << " ms\n";
+
+  ASSERT_EQ(1, output.count());
+  EXPECT_TRUE(output.first().isClosed());
+  EXPECT_EQ(count + 1, output.first().getVertices().count());
+  EXPECT_NEAR(250 * 250, output.first().calcAreaOfStraightSegments(), 0.1);
+}
+
+// For testing performance with huge input containing many ambiguous
+// junctions, which must be joined completely and deterministically.
+TEST_F(TangentPathJoinerTest, testHugeGrid) {
+  const int size = 72;
+  QVector<Path> input;
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      if (x + 1 < size) {
+        input.append(Path::line(Point(x, y), Point(x + 1, y)));
+      }
+      if (y + 1 < size) {
+        input.append(Path::line(Point(x, y), Point(x, y + 1)));
+      }
+    }
+  }
+
+  std::chrono::time_point<std::chrono::high_resolution_clock> start =
+      std::chrono::high_resolution_clock::now();
+  QVector<Path> output = TangentPathJoiner::join(input);
+  std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  std::cout << "Joined " << input.count() << " segments in "
+            << (elapsed.count() * 1000) << " ms\n";
+
+  // Every segment must be contained exactly once in the output.
+  int segments = 0;
+  foreach (const Path& path, output) {
+    segments += path.getVertices().count() - 1;
+  }
+  EXPECT_EQ(input.count(), segments);
+  EXPECT_LT(output.count(), input.count() / 2);
+
+  // The result must be deterministic.
+  QVector<Path> output2 = TangentPathJoiner::join(input);
+  EXPECT_EQ(str(output), str(output2));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -21,7 +21,11 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/core/attribute/attrtypestring.h>
+#include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/cat/componentcategory.h>
 #include <librepcb/core/library/cat/packagecategory.h>
 #include <librepcb/core/library/cmp/component.h>
@@ -110,6 +114,39 @@ protected:
   Version version(const QString& version) {
     return Version::fromString(version);
   }
+
+  FilePath createLibrary(const QString& name) {
+    const FilePath fp = toAbs("local/" % name % ".lplib");
+    Library lib(uuid(), version("0.1"), "", ElementName(name), "", "");
+    saveElement(lib, fp);
+    return fp;
+  }
+
+  FilePath createSymbol(const FilePath& libDir, const Uuid& uuid) {
+    const FilePath fp = libDir.getPathTo("sym/" % uuid.toStr());
+    Symbol sym(uuid, version("0.1"), "", ElementName("Symbol"), "", "");
+    saveElement(sym, fp);
+    return fp;
+  }
+
+  template <typename T>
+  void saveElement(T& element, const FilePath& dir) {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(dir);
+    TransactionalDirectory transactionalDir(fs);
+    element.moveTo(transactionalDir);
+    fs->save();
+  }
+
+  template <typename Fn>
+  void rescanAndWait(Fn startScan) {
+    QEventLoop loop;
+    QObject::connect(mWsDb.get(), &WorkspaceLibraryDb::scanFinished, &loop,
+                     &QEventLoop::quit);
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);  // Avoid hanging.
+    startScan();
+    loop.exec();
+  }
 };
 
 /*******************************************************************************
@@ -312,6 +349,36 @@ TEST_F(WorkspaceLibraryDbTest, testGetLatest) {
   EXPECT_EQ(str(toAbs("sym3")), str(mWsDb->getLatest<Symbol>(uuid(0))));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testGetLatestBulk) {
+  int lib1 = mWriter->addLibrary(toAbs("lib1"), uuid(), version("1"), false,
+                                 QByteArray(), QString());
+  mWriter->addElement<Symbol>(lib1, toAbs("sym1"), uuid(0), version("0.1"),
+                              false, QString());
+  mWriter->addElement<Symbol>(lib1, toAbs("sym2"), uuid(0), version("0.2"),
+                              false, QString());
+  mWriter->addElement<Symbol>(lib1, toAbs("sym3"), uuid(1), version("0.1"),
+                              false, QString());
+
+  const QHash<Uuid, FilePath> result =
+      mWsDb->getLatest<Symbol>(QSet<Uuid>{uuid(0), uuid(1), uuid(2)});
+  EXPECT_EQ(2, result.count());
+  EXPECT_EQ(str(toAbs("sym2")), str(result.value(uuid(0))));
+  EXPECT_EQ(str(toAbs("sym3")), str(result.value(uuid(1))));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetLatestBulkManyElements) {
+  QSet<Uuid> uuids;
+  for (int i = 0; i < 250; ++i) {
+    const Uuid uuid = Uuid::createRandom();
+    mWriter->addElement<Symbol>(0, toAbs(QString("sym%1").arg(i)), uuid,
+                                version("0.1"), false, QString());
+    uuids.insert(uuid);
+  }
+
+  const QHash<Uuid, FilePath> result = mWsDb->getLatest<Symbol>(uuids);
+  EXPECT_EQ(str(uuids), str(Toolbox::toSet(result.keys())));
+}
+
 /*******************************************************************************
  *  Tests for find()
  ******************************************************************************/
@@ -563,6 +630,37 @@ TEST_F(WorkspaceLibraryDbTest, testGetTranslationsNullptr) {
   EXPECT_EQ("_k", keywords.toStdString());
 }
 
+/*******************************************************************************
+ *  Tests for getElementInfos()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testGetElementInfosEmptyDb) {
+  EXPECT_EQ(0,
+            mWsDb->getElementInfos<Symbol>({toAbs("fp")}, QStringList{})
+                .count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetElementInfos) {
+  int id = mWriter->addElement<Symbol>(0, toAbs("fp1"), uuid(), version("0.1"),
+                                       false, QString());
+  mWriter->addTranslation<Symbol>(id, "", ElementName("n1"), "d1", "k1");
+  mWriter->addTranslation<Symbol>(id, "de_DE", ElementName("n1_de"), "d1_de",
+                                  std::nullopt);
+  mWriter->addElement<Symbol>(0, toAbs("fp2"), uuid(), version("0.1"), true,
+                              QString());
+
+  const QHash<FilePath, WorkspaceLibraryDb::ElementInfo> result =
+      mWsDb->getElementInfos<Symbol>(
+          {toAbs("fp1"), toAbs("fp2"), toAbs("fp3")}, QStringList{"de_DE"});
+  ASSERT_EQ(2, result.count());
+  EXPECT_EQ("n1_de", result.value(toAbs("fp1")).name.toStdString());
+  EXPECT_EQ("d1_de", result.value(toAbs("fp1")).description.toStdString());
+  EXPECT_EQ("k1", result.value(toAbs("fp1")).keywords.toStdString());
+  EXPECT_FALSE(result.value(toAbs("fp1")).deprecated);
+  EXPECT_EQ("", result.value(toAbs("fp2")).name.toStdString());
+  EXPECT_TRUE(result.value(toAbs("fp2")).deprecated);
+}
+
 /*******************************************************************************
  *  Tests for getMetadata()
  ******************************************************************************/
@@ -802,6 +900,20 @@ TEST_F(WorkspaceLibraryDbTest, testGetDeviceMetadataNullptr) {
   EXPECT_EQ(str(uuid(2)), str(pkgUuid));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testGetDeviceMetadataBulk) {
+  mWriter->addDevice(0, toAbs("fp1"), uuid(), version("1.1"), false, QString(),
+                     uuid(1), uuid(2));
+  mWriter->addDevice(0, toAbs("fp2"), uuid(), version("1.1"), false, QString(),
+                     uuid(3), uuid(4));
+
+  const QHash<FilePath, std::pair<Uuid, Uuid>> result =
+      mWsDb->getDeviceMetadata(QList<FilePath>{toAbs("fp1"), toAbs("fp3")});
+  ASSERT_EQ(1, result.count());
+  EXPECT_EQ(str(uuid(1)), str(result.begin()->first));
+  EXPECT_EQ(str(uuid(2)), str(result.begin()->second));
+  EXPECT_EQ(str(toAbs("fp1")), str(result.begin().key()));
+}
+
 /*******************************************************************************
  *  Tests for getChilds()
  ******************************************************************************/
@@ -1035,6 +1147,34 @@ TEST_F(WorkspaceLibraryDbTest, testGetGenerated) {
             str(mWsDb->getGenerated<Device>("gen:1")));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testGetAllGeneratedByEmptyDb) {
+  EXPECT_EQ(0, mWsDb->getAllGeneratedBy<Symbol>().count());
+  EXPECT_EQ(0, mWsDb->getAllGeneratedBy<Package>().count());
+  EXPECT_EQ(0, mWsDb->getAllGeneratedBy<Component>().count());
+  EXPECT_EQ(0, mWsDb->getAllGeneratedBy<Device>().count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetAllGeneratedBy) {
+  mWriter->addElement<Symbol>(0, toAbs("sym1"), uuid(1), version("0.1"), false,
+                              "");
+  mWriter->addElement<Symbol>(0, toAbs("sym2"), uuid(2), version("0.1"), false,
+                              "gen:1");
+  mWriter->addElement<Symbol>(0, toAbs("sym3"), uuid(3), version("0.2"), false,
+                              "gen:1");
+  mWriter->addElement<Symbol>(0, toAbs("sym4"), uuid(4), version("0.1"), false,
+                              "gen:2");
+  mWriter->addElement<Package>(0, toAbs("pkg1"), uuid(5), version("0.1"), false,
+                               QString());
+  mWriter->addDevice(0, toAbs("dev1"), uuid(6), version("0.1"), false, "gen:3",
+                     uuid(), uuid());
+
+  EXPECT_EQ((QSet<QString>{"gen:1", "gen:2"}),
+            mWsDb->getAllGeneratedBy<Symbol>());
+  EXPECT_EQ(QSet<QString>{}, mWsDb->getAllGeneratedBy<Package>());
+  EXPECT_EQ(QSet<QString>{}, mWsDb->getAllGeneratedBy<Component>());
+  EXPECT_EQ(QSet<QString>{"gen:3"}, mWsDb->getAllGeneratedBy<Device>());
+}
+
 /*******************************************************************************
  *  Tests for getComponentDevices()
  ******************************************************************************/
@@ -1066,6 +1206,187 @@ TEST_F(WorkspaceLibraryDbTest, testGetComponentDevicesDuplicates) {
   EXPECT_EQ(str(QSet<Uuid>{uuid(1)}), str(mWsDb->getComponentDevices(uuid(0))));
 }
 
+/*******************************************************************************
+ *  Tests for getDeviceParts()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testGetDevicePartsEmptyDb) {
+  EXPECT_EQ(0, mWsDb->getDeviceParts(uuid()).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetDeviceParts) {
+  int dev1 = mWriter->addDevice(0, toAbs("dev1"), uuid(1), version("0.1"),
+                                false, QString(), uuid(), uuid());
+  int dev2 = mWriter->addDevice(0, toAbs("dev2"), uuid(2), version("0.1"),
+                                false, QString(), uuid(), uuid());
+  int part1 = mWriter->addPart(dev1, "MPN1", "Foo");
+  mWriter->addPartAttribute(
+      part1,
+      Attribute(AttributeKey("A"), AttrTypeString::instance(), "1", nullptr));
+  mWriter->addPartAttribute(
+      part1,
+      Attribute(AttributeKey("B"), AttrTypeString::instance(), "2", nullptr));
+  mWriter->addPart(dev1, "MPN2", "Bar");
+  mWriter->addPart(dev2, "MPN3", "Foo");
+
+  const QHash<Uuid, QList<WorkspaceLibraryDb::Part>> result =
+      mWsDb->getDeviceParts(QSet<Uuid>{uuid(1), uuid(2), uuid(3)});
+  ASSERT_EQ(2, result.count());
+  const QList<WorkspaceLibraryDb::Part> parts1 = result.value(uuid(1));
+  ASSERT_EQ(2, parts1.count());
+  EXPECT_EQ("MPN1", parts1.at(0).mpn.toStdString());
+  EXPECT_EQ("Foo", parts1.at(0).manufacturer.toStdString());
+  ASSERT_EQ(2, parts1.at(0).attributes.count());
+  EXPECT_EQ("A", parts1.at(0).attributes.at(0)->getKey()->toStdString());
+  EXPECT_EQ("B", parts1.at(0).attributes.at(1)->getKey()->toStdString());
+  EXPECT_EQ("MPN2", parts1.at(1).mpn.toStdString());
+  EXPECT_EQ(0, parts1.at(1).attributes.count());
+  ASSERT_EQ(1, result.value(uuid(2)).count());
+  EXPECT_EQ("MPN3", result.value(uuid(2)).first().mpn.toStdString());
+
+  // The single-device variant must return the same.
+  EXPECT_TRUE(mWsDb->getDeviceParts(uuid(1)) == parts1);
+}
+
+/*******************************************************************************
+ *  Tests for removeAllElements() and startSingleLibraryRescan()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testRemoveAllElementsOfLibrary) {
+  int lib1 = mWriter->addLibrary(toAbs("lib1"), uuid(), version("1"), false,
+                                 QByteArray(), QString());
+  int lib2 = mWriter->addLibrary(toAbs("lib2"), uuid(), version("2"), false,
+                                 QByteArray(), QString());
+  mWriter->addElement<Symbol>(lib1, toAbs("lib1/sym1"), uuid(1),
+                              version("0.1"), false, QString());
+  mWriter->addElement<Symbol>(lib2, toAbs("lib2/sym2"), uuid(2),
+                              version("0.1"), false, QString());
+  mWriter->addElement<Package>(lib1, toAbs("lib1/pkg1"), uuid(3),
+                               version("0.1"), false, QString());
+
+  mWriter->removeAllElements<Symbol>(lib1);
+  EXPECT_EQ(0, mWsDb->getAll<Symbol>(std::nullopt, toAbs("lib1")).count());
+  EXPECT_EQ(1, mWsDb->getAll<Symbol>(std::nullopt, toAbs("lib2")).count());
+  EXPECT_EQ(1, mWsDb->getAll<Package>(std::nullopt, toAbs("lib1")).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testStartSingleLibraryRescan) {
+  const FilePath lib1 = createLibrary("Lib1");
+  const FilePath lib2 = createLibrary("Lib2");
+  const FilePath sym1 = createSymbol(lib1, uuid(1));
+  const FilePath sym2 = createSymbol(lib2, uuid(2));
+  rescanAndWait([this]() { mWsDb->startLibraryRescan(); });
+  ASSERT_EQ(str(sym1), str(mWsDb->getLatest<Symbol>(uuid(1))));
+  ASSERT_EQ(str(sym2), str(mWsDb->getLatest<Symbol>(uuid(2))));
+
+  // Modify both libraries, but rescan only the first one.
+  const FilePath sym3 = createSymbol(lib1, uuid(3));
+  const FilePath sym4 = createSymbol(lib2, uuid(4));
+  FileUtils::removeDirRecursively(sym2);
+  rescanAndWait([&]() { mWsDb->startSingleLibraryRescan(lib1); });
+  EXPECT_EQ(str(sym1), str(mWsDb->getLatest<Symbol>(uuid(1))));
+  EXPECT_EQ(str(sym3), str(mWsDb->getLatest<Symbol>(uuid(3))));
+  EXPECT_EQ(2, mWsDb->getAll<Symbol>(std::nullopt, lib1).count());
+  EXPECT_EQ(str(sym2), str(mWsDb->getLatest<Symbol>(uuid(2))));
+  EXPECT_FALSE(mWsDb->getLatest<Symbol>(uuid(4)).isValid());
+  EXPECT_EQ(1, mWsDb->getAll<Symbol>(std::nullopt, lib2).count());
+  EXPECT_EQ(2, mWsDb->getAll<Library>().count());
+
+  // A full rescan picks up the modifications of the second library too.
+  rescanAndWait([this]() { mWsDb->startLibraryRescan(); });
+  EXPECT_FALSE(mWsDb->getLatest<Symbol>(uuid(2)).isValid());
+  EXPECT_EQ(str(sym4), str(mWsDb->getLatest<Symbol>(uuid(4))));
+  EXPECT_EQ(2, mWsDb->getAll<Symbol>(std::nullopt, lib1).count());
+  EXPECT_EQ(1, mWsDb->getAll<Symbol>(std::nullopt, lib2).count());
+}
+
+/*******************************************************************************
+ *  Tests for runAsync()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testRunAsync) {
+  mWriter->addElement<Symbol>(0, toAbs("sym1"), uuid(0), version("0.1"), false,
+                              QString());
+
+  const Uuid symUuid = uuid(0);
+  QThread* thread = nullptr;
+  QFuture<FilePath> future = mWsDb->runAsync<FilePath>(
+      [symUuid, &thread](const WorkspaceLibraryDb& db) {
+        thread = QThread::currentThread();
+        return db.getLatest<Symbol>(symUuid);
+      });
+  future.waitForFinished();
+  ASSERT_EQ(1, future.resultCount());
+  EXPECT_EQ(str(toAbs("sym1")), str(future.result()));
+  EXPECT_NE(QThread::currentThread(), thread);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testRunAsyncSeesChanges) {
+  const Uuid symUuid = uuid(0);
+  auto getSymbol = [symUuid](const WorkspaceLibraryDb& db) {
+    return db.getLatest<Symbol>(symUuid);
+  };
+  EXPECT_FALSE(mWsDb->runAsync<FilePath>(getSymbol).result().isValid());
+  mWriter->addElement<Symbol>(0, toAbs("sym1"), uuid(0), version("0.1"), false,
+                              QString());
+  EXPECT_EQ(str(toAbs("sym1")),
+            str(mWsDb->runAsync<FilePath>(getSymbol).result()));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testRunAsyncException) {
+  QFuture<int> future =
+      mWsDb->runAsync<int>([](const WorkspaceLibraryDb& db) -> int {
+        Q_UNUSED(db);
+        throw RuntimeError(__FILE__, __LINE__, "foo");
+      });
+  EXPECT_THROW(future.waitForFinished(), RuntimeError);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testRunAsyncCanceledBeforeStart) {
+  QSemaphore semaphore;
+  QFuture<int> blocker =
+      mWsDb->runAsync<int>([&semaphore](const WorkspaceLibraryDb& db) {
+        Q_UNUSED(db);
+        semaphore.acquire();
+        return 0;
+      });
+  std::atomic_bool executed(false);
+  QFuture<int> future =
+      mWsDb->runAsync<int>([&executed](const WorkspaceLibraryDb& db) {
+        Q_UNUSED(db);
+        executed = true;
+        return 0;
+      });
+  future.cancel();
+  semaphore.release();
+  blocker.waitForFinished();
+  future.waitForFinished();
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(0, future.resultCount());
+  EXPECT_FALSE(executed);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testRunAsyncCanceledWhileRunning) {
+  const Uuid symUuid = uuid(0);
+  QSemaphore started, canceled;
+  std::atomic_bool queried(false);
+  QFuture<FilePath> future = mWsDb->runAsync<FilePath>(
+      [&](const WorkspaceLibraryDb& db) {
+        started.release();
+        canceled.acquire();
+        const FilePath fp = db.getLatest<Symbol>(symUuid);  // Must throw.
+        queried = true;
+        return fp;
+      });
+  started.acquire();
+  future.cancel();
+  canceled.release();
+  future.waitForFinished();
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(0, future.resultCount());
+  EXPECT_FALSE(queried);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,179 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/sqlitedatabase.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacelibrarydbwriter.h>
+#include <librepcb/core/workspace/workspacelibraryelementcache.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryElementCacheTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  std::unique_ptr<WorkspaceLibraryDb> mWsDb;
+  std::unique_ptr<SQLiteDatabase> mDb;
+  std::unique_ptr<WorkspaceLibraryDbWriter> mWriter;
+
+  WorkspaceLibraryElementCacheTest()
+    : mWsDir(FilePath::getRandomTempPath()) {
+    FileUtils::makePath(mWsDir);
+    mWsDb.reset(new WorkspaceLibraryDb(mWsDir));
+    mDb.reset(new SQLiteDatabase(mWsDb->getFilePath()));
+    mWriter.reset(new WorkspaceLibraryDbWriter(mWsDir, *mDb));
+  }
+
+  virtual ~WorkspaceLibraryElementCacheTest() {
+    mWsDb.reset();  // Wait for prefetching to be finished.
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  WorkspaceLibraryElementCache& cache() { return mWsDb->getElementCache(); }
+
+  FilePath createSymbol(const QString& dir, const Uuid& uuid,
+                        const QString& version, bool addToDb = true) {
+    const FilePath fp = mWsDir.getPathTo(dir);
+    Symbol sym(uuid, Version::fromString(version), "", ElementName("Test"),
+               "", "");
+    TransactionalDirectory transDir(TransactionalFileSystem::openRW(fp));
+    sym.saveTo(transDir);
+    transDir.getFileSystem()->save();
+    if (addToDb) {
+      mWriter->addElement<Symbol>(0, fp, uuid, Version::fromString(version),
+                                  false, QString());
+    }
+    return fp;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryElementCacheTest, testGetReturnsCachedElement) {
+  const Uuid uuid = Uuid::createRandom();
+  const FilePath fp = createSymbol("sym", uuid, "0.1", false);
+
+  std::shared_ptr<const Symbol> sym1 = cache().get<Symbol>(fp);
+  std::shared_ptr<const Symbol> sym2 = cache().get<Symbol>(fp);
+  ASSERT_TRUE(sym1);
+  EXPECT_EQ(uuid, sym1->getUuid());
+  EXPECT_EQ(sym1.get(), sym2.get());
+  EXPECT_EQ(1, cache().getCount());
+}
+
+TEST_F(WorkspaceLibraryElementCacheTest, testGetInexistentElement) {
+  EXPECT_THROW(cache().get<Symbol>(mWsDir.getPathTo("foo")), Exception);
+  EXPECT_EQ(0, cache().getCount());
+}
+
+TEST_F(WorkspaceLibraryElementCacheTest, testGetLatest) {
+  const Uuid uuid = Uuid::createRandom();
+  createSymbol("sym1", uuid, "0.1");
+  const FilePath fp2 = createSymbol("sym2", uuid, "0.2");
+
+  std::shared_ptr<const Symbol> sym = cache().getLatest<Symbol>(uuid);
+  ASSERT_TRUE(sym);
+  EXPECT_EQ("0.2", sym->getVersion().toStr().toStdString());
+  EXPECT_EQ(sym.get(), cache().get<Symbol>(fp2).get());
+  EXPECT_EQ(nullptr, cache().getLatest<Symbol>(Uuid::createRandom()));
+}
+
+TEST_F(WorkspaceLibraryElementCacheTest, testLeastRecentlyUsedEviction) {
+  const FilePath fp1 = createSymbol("sym1", Uuid::createRandom(), "0.1");
+  const FilePath fp2 = createSymbol("sym2", Uuid::createRandom(), "0.1");
+  const FilePath fp3 = createSymbol("sym3", Uuid::createRandom(), "0.1");
+  cache().setCapacity(2);
+
+  cache().get<Symbol>(fp1);
+  cache().get<Symbol>(fp2);
+  cache().get<Symbol>(fp1);
+  cache().get<Symbol>(fp3);
+  EXPECT_EQ(2, cache().getCount());
+  EXPECT_TRUE(cache().contains(fp1));
+  EXPECT_FALSE(cache().contains(fp2));
+  EXPECT_TRUE(cache().contains(fp3));
+}
+
+TEST_F(WorkspaceLibraryElementCacheTest, testValidateRemovesOutdated) {
+  const Uuid uuid2 = Uuid::createRandom();
+  const FilePath fp1 = createSymbol("sym1", Uuid::createRandom(), "0.1");
+  const FilePath fp2 = createSymbol("sym2", uuid2, "0.1");
+  const FilePath fp3 = createSymbol("sym3", Uuid::createRandom(), "0.1");
+  cache().get<Symbol>(fp1);
+  cache().get<Symbol>(fp2);
+  cache().get<Symbol>(fp3);
+
+  // Update the version of the second symbol, remove the third symbol.
+  mWriter->removeElement<Symbol>(fp2);
+  mWriter->addElement<Symbol>(0, fp2, uuid2, Version::fromString("0.2"), false,
+                              QString());
+  mWriter->removeElement<Symbol>(fp3);
+
+  cache().validate();
+  EXPECT_TRUE(cache().contains(fp1));
+  EXPECT_FALSE(cache().contains(fp2));
+  EXPECT_FALSE(cache().contains(fp3));
+}
+
+TEST_F(WorkspaceLibraryElementCacheTest, testConcurrentAccess) {
+  QList<FilePath> fps;
+  for (int i = 0; i < 10; ++i) {
+    fps.append(createSymbol("sym" % QString::number(i), Uuid::createRandom(),
+                            "0.1", false));
+  }
+  QList<FilePath> requests;
+  for (int i = 0; i < 20; ++i) {
+    requests += fps;
+  }
+  cache().prefetch<Symbol>(fps.mid(0, 5));
+  const QList<bool> results = QtConcurrent::blockingMapped(
+      requests, [this](const FilePath& fp) {
+        return cache().get<Symbol>(fp)->getDirectory().getAbsPath() == fp;
+      });
+  EXPECT_EQ(requests.count(), results.count(true));
+  EXPECT_EQ(fps.count(), cache().getCount());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/library/pkg/packagecheckmessages.h>
+#include <librepcb/editor/library/cmd/cmdfootprintpadedit.h>
+#include <librepcb/editor/library/pkg/packagecheckobjectlookup.h>
+#include <librepcb/editor/undostack.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PackageCheckObjectLookupTest : public ::testing::Test {
+protected:
+  template <typename T>
+  static std::shared_ptr<const T> getMessage(const RuleCheckMessageList& msgs) {
+    for (const auto& msg : msgs) {
+      if (auto m = std::dynamic_pointer_cast<const T>(msg)) {
+        return m;
+      }
+    }
+    return nullptr;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PackageCheckObjectLookupTest, testFixMessageOfCopy) {
+  Package pkg(Uuid::createRandom(), Version::fromString("0.1"), "",
+              ElementName("Test"), "", "", Package::AssemblyType::Smt);
+  std::shared_ptr<Footprint> footprint = std::make_shared<Footprint>(
+      Uuid::createRandom(), ElementName("default"), "");
+  std::shared_ptr<FootprintPad> pad = std::make_shared<FootprintPad>(
+      Uuid::createRandom(), std::nullopt, Point(0, 0), Angle(0),
+      FootprintPad::Shape::RoundedRect, PositiveLength(1000000),
+      PositiveLength(1000000), UnsignedLimitedRatio(Ratio::fromPercent(0)),
+      Path(), MaskConfig::off(), MaskConfig::automatic(), UnsignedLength(0),
+      FootprintPad::ComponentSide::Top, FootprintPad::Function::StandardPad,
+      PadHoleList{});
+  footprint->getPads().append(pad);
+  pkg.getFootprints().append(footprint);
+
+  // Run the checks on a copy, like the package editor does in the background.
+  std::unique_ptr<Package> copy = pkg.clone();
+  std::shared_ptr<const MsgPadStopMaskOff> msg =
+      getMessage<MsgPadStopMaskOff>(copy->runChecks());
+  ASSERT_TRUE(msg);
+  EXPECT_NE(pad.get(), msg->getPad().get());
+  EXPECT_EQ(-1, pkg.getFootprints().indexOf(msg->getFootprint().get()));
+
+  // The message must resolve to the objects of the original package.
+  const PackageCheckObjectLookup lookup(pkg);
+  EXPECT_EQ(footprint, lookup.getFootprint(*msg->getFootprint()));
+  EXPECT_EQ(pad, lookup.getPad(*msg->getFootprint(), *msg->getPad()));
+
+  // Apply the fix like the package editor does.
+  UndoStack undoStack;
+  std::unique_ptr<CmdFootprintPadEdit> cmd(new CmdFootprintPadEdit(
+      *lookup.getPad(*msg->getFootprint(), *msg->getPad())));
+  cmd->setStopMaskConfig(MaskConfig::automatic(), false);
+  undoStack.execCmd(cmd.release());
+  EXPECT_EQ(MaskConfig::automatic(), pad->getStopMaskConfig());
+  EXPECT_FALSE(getMessage<MsgPadStopMaskOff>(pkg.runChecks()));
+  EXPECT_FALSE(getMessage<MsgPadStopMaskOff>(pkg.clone()->runChecks()));
+
+  // Objects which don't exist anymore can't be resolved.
+  pkg.getFootprints().clear();
+  EXPECT_THROW(lookup.getPad(*msg->getFootprint(), *msg->getPad()), Exception);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb